@@ -80,5 +80,6 @@
 \defgroup union union: calculate new geometry containing geometries A or B
 \defgroup unique unique: make a geometry unique w.r.t. points,
 \defgroup within within: detect if a geometry is inside another geometry, a.o. point-in-polygon
+\defgroup wkb wkb: read and write WKB (Well-Known Binary)
 \defgroup wkt wkt: parse and stream WKT (Well-Known Text)
 */
@@ -222,6 +222,14 @@ of a geometry.
 
 */
 
+/*!
+\page WKB WKB (Well-Known Binary)
+WKB is a binary representation of a geometry, explained here: http://en.wikipedia.org/wiki/Well-known_text#Well-known_binary
+WKB can represent a point, a linestring, a polygon, or multi versions of those, also with Z and M coordinates.
+It is used by spatial databases, e.g. PostGIS, which also uses an extended form (EWKB) storing the SRID.
+
+*/
+
 //---------------------------------------------------------------------------------------------------
 
 
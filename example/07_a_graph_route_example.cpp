@@ -17,6 +17,7 @@
 #include <iomanip>
 #include <limits>
 
+#include <boost/algorithm/string.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <boost/foreach.hpp>
 
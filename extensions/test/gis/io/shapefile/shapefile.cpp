@@ -0,0 +1,410 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <boost/geometry/algorithms/area.hpp>
+#include <boost/geometry/algorithms/equals.hpp>
+#include <boost/geometry/algorithms/length.hpp>
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/index/rtree.hpp>
+#include <boost/geometry/strategies/strategies.hpp>
+
+#include <boost/geometry/extensions/gis/io/shapefile/shapefile.hpp>
+
+
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
+typedef std::vector<unsigned char> byte_vector;
+typedef bg::model::d2::point_xy<double> point_type;
+typedef bg::model::box<point_type> box_type;
+
+
+void push_big(byte_vector& bytes, boost::int32_t value)
+{
+    boost::uint32_t const v = static_cast<boost::uint32_t>(value);
+    for (int i = 3; i >= 0; --i)
+    {
+        bytes.push_back(static_cast<unsigned char>((v >> (i * 8)) & 0xFF));
+    }
+}
+
+void push_little(byte_vector& bytes, boost::int32_t value)
+{
+    boost::uint32_t const v = static_cast<boost::uint32_t>(value);
+    for (int i = 0; i < 4; ++i)
+    {
+        bytes.push_back(static_cast<unsigned char>((v >> (i * 8)) & 0xFF));
+    }
+}
+
+void push_little(byte_vector& bytes, double value)
+{
+    boost::uint64_t v = 0;
+    std::memcpy(&v, &value, sizeof(double));
+    for (int i = 0; i < 8; ++i)
+    {
+        bytes.push_back(static_cast<unsigned char>((v >> (i * 8)) & 0xFF));
+    }
+}
+
+void push_box(byte_vector& bytes, double x1, double y1, double x2, double y2)
+{
+    push_little(bytes, x1);
+    push_little(bytes, y1);
+    push_little(bytes, x2);
+    push_little(bytes, y2);
+}
+
+// The file header with the length set by finish()
+byte_vector file_header(boost::int32_t type)
+{
+    byte_vector bytes;
+    push_big(bytes, 9994);
+    for (int i = 0; i < 5; ++i)
+    {
+        push_big(bytes, 0);
+    }
+    push_big(bytes, 0);
+    push_little(bytes, 1000);
+    push_little(bytes, type);
+    push_box(bytes, 0, 0, 30, 20);
+    push_box(bytes, 0, 0, 0, 0);
+    return bytes;
+}
+
+void set_length(byte_vector& bytes, std::size_t offset, std::size_t size)
+{
+    byte_vector length;
+    push_big(length, static_cast<boost::int32_t>(size / 2));
+    std::copy(length.begin(), length.end(), bytes.begin() + offset);
+}
+
+// Builds the .shp and .shx files from the contents of the records
+struct shapefile_builder
+{
+    shapefile_builder()
+        : shp(file_header(5))
+        , shx(file_header(5))
+        , count(0)
+    {}
+
+    void add(byte_vector const& content)
+    {
+        push_big(shx, static_cast<boost::int32_t>(shp.size() / 2));
+        push_big(shx, static_cast<boost::int32_t>(content.size() / 2));
+
+        push_big(shp, static_cast<boost::int32_t>(++count));
+        push_big(shp, static_cast<boost::int32_t>(content.size() / 2));
+        shp.insert(shp.end(), content.begin(), content.end());
+
+        set_length(shp, 24, shp.size());
+        set_length(shx, 24, shx.size());
+    }
+
+    byte_vector shp;
+    byte_vector shx;
+    int count;
+};
+
+byte_vector null_shape()
+{
+    byte_vector content;
+    push_little(content, 0);
+    return content;
+}
+
+byte_vector point_shape(double x, double y)
+{
+    byte_vector content;
+    push_little(content, 1);
+    push_little(content, x);
+    push_little(content, y);
+    return content;
+}
+
+// Polygon, polyline or multipatch, the parts are passed as the flat array
+// of coordinates, for multipatch the part types and Z coordinates are added
+byte_vector multi_part_shape(boost::int32_t type,
+                             std::vector<std::vector<double> > const& parts,
+                             std::vector<boost::int32_t> const& part_types
+                                = std::vector<boost::int32_t>())
+{
+    double x1 = 1e9, y1 = 1e9, x2 = -1e9, y2 = -1e9;
+    boost::int32_t num_points = 0;
+    for (std::size_t i = 0; i < parts.size(); ++i)
+    {
+        for (std::size_t j = 0; j < parts[i].size(); j += 2)
+        {
+            x1 = (std::min)(x1, parts[i][j]);
+            y1 = (std::min)(y1, parts[i][j + 1]);
+            x2 = (std::max)(x2, parts[i][j]);
+            y2 = (std::max)(y2, parts[i][j + 1]);
+        }
+    }
+
+    byte_vector content;
+    push_little(content, type);
+    push_box(content, x1, y1, x2, y2);
+    push_little(content, static_cast<boost::int32_t>(parts.size()));
+    std::size_t const num_points_offset = content.size();
+    push_little(content, 0);
+    for (std::size_t i = 0; i < parts.size(); ++i)
+    {
+        push_little(content, num_points);
+        num_points += static_cast<boost::int32_t>(parts[i].size() / 2);
+    }
+    for (std::size_t i = 0; i < part_types.size(); ++i)
+    {
+        push_little(content, part_types[i]);
+    }
+    for (std::size_t i = 0; i < parts.size(); ++i)
+    {
+        for (std::size_t j = 0; j < parts[i].size(); ++j)
+        {
+            push_little(content, parts[i][j]);
+        }
+    }
+    if (! part_types.empty())
+    {
+        // Z range and Z coordinates
+        push_little(content, 0.0);
+        push_little(content, 1.0);
+        for (boost::int32_t i = 0; i < num_points; ++i)
+        {
+            push_little(content, 1.0);
+        }
+    }
+
+    byte_vector count;
+    push_little(count, num_points);
+    std::copy(count.begin(), count.end(), content.begin() + num_points_offset);
+    return content;
+}
+
+std::vector<double> coords(double const* first, std::size_t count)
+{
+    return std::vector<double>(first, first + count);
+}
+
+shapefile_builder test_shapefile()
+{
+    // clockwise outer ring and counterclockwise hole
+    double const outer[] = { 0,0, 0,10, 10,10, 10,0, 0,0 };
+    double const inner[] = { 2,2, 4,2, 4,4, 2,4, 2,2 };
+    double const other[] = { 20,10, 20,20, 30,20, 30,10, 20,10 };
+    double const line1[] = { 0,15, 5,15 };
+    double const line2[] = { 5,20, 5,17, 1,17 };
+
+    std::vector<std::vector<double> > polygon;
+    polygon.push_back(coords(outer, 10));
+    polygon.push_back(coords(inner, 10));
+
+    std::vector<std::vector<double> > polygon2;
+    polygon2.push_back(coords(other, 10));
+
+    std::vector<std::vector<double> > polyline;
+    polyline.push_back(coords(line1, 4));
+    polyline.push_back(coords(line2, 6));
+
+    shapefile_builder builder;
+    builder.add(multi_part_shape(5, polygon));
+    builder.add(null_shape());
+    builder.add(multi_part_shape(5, polygon2));
+    builder.add(multi_part_shape(3, polyline));
+    builder.add(point_shape(25, 5));
+    return builder;
+}
+
+template <typename View>
+void check_view(View const& shp)
+{
+    typedef typename View::record_type record_type;
+
+    BOOST_CHECK_EQUAL(shp.type(), 5);
+
+    box_type env;
+    shp.envelope(env);
+    BOOST_CHECK(bg::equals(env, box_type(point_type(0, 0), point_type(30, 20))));
+
+    BOOST_CHECK_EQUAL(std::distance(shp.begin(), shp.end()), 5);
+
+    record_type const polygon = *shp.begin();
+    BOOST_CHECK_EQUAL(polygon.number(), 1);
+    BOOST_CHECK_EQUAL(polygon.num_parts(), 2u);
+    BOOST_CHECK_EQUAL(polygon.points().size(), 10u);
+    BOOST_CHECK_EQUAL(boost::size(polygon.ring(0)), 5u);
+    BOOST_CHECK_CLOSE(bg::area(polygon.ring(0)), 100.0, 0.0001);
+    BOOST_CHECK_CLOSE(bg::area(polygon.ring(1)), -4.0, 0.0001);
+    polygon.envelope(env);
+    BOOST_CHECK(bg::equals(env, box_type(point_type(0, 0), point_type(10, 10))));
+
+    BOOST_CHECK(shp.has_index());
+    BOOST_CHECK_EQUAL(shp.size(), 5u);
+    BOOST_CHECK(shp[1].is_null());
+
+    record_type const polyline = shp[3];
+    BOOST_CHECK_EQUAL(polyline.number(), 4);
+    BOOST_CHECK_EQUAL(polyline.num_parts(), 2u);
+    BOOST_CHECK_CLOSE(bg::length(polyline.part(0)), 5.0, 0.0001);
+    BOOST_CHECK_CLOSE(bg::length(polyline.part(1)), 7.0, 0.0001);
+    BOOST_CHECK_THROW(polyline.part(2), bg::read_shapefile_exception);
+
+    record_type const point = shp[4];
+    BOOST_CHECK_EQUAL(point.type(), 1);
+    BOOST_CHECK(bg::equals(*point.points().begin(), point_type(25, 5)));
+    point.envelope(env);
+    BOOST_CHECK(bg::equals(env, box_type(point_type(25, 5), point_type(25, 5))));
+
+    BOOST_CHECK_THROW(shp[5], bg::read_shapefile_exception);
+
+    // the envelopes of non-null shapes packed into the rtree
+    typedef std::pair<box_type, std::size_t> value_type;
+    bgi::rtree<value_type, bgi::quadratic<4> >
+        rt(bg::shp_envelopes<box_type>(shp));
+    BOOST_CHECK_EQUAL(rt.size(), 4u);
+
+    std::vector<value_type> result;
+    rt.query(bgi::intersects(box_type(point_type(15, 0), point_type(30, 12))),
+             std::back_inserter(result));
+    BOOST_CHECK_EQUAL(result.size(), 2u);
+    std::size_t ids = 0;
+    for (std::size_t i = 0; i < result.size(); ++i)
+    {
+        ids |= std::size_t(1) << result[i].second;
+        BOOST_CHECK_EQUAL(shp[result[i].second].number(),
+                          static_cast<boost::int32_t>(result[i].second + 1));
+    }
+    BOOST_CHECK_EQUAL(ids, (std::size_t(1) << 2) | (std::size_t(1) << 4));
+}
+
+void test_view()
+{
+    shapefile_builder builder = test_shapefile();
+    byte_vector const& shp = builder.shp;
+    byte_vector const& shx = builder.shx;
+
+    bg::shp_view<point_type> view(&shp[0], &shp[0] + shp.size(),
+                                  &shx[0], &shx[0] + shx.size());
+    check_view(view);
+
+    bg::shp_view<point_type> const no_index(&shp[0], &shp[0] + shp.size());
+    BOOST_CHECK(! no_index.has_index());
+    BOOST_CHECK_THROW(no_index[0], bg::read_shapefile_exception);
+}
+
+void test_invalid()
+{
+    shapefile_builder builder = test_shapefile();
+    byte_vector shp = builder.shp;
+
+    // the data shorter than stored in the header
+    BOOST_CHECK_THROW(bg::shp_view<point_type>(&shp[0], &shp[0] + shp.size() - 1),
+                      bg::read_shapefile_exception);
+
+    // wrong file code
+    byte_vector wrong_code = shp;
+    wrong_code[3] = 0;
+    BOOST_CHECK_THROW(bg::shp_view<point_type>(&wrong_code[0], &wrong_code[0] + shp.size()),
+                      bg::read_shapefile_exception);
+
+    // the number of points of the first record greater than stored
+    byte_vector too_many = shp;
+    too_many[100 + 8 + 40] = 0xFF;
+    bg::shp_view<point_type> view(&too_many[0], &too_many[0] + too_many.size());
+    BOOST_CHECK_THROW(*view.begin(), bg::read_shapefile_exception);
+
+    // the length of the first record greater than the file
+    byte_vector too_long = shp;
+    too_long[100 + 5] = 0x7F;
+    bg::shp_view<point_type> view2(&too_long[0], &too_long[0] + too_long.size());
+    BOOST_CHECK_THROW(*view2.begin(), bg::read_shapefile_exception);
+}
+
+void test_multipatch()
+{
+    double const outer[] = { 0,0, 0,10, 10,10, 10,0, 0,0 };
+    double const inner[] = { 2,2, 4,2, 4,4, 2,4, 2,2 };
+    double const strip[] = { 20,0, 20,1, 21,0 };
+
+    std::vector<std::vector<double> > parts;
+    parts.push_back(coords(outer, 10));
+    parts.push_back(coords(inner, 10));
+    parts.push_back(coords(strip, 6));
+
+    // outer ring, inner ring and triangle strip
+    std::vector<boost::int32_t> part_types;
+    part_types.push_back(2);
+    part_types.push_back(3);
+    part_types.push_back(0);
+
+    byte_vector const content = multi_part_shape(31, parts, part_types);
+    bg::shp_record<point_type> const multipatch(1, &content[0], content.size());
+
+    BOOST_CHECK_EQUAL(multipatch.type(), 31);
+    BOOST_CHECK_EQUAL(multipatch.num_parts(), 3u);
+    BOOST_CHECK_EQUAL(multipatch.points().size(), 13u);
+    BOOST_CHECK_EQUAL(boost::size(multipatch.part(0)), 5u);
+    BOOST_CHECK_EQUAL(boost::size(multipatch.part(1)), 5u);
+    BOOST_CHECK_EQUAL(boost::size(multipatch.part(2)), 3u);
+    BOOST_CHECK_CLOSE(bg::area(multipatch.ring(0)), 100.0, 0.0001);
+    BOOST_CHECK_CLOSE(bg::area(multipatch.ring(1)), -4.0, 0.0001);
+    BOOST_CHECK(bg::equals(*multipatch.part(2).begin(), point_type(20, 0)));
+    BOOST_CHECK_THROW(multipatch.part(3), bg::read_shapefile_exception);
+
+    box_type env;
+    multipatch.envelope(env);
+    BOOST_CHECK(bg::equals(env, box_type(point_type(0, 0), point_type(21, 10))));
+}
+
+void write_file(const char * filename, byte_vector const& bytes)
+{
+    std::ofstream ofs(filename, std::ios::binary | std::ios::trunc);
+    ofs.write(reinterpret_cast<const char*>(&bytes[0]), bytes.size());
+}
+
+void test_mapped()
+{
+    shapefile_builder builder = test_shapefile();
+
+    const char * shp_filename = "shapefile_test.shp";
+    const char * shx_filename = "shapefile_test.shx";
+    write_file(shp_filename, builder.shp);
+    write_file(shx_filename, builder.shx);
+
+    {
+        bg::mapped_shapefile<point_type> mapped(shp_filename, shx_filename);
+        check_view(mapped);
+    }
+
+    std::remove(shp_filename);
+    std::remove(shx_filename);
+}
+
+int test_main(int, char* [])
+{
+    test_view();
+    test_invalid();
+    test_multipatch();
+    test_mapped();
+
+    return 0;
+}
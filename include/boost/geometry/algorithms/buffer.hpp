@@ -3,6 +3,7 @@
 // Copyright (c) 2007-2012 Barend Gehrels, Amsterdam, the Netherlands.
 // Copyright (c) 2008-2012 Bruno Lalande, Paris, France.
 // Copyright (c) 2009-2012 Mateusz Loskot, London, UK.
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
 
 // This file was modified by Oracle on 2017.
 // Modifications copyright (c) 2017 Oracle and/or its affiliates.
@@ -19,11 +20,16 @@
 #define BOOST_GEOMETRY_ALGORITHMS_BUFFER_HPP
 
 #include <cstddef>
+#include <vector>
 
+#include <boost/core/addressof.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 
 #include <boost/range.hpp>
 
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+
 #include <boost/variant/apply_visitor.hpp>
 #include <boost/variant/static_visitor.hpp>
 #include <boost/variant/variant_fwd.hpp>
@@ -32,10 +38,14 @@
 #include <boost/geometry/algorithms/envelope.hpp>
 #include <boost/geometry/algorithms/is_empty.hpp>
 #include <boost/geometry/algorithms/not_implemented.hpp>
+#include <boost/geometry/algorithms/unary_union.hpp>
 #include <boost/geometry/arithmetic/arithmetic.hpp>
 #include <boost/geometry/geometries/concepts/check.hpp>
 #include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/multi_polygon.hpp>
 #include <boost/geometry/util/math.hpp>
+#include <boost/geometry/util/parallel.hpp>
+#include <boost/geometry/util/range.hpp>
 
 #include <boost/geometry/algorithms/detail/buffer/buffer_inserter.hpp>
 
@@ -218,6 +228,72 @@ Output return_buffer(Input const& geometry, Distance const& distance, Distance c
     return geometry_out;
 }
 
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace buffer
+{
+
+template
+<
+    typename GeometryIn,
+    typename MultiPolygon,
+    typename DistanceStrategy,
+    typename SideStrategy,
+    typename JoinStrategy,
+    typename EndStrategy,
+    typename PointStrategy,
+    typename GetTurnsPolicy
+>
+inline void buffer_geometry(GeometryIn const& geometry_in,
+                MultiPolygon& geometry_out,
+                DistanceStrategy const& distance_strategy,
+                SideStrategy const& side_strategy,
+                JoinStrategy const& join_strategy,
+                EndStrategy const& end_strategy,
+                PointStrategy const& point_strategy,
+                GetTurnsPolicy const& get_turns_policy)
+{
+    typedef typename boost::range_value<MultiPolygon>::type polygon_type;
+
+    typedef typename point_type<GeometryIn>::type point_type;
+    typedef typename rescale_policy_type<point_type>::type rescale_policy_type;
+
+    geometry_out.clear();
+
+    if (geometry::is_empty(geometry_in))
+    {
+        // Then output geometry is kept empty as well
+        return;
+    }
+
+    model::box<point_type> box;
+    geometry::envelope(geometry_in, box);
+    geometry::buffer(box, box, distance_strategy.max_distance(join_strategy, end_strategy));
+
+    typename strategy::intersection::services::default_strategy
+        <
+            typename cs_tag<GeometryIn>::type
+        >::type intersection_strategy;
+
+    rescale_policy_type rescale_policy
+            = boost::geometry::get_rescale_policy<rescale_policy_type>(box);
+
+    detail::buffer::visit_pieces_default_policy visitor;
+    detail::buffer::buffer_inserter<polygon_type>(geometry_in, range::back_inserter(geometry_out),
+                distance_strategy,
+                side_strategy,
+                join_strategy,
+                end_strategy,
+                point_strategy,
+                intersection_strategy,
+                rescale_policy,
+                visitor,
+                get_turns_policy);
+}
+
+}} // namespace detail::buffer
+#endif // DOXYGEN_NO_DETAIL
+
+
 /*!
 \brief \brief_calc{buffer}
 \ingroup buffer
@@ -263,37 +339,198 @@ inline void buffer(GeometryIn const& geometry_in,
     concepts::check<GeometryIn const>();
     concepts::check<polygon_type>();
 
-    typedef typename point_type<GeometryIn>::type point_type;
-    typedef typename rescale_policy_type<point_type>::type rescale_policy_type;
+    detail::buffer::buffer_geometry(geometry_in, geometry_out,
+                distance_strategy, side_strategy, join_strategy,
+                end_strategy, point_strategy,
+                detail::buffer::get_turns_sequential());
+}
 
-    geometry_out.clear();
 
-    if (geometry::is_empty(geometry_in))
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace buffer
+{
+
+// Buffers each member of a multi-geometry into a separate multi-polygon
+template
+<
+    typename Multi,
+    typename MultiPolygon,
+    typename DistanceStrategy,
+    typename SideStrategy,
+    typename JoinStrategy,
+    typename EndStrategy,
+    typename PointStrategy
+>
+struct buffer_members
+{
+    buffer_members(Multi const& multi,
+                   std::vector<MultiPolygon>& results,
+                   DistanceStrategy const& distance_strategy,
+                   SideStrategy const& side_strategy,
+                   JoinStrategy const& join_strategy,
+                   EndStrategy const& end_strategy,
+                   PointStrategy const& point_strategy)
+        : m_multi(boost::addressof(multi))
+        , m_results(boost::addressof(results))
+        , m_distance_strategy(boost::addressof(distance_strategy))
+        , m_side_strategy(boost::addressof(side_strategy))
+        , m_join_strategy(boost::addressof(join_strategy))
+        , m_end_strategy(boost::addressof(end_strategy))
+        , m_point_strategy(boost::addressof(point_strategy))
+    {}
+
+    inline void operator()(std::size_t i) const
     {
-        // Then output geometry is kept empty as well
+        buffer_geometry(range::at(*m_multi, i), (*m_results)[i],
+                        *m_distance_strategy, *m_side_strategy,
+                        *m_join_strategy, *m_end_strategy, *m_point_strategy,
+                        get_turns_sequential());
+    }
+
+    Multi const* m_multi;
+    std::vector<MultiPolygon>* m_results;
+    DistanceStrategy const* m_distance_strategy;
+    SideStrategy const* m_side_strategy;
+    JoinStrategy const* m_join_strategy;
+    EndStrategy const* m_end_strategy;
+    PointStrategy const* m_point_strategy;
+};
+
+template
+<
+    typename GeometryIn,
+    typename MultiPolygon,
+    typename DistanceStrategy,
+    typename SideStrategy,
+    typename JoinStrategy,
+    typename EndStrategy,
+    typename PointStrategy
+>
+inline void buffer_parallel(execution::parallel_policy const& policy,
+                GeometryIn const& geometry_in,
+                MultiPolygon& geometry_out,
+                DistanceStrategy const& distance_strategy,
+                SideStrategy const& side_strategy,
+                JoinStrategy const& join_strategy,
+                EndStrategy const& end_strategy,
+                PointStrategy const& point_strategy,
+                boost::false_type /*is_multi*/)
+{
+    buffer_geometry(geometry_in, geometry_out,
+                    distance_strategy, side_strategy, join_strategy,
+                    end_strategy, point_strategy,
+                    get_turns_parallel(policy));
+}
+
+// The members of a multi-geometry are buffered in parallel and then
+// the results are merged with the cascaded union
+template
+<
+    typename Multi,
+    typename MultiPolygon,
+    typename DistanceStrategy,
+    typename SideStrategy,
+    typename JoinStrategy,
+    typename EndStrategy,
+    typename PointStrategy
+>
+inline void buffer_parallel(execution::parallel_policy const& policy,
+                Multi const& multi,
+                MultiPolygon& geometry_out,
+                DistanceStrategy const& distance_strategy,
+                SideStrategy const& side_strategy,
+                JoinStrategy const& join_strategy,
+                EndStrategy const& end_strategy,
+                PointStrategy const& point_strategy,
+                boost::true_type /*is_multi*/)
+{
+    std::size_t const threads = policy.threads();
+    std::size_t const count = boost::size(multi);
+    if (threads <= 1 || count <= 1)
+    {
+        buffer_parallel(policy, multi, geometry_out,
+                        distance_strategy, side_strategy, join_strategy,
+                        end_strategy, point_strategy, boost::false_type());
         return;
     }
 
-    model::box<point_type> box;
-    geometry::envelope(geometry_in, box);
-    geometry::buffer(box, box, distance_strategy.max_distance(join_strategy, end_strategy));
+    typedef typename boost::range_value<MultiPolygon>::type polygon_type;
+    typedef model::multi_polygon<polygon_type> result_type;
 
-    typename strategy::intersection::services::default_strategy
+    std::vector<result_type> results(count);
+    buffer_members
         <
-            typename cs_tag<GeometryIn>::type
-        >::type intersection_strategy;
+            Multi, result_type,
+            DistanceStrategy, SideStrategy, JoinStrategy,
+            EndStrategy, PointStrategy
+        > members(multi, results,
+                  distance_strategy, side_strategy, join_strategy,
+                  end_strategy, point_strategy);
+    detail::parallel::for_each_index(count, members, threads);
 
-    rescale_policy_type rescale_policy
-            = boost::geometry::get_rescale_policy<rescale_policy_type>(box);
+    geometry_out.clear();
+    geometry::unary_union(policy, results, geometry_out);
+}
 
-    detail::buffer::buffer_inserter<polygon_type>(geometry_in, range::back_inserter(geometry_out),
-                distance_strategy,
-                side_strategy,
-                join_strategy,
-                end_strategy,
-                point_strategy,
-                intersection_strategy,
-                rescale_policy);
+}} // namespace detail::buffer
+#endif // DOXYGEN_NO_DETAIL
+
+
+/*!
+\brief \brief_calc{buffer} in parallel
+\ingroup buffer
+\details \details_calc{buffer, \det_buffer}.
+    The members of multi-geometries are buffered in parallel and the
+    results are merged with unary_union(). The result covers the same area
+    as the result of the sequential version but the points of the output
+    may differ slightly. The turns between the pieces of other geometries
+    and of the multi-geometries having one member are calculated in
+    parallel and the result is the same as the one of the sequential
+    version.
+\tparam GeometryIn \tparam_geometry
+\tparam MultiPolygon \tparam_geometry{MultiPolygon}
+\tparam DistanceStrategy A strategy defining distance (or radius)
+\tparam SideStrategy A strategy defining creation along sides
+\tparam JoinStrategy A strategy defining creation around convex corners
+\tparam EndStrategy A strategy defining creation at linestring ends
+\tparam PointStrategy A strategy defining creation around points
+\param policy the execution policy defining the number of threads
+\param geometry_in \param_geometry
+\param geometry_out output multi polygon (or std:: collection of polygons),
+    will contain a buffered version of the input geometry
+\param distance_strategy The distance strategy to be used
+\param side_strategy The side strategy to be used
+\param join_strategy The join strategy to be used
+\param end_strategy The end strategy to be used
+\param point_strategy The point strategy to be used
+ */
+template
+<
+    typename GeometryIn,
+    typename MultiPolygon,
+    typename DistanceStrategy,
+    typename SideStrategy,
+    typename JoinStrategy,
+    typename EndStrategy,
+    typename PointStrategy
+>
+inline void buffer(execution::parallel_policy const& policy,
+                GeometryIn const& geometry_in,
+                MultiPolygon& geometry_out,
+                DistanceStrategy const& distance_strategy,
+                SideStrategy const& side_strategy,
+                JoinStrategy const& join_strategy,
+                EndStrategy const& end_strategy,
+                PointStrategy const& point_strategy)
+{
+    typedef typename boost::range_value<MultiPolygon>::type polygon_type;
+    concepts::check<GeometryIn const>();
+    concepts::check<polygon_type>();
+
+    detail::buffer::buffer_parallel(policy, geometry_in, geometry_out,
+                distance_strategy, side_strategy, join_strategy,
+                end_strategy, point_strategy,
+                boost::is_base_of<multi_tag, typename tag<GeometryIn>::type>());
 }
 
 
@@ -1,6 +1,7 @@
 // Boost.Geometry (aka GGL, Generic Geometry Library)
 
 // Copyright (c) 2012-2014 Barend Gehrels, Amsterdam, the Netherlands.
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
 
 // This file was modified by Oracle on 2017.
 // Modifications copyright (c) 2017 Oracle and/or its affiliates.
@@ -28,6 +29,7 @@
 
 #include <boost/geometry/util/condition.hpp>
 #include <boost/geometry/util/math.hpp>
+#include <boost/geometry/util/parallel.hpp>
 
 #include <boost/geometry/strategies/buffer.hpp>
 #include <boost/geometry/strategies/side.hpp>
@@ -909,6 +911,32 @@ struct buffer_inserter<multi_tag, Multi, PolygonOutput>
 namespace detail { namespace buffer
 {
 
+// Calculates the turns of the piece collection sequentially
+struct get_turns_sequential
+{
+    template <typename Collection>
+    inline void apply(Collection& collection) const
+    {
+        collection.get_turns();
+    }
+};
+
+// Calculates the turns of the piece collection in parallel
+struct get_turns_parallel
+{
+    explicit get_turns_parallel(execution::parallel_policy const& policy)
+        : m_policy(policy)
+    {}
+
+    template <typename Collection>
+    inline void apply(Collection& collection) const
+    {
+        collection.get_turns(m_policy);
+    }
+
+    execution::parallel_policy m_policy;
+};
+
 template
 <
     typename GeometryOutput,
@@ -921,7 +949,8 @@ template
     typename PointStrategy,
     typename IntersectionStrategy,
     typename RobustPolicy,
-    typename VisitPiecesPolicy
+    typename VisitPiecesPolicy,
+    typename GetTurnsPolicy
 >
 inline void buffer_inserter(GeometryInput const& geometry_input, OutputIterator out,
         DistanceStrategy const& distance_strategy,
@@ -931,7 +960,8 @@ inline void buffer_inserter(GeometryInput const& geometry_input, OutputIterator
         PointStrategy const& point_strategy,
         IntersectionStrategy const& intersection_strategy,
         RobustPolicy const& robust_policy,
-        VisitPiecesPolicy& visit_pieces_policy
+        VisitPiecesPolicy& visit_pieces_policy,
+        GetTurnsPolicy const& get_turns_policy
     )
 {
     boost::ignore_unused(visit_pieces_policy);
@@ -965,7 +995,7 @@ inline void buffer_inserter(GeometryInput const& geometry_input, OutputIterator
             end_strategy, point_strategy,
             robust_policy, intersection_strategy.get_side_strategy());
 
-    collection.get_turns();
+    get_turns_policy.apply(collection);
     collection.classify_turns();
     if (BOOST_GEOMETRY_CONDITION(areal))
     {
@@ -1014,6 +1044,38 @@ inline void buffer_inserter(GeometryInput const& geometry_input, OutputIterator
     visit_pieces_policy.apply(const_collection, 2);
 }
 
+template
+<
+    typename GeometryOutput,
+    typename GeometryInput,
+    typename OutputIterator,
+    typename DistanceStrategy,
+    typename SideStrategy,
+    typename JoinStrategy,
+    typename EndStrategy,
+    typename PointStrategy,
+    typename IntersectionStrategy,
+    typename RobustPolicy,
+    typename VisitPiecesPolicy
+>
+inline void buffer_inserter(GeometryInput const& geometry_input, OutputIterator out,
+        DistanceStrategy const& distance_strategy,
+        SideStrategy const& side_strategy,
+        JoinStrategy const& join_strategy,
+        EndStrategy const& end_strategy,
+        PointStrategy const& point_strategy,
+        IntersectionStrategy const& intersection_strategy,
+        RobustPolicy const& robust_policy,
+        VisitPiecesPolicy& visit_pieces_policy
+    )
+{
+    buffer_inserter<GeometryOutput>(geometry_input, out,
+        distance_strategy, side_strategy, join_strategy,
+        end_strategy, point_strategy,
+        intersection_strategy, robust_policy, visit_pieces_policy,
+        get_turns_sequential());
+}
+
 template
 <
     typename GeometryOutput,
@@ -1,7 +1,7 @@
 // Boost.Geometry (aka GGL, Generic Geometry Library)
 
 // Copyright (c) 2012-2014 Barend Gehrels, Amsterdam, the Netherlands.
-// Copyright (c) 2017 Adam Wulkiewicz, Lodz, Poland.
+// Copyright (c) 2017-2018 Adam Wulkiewicz, Lodz, Poland.
 
 // This file was modified by Oracle on 2016-2017.
 // Modifications copyright (c) 2016-2017 Oracle and/or its affiliates.
@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <set>
+#include <vector>
 
 #include <boost/core/ignore_unused.hpp>
 #include <boost/range.hpp>
@@ -56,6 +57,7 @@
 #include <boost/geometry/algorithms/detail/sections/sectionalize.hpp>
 #include <boost/geometry/algorithms/detail/sections/section_box_policies.hpp>
 
+#include <boost/geometry/util/parallel.hpp>
 #include <boost/geometry/util/range.hpp>
 
 
@@ -884,7 +886,7 @@ struct buffered_piece_collection
         }
     }
 
-    inline void get_turns()
+    inline void enlarge_sections()
     {
         for(typename boost::range_iterator<sections_type>::type it
                 = boost::begin(monotonic_sections);
@@ -893,6 +895,22 @@ struct buffered_piece_collection
         {
             enlarge_box(it->bounding_box, 1);
         }
+    }
+
+    inline void prepare_turns()
+    {
+        insert_rescaled_piece_turns();
+
+        reverse_negative_robust_rings();
+
+        determine_properties();
+
+        prepare_buffered_point_pieces();
+    }
+
+    inline void get_turns()
+    {
+        enlarge_sections();
 
         {
             // Calculate the turns
@@ -914,16 +932,94 @@ struct buffered_piece_collection
                          detail::section::overlaps_section_box());
         }
 
-        insert_rescaled_piece_turns();
+        prepare_turns();
 
-        reverse_negative_robust_rings();
+        {
+            // Check if it is inside any of the pieces
+            turn_in_piece_visitor
+                <
+                    turn_vector_type, piece_vector_type
+                > visitor(m_turns, m_pieces);
 
-        determine_properties();
+            geometry::partition
+                <
+                    robust_box_type
+                >::apply(m_turns, m_pieces, visitor,
+                         turn_get_box(), turn_ovelaps_box(),
+                         piece_get_box(), piece_ovelaps_box());
 
-        prepare_buffered_point_pieces();
+        }
+    }
+
+    // The turns between the pieces are calculated in parallel and the
+    // turns are checked against the pieces in parallel. The turns are
+    // the same and are stored in the same order as in the sequential
+    // version.
+    inline void get_turns(execution::parallel_policy const& policy)
+    {
+        enlarge_sections();
+
+        {
+            // Calculate the turns
+            parallel_piece_turn_visitor
+                <
+                    piece_vector_type,
+                    buffered_ring_collection<buffered_ring<Ring> >,
+                    turn_vector_type,
+                    IntersectionStrategy,
+                    RobustPolicy
+                > visitor(m_pieces, offsetted_rings,
+                          m_intersection_strategy, m_robust_policy);
+
+            geometry::partition
+                <
+                    robust_box_type
+                >::apply(policy, monotonic_sections, visitor,
+                         detail::section::get_section_box(),
+                         detail::section::overlaps_section_box());
+
+            m_turns.insert(m_turns.end(),
+                           visitor.m_turns.begin(), visitor.m_turns.end());
+        }
+
+        prepare_turns();
+
+#ifndef BOOST_GEOMETRY_NO_PARALLEL
+        std::size_t const threads = policy.threads();
+        if (threads > 1)
+        {
+            // Find the pairs of turns and pieces sequentially
+            // and check them in parallel
+            typedef detail::partition::collect_pairs_visitor
+                <
+                    buffer_turn_info_type, piece
+                > collector_type;
+            typedef typename collector_type::pairs_type pairs_type;
+
+            collector_type collector;
+            geometry::partition
+                <
+                    robust_box_type
+                >::apply(m_turns, m_pieces, collector,
+                         turn_get_box(), turn_ovelaps_box(),
+                         piece_get_box(), piece_ovelaps_box());
+
+            std::stable_sort(collector.pairs.begin(), collector.pairs.end(),
+                             turn_in_piece_pair_less());
+
+            // more parts than threads to balance the work
+            std::size_t const parts = (std::min)(threads * 4,
+                                                 collector.pairs.size());
+            turn_in_piece_part
+                <
+                    turn_vector_type, piece_vector_type, pairs_type
+                > part(m_turns, m_pieces, collector.pairs, parts);
+            detail::parallel::for_each_index(parts, part, threads);
+            return;
+        }
+#endif
 
         {
-            // Check if it is inside any of the pieces
             turn_in_piece_visitor
                 <
                     turn_vector_type, piece_vector_type
@@ -935,7 +1031,6 @@ struct buffered_piece_collection
                 >::apply(m_turns, m_pieces, visitor,
                          turn_get_box(), turn_ovelaps_box(),
                          piece_get_box(), piece_ovelaps_box());
-
         }
     }
 
@@ -1,7 +1,7 @@
 // Boost.Geometry (aka GGL, Generic Geometry Library)
 
 // Copyright (c) 2012-2014 Barend Gehrels, Amsterdam, the Netherlands.
-// Copyright (c) 2017 Adam Wulkiewicz, Lodz, Poland.
+// Copyright (c) 2017-2018 Adam Wulkiewicz, Lodz, Poland.
 
 // This file was modified by Oracle on 2017.
 // Modifications copyright (c) 2017 Oracle and/or its affiliates.
@@ -14,6 +14,10 @@
 #ifndef BOOST_GEOMETRY_ALGORITHMS_DETAIL_BUFFER_GET_PIECE_TURNS_HPP
 #define BOOST_GEOMETRY_ALGORITHMS_DETAIL_BUFFER_GET_PIECE_TURNS_HPP
 
+#include <algorithm>
+#include <iterator>
+
+#include <boost/core/addressof.hpp>
 #include <boost/core/ignore_unused.hpp>
 #include <boost/range.hpp>
 
@@ -303,6 +307,62 @@ public:
     }
 };
 
+// Visitor used by the parallel partition, storing the turns
+// in its own container
+template
+<
+    typename Pieces,
+    typename Rings,
+    typename Turns,
+    typename IntersectionStrategy,
+    typename RobustPolicy
+>
+struct parallel_piece_turn_visitor
+{
+    typedef piece_turn_visitor
+        <
+            Pieces, Rings, Turns, IntersectionStrategy, RobustPolicy
+        > piece_turn_visitor_type;
+
+    Pieces const* m_pieces;
+    Rings const* m_rings;
+    IntersectionStrategy const* m_intersection_strategy;
+    RobustPolicy const* m_robust_policy;
+    Turns m_turns;
+
+    inline parallel_piece_turn_visitor(Pieces const& pieces,
+            Rings const& ring_collection,
+            IntersectionStrategy const& intersection_strategy,
+            RobustPolicy const& robust_policy)
+        : m_pieces(boost::addressof(pieces))
+        , m_rings(boost::addressof(ring_collection))
+        , m_intersection_strategy(boost::addressof(intersection_strategy))
+        , m_robust_policy(boost::addressof(robust_policy))
+    {}
+
+    template <typename Section>
+    inline bool apply(Section const& section1, Section const& section2)
+    {
+        piece_turn_visitor_type visitor(*m_pieces, *m_rings, m_turns,
+                                        *m_intersection_strategy,
+                                        *m_robust_policy);
+        return visitor.apply(section1, section2);
+    }
+
+    inline parallel_piece_turn_visitor split() const
+    {
+        return parallel_piece_turn_visitor(*m_pieces, *m_rings,
+                                           *m_intersection_strategy,
+                                           *m_robust_policy);
+    }
+
+    inline void join(parallel_piece_turn_visitor const& other)
+    {
+        std::copy(boost::begin(other.m_turns), boost::end(other.m_turns),
+                  std::back_inserter(m_turns));
+    }
+};
+
 
 }} // namespace detail::buffer
 #endif // DOXYGEN_NO_DETAIL
@@ -1,7 +1,7 @@
 // Boost.Geometry (aka GGL, Generic Geometry Library)
 
 // Copyright (c) 2012-2014 Barend Gehrels, Amsterdam, the Netherlands.
-// Copyright (c) 2017 Adam Wulkiewicz, Lodz, Poland.
+// Copyright (c) 2017-2018 Adam Wulkiewicz, Lodz, Poland.
 
 // This file was modified by Oracle on 2016.
 // Modifications copyright (c) 2016 Oracle and/or its affiliates.
@@ -15,6 +15,8 @@
 #define BOOST_GEOMETRY_ALGORITHMS_DETAIL_BUFFER_TURN_IN_PIECE_VISITOR
 
 
+#include <cstddef>
+
 #include <boost/core/ignore_unused.hpp>
 
 #include <boost/range.hpp>
@@ -813,6 +815,62 @@ public:
     }
 };
 
+// Visits a part of the pairs of turns and pieces sorted by turns. The
+// turn_in_piece_visitor modifies only the turn of the visited pair so the
+// parts are adjusted to contain all pairs of a turn. Then the parts can be
+// visited in parallel and each turn is analysed the same way as if all
+// pairs were visited sequentially.
+template <typename Turns, typename Pieces, typename Pairs>
+class turn_in_piece_part
+{
+public:
+    turn_in_piece_part(Turns& turns, Pieces const& pieces,
+                       Pairs const& pairs, std::size_t parts)
+        : m_turns(turns)
+        , m_pieces(pieces)
+        , m_pairs(pairs)
+        , m_parts(parts)
+    {}
+
+    void operator()(std::size_t part)
+    {
+        std::size_t const first = boundary(part);
+        std::size_t const last = boundary(part + 1);
+
+        turn_in_piece_visitor<Turns, Pieces> visitor(m_turns, m_pieces);
+        for (std::size_t i = first; i < last; ++i)
+        {
+            visitor.apply(*m_pairs[i].first, *m_pairs[i].second);
+        }
+    }
+
+private:
+    std::size_t boundary(std::size_t part) const
+    {
+        std::size_t result = m_pairs.size() * part / m_parts;
+        while (result > 0 && result < m_pairs.size()
+            && m_pairs[result].first == m_pairs[result - 1].first)
+        {
+            ++result;
+        }
+        return result;
+    }
+
+    Turns& m_turns;
+    Pieces const& m_pieces;
+    Pairs const& m_pairs;
+    std::size_t m_parts;
+};
+
+struct turn_in_piece_pair_less
+{
+    template <typename Pair>
+    inline bool operator()(Pair const& l, Pair const& r) const
+    {
+        return l.first->turn_index < r.first->turn_index;
+    }
+};
+
 
 }} // namespace detail::buffer
 #endif // DOXYGEN_NO_DETAIL
@@ -1,6 +1,7 @@
 // Boost.Geometry (aka GGL, Generic Geometry Library)
 
 // Copyright (c) 2007-2012 Barend Gehrels, Amsterdam, the Netherlands.
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
 
 // This file was modified by Oracle on 2014, 2017.
 // Modifications copyright (c) 2014-2017, Oracle and/or its affiliates.
@@ -152,6 +153,49 @@ struct intersection
             >::apply(geometry1, geometry2, robust_policy, geometry_out,
                      strategy_type());
     }
+
+    // The turns are calculated and the parents of rings are assigned in
+    // parallel, only areal geometries are supported
+    template
+    <
+        typename Geometry1,
+        typename Geometry2,
+        typename RobustPolicy,
+        typename Collection
+    >
+    static inline bool apply(Geometry1 const& geometry1,
+                             Geometry2 const& geometry2,
+                             RobustPolicy const& robust_policy,
+                             Collection & output_collection,
+                             execution::parallel_policy const& policy)
+    {
+        detail::overlay::overlay_areal_parallel
+            <
+                overlay_intersection, false
+            >(geometry1, geometry2, robust_policy, output_collection, policy);
+        return true;
+    }
+
+    template
+    <
+        typename Geometry1,
+        typename Geometry2,
+        typename RobustPolicy,
+        typename Collection
+    >
+    static inline bool apply(Geometry1 const& geometry1,
+                             Geometry2 const& geometry2,
+                             RobustPolicy const& robust_policy,
+                             Collection & output_collection,
+                             detail::overlay::timed_parallel_policy const& policy)
+    {
+        detail::overlay::overlay_areal_parallel
+            <
+                overlay_intersection, false
+            >(geometry1, geometry2, robust_policy, output_collection,
+              policy.policy, policy.timings);
+        return true;
+    }
 };
 
 } // resolve_strategy
@@ -335,6 +379,10 @@ struct intersection<variant<BOOST_VARIANT_ENUM_PARAMS(T1)>, variant<BOOST_VARIAN
 \param geometry_out The output geometry, either a multi_point, multi_polygon,
     multi_linestring, or a box (for intersection of two boxes)
 \param strategy \param_strategy{intersection}
+\note If execution::parallel_policy is passed instead of the strategy the
+    turns are calculated and the parents of rings are assigned in parallel.
+    The result is the same as the one of the sequential version. Only areal
+    geometries are supported.
 
 \qbk{distinguish,with strategy}
 \qbk{[include reference/algorithms/intersection.qbk]}
@@ -359,6 +407,46 @@ inline bool intersection(Geometry1 const& geometry1,
 }
 
 
+/*!
+\brief \brief_calc2{intersection}, in parallel
+\ingroup intersection
+\details \details_calc2{intersection, spatial set theoretic intersection}.
+    The turns are calculated and the parents of rings are assigned in
+    parallel. The durations of the phases of the overlay are added to timings.
+\tparam Geometry1 \tparam_geometry
+\tparam Geometry2 \tparam_geometry
+\tparam GeometryOut Collection of polygons (e.g. std::vector, std::deque, boost::geometry::multi_polygon)
+\param geometry1 \param_geometry
+\param geometry2 \param_geometry
+\param geometry_out The output geometry, a multi_polygon or a collection of polygons
+\param policy the parallel execution policy
+\param timings the durations of the phases of the overlay
+\note Only areal geometries are supported.
+
+\qbk{distinguish,with parallel policy and timings}
+\qbk{[include reference/algorithms/intersection.qbk]}
+*/
+template
+<
+    typename Geometry1,
+    typename Geometry2,
+    typename GeometryOut
+>
+inline bool intersection(Geometry1 const& geometry1,
+                         Geometry2 const& geometry2,
+                         GeometryOut& geometry_out,
+                         execution::parallel_policy const& policy,
+                         overlay_timings& timings)
+{
+    return resolve_variant::intersection
+        <
+            Geometry1,
+            Geometry2
+        >::apply(geometry1, geometry2, geometry_out,
+                 detail::overlay::timed_parallel_policy(policy, timings));
+}
+
+
 /*!
 \brief \brief_calc2{intersection}
 \ingroup intersection
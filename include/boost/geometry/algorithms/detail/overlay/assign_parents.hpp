@@ -1,7 +1,7 @@
 // Boost.Geometry (aka GGL, Generic Geometry Library)
 
 // Copyright (c) 2007-2012 Barend Gehrels, Amsterdam, the Netherlands.
-// Copyright (c) 2017 Adam Wulkiewicz, Lodz, Poland.
+// Copyright (c) 2017-2018 Adam Wulkiewicz, Lodz, Poland.
 
 // This file was modified by Oracle on 2017.
 // Modifications copyright (c) 2017 Oracle and/or its affiliates.
@@ -14,6 +14,10 @@
 #ifndef BOOST_GEOMETRY_ALGORITHMS_DETAIL_OVERLAY_ASSIGN_PARENTS_HPP
 #define BOOST_GEOMETRY_ALGORITHMS_DETAIL_OVERLAY_ASSIGN_PARENTS_HPP
 
+#include <cstddef>
+#include <vector>
+
+#include <boost/core/addressof.hpp>
 #include <boost/range.hpp>
 
 #include <boost/geometry/algorithms/area.hpp>
@@ -26,6 +30,8 @@
 
 #include <boost/geometry/geometries/box.hpp>
 
+#include <boost/geometry/util/parallel.hpp>
+
 namespace boost { namespace geometry
 {
 
@@ -195,19 +201,203 @@ struct assign_visitor
                                         m_strategy)
                )
             {
-                // Assign a parent if there was no earlier parent, or the newly
-                // found parent is smaller than the previous one
-                if (inner_in_map.parent.source_index == -1
-                    || outer.abs_area < inner_in_map.parent_area)
-                {
-                    inner_in_map.parent = outer.id;
-                    inner_in_map.parent_area = outer.abs_area;
-                }
+                assign_parent(inner_in_map, outer.id, outer.abs_area);
+            }
+        }
+
+        return true;
+    }
+
+    template <typename AreaType>
+    static inline void assign_parent(ring_info_type& inner_in_map,
+                                     ring_identifier const& outer_id,
+                                     AreaType const& outer_abs_area)
+    {
+        // Assign a parent if there was no earlier parent, or the newly
+        // found parent is smaller than the previous one
+        if (inner_in_map.parent.source_index == -1
+            || outer_abs_area < inner_in_map.parent_area)
+        {
+            inner_in_map.parent = outer_id;
+            inner_in_map.parent_area = outer_abs_area;
+        }
+    }
+};
+
+// Visitor used by the parallel partition. The ring map is not modified,
+// the parents found in each part are stored and then assigned in the order
+// of the parts so the result is the same as the one of assign_visitor.
+template
+<
+    typename Geometry1,
+    typename Geometry2,
+    typename Collection,
+    typename RingMap,
+    typename Strategy,
+    typename AreaType
+>
+struct parallel_assign_visitor
+{
+    typedef typename RingMap::mapped_type ring_info_type;
+
+    struct found_parent
+    {
+        ring_identifier inner_id;
+        ring_identifier outer_id;
+        AreaType outer_abs_area;
+    };
+
+    Geometry1 const* m_geometry1;
+    Geometry2 const* m_geometry2;
+    Collection const* m_collection;
+    RingMap const* m_ring_map;
+    Strategy const* m_strategy;
+    bool m_check_for_orientation;
+    std::vector<found_parent> m_parents;
+
+    inline parallel_assign_visitor(Geometry1 const& g1, Geometry2 const& g2, Collection const& c,
+                                   RingMap const& map, Strategy const& strategy, bool check)
+        : m_geometry1(boost::addressof(g1))
+        , m_geometry2(boost::addressof(g2))
+        , m_collection(boost::addressof(c))
+        , m_ring_map(boost::addressof(map))
+        , m_strategy(boost::addressof(strategy))
+        , m_check_for_orientation(check)
+    {}
+
+    template <typename Item>
+    inline bool apply(Item const& outer, Item const& inner, bool first = true)
+    {
+        if (first && outer.abs_area < inner.abs_area)
+        {
+            // Apply with reversed arguments
+            apply(inner, outer, false);
+            return true;
+        }
+
+        if (m_check_for_orientation
+         || (math::larger(outer.real_area, 0)
+          && math::smaller(inner.real_area, 0)))
+        {
+            ring_info_type const& inner_in_map = m_ring_map->find(inner.id)->second;
+
+            if (geometry::covered_by(inner_in_map.point, outer.envelope)
+               && within_selected_input(inner_in_map, inner.id, outer.id,
+                                        *m_geometry1, *m_geometry2, *m_collection,
+                                        *m_strategy)
+               )
+            {
+                found_parent parent;
+                parent.inner_id = inner.id;
+                parent.outer_id = outer.id;
+                parent.outer_abs_area = outer.abs_area;
+                m_parents.push_back(parent);
             }
         }
 
         return true;
     }
+
+    inline parallel_assign_visitor split() const
+    {
+        return parallel_assign_visitor(*m_geometry1, *m_geometry2, *m_collection,
+                                       *m_ring_map, *m_strategy,
+                                       m_check_for_orientation);
+    }
+
+    inline void join(parallel_assign_visitor const& other)
+    {
+        m_parents.insert(m_parents.end(),
+                         other.m_parents.begin(), other.m_parents.end());
+    }
+};
+
+// Finds the parents of the rings sequentially
+struct assign_parents_sequential
+{
+    template
+    <
+        typename Box, typename AreaType,
+        typename Geometry1, typename Geometry2,
+        typename RingCollection, typename RingMap,
+        typename Strategy, typename Vector
+    >
+    static inline void apply(Geometry1 const& geometry1,
+                             Geometry2 const& geometry2,
+                             RingCollection const& collection,
+                             RingMap& ring_map,
+                             Strategy const& strategy,
+                             bool check_for_orientation,
+                             Vector const& vector)
+    {
+        assign_visitor
+            <
+                Geometry1, Geometry2,
+                RingCollection, RingMap,
+                Strategy
+            > visitor(geometry1, geometry2, collection, ring_map, strategy, check_for_orientation);
+
+        geometry::partition
+            <
+                Box
+            >::apply(vector, visitor, ring_info_helper_get_box(),
+                     ring_info_helper_ovelaps_box());
+    }
+};
+
+// Finds the parents of the rings in parallel
+class assign_parents_parallel
+{
+public:
+    explicit assign_parents_parallel(execution::parallel_policy const& policy)
+        : m_policy(policy)
+    {}
+
+    template
+    <
+        typename Box, typename AreaType,
+        typename Geometry1, typename Geometry2,
+        typename RingCollection, typename RingMap,
+        typename Strategy, typename Vector
+    >
+    inline void apply(Geometry1 const& geometry1,
+                      Geometry2 const& geometry2,
+                      RingCollection const& collection,
+                      RingMap& ring_map,
+                      Strategy const& strategy,
+                      bool check_for_orientation,
+                      Vector const& vector) const
+    {
+        typedef parallel_assign_visitor
+            <
+                Geometry1, Geometry2,
+                RingCollection, RingMap,
+                Strategy, AreaType
+            > visitor_type;
+
+        visitor_type visitor(geometry1, geometry2, collection, ring_map, strategy, check_for_orientation);
+
+        geometry::partition
+            <
+                Box
+            >::apply(m_policy, vector, visitor, ring_info_helper_get_box(),
+                     ring_info_helper_ovelaps_box());
+
+        for (std::size_t i = 0; i < visitor.m_parents.size(); ++i)
+        {
+            typename visitor_type::found_parent const& parent = visitor.m_parents[i];
+            assign_visitor
+                <
+                    Geometry1, Geometry2,
+                    RingCollection, RingMap,
+                    Strategy
+                >::assign_parent(ring_map[parent.inner_id],
+                                 parent.outer_id, parent.outer_abs_area);
+        }
+    }
+
+private:
+    execution::parallel_policy m_policy;
 };
 
 
@@ -217,9 +407,11 @@ template
     typename Geometry1, typename Geometry2,
     typename RingCollection,
     typename RingMap,
-    typename Strategy
+    typename Strategy,
+    typename AssignPolicy
 >
-inline void assign_parents(Geometry1 const& geometry1,
+inline void assign_parents(AssignPolicy const& assign_policy,
+            Geometry1 const& geometry1,
             Geometry2 const& geometry2,
             RingCollection const& collection,
             RingMap& ring_map,
@@ -321,18 +513,9 @@ inline void assign_parents(Geometry1 const& geometry1,
             }
         }
 
-        assign_visitor
-            <
-                Geometry1, Geometry2,
-                RingCollection, RingMap,
-                Strategy
-            > visitor(geometry1, geometry2, collection, ring_map, strategy, check_for_orientation);
-
-        geometry::partition
-            <
-                box_type
-            >::apply(vector, visitor, ring_info_helper_get_box(),
-                     ring_info_helper_ovelaps_box());
+        assign_policy.template apply<box_type, area_result_type>(
+            geometry1, geometry2, collection, ring_map, strategy,
+            check_for_orientation, vector);
     }
 
     if (check_for_orientation)
@@ -388,6 +571,46 @@ inline void assign_parents(Geometry1 const& geometry1,
 }
 
 
+template
+<
+    overlay_type OverlayType,
+    typename Geometry1, typename Geometry2,
+    typename RingCollection,
+    typename RingMap,
+    typename Strategy
+>
+inline void assign_parents(Geometry1 const& geometry1,
+            Geometry2 const& geometry2,
+            RingCollection const& collection,
+            RingMap& ring_map,
+            Strategy const& strategy)
+{
+    assign_parents<OverlayType>(assign_parents_sequential(),
+            geometry1, geometry2, collection, ring_map, strategy);
+}
+
+// The rings are checked in parallel, the result is the same as the one
+// of the sequential version
+template
+<
+    overlay_type OverlayType,
+    typename Geometry1, typename Geometry2,
+    typename RingCollection,
+    typename RingMap,
+    typename Strategy
+>
+inline void assign_parents(execution::parallel_policy const& policy,
+            Geometry1 const& geometry1,
+            Geometry2 const& geometry2,
+            RingCollection const& collection,
+            RingMap& ring_map,
+            Strategy const& strategy)
+{
+    assign_parents<OverlayType>(assign_parents_parallel(policy),
+            geometry1, geometry2, collection, ring_map, strategy);
+}
+
+
 // Version for one geometry (called by buffer/dissolve)
 template
 <
@@ -1,7 +1,7 @@
 // Boost.Geometry (aka GGL, Generic Geometry Library)
 
 // Copyright (c) 2007-2012 Barend Gehrels, Amsterdam, the Netherlands.
-// Copyright (c) 2014-2017 Adam Wulkiewicz, Lodz, Poland.
+// Copyright (c) 2014-2018 Adam Wulkiewicz, Lodz, Poland.
 
 // This file was modified by Oracle on 2014, 2016, 2017.
 // Modifications copyright (c) 2014-2017 Oracle and/or its affiliates.
@@ -16,11 +16,14 @@
 #define BOOST_GEOMETRY_ALGORITHMS_DETAIL_OVERLAY_GET_TURNS_HPP
 
 
+#include <algorithm>
 #include <cstddef>
+#include <iterator>
 #include <map>
 
 #include <boost/array.hpp>
 #include <boost/concept_check.hpp>
+#include <boost/core/addressof.hpp>
 #include <boost/core/ignore_unused.hpp>
 #include <boost/mpl/if.hpp>
 #include <boost/mpl/vector_c.hpp>
@@ -36,7 +39,9 @@
 
 #include <boost/geometry/geometries/concepts/check.hpp>
 
+#include <boost/geometry/util/condition.hpp>
 #include <boost/geometry/util/math.hpp>
+#include <boost/geometry/util/parallel.hpp>
 #include <boost/geometry/views/closeable_view.hpp>
 #include <boost/geometry/views/reversible_view.hpp>
 #include <boost/geometry/views/detail/range_type.hpp>
@@ -445,6 +450,78 @@ struct section_visitor
 
 };
 
+// Visitor used by the parallel partition. Each part of the pairs of
+// sections is visited by a visitor storing the turns in its own container.
+// The turns are joined in the order of the parts.
+template
+<
+    typename Geometry1, typename Geometry2,
+    bool Reverse1, bool Reverse2,
+    typename TurnPolicy,
+    typename IntersectionStrategy,
+    typename RobustPolicy,
+    typename Turns,
+    typename InterruptPolicy
+>
+struct parallel_section_visitor
+{
+    typedef section_visitor
+        <
+            Geometry1, Geometry2,
+            Reverse1, Reverse2,
+            TurnPolicy,
+            IntersectionStrategy, RobustPolicy,
+            Turns, InterruptPolicy
+        > section_visitor_type;
+
+    int m_source_id1;
+    Geometry1 const* m_geometry1;
+    int m_source_id2;
+    Geometry2 const* m_geometry2;
+    IntersectionStrategy const* m_intersection_strategy;
+    RobustPolicy const* m_rescale_policy;
+    InterruptPolicy m_interrupt_policy;
+    Turns m_turns;
+
+    parallel_section_visitor(int id1, Geometry1 const& g1,
+                             int id2, Geometry2 const& g2,
+                             IntersectionStrategy const& intersection_strategy,
+                             RobustPolicy const& robust_policy,
+                             InterruptPolicy const& ip)
+        : m_source_id1(id1), m_geometry1(boost::addressof(g1))
+        , m_source_id2(id2), m_geometry2(boost::addressof(g2))
+        , m_intersection_strategy(boost::addressof(intersection_strategy))
+        , m_rescale_policy(boost::addressof(robust_policy))
+        , m_interrupt_policy(ip)
+    {}
+
+    template <typename Section>
+    inline bool apply(Section const& sec1, Section const& sec2)
+    {
+        section_visitor_type visitor(m_source_id1, *m_geometry1,
+                                     m_source_id2, *m_geometry2,
+                                     *m_intersection_strategy,
+                                     *m_rescale_policy,
+                                     m_turns, m_interrupt_policy);
+        return visitor.apply(sec1, sec2);
+    }
+
+    inline parallel_section_visitor split() const
+    {
+        return parallel_section_visitor(m_source_id1, *m_geometry1,
+                                        m_source_id2, *m_geometry2,
+                                        *m_intersection_strategy,
+                                        *m_rescale_policy,
+                                        m_interrupt_policy);
+    }
+
+    inline void join(parallel_section_visitor const& other)
+    {
+        std::copy(boost::begin(other.m_turns), boost::end(other.m_turns),
+                  std::back_inserter(m_turns));
+    }
+};
+
 template
 <
     typename Geometry1, typename Geometry2,
@@ -453,18 +530,9 @@ template
 >
 class get_turns_generic
 {
-
-public:
-    template <typename IntersectionStrategy, typename RobustPolicy, typename Turns, typename InterruptPolicy>
-    static inline void apply(
-            int source_id1, Geometry1 const& geometry1,
-            int source_id2, Geometry2 const& geometry2,
-            IntersectionStrategy const& intersection_strategy,
-            RobustPolicy const& robust_policy,
-            Turns& turns,
-            InterruptPolicy& interrupt_policy)
+    template <typename Turns, typename RobustPolicy>
+    struct sections_traits
     {
-        // First create monotonic sections...
         typedef typename boost::range_value<Turns>::type ip_type;
         typedef typename ip_type::point_type point_type;
 
@@ -475,9 +543,16 @@ public:
                     point_type, RobustPolicy
                 >::type
             > box_type;
-        typedef geometry::sections<box_type, 2> sections_type;
-
-        sections_type sec1, sec2;
+        typedef geometry::sections<box_type, 2> type;
+    };
+
+    template <typename IntersectionStrategy, typename RobustPolicy, typename Sections>
+    static inline void sectionalize(Geometry1 const& geometry1,
+                                    Geometry2 const& geometry2,
+                                    IntersectionStrategy const& intersection_strategy,
+                                    RobustPolicy const& robust_policy,
+                                    Sections& sec1, Sections& sec2)
+    {
         typedef boost::mpl::vector_c<std::size_t, 0, 1> dimensions;
 
         typename IntersectionStrategy::envelope_strategy_type const
@@ -487,6 +562,25 @@ public:
                 sec1, envelope_strategy, 0);
         geometry::sectionalize<Reverse2, dimensions>(geometry2, robust_policy,
                 sec2, envelope_strategy, 1);
+    }
+
+public:
+    template <typename IntersectionStrategy, typename RobustPolicy, typename Turns, typename InterruptPolicy>
+    static inline void apply(
+            int source_id1, Geometry1 const& geometry1,
+            int source_id2, Geometry2 const& geometry2,
+            IntersectionStrategy const& intersection_strategy,
+            RobustPolicy const& robust_policy,
+            Turns& turns,
+            InterruptPolicy& interrupt_policy)
+    {
+        typedef typename sections_traits<Turns, RobustPolicy>::type sections_type;
+        typedef typename sections_type::box_type box_type;
+
+        // First create monotonic sections...
+        sections_type sec1, sec2;
+        sectionalize(geometry1, geometry2, intersection_strategy, robust_policy,
+                     sec1, sec2);
 
         // ... and then partition them, intersecting overlapping sections in visitor method
         section_visitor
@@ -507,6 +601,57 @@ public:
                      detail::section::get_section_box(),
                      detail::section::overlaps_section_box());
     }
+
+    // The pairs of sections are intersected in parallel. The order of
+    // the turns is the same as in the sequential version. If the interrupt
+    // policy is enabled the turns are calculated sequentially because
+    // the policy has to check the turns in order.
+    template <typename IntersectionStrategy, typename RobustPolicy, typename Turns, typename InterruptPolicy>
+    static inline void apply(
+            execution::parallel_policy const& policy,
+            int source_id1, Geometry1 const& geometry1,
+            int source_id2, Geometry2 const& geometry2,
+            IntersectionStrategy const& intersection_strategy,
+            RobustPolicy const& robust_policy,
+            Turns& turns,
+            InterruptPolicy& interrupt_policy)
+    {
+        if (BOOST_GEOMETRY_CONDITION(InterruptPolicy::enabled))
+        {
+            apply(source_id1, geometry1, source_id2, geometry2,
+                  intersection_strategy, robust_policy,
+                  turns, interrupt_policy);
+            return;
+        }
+
+        typedef typename sections_traits<Turns, RobustPolicy>::type sections_type;
+        typedef typename sections_type::box_type box_type;
+
+        sections_type sec1, sec2;
+        sectionalize(geometry1, geometry2, intersection_strategy, robust_policy,
+                     sec1, sec2);
+
+        parallel_section_visitor
+            <
+                Geometry1, Geometry2,
+                Reverse1, Reverse2,
+                TurnPolicy,
+                IntersectionStrategy, RobustPolicy,
+                Turns, InterruptPolicy
+            > visitor(source_id1, geometry1, source_id2, geometry2,
+                      intersection_strategy, robust_policy,
+                      interrupt_policy);
+
+        geometry::partition
+            <
+                box_type
+            >::apply(policy, sec1, sec2, visitor,
+                     detail::section::get_section_box(),
+                     detail::section::overlaps_section_box());
+
+        std::copy(boost::begin(visitor.m_turns), boost::end(visitor.m_turns),
+                  std::back_inserter(turns));
+    }
 };
 
 
@@ -540,6 +685,22 @@ struct get_turns_cs
         >::type iterator_type;
 
 
+    // The turns with a box are calculated sequentially
+    template <typename IntersectionStrategy, typename RobustPolicy, typename Turns, typename InterruptPolicy>
+    static inline void apply(
+                execution::parallel_policy const& ,
+                int source_id1, Range const& range,
+                int source_id2, Box const& box,
+                IntersectionStrategy const& intersection_strategy,
+                RobustPolicy const& robust_policy,
+                Turns& turns,
+                InterruptPolicy& interrupt_policy)
+    {
+        apply(source_id1, range, source_id2, box,
+              intersection_strategy, robust_policy,
+              turns, interrupt_policy);
+    }
+
     template <typename IntersectionStrategy, typename RobustPolicy, typename Turns, typename InterruptPolicy>
     static inline void apply(
                 int source_id1, Range const& range,
@@ -721,6 +882,22 @@ template
 >
 struct get_turns_polygon_cs
 {
+    // The turns with a box are calculated sequentially
+    template <typename IntersectionStrategy, typename RobustPolicy, typename Turns, typename InterruptPolicy>
+    static inline void apply(
+            execution::parallel_policy const& ,
+            int source_id1, Polygon const& polygon,
+            int source_id2, Box const& box,
+            IntersectionStrategy const& intersection_strategy,
+            RobustPolicy const& robust_policy,
+            Turns& turns,
+            InterruptPolicy& interrupt_policy)
+    {
+        apply(source_id1, polygon, source_id2, box,
+              intersection_strategy, robust_policy,
+              turns, interrupt_policy);
+    }
+
     template <typename IntersectionStrategy, typename RobustPolicy, typename Turns, typename InterruptPolicy>
     static inline void apply(
             int source_id1, Polygon const& polygon,
@@ -777,6 +954,22 @@ template
 >
 struct get_turns_multi_polygon_cs
 {
+    // The turns with a box are calculated sequentially
+    template <typename IntersectionStrategy, typename RobustPolicy, typename Turns, typename InterruptPolicy>
+    static inline void apply(
+            execution::parallel_policy const& ,
+            int source_id1, Multi const& multi,
+            int source_id2, Box const& box,
+            IntersectionStrategy const& intersection_strategy,
+            RobustPolicy const& robust_policy,
+            Turns& turns,
+            InterruptPolicy& interrupt_policy)
+    {
+        apply(source_id1, multi, source_id2, box,
+              intersection_strategy, robust_policy,
+              turns, interrupt_policy);
+    }
+
     template <typename IntersectionStrategy, typename RobustPolicy, typename Turns, typename InterruptPolicy>
     static inline void apply(
             int source_id1, Multi const& multi,
@@ -974,6 +1167,26 @@ struct get_turns_reversed
                      intersection_strategy, robust_policy,
                      turns, interrupt_policy);
     }
+
+    template <typename IntersectionStrategy, typename RobustPolicy, typename Turns, typename InterruptPolicy>
+    static inline void apply(execution::parallel_policy const& policy,
+                             int source_id1, Geometry1 const& g1,
+                             int source_id2, Geometry2 const& g2,
+                             IntersectionStrategy const& intersection_strategy,
+                             RobustPolicy const& robust_policy,
+                             Turns& turns,
+                             InterruptPolicy& interrupt_policy)
+    {
+        get_turns
+            <
+                GeometryTag2, GeometryTag1,
+                Geometry2, Geometry1,
+                Reverse2, Reverse1,
+                TurnPolicy
+            >::apply(policy, source_id2, g2, source_id1, g1,
+                     intersection_strategy, robust_policy,
+                     turns, interrupt_policy);
+    }
 };
 
 
@@ -1045,6 +1258,75 @@ inline void get_turns(Geometry1 const& geometry1,
                        turns, interrupt_policy);
 }
 
+/*!
+\brief \brief_calc2{turn points} in parallel
+\ingroup overlay
+\details The pairs of monotonic sections of the geometries are intersected
+    in parallel. The turns are the same and in the same order as the ones
+    calculated sequentially. If the interrupt policy is enabled or one of the
+    geometries is a box the turns are calculated sequentially.
+\tparam Geometry1 \tparam_geometry
+\tparam Geometry2 \tparam_geometry
+\tparam Turns type of turn-container (e.g. vector of "intersection/turn point"'s)
+\param policy parallel execution policy
+\param geometry1 \param_geometry
+\param geometry2 \param_geometry
+\param intersection_strategy segments intersection strategy
+\param robust_policy policy to handle robustness issues
+\param turns container which will contain turn points
+\param interrupt_policy policy determining if process is stopped
+    when intersection is found
+ */
+template
+<
+    bool Reverse1, bool Reverse2,
+    typename AssignPolicy,
+    typename Geometry1,
+    typename Geometry2,
+    typename IntersectionStrategy,
+    typename RobustPolicy,
+    typename Turns,
+    typename InterruptPolicy
+>
+inline void get_turns(execution::parallel_policy const& policy,
+                      Geometry1 const& geometry1,
+                      Geometry2 const& geometry2,
+                      IntersectionStrategy const& intersection_strategy,
+                      RobustPolicy const& robust_policy,
+                      Turns& turns,
+                      InterruptPolicy& interrupt_policy)
+{
+    concepts::check_concepts_and_equal_dimensions<Geometry1 const, Geometry2 const>();
+
+    typedef detail::overlay::get_turn_info<AssignPolicy> TurnPolicy;
+
+    boost::mpl::if_c
+        <
+            reverse_dispatch<Geometry1, Geometry2>::type::value,
+            dispatch::get_turns_reversed
+            <
+                typename tag<Geometry1>::type,
+                typename tag<Geometry2>::type,
+                Geometry1, Geometry2,
+                Reverse1, Reverse2,
+                TurnPolicy
+            >,
+            dispatch::get_turns
+            <
+                typename tag<Geometry1>::type,
+                typename tag<Geometry2>::type,
+                Geometry1, Geometry2,
+                Reverse1, Reverse2,
+                TurnPolicy
+            >
+        >::type::apply(policy,
+                       0, geometry1,
+                       1, geometry2,
+                       intersection_strategy,
+                       robust_policy,
+                       turns, interrupt_policy);
+}
+
 #if defined(_MSC_VER)
 #pragma warning(pop)
 #endif
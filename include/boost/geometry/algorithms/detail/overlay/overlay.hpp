@@ -1,7 +1,7 @@
 // Boost.Geometry (aka GGL, Generic Geometry Library)
 
 // Copyright (c) 2007-2015 Barend Gehrels, Amsterdam, the Netherlands.
-// Copyright (c) 2013-2017 Adam Wulkiewicz, Lodz, Poland
+// Copyright (c) 2013-2018 Adam Wulkiewicz, Lodz, Poland
 
 // This file was modified by Oracle on 2015, 2017.
 // Modifications copyright (c) 2015-2017, Oracle and/or its affiliates.
@@ -20,9 +20,24 @@
 #include <deque>
 #include <map>
 
+#include <boost/config.hpp>
+#include <boost/core/addressof.hpp>
 #include <boost/range.hpp>
 #include <boost/mpl/assert.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_void.hpp>
 
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+#include <chrono>
+#else
+#include <ctime>
+#endif
+
+#include <boost/geometry/core/is_areal.hpp>
+#include <boost/geometry/core/point_order.hpp>
+#include <boost/geometry/core/tag.hpp>
+#include <boost/geometry/core/tags.hpp>
 
 #include <boost/geometry/algorithms/detail/overlay/cluster_info.hpp>
 #include <boost/geometry/algorithms/detail/overlay/enrich_intersection_points.hpp>
@@ -50,6 +65,8 @@
 #include <boost/geometry/policies/robustness/segment_ratio_type.hpp>
 
 #include <boost/geometry/util/condition.hpp>
+#include <boost/geometry/util/parallel.hpp>
+#include <boost/geometry/util/range.hpp>
 
 #ifdef BOOST_GEOMETRY_DEBUG_ASSEMBLE
 #  include <boost/geometry/io/dsv/write.hpp>
@@ -60,6 +77,29 @@ namespace boost { namespace geometry
 {
 
 
+/*!
+\brief Durations of the phases of the overlay, in seconds
+\details Filled by union_(), intersection() and difference() called with
+    execution::parallel_policy. The durations are added to the values
+    already stored.
+*/
+struct overlay_timings
+{
+    overlay_timings()
+        : get_turns(0), self_turns(0), enrich(0), traverse(0)
+        , select_rings(0), assign_parents(0), add_rings(0)
+    {}
+
+    double get_turns;
+    double self_turns;
+    double enrich;
+    double traverse;
+    double select_rings;
+    double assign_parents;
+    double add_rings;
+};
+
+
 #ifndef DOXYGEN_NO_DETAIL
 namespace detail { namespace overlay
 {
@@ -95,6 +135,154 @@ struct overlay_null_visitor
     {}
 };
 
+// Measures the durations of the phases if the timings are requested
+class overlay_phase_timer
+{
+public:
+    explicit overlay_phase_timer(overlay_timings* timings)
+        : m_timings(timings)
+        , m_start(timings ? now() : 0)
+    {}
+
+    // Adds the time elapsed since the end of the previous phase
+    // to the duration of the phase
+    void end(double overlay_timings::* phase)
+    {
+        if (m_timings)
+        {
+            double const t = now();
+            m_timings->*phase += t - m_start;
+            m_start = t;
+        }
+    }
+
+private:
+    static double now()
+    {
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+        return std::chrono::duration<double>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+#else
+        return double(std::clock()) / CLOCKS_PER_SEC;
+#endif
+    }
+
+    overlay_timings* m_timings;
+    double m_start;
+};
+
+// The phases of the overlay which are executed sequentially
+struct overlay_sequential_phases
+{
+    template
+    <
+        bool Reverse1, bool Reverse2,
+        typename Geometry1, typename Geometry2,
+        typename Strategy, typename RobustPolicy,
+        typename Turns, typename InterruptPolicy
+    >
+    inline void get_turns(Geometry1 const& geometry1, Geometry2 const& geometry2,
+                          Strategy const& strategy, RobustPolicy const& robust_policy,
+                          Turns& turns, InterruptPolicy& interrupt_policy) const
+    {
+        geometry::get_turns
+            <
+                Reverse1, Reverse2,
+                detail::overlay::assign_null_policy
+            >(geometry1, geometry2, strategy, robust_policy, turns, interrupt_policy);
+    }
+
+    template
+    <
+        bool Reverse,
+        typename Geometry, typename Strategy, typename RobustPolicy,
+        typename Turns, typename InterruptPolicy
+    >
+    inline void self_turns(Geometry const& geometry,
+                           Strategy const& strategy, RobustPolicy const& robust_policy,
+                           Turns& turns, InterruptPolicy& interrupt_policy,
+                           int source_index) const
+    {
+        self_get_turn_points::self_turns<Reverse, assign_null_policy>(geometry,
+            strategy, robust_policy, turns, interrupt_policy, source_index);
+    }
+
+    template
+    <
+        overlay_type OverlayType,
+        typename Geometry1, typename Geometry2,
+        typename RingCollection, typename RingMap, typename Strategy
+    >
+    inline void assign_parents(Geometry1 const& geometry1, Geometry2 const& geometry2,
+                               RingCollection const& collection, RingMap& ring_map,
+                               Strategy const& strategy) const
+    {
+        detail::overlay::assign_parents<OverlayType>(geometry1, geometry2,
+            collection, ring_map, strategy);
+    }
+};
+
+// The phases of the overlay which are executed in parallel. The turns are
+// calculated and the parents of rings are assigned in parallel.
+// The turns are enriched and traversed sequentially.
+class overlay_parallel_phases
+{
+public:
+    explicit overlay_parallel_phases(execution::parallel_policy const& policy)
+        : m_policy(policy)
+    {}
+
+    template
+    <
+        bool Reverse1, bool Reverse2,
+        typename Geometry1, typename Geometry2,
+        typename Strategy, typename RobustPolicy,
+        typename Turns, typename InterruptPolicy
+    >
+    inline void get_turns(Geometry1 const& geometry1, Geometry2 const& geometry2,
+                          Strategy const& strategy, RobustPolicy const& robust_policy,
+                          Turns& turns, InterruptPolicy& interrupt_policy) const
+    {
+        geometry::get_turns
+            <
+                Reverse1, Reverse2,
+                detail::overlay::assign_null_policy
+            >(m_policy, geometry1, geometry2, strategy, robust_policy, turns, interrupt_policy);
+    }
+
+    template
+    <
+        bool Reverse,
+        typename Geometry, typename Strategy, typename RobustPolicy,
+        typename Turns, typename InterruptPolicy
+    >
+    inline void self_turns(Geometry const& geometry,
+                           Strategy const& strategy, RobustPolicy const& robust_policy,
+                           Turns& turns, InterruptPolicy& interrupt_policy,
+                           int source_index) const
+    {
+        self_get_turn_points::self_turns<Reverse, assign_null_policy>(m_policy, geometry,
+            strategy, robust_policy, turns, interrupt_policy, source_index);
+    }
+
+    template
+    <
+        overlay_type OverlayType,
+        typename Geometry1, typename Geometry2,
+        typename RingCollection, typename RingMap, typename Strategy
+    >
+    inline void assign_parents(Geometry1 const& geometry1, Geometry2 const& geometry2,
+                               RingCollection const& collection, RingMap& ring_map,
+                               Strategy const& strategy) const
+    {
+        detail::overlay::assign_parents<OverlayType>(m_policy, geometry1, geometry2,
+            collection, ring_map, strategy);
+    }
+
+private:
+    execution::parallel_policy m_policy;
+};
+
 template
 <
     overlay_type OverlayType,
@@ -253,13 +441,16 @@ template
 >
 struct overlay
 {
-    template <typename RobustPolicy, typename OutputIterator, typename Strategy, typename Visitor>
-    static inline OutputIterator apply(
+private:
+    template <typename Phases, typename RobustPolicy, typename OutputIterator, typename Strategy, typename Visitor>
+    static inline OutputIterator apply_phases(
+                Phases const& phases,
                 Geometry1 const& geometry1, Geometry2 const& geometry2,
                 RobustPolicy const& robust_policy,
                 OutputIterator out,
                 Strategy const& strategy,
-                Visitor& visitor)
+                Visitor& visitor,
+                overlay_timings* timings)
     {
         bool const is_empty1 = geometry::is_empty(geometry1);
         bool const is_empty2 = geometry::is_empty(geometry2);
@@ -299,31 +490,34 @@ struct overlay
 
         turn_container_type turns;
 
+        overlay_phase_timer timer(timings);
+
 #ifdef BOOST_GEOMETRY_DEBUG_ASSEMBLE
 std::cout << "get turns" << std::endl;
 #endif
         detail::get_turns::no_interrupt_policy policy;
-        geometry::get_turns
-            <
-                Reverse1, Reverse2,
-                detail::overlay::assign_null_policy
-            >(geometry1, geometry2, strategy, robust_policy, turns, policy);
+        phases.template get_turns<Reverse1, Reverse2>(geometry1, geometry2,
+            strategy, robust_policy, turns, policy);
 
         visitor.visit_turns(1, turns);
 
+        timer.end(&overlay_timings::get_turns);
+
 #if ! defined(BOOST_GEOMETRY_NO_SELF_TURNS)
         if (needs_self_turns<Geometry1>::apply(geometry1))
         {
-            self_get_turn_points::self_turns<Reverse1, assign_null_policy>(geometry1,
+            phases.template self_turns<Reverse1>(geometry1,
                 strategy, robust_policy, turns, policy, 0);
         }
         if (needs_self_turns<Geometry2>::apply(geometry2))
         {
-            self_get_turn_points::self_turns<Reverse2, assign_null_policy>(geometry2,
+            phases.template self_turns<Reverse2>(geometry2,
                 strategy, robust_policy, turns, policy, 1);
         }
 #endif
 
+        timer.end(&overlay_timings::self_turns);
+
 
 #ifdef BOOST_GEOMETRY_DEBUG_ASSEMBLE
 std::cout << "enrich" << std::endl;
@@ -341,6 +535,8 @@ std::cout << "enrich" << std::endl;
 
         visitor.visit_clusters(clusters, turns);
 
+        timer.end(&overlay_timings::enrich);
+
 #ifdef BOOST_GEOMETRY_DEBUG_ASSEMBLE
 std::cout << "traverse" << std::endl;
 #endif
@@ -360,6 +556,8 @@ std::cout << "traverse" << std::endl;
                 );
         visitor.visit_turns(3, turns);
 
+        timer.end(&overlay_timings::traverse);
+
         get_ring_turn_info<OverlayType>(turn_info_per_ring, turns, clusters);
 
         typedef typename Strategy::template area_strategy<point_type>::type area_strategy_type;
@@ -390,9 +588,13 @@ std::cout << "traverse" << std::endl;
             }
         }
 
-        assign_parents<OverlayType>(geometry1, geometry2,
+        timer.end(&overlay_timings::select_rings);
+
+        phases.template assign_parents<OverlayType>(geometry1, geometry2,
             rings, selected_ring_properties, strategy);
 
+        timer.end(&overlay_timings::assign_parents);
+
         // NOTE: There is no need to check result area for union because
         // as long as the polygons in the input are valid the resulting
         // polygons should be valid as well.
@@ -400,17 +602,94 @@ std::cout << "traverse" << std::endl;
         // can be changed with #define. This may be important in non-cartesian CSes.
         // The result may be too big, so the area is negative. In this case either
         // it can be returned or an exception can be thrown.
-        return add_rings<GeometryOut>(selected_ring_properties, geometry1, geometry2, rings, out,
-                                      area_strategy,
-                                      OverlayType == overlay_union ? 
+        out = add_rings<GeometryOut>(selected_ring_properties, geometry1, geometry2, rings, out,
+                                     area_strategy,
+                                     OverlayType == overlay_union ? 
 #if defined(BOOST_GEOMETRY_UNION_THROW_INVALID_OUTPUT_EXCEPTION)
-                                      add_rings_throw_if_reversed
+                                     add_rings_throw_if_reversed
 #elif defined(BOOST_GEOMETRY_UNION_RETURN_INVALID)
-                                      add_rings_add_unordered
+                                     add_rings_add_unordered
 #else
-                                      add_rings_ignore_unordered
+                                     add_rings_ignore_unordered
 #endif
-                                      : add_rings_ignore_unordered);
+                                     : add_rings_ignore_unordered);
+
+        timer.end(&overlay_timings::add_rings);
+
+        return out;
+    }
+
+public:
+    template <typename RobustPolicy, typename OutputIterator, typename Strategy, typename Visitor>
+    static inline OutputIterator apply(
+                Geometry1 const& geometry1, Geometry2 const& geometry2,
+                RobustPolicy const& robust_policy,
+                OutputIterator out,
+                Strategy const& strategy,
+                Visitor& visitor)
+    {
+        return apply_phases(overlay_sequential_phases(),
+                            geometry1, geometry2, robust_policy, out,
+                            strategy, visitor, 0);
+    }
+
+    // Stores the durations of the phases in timings
+    template <typename RobustPolicy, typename OutputIterator, typename Strategy, typename Visitor>
+    static inline OutputIterator apply(
+                Geometry1 const& geometry1, Geometry2 const& geometry2,
+                RobustPolicy const& robust_policy,
+                OutputIterator out,
+                Strategy const& strategy,
+                Visitor& visitor,
+                overlay_timings& timings)
+    {
+        return apply_phases(overlay_sequential_phases(),
+                            geometry1, geometry2, robust_policy, out,
+                            strategy, visitor, boost::addressof(timings));
+    }
+
+    // The turns are calculated and the parents of rings are assigned
+    // in parallel. The result is the same as the one of the sequential
+    // version.
+    template <typename RobustPolicy, typename OutputIterator, typename Strategy, typename Visitor>
+    static inline OutputIterator apply(
+                execution::parallel_policy const& policy,
+                Geometry1 const& geometry1, Geometry2 const& geometry2,
+                RobustPolicy const& robust_policy,
+                OutputIterator out,
+                Strategy const& strategy,
+                Visitor& visitor)
+    {
+        return apply_phases(overlay_parallel_phases(policy),
+                            geometry1, geometry2, robust_policy, out,
+                            strategy, visitor, 0);
+    }
+
+    template <typename RobustPolicy, typename OutputIterator, typename Strategy, typename Visitor>
+    static inline OutputIterator apply(
+                execution::parallel_policy const& policy,
+                Geometry1 const& geometry1, Geometry2 const& geometry2,
+                RobustPolicy const& robust_policy,
+                OutputIterator out,
+                Strategy const& strategy,
+                Visitor& visitor,
+                overlay_timings& timings)
+    {
+        return apply_phases(overlay_parallel_phases(policy),
+                            geometry1, geometry2, robust_policy, out,
+                            strategy, visitor, boost::addressof(timings));
+    }
+
+    template <typename RobustPolicy, typename OutputIterator, typename Strategy>
+    static inline OutputIterator apply(
+                execution::parallel_policy const& policy,
+                Geometry1 const& geometry1, Geometry2 const& geometry2,
+                RobustPolicy const& robust_policy,
+                OutputIterator out,
+                Strategy const& strategy)
+    {
+        overlay_null_visitor visitor;
+        return apply(policy, geometry1, geometry2, robust_policy, out, strategy, visitor);
     }
 
     template <typename RobustPolicy, typename OutputIterator, typename Strategy>
@@ -426,6 +705,117 @@ std::cout << "traverse" << std::endl;
 };
 
 
+// The parallel policy and the timings passed by the algorithms in place
+// of the strategy
+struct timed_parallel_policy
+{
+    timed_parallel_policy(execution::parallel_policy const& p,
+                          overlay_timings& t)
+        : policy(p), timings(boost::addressof(t))
+    {}
+
+    execution::parallel_policy policy;
+    overlay_timings* timings;
+};
+
+// The polygon type stored in the output collection of the parallel overlay,
+// void if the output is not a collection of polygons, e.g. a box
+template
+<
+    typename Collection,
+    typename Tag = typename geometry::tag<Collection>::type
+>
+struct parallel_overlay_output
+{
+    typedef void type;
+};
+
+template <typename Collection>
+struct parallel_overlay_output<Collection, multi_polygon_tag>
+{
+    typedef typename boost::range_value<Collection>::type type;
+};
+
+// e.g. std::vector of polygons
+template <typename Collection>
+struct parallel_overlay_output<Collection, void>
+{
+    typedef typename boost::range_value<Collection>::type value_type;
+
+    typedef typename boost::mpl::if_c
+        <
+            boost::is_same
+                <
+                    typename geometry::tag<value_type>::type,
+                    polygon_tag
+                >::value,
+            value_type,
+            void
+        >::type type;
+};
+
+// Calculates the union, intersection or difference of areal geometries
+// using the parallel overlay, called by the algorithms taking
+// execution::parallel_policy instead of the strategy. The durations of
+// the phases are stored in timings if it is not null.
+template
+<
+    overlay_type OverlayType,
+    bool ReverseSecond,
+    typename Geometry1,
+    typename Geometry2,
+    typename RobustPolicy,
+    typename Collection
+>
+inline void overlay_areal_parallel(Geometry1 const& geometry1,
+                                   Geometry2 const& geometry2,
+                                   RobustPolicy const& robust_policy,
+                                   Collection& output_collection,
+                                   execution::parallel_policy const& policy,
+                                   overlay_timings* timings = 0)
+{
+    typedef typename parallel_overlay_output<Collection>::type geometry_out;
+
+    BOOST_MPL_ASSERT_MSG
+        (
+            (geometry::is_areal<Geometry1>::value
+             && geometry::is_areal<Geometry2>::value
+             && ! boost::is_void<geometry_out>::value),
+            PARALLEL_OVERLAY_IS_IMPLEMENTED_ONLY_FOR_AREAL_GEOMETRIES_AND_POLYGONAL_OUTPUT,
+            (types<Geometry1, Geometry2, Collection>)
+        );
+
+    typedef overlay
+        <
+            Geometry1, Geometry2,
+            do_reverse<geometry::point_order<Geometry1>::value>::value,
+            do_reverse<geometry::point_order<Geometry2>::value, ReverseSecond>::value,
+            do_reverse<geometry::point_order<geometry_out>::value>::value,
+            geometry_out, OverlayType
+        > overlay_type;
+
+    typename strategy::intersection::services::default_strategy
+        <
+            typename cs_tag<geometry_out>::type
+        >::type strategy;
+
+    overlay_null_visitor visitor;
+
+    if (timings)
+    {
+        overlay_type::apply(policy, geometry1, geometry2, robust_policy,
+                            range::back_inserter(output_collection),
+                            strategy, visitor, *timings);
+    }
+    else
+    {
+        overlay_type::apply(policy, geometry1, geometry2, robust_policy,
+                            range::back_inserter(output_collection),
+                            strategy, visitor);
+    }
+}
+
+
 }} // namespace detail::overlay
 #endif // DOXYGEN_NO_DETAIL
 
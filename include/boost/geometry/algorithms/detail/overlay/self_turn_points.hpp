@@ -1,7 +1,7 @@
 // Boost.Geometry (aka GGL, Generic Geometry Library)
 
 // Copyright (c) 2007-2012 Barend Gehrels, Amsterdam, the Netherlands.
-// Copyright (c) 2017 Adam Wulkiewicz, Lodz, Poland.
+// Copyright (c) 2017-2018 Adam Wulkiewicz, Lodz, Poland.
 
 // This file was modified by Oracle on 2017.
 // Modifications copyright (c) 2017 Oracle and/or its affiliates.
@@ -16,8 +16,11 @@
 #define BOOST_GEOMETRY_ALGORITHMS_DETAIL_OVERLAY_SELF_TURN_POINTS_HPP
 
 
+#include <algorithm>
 #include <cstddef>
+#include <iterator>
 
+#include <boost/core/addressof.hpp>
 #include <boost/mpl/vector_c.hpp>
 #include <boost/range.hpp>
 
@@ -37,6 +40,7 @@
 #include <boost/geometry/geometries/box.hpp>
 
 #include <boost/geometry/util/condition.hpp>
+#include <boost/geometry/util/parallel.hpp>
 
 
 namespace boost { namespace geometry
@@ -123,19 +127,79 @@ struct self_section_visitor
 
 };
 
+// Visitor used by the parallel partition, storing the turns
+// in its own container
+template
+<
+    bool Reverse,
+    typename Geometry,
+    typename Turns,
+    typename TurnPolicy,
+    typename IntersectionStrategy,
+    typename RobustPolicy,
+    typename InterruptPolicy
+>
+struct parallel_self_section_visitor
+{
+    typedef self_section_visitor
+        <
+            Reverse, Geometry,
+            Turns, TurnPolicy, IntersectionStrategy, RobustPolicy, InterruptPolicy
+        > self_section_visitor_type;
+
+    Geometry const* m_geometry;
+    IntersectionStrategy const* m_intersection_strategy;
+    RobustPolicy const* m_rescale_policy;
+    InterruptPolicy m_interrupt_policy;
+    int m_source_index;
+    bool m_skip_adjacent;
+    Turns m_turns;
+
+    inline parallel_self_section_visitor(Geometry const& g,
+                                         IntersectionStrategy const& is,
+                                         RobustPolicy const& rp,
+                                         InterruptPolicy const& ip,
+                                         int source_index,
+                                         bool skip_adjacent)
+        : m_geometry(boost::addressof(g))
+        , m_intersection_strategy(boost::addressof(is))
+        , m_rescale_policy(boost::addressof(rp))
+        , m_interrupt_policy(ip)
+        , m_source_index(source_index)
+        , m_skip_adjacent(skip_adjacent)
+    {}
+
+    template <typename Section>
+    inline bool apply(Section const& sec1, Section const& sec2)
+    {
+        self_section_visitor_type visitor(*m_geometry, *m_intersection_strategy,
+                                          *m_rescale_policy, m_turns,
+                                          m_interrupt_policy,
+                                          m_source_index, m_skip_adjacent);
+        return visitor.apply(sec1, sec2);
+    }
+
+    inline parallel_self_section_visitor split() const
+    {
+        return parallel_self_section_visitor(*m_geometry, *m_intersection_strategy,
+                                             *m_rescale_policy, m_interrupt_policy,
+                                             m_source_index, m_skip_adjacent);
+    }
+
+    inline void join(parallel_self_section_visitor const& other)
+    {
+        std::copy(boost::begin(other.m_turns), boost::end(other.m_turns),
+                  std::back_inserter(m_turns));
+    }
+};
+
 
 
 template <bool Reverse, typename TurnPolicy>
 struct get_turns
 {
-    template <typename Geometry, typename IntersectionStrategy, typename RobustPolicy, typename Turns, typename InterruptPolicy>
-    static inline bool apply(
-            Geometry const& geometry,
-            IntersectionStrategy const& intersection_strategy,
-            RobustPolicy const& robust_policy,
-            Turns& turns,
-            InterruptPolicy& interrupt_policy,
-            int source_index, bool skip_adjacent)
+    template <typename Geometry, typename RobustPolicy>
+    struct sections_traits
     {
         typedef model::box
             <
@@ -148,13 +212,35 @@ struct get_turns
 
         // sectionalize in two dimensions to detect
         // all potential spikes correctly
-        typedef geometry::sections<box_type, 2> sections_type;
-
+        typedef geometry::sections<box_type, 2> type;
+    };
+
+    template <typename Geometry, typename IntersectionStrategy, typename RobustPolicy, typename Sections>
+    static inline void sectionalize(Geometry const& geometry,
+                                    IntersectionStrategy const& intersection_strategy,
+                                    RobustPolicy const& robust_policy,
+                                    Sections& sec)
+    {
         typedef boost::mpl::vector_c<std::size_t, 0, 1> dimensions;
 
-        sections_type sec;
         geometry::sectionalize<Reverse, dimensions>(geometry, robust_policy, sec,
                                                   intersection_strategy.get_envelope_strategy());
+    }
+
+    template <typename Geometry, typename IntersectionStrategy, typename RobustPolicy, typename Turns, typename InterruptPolicy>
+    static inline bool apply(
+            Geometry const& geometry,
+            IntersectionStrategy const& intersection_strategy,
+            RobustPolicy const& robust_policy,
+            Turns& turns,
+            InterruptPolicy& interrupt_policy,
+            int source_index, bool skip_adjacent)
+    {
+        typedef typename sections_traits<Geometry, RobustPolicy>::type sections_type;
+        typedef typename sections_type::box_type box_type;
+
+        sections_type sec;
+        sectionalize(geometry, intersection_strategy, robust_policy, sec);
 
         self_section_visitor
             <
@@ -172,6 +258,49 @@ struct get_turns
 
         return ! interrupt_policy.has_intersections;
     }
+
+    // The pairs of sections are intersected in parallel unless the
+    // interrupt policy is enabled
+    template <typename Geometry, typename IntersectionStrategy, typename RobustPolicy, typename Turns, typename InterruptPolicy>
+    static inline bool apply(
+            execution::parallel_policy const& policy,
+            Geometry const& geometry,
+            IntersectionStrategy const& intersection_strategy,
+            RobustPolicy const& robust_policy,
+            Turns& turns,
+            InterruptPolicy& interrupt_policy,
+            int source_index, bool skip_adjacent)
+    {
+        if (BOOST_GEOMETRY_CONDITION(InterruptPolicy::enabled))
+        {
+            return apply(geometry, intersection_strategy, robust_policy,
+                         turns, interrupt_policy, source_index, skip_adjacent);
+        }
+
+        typedef typename sections_traits<Geometry, RobustPolicy>::type sections_type;
+        typedef typename sections_type::box_type box_type;
+
+        sections_type sec;
+        sectionalize(geometry, intersection_strategy, robust_policy, sec);
+
+        parallel_self_section_visitor
+            <
+                Reverse, Geometry,
+                Turns, TurnPolicy, IntersectionStrategy, RobustPolicy, InterruptPolicy
+            > visitor(geometry, intersection_strategy, robust_policy, interrupt_policy, source_index, skip_adjacent);
+
+        geometry::partition
+            <
+                box_type
+            >::apply(policy, sec, visitor,
+                     detail::section::get_section_box(),
+                     detail::section::overlaps_section_box());
+
+        std::copy(boost::begin(visitor.m_turns), boost::end(visitor.m_turns),
+                  std::back_inserter(turns));
+
+        return ! interrupt_policy.has_intersections;
+    }
 };
 
 
@@ -234,6 +363,20 @@ struct self_get_turn_points
     {
         return true;
     }
+
+    template <typename Strategy, typename RobustPolicy, typename Turns, typename InterruptPolicy>
+    static inline bool apply(
+            execution::parallel_policy const& ,
+            Box const& ,
+            Strategy const& ,
+            RobustPolicy const& ,
+            Turns& ,
+            InterruptPolicy& ,
+            int /*source_index*/,
+            bool /*skip_adjacent*/)
+    {
+        return true;
+    }
 };
 
 
@@ -309,6 +452,39 @@ inline void self_turns(Geometry const& geometry,
                      source_index, skip_adjacent);
 }
 
+template
+<
+    bool Reverse,
+    typename AssignPolicy,
+    typename Geometry,
+    typename IntersectionStrategy,
+    typename RobustPolicy,
+    typename Turns,
+    typename InterruptPolicy
+>
+inline void self_turns(execution::parallel_policy const& policy,
+                       Geometry const& geometry,
+                       IntersectionStrategy const& strategy,
+                       RobustPolicy const& robust_policy,
+                       Turns& turns,
+                       InterruptPolicy& interrupt_policy,
+                       int source_index = 0,
+                       bool skip_adjacent = false)
+{
+    concepts::check<Geometry const>();
+
+    typedef detail::overlay::get_turn_info<detail::overlay::assign_null_policy> turn_policy;
+
+    dispatch::self_get_turn_points
+            <
+                Reverse,
+                typename tag<Geometry>::type,
+                Geometry,
+                turn_policy
+            >::apply(policy, geometry, strategy, robust_policy, turns, interrupt_policy,
+                     source_index, skip_adjacent);
+}
+
 }} // namespace detail::self_get_turn_points
 #endif // DOXYGEN_NO_DETAIL
 
@@ -357,6 +533,57 @@ inline void self_turns(Geometry const& geometry,
               source_index, skip_adjacent);
 }
 
+/*!
+    \brief Calculate self intersections of a geometry in parallel
+    \ingroup overlay
+    \details The pairs of monotonic sections of the geometry are intersected
+        in parallel. The turns are the same and in the same order as the ones
+        calculated sequentially. If the interrupt policy is enabled the turns
+        are calculated sequentially.
+    \tparam Geometry geometry type
+    \tparam Turns type of intersection container
+                (e.g. vector of "intersection/turn point"'s)
+    \param policy parallel execution policy
+    \param geometry geometry
+    \param strategy strategy to be used
+    \param robust_policy policy to handle robustness issues
+    \param turns container which will contain intersection points
+    \param interrupt_policy policy determining if process is stopped
+        when intersection is found
+ */
+template
+<
+    typename AssignPolicy,
+    typename Geometry,
+    typename IntersectionStrategy,
+    typename RobustPolicy,
+    typename Turns,
+    typename InterruptPolicy
+>
+inline void self_turns(execution::parallel_policy const& policy,
+                       Geometry const& geometry,
+                       IntersectionStrategy const& strategy,
+                       RobustPolicy const& robust_policy,
+                       Turns& turns,
+                       InterruptPolicy& interrupt_policy,
+                       int source_index = 0,
+                       bool skip_adjacent = false)
+{
+    concepts::check<Geometry const>();
+
+    static bool const reverse =  detail::overlay::do_reverse
+        <
+            geometry::point_order<Geometry>::value
+        >::value;
+
+    detail::self_get_turn_points::self_turns
+            <
+                reverse,
+                AssignPolicy
+            >(policy, geometry, strategy, robust_policy, turns, interrupt_policy,
+              source_index, skip_adjacent);
+}
+
 
 
 }} // namespace boost::geometry
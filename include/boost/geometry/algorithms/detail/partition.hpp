@@ -1,7 +1,7 @@
 // Boost.Geometry (aka GGL, Generic Geometry Library)
 
 // Copyright (c) 2011-2015 Barend Gehrels, Amsterdam, the Netherlands.
-// Copyright (c) 2017 Adam Wulkiewicz, Lodz, Poland.
+// Copyright (c) 2017-2018 Adam Wulkiewicz, Lodz, Poland.
 
 // This file was modified by Oracle on 2015, 2017.
 // Modifications copyright (c) 2015-2017 Oracle and/or its affiliates.
@@ -17,11 +17,14 @@
 #define BOOST_GEOMETRY_ALGORITHMS_DETAIL_PARTITION_HPP
 
 #include <cstddef>
+#include <utility>
 #include <vector>
+#include <boost/core/ignore_unused.hpp>
 #include <boost/range.hpp>
 #include <boost/geometry/core/access.hpp>
 #include <boost/geometry/core/coordinate_type.hpp>
 #include <boost/geometry/algorithms/assign.hpp>
+#include <boost/geometry/util/parallel.hpp>
 
 
 namespace boost { namespace geometry
@@ -577,9 +580,133 @@ struct include_all_policy
     }
 };
 
+#ifndef BOOST_GEOMETRY_NO_PARALLEL
+
+// Stores the pairs of items in the order in which they're visited
+// by the sequential partition
+template <typename Item1, typename Item2>
+struct collect_pairs_visitor
+{
+    typedef std::vector<std::pair<Item1 const*, Item2 const*> > pairs_type;
+
+    template <typename It1, typename It2>
+    inline bool apply(It1 const& item1, It2 const& item2)
+    {
+        pairs.push_back(std::make_pair(&item1, &item2));
+        return true;
+    }
+
+    pairs_type pairs;
+};
+
+// Visits a contiguous part of the pairs with a separate visitor
+template <typename Pairs, typename VisitPolicy>
+class visit_pairs_part
+{
+public:
+    visit_pairs_part(Pairs const& pairs, std::vector<VisitPolicy>& visitors)
+        : m_pairs(pairs)
+        , m_visitors(visitors)
+        , m_interrupted(visitors.size(), 0)
+        , m_first_interrupted(visitors.size())
+    {}
+
+    void operator()(std::size_t part)
+    {
+        // The results of the parts following the interrupted one
+        // are not used
+        if (part > m_first_interrupted)
+        {
+            return;
+        }
+
+        std::size_t const parts = m_visitors.size();
+        std::size_t const first = m_pairs.size() * part / parts;
+        std::size_t const last = m_pairs.size() * (part + 1) / parts;
+
+        VisitPolicy& visitor = m_visitors[part];
+        for (std::size_t i = first; i < last; ++i)
+        {
+            if (! visitor.apply(*m_pairs[i].first, *m_pairs[i].second))
+            {
+                m_interrupted[part] = 1;
+
+                std::size_t current = m_first_interrupted;
+                while (part < current
+                    && ! m_first_interrupted.compare_exchange_weak(current, part))
+                {}
+                return;
+            }
+        }
+    }
+
+    bool interrupted(std::size_t part) const
+    {
+        return m_interrupted[part] != 0;
+    }
+
+private:
+    Pairs const& m_pairs;
+    std::vector<VisitPolicy>& m_visitors;
+    std::vector<char> m_interrupted;
+    std::atomic<std::size_t> m_first_interrupted;
+};
+
+// Visits the pairs in parts, each part with a visitor returned by
+// visitor.split(). Then the visitors are joined with visitor.join() in the
+// order of the parts so the result is the same as if the pairs were
+// visited sequentially.
+template <typename Pairs, typename VisitPolicy>
+inline bool visit_pairs(Pairs const& pairs, VisitPolicy& visitor,
+                        std::size_t threads)
+{
+    // more parts than threads to balance the work
+    std::size_t parts = threads * 4;
+    if (parts > pairs.size())
+    {
+        parts = pairs.size();
+    }
+
+    std::vector<VisitPolicy> visitors;
+    visitors.reserve(parts);
+    for (std::size_t i = 0; i < parts; ++i)
+    {
+        visitors.push_back(visitor.split());
+    }
+
+    visit_pairs_part<Pairs, VisitPolicy> part(pairs, visitors);
+    parallel::for_each_index(parts, part, threads);
+
+    for (std::size_t i = 0; i < parts; ++i)
+    {
+        visitor.join(visitors[i]);
+        if (part.interrupted(i))
+        {
+            return false; // interrupt
+        }
+    }
+
+    return true;
+}
+
+#endif // BOOST_GEOMETRY_NO_PARALLEL
+
 
 }} // namespace detail::partition
 
+/*!
+\brief Divides the input ranges recursively and visits the pairs of items
+    which boxes may overlap.
+\details The versions taking execution::parallel_policy as the first argument
+    visit the pairs in parallel. The pairs are found sequentially, then they
+    are divided into parts. Each part is visited by a separate visitor
+    returned by visitor.split() and then the results are merged with
+    visitor.join(part_visitor) in the order of the parts. So the VisitPolicy
+    has to implement these functions and the result is the same as the one
+    of the sequential version. If the visitor interrupts the process the
+    parts following the interrupted one are not joined. The function
+    visiting box (VisitBoxPolicy) is not supported by the parallel versions.
+*/
 template
 <
     typename Box,
@@ -840,6 +967,109 @@ public:
 
         return true;
     }
+
+    template
+    <
+        typename ForwardRange,
+        typename VisitPolicy,
+        typename ExpandPolicy,
+        typename OverlapsPolicy
+    >
+    static inline bool apply(execution::parallel_policy const& policy,
+                             ForwardRange const& forward_range,
+                             VisitPolicy& visitor,
+                             ExpandPolicy const& expand_policy,
+                             OverlapsPolicy const& overlaps_policy,
+                             std::size_t min_elements = default_min_elements)
+    {
+#ifndef BOOST_GEOMETRY_NO_PARALLEL
+        std::size_t const threads = policy.threads();
+        if (threads > 1)
+        {
+            typedef typename boost::range_value<ForwardRange>::type item_type;
+
+            detail::partition::collect_pairs_visitor
+                <
+                    item_type, item_type
+                > collector;
+            apply(forward_range, collector, expand_policy, overlaps_policy,
+                  min_elements, detail::partition::visit_no_policy());
+
+            return detail::partition::visit_pairs(collector.pairs,
+                                                  visitor, threads);
+        }
+#else
+        boost::ignore_unused(policy);
+#endif
+
+        return apply(forward_range, visitor, expand_policy, overlaps_policy,
+                     min_elements, detail::partition::visit_no_policy());
+    }
+
+    template
+    <
+        typename ForwardRange1,
+        typename ForwardRange2,
+        typename VisitPolicy,
+        typename ExpandPolicy1,
+        typename OverlapsPolicy1
+    >
+    static inline bool apply(execution::parallel_policy const& policy,
+                             ForwardRange1 const& forward_range1,
+                             ForwardRange2 const& forward_range2,
+                             VisitPolicy& visitor,
+                             ExpandPolicy1 const& expand_policy1,
+                             OverlapsPolicy1 const& overlaps_policy1)
+    {
+        return apply(policy, forward_range1, forward_range2, visitor,
+                     expand_policy1, overlaps_policy1, expand_policy1, overlaps_policy1,
+                     default_min_elements);
+    }
+
+    template
+    <
+        typename ForwardRange1,
+        typename ForwardRange2,
+        typename VisitPolicy,
+        typename ExpandPolicy1,
+        typename OverlapsPolicy1,
+        typename ExpandPolicy2,
+        typename OverlapsPolicy2
+    >
+    static inline bool apply(execution::parallel_policy const& policy,
+                             ForwardRange1 const& forward_range1,
+                             ForwardRange2 const& forward_range2,
+                             VisitPolicy& visitor,
+                             ExpandPolicy1 const& expand_policy1,
+                             OverlapsPolicy1 const& overlaps_policy1,
+                             ExpandPolicy2 const& expand_policy2,
+                             OverlapsPolicy2 const& overlaps_policy2,
+                             std::size_t min_elements = default_min_elements)
+    {
+#ifndef BOOST_GEOMETRY_NO_PARALLEL
+        std::size_t const threads = policy.threads();
+        if (threads > 1)
+        {
+            detail::partition::collect_pairs_visitor
+                <
+                    typename boost::range_value<ForwardRange1>::type,
+                    typename boost::range_value<ForwardRange2>::type
+                > collector;
+            apply(forward_range1, forward_range2, collector,
+                  expand_policy1, overlaps_policy1, expand_policy2, overlaps_policy2,
+                  min_elements, detail::partition::visit_no_policy());
+
+            return detail::partition::visit_pairs(collector.pairs,
+                                                  visitor, threads);
+        }
+#else
+        boost::ignore_unused(policy);
+#endif
+
+        return apply(forward_range1, forward_range2, visitor,
+                     expand_policy1, overlaps_policy1, expand_policy2, overlaps_policy2,
+                     min_elements, detail::partition::visit_no_policy());
+    }
 };
 
 
@@ -1,6 +1,7 @@
 // Boost.Geometry (aka GGL, Generic Geometry Library)
 
 // Copyright (c) 2007-2012 Barend Gehrels, Amsterdam, the Netherlands.
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
 
 // This file was modified by Oracle on 2017.
 // Modifications copyright (c) 2017, Oracle and/or its affiliates.
@@ -168,6 +169,47 @@ struct difference
             geometry1, geometry2, robust_policy,
             range::back_inserter(output_collection));
     }
+
+    // The turns are calculated and the parents of rings are assigned in
+    // parallel, only areal geometries are supported
+    template
+    <
+        typename Geometry1,
+        typename Geometry2,
+        typename RobustPolicy,
+        typename Collection
+    >
+    static inline void apply(Geometry1 const& geometry1,
+                             Geometry2 const& geometry2,
+                             RobustPolicy const& robust_policy,
+                             Collection & output_collection,
+                             execution::parallel_policy const& policy)
+    {
+        detail::overlay::overlay_areal_parallel
+            <
+                overlay_difference, true
+            >(geometry1, geometry2, robust_policy, output_collection, policy);
+    }
+
+    template
+    <
+        typename Geometry1,
+        typename Geometry2,
+        typename RobustPolicy,
+        typename Collection
+    >
+    static inline void apply(Geometry1 const& geometry1,
+                             Geometry2 const& geometry2,
+                             RobustPolicy const& robust_policy,
+                             Collection & output_collection,
+                             detail::overlay::timed_parallel_policy const& policy)
+    {
+        detail::overlay::overlay_areal_parallel
+            <
+                overlay_difference, true
+            >(geometry1, geometry2, robust_policy, output_collection,
+              policy.policy, policy.timings);
+    }
 };
 
 } // resolve_strategy
@@ -345,6 +387,10 @@ struct difference<variant<BOOST_VARIANT_ENUM_PARAMS(T1)>, variant<BOOST_VARIANT_
 \param geometry2 \param_geometry
 \param output_collection the output collection
 \param strategy \param_strategy{difference}
+\note If execution::parallel_policy is passed instead of the strategy the
+    turns are calculated and the parents of rings are assigned in parallel.
+    The result is the same as the one of the sequential version. Only areal
+    geometries are supported.
 
 \qbk{distinguish,with strategy}
 \qbk{[include reference/algorithms/difference.qbk]}
@@ -369,6 +415,47 @@ inline void difference(Geometry1 const& geometry1,
 }
 
 
+/*!
+\brief_calc2{difference}, in parallel
+\ingroup difference
+\details \details_calc2{difference, spatial set theoretic difference}.
+    The turns are calculated and the parents of rings are assigned in
+    parallel. The durations of the phases of the overlay are added to timings.
+\tparam Geometry1 \tparam_geometry
+\tparam Geometry2 \tparam_geometry
+\tparam Collection output collection of polygons, either a multi_polygon,
+    or a std::vector<Polygon> / std::deque<Polygon> etc
+\param geometry1 \param_geometry
+\param geometry2 \param_geometry
+\param output_collection the output collection
+\param policy the parallel execution policy
+\param timings the durations of the phases of the overlay
+\note Only areal geometries are supported.
+
+\qbk{distinguish,with parallel policy and timings}
+\qbk{[include reference/algorithms/difference.qbk]}
+*/
+template
+<
+    typename Geometry1,
+    typename Geometry2,
+    typename Collection
+>
+inline void difference(Geometry1 const& geometry1,
+                       Geometry2 const& geometry2,
+                       Collection& output_collection,
+                       execution::parallel_policy const& policy,
+                       overlay_timings& timings)
+{
+    resolve_variant::difference
+        <
+            Geometry1,
+            Geometry2
+        >::apply(geometry1, geometry2, output_collection,
+                 detail::overlay::timed_parallel_policy(policy, timings));
+}
+
+
 /*!
 \brief_calc2{difference}
 \ingroup difference
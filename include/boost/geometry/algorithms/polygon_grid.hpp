@@ -0,0 +1,359 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_ALGORITHMS_POLYGON_GRID_HPP
+#define BOOST_GEOMETRY_ALGORITHMS_POLYGON_GRID_HPP
+
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <boost/mpl/assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/coordinate_type.hpp>
+#include <boost/geometry/core/cs.hpp>
+#include <boost/geometry/core/is_areal.hpp>
+#include <boost/geometry/core/point_type.hpp>
+#include <boost/geometry/core/tag.hpp>
+#include <boost/geometry/core/tags.hpp>
+
+#include <boost/geometry/algorithms/covered_by.hpp>
+#include <boost/geometry/algorithms/detail/assign_indexed_point.hpp>
+#include <boost/geometry/algorithms/envelope.hpp>
+
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/concepts/check.hpp>
+
+#include <boost/geometry/iterators/segment_iterator.hpp>
+
+#include <boost/geometry/strategies/cartesian/point_in_poly_winding.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace polygon_grid
+{
+
+
+// The maximum average number of cells containing a segment. If the
+// finest grid would store more segments, the number of cells is reduced.
+static const std::size_t max_cells_per_segment = 8;
+
+template <typename Point>
+struct edge
+{
+    typedef typename geometry::coordinate_type<Point>::type coordinate_type;
+
+    Point first;
+    Point second;
+    coordinate_type min_y;
+};
+
+struct edge_min_y_less
+{
+    template <typename Edge>
+    inline bool operator()(Edge const& l, Edge const& r) const
+    {
+        return l.min_y < r.min_y;
+    }
+};
+
+
+}} // namespace detail::polygon_grid
+#endif // DOXYGEN_NO_DETAIL
+
+
+/*!
+\brief Uniform grid of the segments of an areal geometry
+\ingroup polygon_grid
+\details The envelope of the geometry is divided into vertical cells of
+    equal width, each one storing the segments overlapping it sorted by
+    the lowest y coordinate. The winding strategy counts the segments
+    crossed by the ray cast from the point in the direction of decreasing
+    y coordinates so within() and covered_by() taking the grid analyse only
+    the segments of the cell containing the point and lying below it.
+    For typical geometries the number of these segments doesn't depend on
+    the total number of segments so each point is tested in O(1) average
+    time. The results are the same as the results of the algorithms
+    analysing all segments of the geometry.
+    The number of cells is adapted to the geometry so that the grid stores
+    at most 8 times more segments than the geometry has.
+    The grid stores copies of the segments so the geometry doesn't have
+    to exist after the grid is created. The grid is not modified by the
+    predicates so it can be used concurrently by many threads.
+\tparam Geometry areal geometry in cartesian coordinate system,
+    e.g. polygon or multi_polygon
+*/
+template <typename Geometry>
+class polygon_grid
+{
+    BOOST_MPL_ASSERT_MSG
+        (
+            (geometry::is_areal<Geometry>::value
+             && ! boost::is_same<typename geometry::tag<Geometry>::type, box_tag>::value
+             && boost::is_same
+                 <
+                     typename geometry::cs_tag<Geometry>::type,
+                     cartesian_tag
+                 >::value),
+            POLYGON_GRID_IS_IMPLEMENTED_ONLY_FOR_CARTESIAN_RINGS_POLYGONS_AND_MULTI_POLYGONS,
+            (types<Geometry>)
+        );
+
+public:
+    typedef Geometry geometry_type;
+    typedef typename geometry::point_type<Geometry>::type point_type;
+    typedef typename geometry::coordinate_type<Geometry>::type coordinate_type;
+    typedef model::box<point_type> box_type;
+
+    /*!
+    \brief The constructor creating the grid of the segments of the geometry.
+    \param geometry the geometry
+    */
+    explicit polygon_grid(Geometry const& geometry)
+        : m_scale(0)
+    {
+        geometry::envelope(geometry, m_envelope);
+
+        std::vector<edge_type> edges;
+        typedef geometry::segment_iterator<Geometry const> iterator_type;
+        for (iterator_type it = geometry::segments_begin(geometry);
+             it != geometry::segments_end(geometry); ++it)
+        {
+            edge_type e;
+            geometry::detail::assign_point_from_index<0>(*it, e.first);
+            geometry::detail::assign_point_from_index<1>(*it, e.second);
+            e.min_y = (std::min)(geometry::get<1>(e.first), geometry::get<1>(e.second));
+            edges.push_back(e);
+        }
+
+        create(edges);
+    }
+
+    /*!
+    \brief Returns the envelope of the geometry.
+    */
+    box_type const& envelope() const
+    {
+        return m_envelope;
+    }
+
+    /*!
+    \brief Returns the number of cells of the grid.
+    */
+    std::size_t cells_count() const
+    {
+        return m_offsets.empty() ? 0 : m_offsets.size() - 1;
+    }
+
+#ifndef DOXYGEN_NO_DETAIL
+    // Returns 1 if the point is in the interior, 0 if it's on the boundary
+    // and -1 if it's in the exterior of the geometry.
+    // The segments not overlapping the cell of the point can't be crossed
+    // by the ray. The segments lying above the point can't be crossed
+    // either so the traversal of the sorted segments stops at the first one.
+    template <typename Point>
+    inline int point_code(Point const& point) const
+    {
+        if (m_offsets.empty() || ! geometry::covered_by(point, m_envelope))
+        {
+            return -1;
+        }
+
+        typedef strategy::within::cartesian_winding
+            <
+                Point, point_type
+            > strategy_type;
+
+        std::size_t const cell = cell_index(geometry::get<0>(point));
+        typename std::vector<edge_type>::const_iterator
+            it = m_edges.begin() + m_offsets[cell];
+        typename std::vector<edge_type>::const_iterator const
+            end = m_edges.begin() + m_offsets[cell + 1];
+
+        typename strategy_type::state_type state;
+        for ( ; it != end && ! (geometry::get<1>(point) < it->min_y) ; ++it)
+        {
+            if (! strategy_type::apply(point, it->first, it->second, state))
+            {
+                break;
+            }
+        }
+
+        return strategy_type::result(state);
+    }
+#endif // DOXYGEN_NO_DETAIL
+
+private:
+    typedef detail::polygon_grid::edge<point_type> edge_type;
+
+    // The cell index is a monotonic function of the x coordinate so
+    // a segment overlapping a range of cells overlaps all of them
+    // and the cell of any point of the segment is in this range.
+    template <typename T>
+    inline std::size_t cell_index(T const& x) const
+    {
+        double const d = (static_cast<double>(x)
+                          - static_cast<double>(geometry::get<min_corner, 0>(m_envelope)))
+                       * m_scale;
+        std::size_t const last = m_offsets.size() - 2;
+        return d <= 0 ? 0
+             : d >= static_cast<double>(last) ? last
+             : static_cast<std::size_t>(d);
+    }
+
+    inline std::size_t entries_count(std::vector<edge_type> const& edges) const
+    {
+        std::size_t result = 0;
+        for (std::size_t i = 0 ; i < edges.size() ; ++i)
+        {
+            std::pair<std::size_t, std::size_t> const r = cells_range(edges[i]);
+            result += r.second - r.first + 1;
+        }
+        return result;
+    }
+
+    inline std::pair<std::size_t, std::size_t> cells_range(edge_type const& e) const
+    {
+        std::size_t const c1 = cell_index(geometry::get<0>(e.first));
+        std::size_t const c2 = cell_index(geometry::get<0>(e.second));
+        return c1 < c2 ? std::make_pair(c1, c2) : std::make_pair(c2, c1);
+    }
+
+    inline void set_cells_count(std::size_t count)
+    {
+        double const width
+            = static_cast<double>(geometry::get<max_corner, 0>(m_envelope))
+            - static_cast<double>(geometry::get<min_corner, 0>(m_envelope));
+
+        m_offsets.assign(count + 1, 0);
+        m_scale = width > 0 ? static_cast<double>(count) / width : 0;
+    }
+
+    inline void create(std::vector<edge_type> const& edges)
+    {
+        if (edges.empty())
+        {
+            return;
+        }
+
+        std::size_t const max_entries
+            = detail::polygon_grid::max_cells_per_segment * edges.size();
+
+        // Start with the number of cells equal to the number of segments
+        // and halve it until the segments fit
+        std::size_t count = edges.size();
+        set_cells_count(count);
+        while (count > 1 && entries_count(edges) > max_entries)
+        {
+            count /= 2;
+            set_cells_count(count);
+        }
+
+        // Count the segments of each cell and store them contiguously
+        for (std::size_t i = 0 ; i < edges.size() ; ++i)
+        {
+            std::pair<std::size_t, std::size_t> const r = cells_range(edges[i]);
+            for (std::size_t c = r.first ; c <= r.second ; ++c)
+            {
+                ++m_offsets[c + 1];
+            }
+        }
+        for (std::size_t c = 0 ; c < count ; ++c)
+        {
+            m_offsets[c + 1] += m_offsets[c];
+        }
+
+        m_edges.resize(m_offsets.back());
+        std::vector<std::size_t> positions(m_offsets.begin(), m_offsets.end() - 1);
+        for (std::size_t i = 0 ; i < edges.size() ; ++i)
+        {
+            std::pair<std::size_t, std::size_t> const r = cells_range(edges[i]);
+            for (std::size_t c = r.first ; c <= r.second ; ++c)
+            {
+                m_edges[positions[c]++] = edges[i];
+            }
+        }
+
+        for (std::size_t c = 0 ; c < count ; ++c)
+        {
+            std::sort(m_edges.begin() + m_offsets[c],
+                      m_edges.begin() + m_offsets[c + 1],
+                      detail::polygon_grid::edge_min_y_less());
+        }
+    }
+
+    box_type m_envelope;
+    double m_scale;
+    std::vector<std::size_t> m_offsets;
+    std::vector<edge_type> m_edges;
+};
+
+
+/*!
+\brief \brief_check12{is completely inside}
+\ingroup polygon_grid
+\details Checks if the point is in the interior of the geometry using
+    the grid of its segments.
+\tparam Point \tparam_point
+\tparam Geometry the type of the geometry of the grid
+\param point \param_point
+\param grid the grid of the segments of the geometry
+\return \return_check2{is within, geometry}
+*/
+template <typename Point, typename Geometry>
+inline bool within(Point const& point, polygon_grid<Geometry> const& grid)
+{
+    concepts::check<Point const>();
+    BOOST_MPL_ASSERT_MSG
+        (
+            (boost::is_same<typename geometry::tag<Point>::type, point_tag>::value),
+            NOT_IMPLEMENTED_FOR_THIS_GEOMETRY_TYPE,
+            (types<Point>)
+        );
+
+    return grid.point_code(point) > 0;
+}
+
+/*!
+\brief \brief_check12{is inside or on border}
+\ingroup polygon_grid
+\details Checks if the point is in the interior or on the boundary of the
+    geometry using the grid of its segments.
+\tparam Point \tparam_point
+\tparam Geometry the type of the geometry of the grid
+\param point \param_point
+\param grid the grid of the segments of the geometry
+\return \return_check2{is inside or on border, geometry}
+*/
+template <typename Point, typename Geometry>
+inline bool covered_by(Point const& point, polygon_grid<Geometry> const& grid)
+{
+    concepts::check<Point const>();
+    BOOST_MPL_ASSERT_MSG
+        (
+            (boost::is_same<typename geometry::tag<Point>::type, point_tag>::value),
+            NOT_IMPLEMENTED_FOR_THIS_GEOMETRY_TYPE,
+            (types<Point>)
+        );
+
+    return grid.point_code(point) >= 0;
+}
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_ALGORITHMS_POLYGON_GRID_HPP
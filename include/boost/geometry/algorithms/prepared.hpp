@@ -0,0 +1,529 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_ALGORITHMS_PREPARED_HPP
+#define BOOST_GEOMETRY_ALGORITHMS_PREPARED_HPP
+
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <boost/core/addressof.hpp>
+#include <boost/mpl/assert.hpp>
+#include <boost/range.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/cs.hpp>
+#include <boost/geometry/core/is_areal.hpp>
+#include <boost/geometry/core/point_type.hpp>
+#include <boost/geometry/core/tag.hpp>
+#include <boost/geometry/core/tags.hpp>
+
+#include <boost/geometry/algorithms/convert.hpp>
+#include <boost/geometry/algorithms/covered_by.hpp>
+#include <boost/geometry/algorithms/detail/disjoint/box_box.hpp>
+#include <boost/geometry/algorithms/envelope.hpp>
+#include <boost/geometry/algorithms/intersects.hpp>
+#include <boost/geometry/algorithms/not_implemented.hpp>
+
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/concepts/check.hpp>
+#include <boost/geometry/geometries/ring.hpp>
+#include <boost/geometry/geometries/segment.hpp>
+
+#include <boost/geometry/index/rtree.hpp>
+
+#include <boost/geometry/iterators/point_iterator.hpp>
+#include <boost/geometry/iterators/segment_iterator.hpp>
+
+#include <boost/geometry/strategies/cartesian/point_in_poly_winding.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+/*!
+\brief Areal geometry prepared for repeated predicate evaluation
+\ingroup prepared
+\details The envelope of the geometry and an rtree of the envelopes of its
+    segments are created once. The predicates within(), covered_by() and
+    intersects() taking the prepared geometry query the rtree instead of
+    analysing all segments so for a geometry with n segments each point
+    is tested in O(log(n) + k) where k is the number of segments crossing
+    the vertical ray cast from the point.
+    The geometry is not copied, it must exist as long as the prepared
+    geometry is used. The prepared geometry is not modified by the
+    predicates so it can be used concurrently by many threads.
+\tparam Geometry areal geometry in cartesian coordinate system,
+    e.g. polygon or multi_polygon
+*/
+template <typename Geometry>
+class prepared
+{
+    BOOST_MPL_ASSERT_MSG
+        (
+            (geometry::is_areal<Geometry>::value
+             && ! boost::is_same<typename geometry::tag<Geometry>::type, box_tag>::value
+             && boost::is_same
+                 <
+                     typename geometry::cs_tag<Geometry>::type,
+                     cartesian_tag
+                 >::value),
+            PREPARED_IS_IMPLEMENTED_ONLY_FOR_CARTESIAN_RINGS_POLYGONS_AND_MULTI_POLYGONS,
+            (types<Geometry>)
+        );
+
+public:
+    typedef Geometry geometry_type;
+    typedef typename geometry::point_type<Geometry>::type point_type;
+    typedef model::box<point_type> box_type;
+    typedef model::segment<point_type> segment_type;
+
+    /*!
+    \brief The constructor creating the index of the segments of the geometry.
+    \param geometry the geometry which must exist as long as the prepared geometry
+    */
+    explicit prepared(Geometry const& geometry)
+        : m_geometry(boost::addressof(geometry))
+    {
+        geometry::envelope(geometry, m_envelope);
+
+        std::vector<box_pair_type> boxes;
+        typedef segment_iterator<Geometry const> iterator_type;
+        for (iterator_type it = geometry::segments_begin(geometry);
+             it != geometry::segments_end(geometry); ++it)
+        {
+            segment_type segment;
+            geometry::detail::assign_point_from_index<0>(*it, segment.first);
+            geometry::detail::assign_point_from_index<1>(*it, segment.second);
+
+            box_type box;
+            geometry::envelope(segment, box);
+
+            boxes.push_back(box_pair_type(box, m_segments.size()));
+            m_segments.push_back(segment);
+        }
+
+        rtree_type rtree(boxes.begin(), boxes.end());
+        m_rtree.swap(rtree);
+    }
+
+    /*!
+    \brief Returns the prepared geometry.
+    */
+    Geometry const& geometry() const
+    {
+        return *m_geometry;
+    }
+
+    /*!
+    \brief Returns the envelope of the prepared geometry.
+    */
+    box_type const& envelope() const
+    {
+        return m_envelope;
+    }
+
+    /*!
+    \brief Returns the number of indexed segments.
+    */
+    std::size_t segments_count() const
+    {
+        return m_segments.size();
+    }
+
+#ifndef DOXYGEN_NO_DETAIL
+    // Returns 1 if the point is in the interior, 0 if it's on the boundary
+    // and -1 if it's in the exterior of the geometry.
+    // The winding strategy counts the segments crossed by the ray cast
+    // from the point in the direction of decreasing y coordinates.
+    // The segments not intersecting this ray don't change the state so
+    // only the segments with envelopes intersecting the ray are checked.
+    template <typename Point>
+    inline int point_code(Point const& point) const
+    {
+        if (! geometry::covered_by(point, m_envelope))
+        {
+            return -1;
+        }
+
+        typedef strategy::within::cartesian_winding
+            <
+                Point, point_type
+            > strategy_type;
+
+        box_type ray;
+        geometry::set<min_corner, 0>(ray, geometry::get<0>(point));
+        geometry::set<min_corner, 1>(ray, geometry::get<min_corner, 1>(m_envelope));
+        geometry::set<max_corner, 0>(ray, geometry::get<0>(point));
+        geometry::set<max_corner, 1>(ray, geometry::get<1>(point));
+
+        typename strategy_type::state_type state;
+        m_rtree.query(index::intersects(ray),
+                      winding_output<Point, strategy_type>(point, m_segments, state));
+
+        return strategy_type::result(state);
+    }
+
+    // Returns true if the segment intersects any segment of the geometry
+    template <typename Segment>
+    inline bool intersects_segment(Segment const& segment) const
+    {
+        box_type box;
+        geometry::envelope(segment, box);
+
+        if (geometry::detail::disjoint::disjoint_box_box(box, m_envelope))
+        {
+            return false;
+        }
+
+        for (typename rtree_type::const_query_iterator it
+                = m_rtree.qbegin(index::intersects(box));
+             it != m_rtree.qend(); ++it)
+        {
+            if (geometry::intersects(segment, m_segments[it->second]))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+#endif // DOXYGEN_NO_DETAIL
+
+private:
+    typedef std::pair<box_type, std::size_t> box_pair_type;
+    typedef index::rtree<box_pair_type, index::rstar<16> > rtree_type;
+
+    // Output iterator passing the segments found by the query
+    // to the winding strategy
+    template <typename Point, typename Strategy>
+    struct winding_output
+    {
+        typedef std::output_iterator_tag iterator_category;
+        typedef void value_type;
+        typedef void difference_type;
+        typedef void pointer;
+        typedef void reference;
+
+        winding_output(Point const& point,
+                       std::vector<segment_type> const& segments,
+                       typename Strategy::state_type& state)
+            : m_point(boost::addressof(point))
+            , m_segments(boost::addressof(segments))
+            , m_state(boost::addressof(state))
+        {}
+
+        winding_output& operator*() { return *this; }
+        winding_output& operator++() { return *this; }
+        winding_output& operator++(int) { return *this; }
+
+        winding_output& operator=(box_pair_type const& value)
+        {
+            segment_type const& segment = (*m_segments)[value.second];
+            Strategy::apply(*m_point, segment.first, segment.second, *m_state);
+            return *this;
+        }
+
+        Point const* m_point;
+        std::vector<segment_type> const* m_segments;
+        typename Strategy::state_type* m_state;
+    };
+
+    Geometry const* m_geometry;
+    box_type m_envelope;
+    std::vector<segment_type> m_segments;
+    rtree_type m_rtree;
+};
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace prepared
+{
+
+
+struct intersects_point
+{
+    template <typename Point, typename Prepared>
+    static inline bool apply(Point const& point, Prepared const& prepared)
+    {
+        return prepared.point_code(point) >= 0;
+    }
+};
+
+struct intersects_multi_point
+{
+    template <typename MultiPoint, typename Prepared>
+    static inline bool apply(MultiPoint const& multi_point, Prepared const& prepared)
+    {
+        for (typename boost::range_iterator<MultiPoint const>::type
+                it = boost::begin(multi_point);
+             it != boost::end(multi_point); ++it)
+        {
+            if (prepared.point_code(*it) >= 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+template <typename Prepared>
+struct point_in_prepared
+{
+    explicit point_in_prepared(Prepared const& prepared)
+        : m_prepared(boost::addressof(prepared))
+    {}
+
+    template <typename Point>
+    inline bool operator()(Point const& point) const
+    {
+        return m_prepared->point_code(point) >= 0;
+    }
+
+    Prepared const* m_prepared;
+};
+
+template <typename Areal>
+struct point_covered_by
+{
+    explicit point_covered_by(Areal const& areal)
+        : m_areal(boost::addressof(areal))
+    {}
+
+    template <typename Point>
+    inline bool operator()(Point const& point) const
+    {
+        return geometry::covered_by(point, *m_areal);
+    }
+
+    Areal const* m_areal;
+};
+
+// Returns true if the predicate is true for the first point of any
+// single geometry
+template <typename Geometry, typename Predicate>
+inline bool any_first_point(Geometry const& geometry, Predicate const& predicate,
+                            boost::false_type /*is_multi*/)
+{
+    geometry::point_iterator<Geometry const> it = geometry::points_begin(geometry);
+    return it != geometry::points_end(geometry) && predicate(*it);
+}
+
+template <typename Geometry, typename Predicate>
+inline bool any_first_point(Geometry const& geometry, Predicate const& predicate,
+                            boost::true_type /*is_multi*/)
+{
+    for (typename boost::range_iterator<Geometry const>::type
+            it = boost::begin(geometry);
+         it != boost::end(geometry); ++it)
+    {
+        if (any_first_point(*it, predicate, boost::false_type()))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename Geometry, typename Predicate>
+inline bool any_first_point(Geometry const& geometry, Predicate const& predicate)
+{
+    return any_first_point(geometry, predicate,
+        boost::is_base_of<multi_tag, typename geometry::tag<Geometry>::type>());
+}
+
+// The geometries intersect if any of their segments intersect. If they
+// don't, a single geometry may still be inside the other geometry. Then
+// its first point is inside too.
+template <bool IsAreal>
+struct intersects_segments
+{
+    template <typename Geometry, typename Prepared>
+    static inline bool apply(Geometry const& geometry, Prepared const& prepared)
+    {
+        typedef geometry::segment_iterator<Geometry const> iterator_type;
+
+        if (geometry::detail::disjoint::disjoint_box_box(
+                return_envelope<typename Prepared::box_type>(geometry),
+                prepared.envelope()))
+        {
+            return false;
+        }
+
+        for (iterator_type it = geometry::segments_begin(geometry);
+             it != geometry::segments_end(geometry); ++it)
+        {
+            if (prepared.intersects_segment(*it))
+            {
+                return true;
+            }
+        }
+
+        if (any_first_point(geometry, point_in_prepared<Prepared>(prepared)))
+        {
+            return true;
+        }
+
+        return IsAreal
+            && any_first_point(prepared.geometry(), point_covered_by<Geometry>(geometry));
+    }
+};
+
+struct intersects_box
+{
+    template <typename Box, typename Prepared>
+    static inline bool apply(Box const& box, Prepared const& prepared)
+    {
+        model::ring<typename point_type<Box>::type> ring;
+        geometry::convert(box, ring);
+        return intersects_segments<true>::apply(ring, prepared);
+    }
+};
+
+
+}} // namespace detail::prepared
+#endif // DOXYGEN_NO_DETAIL
+
+
+#ifndef DOXYGEN_NO_DISPATCH
+namespace dispatch
+{
+
+
+template <typename Geometry, typename Tag = typename tag<Geometry>::type>
+struct intersects_prepared
+    : not_implemented<Tag>
+{};
+
+template <typename Point>
+struct intersects_prepared<Point, point_tag>
+    : detail::prepared::intersects_point
+{};
+
+template <typename MultiPoint>
+struct intersects_prepared<MultiPoint, multi_point_tag>
+    : detail::prepared::intersects_multi_point
+{};
+
+template <typename Linestring>
+struct intersects_prepared<Linestring, linestring_tag>
+    : detail::prepared::intersects_segments<false>
+{};
+
+template <typename MultiLinestring>
+struct intersects_prepared<MultiLinestring, multi_linestring_tag>
+    : detail::prepared::intersects_segments<false>
+{};
+
+template <typename Ring>
+struct intersects_prepared<Ring, ring_tag>
+    : detail::prepared::intersects_segments<true>
+{};
+
+template <typename Polygon>
+struct intersects_prepared<Polygon, polygon_tag>
+    : detail::prepared::intersects_segments<true>
+{};
+
+template <typename MultiPolygon>
+struct intersects_prepared<MultiPolygon, multi_polygon_tag>
+    : detail::prepared::intersects_segments<true>
+{};
+
+template <typename Box>
+struct intersects_prepared<Box, box_tag>
+    : detail::prepared::intersects_box
+{};
+
+
+} // namespace dispatch
+#endif // DOXYGEN_NO_DISPATCH
+
+
+/*!
+\brief \brief_check12{is completely inside}
+\ingroup prepared
+\details Checks if the point is in the interior of the prepared geometry
+    using the index of its segments.
+\tparam Point \tparam_point
+\tparam Geometry the type of the prepared geometry
+\param point \param_point
+\param prepared the prepared geometry
+\return \return_check2{is within, prepared geometry}
+*/
+template <typename Point, typename Geometry>
+inline bool within(Point const& point, prepared<Geometry> const& prepared)
+{
+    concepts::check<Point const>();
+    BOOST_MPL_ASSERT_MSG
+        (
+            (boost::is_same<typename geometry::tag<Point>::type, point_tag>::value),
+            NOT_IMPLEMENTED_FOR_THIS_GEOMETRY_TYPE,
+            (types<Point>)
+        );
+
+    return prepared.point_code(point) > 0;
+}
+
+/*!
+\brief \brief_check12{is inside or on border}
+\ingroup prepared
+\details Checks if the point is in the interior or on the boundary of the
+    prepared geometry using the index of its segments.
+\tparam Point \tparam_point
+\tparam Geometry the type of the prepared geometry
+\param point \param_point
+\param prepared the prepared geometry
+\return \return_check2{is inside or on border, prepared geometry}
+*/
+template <typename Point, typename Geometry>
+inline bool covered_by(Point const& point, prepared<Geometry> const& prepared)
+{
+    concepts::check<Point const>();
+    BOOST_MPL_ASSERT_MSG
+        (
+            (boost::is_same<typename geometry::tag<Point>::type, point_tag>::value),
+            NOT_IMPLEMENTED_FOR_THIS_GEOMETRY_TYPE,
+            (types<Point>)
+        );
+
+    return prepared.point_code(point) >= 0;
+}
+
+/*!
+\brief \brief_check2{have at least one intersection}
+\ingroup prepared
+\details Checks if the geometry intersects the prepared geometry using the
+    index of its segments.
+\tparam Geometry1 \tparam_geometry
+\tparam Geometry2 the type of the prepared geometry
+\param geometry \param_geometry
+\param prepared the prepared geometry
+\return \return_check2{intersect (each other), prepared geometry}
+*/
+template <typename Geometry1, typename Geometry2>
+inline bool intersects(Geometry1 const& geometry, prepared<Geometry2> const& prepared)
+{
+    concepts::check<Geometry1 const>();
+
+    return dispatch::intersects_prepared<Geometry1>::apply(geometry, prepared);
+}
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_ALGORITHMS_PREPARED_HPP
@@ -0,0 +1,354 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_ALGORITHMS_UNARY_UNION_HPP
+#define BOOST_GEOMETRY_ALGORITHMS_UNARY_UNION_HPP
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <boost/core/addressof.hpp>
+#include <boost/mpl/assert.hpp>
+#include <boost/range.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/coordinate_dimension.hpp>
+#include <boost/geometry/core/is_areal.hpp>
+#include <boost/geometry/core/point_type.hpp>
+#include <boost/geometry/core/tag.hpp>
+#include <boost/geometry/core/tags.hpp>
+
+#include <boost/geometry/algorithms/convert.hpp>
+#include <boost/geometry/algorithms/detail/disjoint/box_box.hpp>
+#include <boost/geometry/algorithms/envelope.hpp>
+#include <boost/geometry/algorithms/expand.hpp>
+#include <boost/geometry/algorithms/is_empty.hpp>
+#include <boost/geometry/algorithms/union.hpp>
+
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/concepts/check.hpp>
+#include <boost/geometry/geometries/multi_polygon.hpp>
+
+#include <boost/geometry/util/parallel.hpp>
+#include <boost/geometry/util/range.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace unary_union
+{
+
+
+// The number of geometries in the leaves of the STR ordering
+static const std::size_t str_leaf_size = 16;
+
+template <typename Point>
+struct str_entry
+{
+    Point center;
+    std::size_t index;
+};
+
+template <std::size_t Dimension>
+struct str_entry_less
+{
+    template <typename Entry>
+    inline bool operator()(Entry const& l, Entry const& r) const
+    {
+        return geometry::get<Dimension>(l.center) < geometry::get<Dimension>(r.center);
+    }
+};
+
+// Sort-Tile-Recursive ordering of the geometries. The centers of the
+// envelopes are sorted by x coordinate and split into vertical slices,
+// each slice is then sorted by y coordinate. Consecutive geometries
+// are close to each other, the same way as in the leaves of the rtree
+// created with the packing algorithm.
+template <typename Box>
+inline void str_order(std::vector<Box> const& boxes,
+                      std::vector<std::size_t>& order)
+{
+    typedef typename geometry::point_type<Box>::type point_type;
+    typedef str_entry<point_type> entry_type;
+
+    std::size_t const count = boxes.size();
+
+    std::vector<entry_type> entries(count);
+    for (std::size_t i = 0 ; i < count ; ++i)
+    {
+        entries[i].index = i;
+        geometry::set<0>(entries[i].center,
+            (geometry::get<min_corner, 0>(boxes[i]) + geometry::get<max_corner, 0>(boxes[i])) / 2);
+        geometry::set<1>(entries[i].center,
+            (geometry::get<min_corner, 1>(boxes[i]) + geometry::get<max_corner, 1>(boxes[i])) / 2);
+    }
+
+    std::sort(entries.begin(), entries.end(), str_entry_less<0>());
+
+    std::size_t const leaves = (count + str_leaf_size - 1) / str_leaf_size;
+    std::size_t const slices = static_cast<std::size_t>(
+        std::ceil(std::sqrt(static_cast<double>(leaves))));
+    std::size_t const slice_size = slices > 0 ? slices * str_leaf_size : count;
+
+    for (std::size_t i = 0 ; i < count ; i += slice_size)
+    {
+        std::size_t const last = (std::min)(i + slice_size, count);
+        std::sort(entries.begin() + i, entries.begin() + last, str_entry_less<1>());
+    }
+
+    order.resize(count);
+    for (std::size_t i = 0 ; i < count ; ++i)
+    {
+        order[i] = entries[i].index;
+    }
+}
+
+// Converts one input geometry to a multi-polygon. The boxes and rings
+// are converted to a polygon which is then appended, the multi-polygons
+// are converted directly.
+template <typename Geometry, typename Tag = typename geometry::tag<Geometry>::type>
+struct to_multi_polygon
+{
+    template <typename MultiPolygon>
+    static inline void apply(Geometry const& geometry, MultiPolygon& multi_polygon)
+    {
+        typename boost::range_value<MultiPolygon>::type polygon;
+        geometry::convert(geometry, polygon);
+        range::push_back(multi_polygon, polygon);
+    }
+};
+
+template <typename Geometry>
+struct to_multi_polygon<Geometry, multi_polygon_tag>
+{
+    template <typename MultiPolygon>
+    static inline void apply(Geometry const& geometry, MultiPolygon& multi_polygon)
+    {
+        geometry::convert(geometry, multi_polygon);
+    }
+};
+
+// Merges the pairs of consecutive geometries of one level of the cascade.
+// The geometries with disjoint envelopes are moved to the result without
+// calculating the union.
+template <typename MultiPolygon, typename Box>
+struct merge_pairs
+{
+    merge_pairs(std::vector<MultiPolygon>& geometries,
+                std::vector<Box>& boxes,
+                std::vector<MultiPolygon>& merged,
+                std::vector<Box>& merged_boxes)
+        : m_geometries(boost::addressof(geometries))
+        , m_boxes(boost::addressof(boxes))
+        , m_merged(boost::addressof(merged))
+        , m_merged_boxes(boost::addressof(merged_boxes))
+    {}
+
+    inline void operator()(std::size_t i) const
+    {
+        std::size_t const first = 2 * i;
+        std::size_t const second = first + 1;
+
+        MultiPolygon& result = (*m_merged)[i];
+        Box& result_box = (*m_merged_boxes)[i];
+
+        result_box = (*m_boxes)[first];
+
+        if (second >= m_geometries->size())
+        {
+            result.swap((*m_geometries)[first]);
+            return;
+        }
+
+        geometry::expand(result_box, (*m_boxes)[second]);
+
+        if (geometry::detail::disjoint::disjoint_box_box((*m_boxes)[first],
+                                                         (*m_boxes)[second]))
+        {
+            result.swap((*m_geometries)[first]);
+            result.insert(result.end(),
+                          boost::begin((*m_geometries)[second]),
+                          boost::end((*m_geometries)[second]));
+        }
+        else
+        {
+            geometry::union_((*m_geometries)[first], (*m_geometries)[second], result);
+        }
+
+        // release the memory as soon as possible
+        MultiPolygon().swap((*m_geometries)[first]);
+        MultiPolygon().swap((*m_geometries)[second]);
+    }
+
+    std::vector<MultiPolygon>* m_geometries;
+    std::vector<Box>* m_boxes;
+    std::vector<MultiPolygon>* m_merged;
+    std::vector<Box>* m_merged_boxes;
+};
+
+template <typename Range, typename Collection>
+inline void apply(Range const& range, Collection& output_collection,
+                  std::size_t threads)
+{
+    typedef typename boost::range_value<Range>::type geometry_in;
+    typedef typename boost::range_value<Collection>::type polygon_type;
+    typedef model::multi_polygon<polygon_type> multi_polygon_type;
+    typedef typename geometry::point_type<polygon_type>::type point_type;
+    typedef model::box<point_type> box_type;
+
+    BOOST_MPL_ASSERT_MSG
+        (
+            (geometry::is_areal<geometry_in>::value
+             && boost::is_same
+                 <
+                     typename geometry::tag<polygon_type>::type,
+                     polygon_tag
+                 >::value),
+            UNARY_UNION_IS_IMPLEMENTED_ONLY_FOR_AREAL_GEOMETRIES_AND_POLYGONS_OUTPUT,
+            (types<geometry_in, polygon_type>)
+        );
+
+    // The STR ordering and the conversion of boxes use only the first
+    // two coordinates
+    BOOST_MPL_ASSERT_MSG
+        (
+            (geometry::dimension<geometry_in>::value == 2),
+            UNARY_UNION_IS_IMPLEMENTED_ONLY_FOR_2D_GEOMETRIES,
+            (types<geometry_in>)
+        );
+
+    std::vector<multi_polygon_type> geometries;
+    std::vector<box_type> boxes;
+    {
+        std::vector<multi_polygon_type> input;
+        std::vector<box_type> input_boxes;
+        input.reserve(boost::size(range));
+        input_boxes.reserve(boost::size(range));
+
+        for (typename boost::range_iterator<Range const>::type it = boost::begin(range);
+             it != boost::end(range); ++it)
+        {
+            if (geometry::is_empty(*it))
+            {
+                continue;
+            }
+
+            input.push_back(multi_polygon_type());
+            to_multi_polygon<geometry_in>::apply(*it, input.back());
+
+            box_type box;
+            geometry::envelope(input.back(), box);
+            input_boxes.push_back(box);
+        }
+
+        std::vector<std::size_t> order;
+        str_order(input_boxes, order);
+
+        geometries.resize(input.size());
+        boxes.resize(input.size());
+        for (std::size_t i = 0 ; i < order.size() ; ++i)
+        {
+            geometries[i].swap(input[order[i]]);
+            boxes[i] = input_boxes[order[i]];
+        }
+    }
+
+    // Cascade of pairwise unions. At each level consecutive geometries,
+    // close to each other in the STR order, are merged so the number of
+    // geometries is halved and the intermediate results stay small.
+    while (geometries.size() > 1)
+    {
+        std::size_t const count = (geometries.size() + 1) / 2;
+
+        std::vector<multi_polygon_type> merged(count);
+        std::vector<box_type> merged_boxes(count);
+
+        merge_pairs<multi_polygon_type, box_type> merge(geometries, boxes,
+                                                        merged, merged_boxes);
+        detail::parallel::for_each_index(count, merge, threads);
+
+        geometries.swap(merged);
+        boxes.swap(merged_boxes);
+    }
+
+    if (! geometries.empty())
+    {
+        for (typename boost::range_iterator<multi_polygon_type>::type
+                it = boost::begin(geometries.front());
+             it != boost::end(geometries.front()); ++it)
+        {
+            range::push_back(output_collection, *it);
+        }
+    }
+}
+
+
+}} // namespace detail::unary_union
+#endif // DOXYGEN_NO_DETAIL
+
+
+/*!
+\brief Combines all geometries of a range
+\ingroup union
+\details The union of all areal geometries of a range is calculated as
+    a cascade of pairwise unions of the geometries ordered with the
+    Sort-Tile-Recursive algorithm. This is considerably faster than
+    the union of each geometry with the accumulated result.
+\tparam Range range of two-dimensional areal geometries (polygons,
+    multi-polygons, rings or boxes), e.g. std::vector<Polygon>
+\tparam Collection output collection, either a multi-polygon,
+    or a std::vector<Polygon> / std::deque<Polygon> etc
+\param range the range of geometries
+\param output_collection the output collection
+*/
+template <typename Range, typename Collection>
+inline void unary_union(Range const& range, Collection& output_collection)
+{
+    concepts::check<typename boost::range_value<Range>::type const>();
+    concepts::check<typename boost::range_value<Collection>::type>();
+
+    detail::unary_union::apply(range, output_collection, 1);
+}
+
+/*!
+\brief Combines all geometries of a range in parallel
+\ingroup union
+\details The union of all areal geometries of a range is calculated as
+    a cascade of pairwise unions of the geometries ordered with the
+    Sort-Tile-Recursive algorithm. The unions of each level of the
+    cascade are calculated in parallel. The result is the same as the
+    one of the sequential version.
+\tparam Range range of two-dimensional areal geometries (polygons,
+    multi-polygons, rings or boxes), e.g. std::vector<Polygon>
+\tparam Collection output collection, either a multi-polygon,
+    or a std::vector<Polygon> / std::deque<Polygon> etc
+\param policy the execution policy defining the number of threads
+\param range the range of geometries
+\param output_collection the output collection
+*/
+template <typename Range, typename Collection>
+inline void unary_union(execution::parallel_policy const& policy,
+                        Range const& range, Collection& output_collection)
+{
+    concepts::check<typename boost::range_value<Range>::type const>();
+    concepts::check<typename boost::range_value<Collection>::type>();
+
+    detail::unary_union::apply(range, output_collection, policy.threads());
+}
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_ALGORITHMS_UNARY_UNION_HPP
@@ -1,6 +1,7 @@
 // Boost.Geometry (aka GGL, Generic Geometry Library)
 
 // Copyright (c) 2007-2014 Barend Gehrels, Amsterdam, the Netherlands.
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
 
 // This file was modified by Oracle on 2014, 2017.
 // Modifications copyright (c) 2014-2017 Oracle and/or its affiliates.
@@ -291,6 +292,47 @@ struct union_
                     range::back_inserter(output_collection),
                     strategy_type());
     }
+
+    // The turns are calculated and the parents of rings are assigned in
+    // parallel, only areal geometries are supported
+    template
+    <
+        typename Geometry1,
+        typename Geometry2,
+        typename RobustPolicy,
+        typename Collection
+    >
+    static inline void apply(Geometry1 const& geometry1,
+                             Geometry2 const& geometry2,
+                             RobustPolicy const& robust_policy,
+                             Collection & output_collection,
+                             execution::parallel_policy const& policy)
+    {
+        detail::overlay::overlay_areal_parallel
+            <
+                overlay_union, false
+            >(geometry1, geometry2, robust_policy, output_collection, policy);
+    }
+
+    template
+    <
+        typename Geometry1,
+        typename Geometry2,
+        typename RobustPolicy,
+        typename Collection
+    >
+    static inline void apply(Geometry1 const& geometry1,
+                             Geometry2 const& geometry2,
+                             RobustPolicy const& robust_policy,
+                             Collection & output_collection,
+                             detail::overlay::timed_parallel_policy const& policy)
+    {
+        detail::overlay::overlay_areal_parallel
+            <
+                overlay_union, false
+            >(geometry1, geometry2, robust_policy, output_collection,
+              policy.policy, policy.timings);
+    }
 };
 
 } // resolve_strategy
@@ -473,6 +515,10 @@ struct union_<variant<BOOST_VARIANT_ENUM_PARAMS(T1)>, variant<BOOST_VARIANT_ENUM
 \param geometry2 \param_geometry
 \param output_collection the output collection
 \param strategy \param_strategy{union_}
+\note If execution::parallel_policy is passed instead of the strategy the
+    turns are calculated and the parents of rings are assigned in parallel.
+    The result is the same as the one of the sequential version. Only areal
+    geometries are supported.
 \note Called union_ because union is a reserved word.
 
 \qbk{distinguish,with strategy}
@@ -498,6 +544,47 @@ inline void union_(Geometry1 const& geometry1,
 }
 
 
+/*!
+\brief Combines two geometries which each other, in parallel
+\ingroup union
+\details \details_calc2{union, spatial set theoretic union}.
+    The turns are calculated and the parents of rings are assigned in
+    parallel. The durations of the phases of the overlay are added to timings.
+\tparam Geometry1 \tparam_geometry
+\tparam Geometry2 \tparam_geometry
+\tparam Collection output collection of polygons, either a multi_polygon,
+    or a std::vector<Polygon> / std::deque<Polygon> etc
+\param geometry1 \param_geometry
+\param geometry2 \param_geometry
+\param output_collection the output collection
+\param policy the parallel execution policy
+\param timings the durations of the phases of the overlay
+\note Only areal geometries are supported.
+
+\qbk{distinguish,with parallel policy and timings}
+\qbk{[include reference/algorithms/union.qbk]}
+*/
+template
+<
+    typename Geometry1,
+    typename Geometry2,
+    typename Collection
+>
+inline void union_(Geometry1 const& geometry1,
+                   Geometry2 const& geometry2,
+                   Collection& output_collection,
+                   execution::parallel_policy const& policy,
+                   overlay_timings& timings)
+{
+    resolve_variant::union_
+        <
+            Geometry1,
+            Geometry2
+        >::apply(geometry1, geometry2, output_collection,
+                 detail::overlay::timed_parallel_policy(policy, timings));
+}
+
+
 /*!
 \brief Combines two geometries which each other
 \ingroup union
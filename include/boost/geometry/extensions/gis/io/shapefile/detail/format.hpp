@@ -0,0 +1,176 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_EXT_GIS_IO_SHAPEFILE_DETAIL_FORMAT_HPP
+#define BOOST_GEOMETRY_EXT_GIS_IO_SHAPEFILE_DETAIL_FORMAT_HPP
+
+
+#include <cstddef>
+
+#include <boost/cstdint.hpp>
+
+#include <boost/geometry/core/exception.hpp>
+
+#include <boost/geometry/io/wkb/detail/endian.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+/*!
+\brief Read Shapefile Exception
+\ingroup core
+\details The read_shapefile_exception is thrown when the bytes of a
+    shapefile are not valid
+ */
+class read_shapefile_exception : public geometry::exception
+{
+public:
+
+    inline read_shapefile_exception() {}
+
+    virtual char const* what() const throw()
+    {
+        return "Boost.Geometry Read Shapefile exception";
+    }
+};
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace shapefile
+{
+
+
+struct shape_type
+{
+    enum enum_t
+    {
+        null_shape  = 0,
+        point       = 1,
+        polyline    = 3,
+        polygon     = 5,
+        multipoint  = 8,
+        pointz      = 11,
+        polylinez   = 13,
+        polygonz    = 15,
+        multipointz = 18,
+        pointm      = 21,
+        polylinem   = 23,
+        polygonm    = 25,
+        multipointm = 28,
+        multipatch  = 31
+    };
+};
+
+// The XY shape having the same layout as a shape with Z or M, Z and M
+// are stored after the XY coordinates
+inline int base_shape_type(boost::int32_t type)
+{
+    switch (type)
+    {
+    case shape_type::pointz:
+    case shape_type::pointm:
+        return shape_type::point;
+    case shape_type::polylinez:
+    case shape_type::polylinem:
+        return shape_type::polyline;
+    case shape_type::polygonz:
+    case shape_type::polygonm:
+        return shape_type::polygon;
+    case shape_type::multipointz:
+    case shape_type::multipointm:
+        return shape_type::multipoint;
+    default:
+        return type;
+    }
+}
+
+
+std::size_t const file_header_size = 100;
+std::size_t const record_header_size = 8;
+std::size_t const index_record_size = 8;
+boost::int32_t const file_code = 9994;
+
+
+// The file and record headers store big-endian, the rest of the file
+// little-endian values
+inline boost::int32_t load_big_int32(unsigned char const* p)
+{
+    return static_cast<boost::int32_t>(wkb::load_uint32(p,
+        wkb::native_byte_order() != wkb::byte_order_type::xdr));
+}
+
+inline boost::int32_t load_little_int32(unsigned char const* p)
+{
+    return static_cast<boost::int32_t>(wkb::load_uint32(p,
+        wkb::native_byte_order() != wkb::byte_order_type::ndr));
+}
+
+inline double load_little_double(unsigned char const* p)
+{
+    return wkb::native_byte_order() == wkb::byte_order_type::ndr
+         ? wkb::load_double<false>(p)
+         : wkb::load_double<true>(p);
+}
+
+
+// Checks the header of a .shp or .shx file and returns the end of the data
+inline unsigned char const* check_file_header(unsigned char const* first,
+                                              unsigned char const* last)
+{
+    if (static_cast<std::size_t>(last - first) < file_header_size
+     || load_big_int32(first) != file_code)
+    {
+        throw read_shapefile_exception();
+    }
+
+    // The length is stored in 16-bit words
+    boost::int32_t const length = load_big_int32(first + 24);
+    if (length < 0
+     || static_cast<std::size_t>(length) * 2 < file_header_size
+     || static_cast<std::size_t>(length) * 2 > static_cast<std::size_t>(last - first))
+    {
+        throw read_shapefile_exception();
+    }
+
+    return first + static_cast<std::size_t>(length) * 2;
+}
+
+// Reads the header of the record at the position, returns the end of the record
+inline unsigned char const* read_record_header(unsigned char const* it,
+                                               unsigned char const* end,
+                                               boost::int32_t& number,
+                                               std::size_t& content_size)
+{
+    if (static_cast<std::size_t>(end - it) < record_header_size)
+    {
+        throw read_shapefile_exception();
+    }
+
+    number = load_big_int32(it);
+    boost::int32_t const length = load_big_int32(it + 4);
+    if (length < 0
+     || static_cast<std::size_t>(length) * 2
+            > static_cast<std::size_t>(end - it) - record_header_size)
+    {
+        throw read_shapefile_exception();
+    }
+
+    content_size = static_cast<std::size_t>(length) * 2;
+    return it + record_header_size + content_size;
+}
+
+
+}} // namespace detail::shapefile
+#endif // DOXYGEN_NO_DETAIL
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_EXT_GIS_IO_SHAPEFILE_DETAIL_FORMAT_HPP
@@ -0,0 +1,90 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_EXT_GIS_IO_SHAPEFILE_MAPPED_SHAPEFILE_HPP
+#define BOOST_GEOMETRY_EXT_GIS_IO_SHAPEFILE_MAPPED_SHAPEFILE_HPP
+
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <boost/geometry/extensions/gis/io/shapefile/shp_view.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+/*!
+\brief Shapefile stored in the memory-mapped file
+\details The .shp file, and optionally the .shx file, are mapped into memory.
+    The records are loaded lazily by the operating system when they are
+    accessed and are read without copying the bytes.
+\tparam Point point type the coordinates are converted to
+*/
+template <typename Point>
+class mapped_shapefile
+    : public shp_view<Point>
+{
+    typedef shp_view<Point> view_type;
+
+    mapped_shapefile(mapped_shapefile const&);
+    mapped_shapefile & operator=(mapped_shapefile const&);
+
+public:
+    /*!
+    \brief Maps the .shp file
+    \param filename the name of the .shp file
+    \note Throws boost::interprocess::interprocess_exception if the file
+        can't be mapped and read_shapefile_exception if it is not valid
+    */
+    explicit mapped_shapefile(const char * filename)
+        : m_mapping(filename, boost::interprocess::read_only)
+        , m_region(m_mapping, boost::interprocess::read_only)
+    {
+        unsigned char const* const first = bytes(m_region);
+        static_cast<view_type&>(*this) = view_type(first, first + m_region.get_size());
+    }
+
+    /*!
+    \brief Maps the .shp and .shx files, allowing to access the records
+        by index
+    \param filename the name of the .shp file
+    \param index_filename the name of the .shx file
+    \note Throws boost::interprocess::interprocess_exception if the files
+        can't be mapped and read_shapefile_exception if they are not valid
+    */
+    mapped_shapefile(const char * filename, const char * index_filename)
+        : m_mapping(filename, boost::interprocess::read_only)
+        , m_region(m_mapping, boost::interprocess::read_only)
+        , m_index_mapping(index_filename, boost::interprocess::read_only)
+        , m_index_region(m_index_mapping, boost::interprocess::read_only)
+    {
+        unsigned char const* const first = bytes(m_region);
+        unsigned char const* const index_first = bytes(m_index_region);
+        static_cast<view_type&>(*this) = view_type(first, first + m_region.get_size(),
+            index_first, index_first + m_index_region.get_size());
+    }
+
+private:
+    static inline unsigned char const* bytes(boost::interprocess::mapped_region const& region)
+    {
+        return static_cast<unsigned char const*>(region.get_address());
+    }
+
+    boost::interprocess::file_mapping m_mapping;
+    boost::interprocess::mapped_region m_region;
+    boost::interprocess::file_mapping m_index_mapping;
+    boost::interprocess::mapped_region m_index_region;
+};
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_EXT_GIS_IO_SHAPEFILE_MAPPED_SHAPEFILE_HPP
@@ -0,0 +1,499 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_EXT_GIS_IO_SHAPEFILE_SHP_VIEW_HPP
+#define BOOST_GEOMETRY_EXT_GIS_IO_SHAPEFILE_SHP_VIEW_HPP
+
+
+#include <cstddef>
+#include <utility>
+
+#include <boost/cstdint.hpp>
+#include <boost/iterator/iterator_categories.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/range/iterator_range.hpp>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/coordinate_type.hpp>
+
+#include <boost/geometry/io/wkb/view.hpp>
+
+#include <boost/geometry/extensions/gis/io/shapefile/detail/format.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+/*!
+\brief Record of a shapefile, used without copying the bytes
+\details The points of the shapes are exposed as views converting the
+    coordinates when the iterators are dereferenced, the same way as the
+    views of WKB since the X and Y coordinates are stored the same way.
+    Z and M coordinates are not read. The bytes have to outlive the record.
+\tparam Point point type the coordinates are converted to
+*/
+template <typename Point>
+class shp_record
+{
+public:
+    typedef wkb_linestring_view<Point> part_type;
+    typedef wkb_ring_view<Point> ring_type;
+
+    inline shp_record()
+        : m_number(0)
+        , m_type(detail::shapefile::shape_type::null_shape)
+        , m_content(NULL)
+        , m_num_parts(0)
+        , m_num_points(0)
+        , m_parts(NULL)
+        , m_points(NULL)
+    {}
+
+    /*!
+    \brief Constructs the record from its content
+    \note Throws read_shapefile_exception if the content is not valid
+    */
+    inline shp_record(boost::int32_t number, unsigned char const* content,
+                      std::size_t size)
+        : m_number(number)
+        , m_type(detail::shapefile::shape_type::null_shape)
+        , m_content(content)
+        , m_num_parts(0)
+        , m_num_points(0)
+        , m_parts(NULL)
+        , m_points(NULL)
+    {
+        namespace shp = detail::shapefile;
+
+        check(size >= 4);
+        m_type = shp::load_little_int32(content);
+
+        switch (shp::base_shape_type(m_type))
+        {
+        case shp::shape_type::null_shape:
+            break;
+        case shp::shape_type::point:
+            check(size >= 20);
+            m_num_points = 1;
+            m_points = content + 4;
+            break;
+        case shp::shape_type::multipoint:
+            check(size >= 40);
+            m_num_points = count(content + 36, size - 40, 16);
+            m_points = content + 40;
+            break;
+        case shp::shape_type::polyline:
+        case shp::shape_type::polygon:
+        case shp::shape_type::multipatch:
+            {
+                // MultiPatch stores the array of the types of the parts
+                // after the array of the parts
+                std::size_t const part_size
+                    = m_type == shp::shape_type::multipatch ? 8 : 4;
+                check(size >= 44);
+                m_num_parts = count(content + 36, size - 44, part_size);
+                m_num_points = count(content + 40,
+                                     size - 44 - m_num_parts * part_size, 16);
+                m_parts = content + 44;
+                m_points = m_parts + m_num_parts * part_size;
+            }
+            break;
+        default:
+            throw read_shapefile_exception();
+        }
+    }
+
+    //! The number of the record stored in the file, starting from 1
+    inline boost::int32_t number() const { return m_number; }
+
+    //! The type of the shape as stored in the file
+    inline boost::int32_t type() const { return m_type; }
+
+    inline bool is_null() const
+    {
+        return m_type == detail::shapefile::shape_type::null_shape;
+    }
+
+    //! The number of parts of a polyline, polygon or multipatch, 0 for other shapes
+    inline std::size_t num_parts() const { return m_num_parts; }
+
+    //! All of the points of the shape
+    inline part_type points() const
+    {
+        return part_type(points_view(m_points, m_num_points));
+    }
+
+    /*!
+    \brief The points of a part of a polyline, polygon or multipatch
+    \note Throws read_shapefile_exception if the part is not valid
+    */
+    inline part_type part(std::size_t index) const
+    {
+        namespace shp = detail::shapefile;
+
+        // the types of the parts of MultiPatch are stored in a separate
+        // array after the parts so the indexes are stored the same way
+        check(index < m_num_parts);
+        boost::int32_t const first
+            = shp::load_little_int32(m_parts + index * 4);
+        boost::int32_t const last = index + 1 < m_num_parts
+            ? shp::load_little_int32(m_parts + (index + 1) * 4)
+            : static_cast<boost::int32_t>(m_num_points);
+        check(0 <= first && first <= last
+           && static_cast<std::size_t>(last) <= m_num_points);
+
+        return part_type(points_view(m_points + first * 16,
+                                     static_cast<std::size_t>(last - first)));
+    }
+
+    //! The ring of a polygon, the outer rings are stored clockwise
+    inline ring_type ring(std::size_t index) const
+    {
+        return ring_type(part(index));
+    }
+
+    /*!
+    \brief Assigns the bounding box stored in the record to a box, or the
+        point if the shape is a point
+    \note The box is not changed if the shape is null
+    */
+    template <typename Box>
+    inline void envelope(Box& box) const
+    {
+        namespace shp = detail::shapefile;
+
+        int const base_type = shp::base_shape_type(m_type);
+        if (base_type == shp::shape_type::null_shape)
+        {
+            return;
+        }
+
+        unsigned char const* const p = base_type == shp::shape_type::point
+                                     ? m_points : m_content + 4;
+        std::size_t const max_offset = base_type == shp::shape_type::point
+                                     ? 0 : 16;
+
+        typedef typename coordinate_type<Box>::type coordinate_type;
+        set<min_corner, 0>(box, static_cast<coordinate_type>(shp::load_little_double(p)));
+        set<min_corner, 1>(box, static_cast<coordinate_type>(shp::load_little_double(p + 8)));
+        set<max_corner, 0>(box, static_cast<coordinate_type>(shp::load_little_double(p + max_offset)));
+        set<max_corner, 1>(box, static_cast<coordinate_type>(shp::load_little_double(p + max_offset + 8)));
+    }
+
+private:
+    static inline void check(bool condition)
+    {
+        if (! condition)
+        {
+            throw read_shapefile_exception();
+        }
+    }
+
+    // The number of elements checked against the remaining bytes
+    static inline std::size_t count(unsigned char const* p,
+                                    std::size_t remaining,
+                                    std::size_t element_size)
+    {
+        boost::int32_t const n = detail::shapefile::load_little_int32(p);
+        check(n >= 0 && static_cast<std::size_t>(n) <= remaining / element_size);
+        return static_cast<std::size_t>(n);
+    }
+
+    static inline detail::wkb::points_view<Point>
+        points_view(unsigned char const* first, std::size_t count)
+    {
+        detail::wkb::point_layout layout;
+        layout.swap = detail::wkb::native_byte_order()
+                   != detail::wkb::byte_order_type::ndr;
+        return detail::wkb::points_view<Point>(first, count, layout);
+    }
+
+    boost::int32_t m_number;
+    boost::int32_t m_type;
+    unsigned char const* m_content;
+    std::size_t m_num_parts;
+    std::size_t m_num_points;
+    unsigned char const* m_parts;
+    unsigned char const* m_points;
+};
+
+
+/*!
+\brief Forward iterator over the records of a shapefile
+\tparam Point point type the coordinates are converted to
+*/
+template <typename Point>
+class shp_record_iterator
+    : public boost::iterator_facade
+        <
+            shp_record_iterator<Point>,
+            shp_record<Point> const,
+            boost::forward_traversal_tag,
+            shp_record<Point>
+        >
+{
+public:
+    inline shp_record_iterator()
+        : m_position(NULL)
+        , m_end(NULL)
+    {}
+
+    inline shp_record_iterator(unsigned char const* position,
+                               unsigned char const* end)
+        : m_position(position)
+        , m_end(end)
+    {}
+
+private:
+    friend class boost::iterator_core_access;
+
+    inline shp_record<Point> dereference() const
+    {
+        boost::int32_t number = 0;
+        std::size_t size = 0;
+        detail::shapefile::read_record_header(m_position, m_end, number, size);
+        return shp_record<Point>(number,
+            m_position + detail::shapefile::record_header_size, size);
+    }
+
+    inline bool equal(shp_record_iterator const& other) const
+    {
+        return m_position == other.m_position;
+    }
+
+    inline void increment()
+    {
+        boost::int32_t number = 0;
+        std::size_t size = 0;
+        m_position = detail::shapefile::read_record_header(m_position, m_end,
+                                                           number, size);
+    }
+
+    unsigned char const* m_position;
+    unsigned char const* m_end;
+};
+
+
+/*!
+\brief Shapefile (.shp) stored in memory, used without copying the bytes
+\details The records are read in place, e.g. from a memory-mapped file. If the
+    index (.shx) is passed too, the records can also be accessed by index.
+\tparam Point point type the coordinates are converted to
+*/
+template <typename Point>
+class shp_view
+{
+public:
+    typedef shp_record<Point> record_type;
+    typedef shp_record_iterator<Point> iterator;
+    typedef shp_record_iterator<Point> const_iterator;
+
+    inline shp_view()
+        : m_first(NULL)
+        , m_last(NULL)
+        , m_index_first(NULL)
+        , m_index_last(NULL)
+    {}
+
+    /*!
+    \brief Constructs the view of the bytes of a .shp file
+    \note Throws read_shapefile_exception if the header is not valid
+    */
+    template <typename ByteType>
+    inline shp_view(ByteType const* first, ByteType const* last)
+        : m_index_first(NULL)
+        , m_index_last(NULL)
+    {
+        assign(detail::wkb::to_bytes(first), detail::wkb::to_bytes(last));
+    }
+
+    /*!
+    \brief Constructs the view of the bytes of a .shp and .shx file
+    \note Throws read_shapefile_exception if the headers are not valid
+    */
+    template <typename ByteType>
+    inline shp_view(ByteType const* first, ByteType const* last,
+                    ByteType const* index_first, ByteType const* index_last)
+    {
+        assign(detail::wkb::to_bytes(first), detail::wkb::to_bytes(last));
+
+        m_index_first = detail::wkb::to_bytes(index_first);
+        m_index_last = detail::shapefile::check_file_header(m_index_first,
+                            detail::wkb::to_bytes(index_last));
+        m_index_first += detail::shapefile::file_header_size;
+    }
+
+    //! The type of the shapes as stored in the header of the file
+    inline boost::int32_t type() const
+    {
+        return m_first == NULL ? 0
+             : detail::shapefile::load_little_int32(m_first - 68);
+    }
+
+    //! Assigns the bounding box of all shapes stored in the header
+    template <typename Box>
+    inline void envelope(Box& box) const
+    {
+        typedef typename coordinate_type<Box>::type coordinate_type;
+        unsigned char const* const p = m_first - 64;
+        set<min_corner, 0>(box, static_cast<coordinate_type>(detail::shapefile::load_little_double(p)));
+        set<min_corner, 1>(box, static_cast<coordinate_type>(detail::shapefile::load_little_double(p + 8)));
+        set<max_corner, 0>(box, static_cast<coordinate_type>(detail::shapefile::load_little_double(p + 16)));
+        set<max_corner, 1>(box, static_cast<coordinate_type>(detail::shapefile::load_little_double(p + 24)));
+    }
+
+    inline const_iterator begin() const { return const_iterator(m_first, m_last); }
+    inline const_iterator end() const { return const_iterator(m_last, m_last); }
+
+    //! True if the records can be accessed by index
+    inline bool has_index() const { return m_index_first != NULL; }
+
+    //! The number of records stored in the index
+    inline std::size_t size() const
+    {
+        return static_cast<std::size_t>(m_index_last - m_index_first)
+             / detail::shapefile::index_record_size;
+    }
+
+    /*!
+    \brief The record at the index, starting from 0
+    \note Throws read_shapefile_exception if there is no index or the record
+        is not valid
+    */
+    inline record_type operator[](std::size_t index) const
+    {
+        namespace shp = detail::shapefile;
+
+        if (! has_index() || index >= size())
+        {
+            throw read_shapefile_exception();
+        }
+
+        // The offset is stored in 16-bit words from the beginning of the file
+        boost::int32_t const offset = shp::load_big_int32(
+            m_index_first + index * shp::index_record_size);
+        if (offset < static_cast<boost::int32_t>(shp::file_header_size) / 2
+         || static_cast<std::size_t>(offset) * 2 - shp::file_header_size
+                > static_cast<std::size_t>(m_last - m_first))
+        {
+            throw read_shapefile_exception();
+        }
+
+        unsigned char const* const position
+            = m_first + (static_cast<std::size_t>(offset) * 2 - shp::file_header_size);
+        return *const_iterator(position, m_last);
+    }
+
+private:
+    inline void assign(unsigned char const* first, unsigned char const* last)
+    {
+        m_last = detail::shapefile::check_file_header(first, last);
+        m_first = first + detail::shapefile::file_header_size;
+    }
+
+    unsigned char const* m_first;
+    unsigned char const* m_last;
+    unsigned char const* m_index_first;
+    unsigned char const* m_index_last;
+};
+
+
+/*!
+\brief Forward iterator over the bounding boxes of the non-null shapes
+    of a shapefile, paired with the indexes of the records
+\details The value type is std::pair<Box, std::size_t> which can be stored
+    in the rtree. Only the headers of the records are read.
+\tparam Box the type of the bounding boxes
+\tparam Point point type of the records
+*/
+template <typename Box, typename Point>
+class shp_envelope_iterator
+    : public boost::iterator_facade
+        <
+            shp_envelope_iterator<Box, Point>,
+            std::pair<Box, std::size_t> const,
+            boost::forward_traversal_tag,
+            std::pair<Box, std::size_t>
+        >
+{
+public:
+    inline shp_envelope_iterator()
+        : m_index(0)
+    {}
+
+    inline shp_envelope_iterator(shp_record_iterator<Point> const& it,
+                                 shp_record_iterator<Point> const& end)
+        : m_it(it)
+        , m_end(end)
+        , m_index(0)
+    {
+        skip_null();
+    }
+
+private:
+    friend class boost::iterator_core_access;
+
+    inline std::pair<Box, std::size_t> dereference() const
+    {
+        std::pair<Box, std::size_t> result;
+        (*m_it).envelope(result.first);
+        result.second = m_index;
+        return result;
+    }
+
+    inline bool equal(shp_envelope_iterator const& other) const
+    {
+        return m_it == other.m_it;
+    }
+
+    inline void increment()
+    {
+        ++m_it;
+        ++m_index;
+        skip_null();
+    }
+
+    inline void skip_null()
+    {
+        while (m_it != m_end && (*m_it).is_null())
+        {
+            ++m_it;
+            ++m_index;
+        }
+    }
+
+    shp_record_iterator<Point> m_it;
+    shp_record_iterator<Point> m_end;
+    std::size_t m_index;
+};
+
+
+/*!
+\brief Returns the range of the bounding boxes of the shapes paired with
+    the indexes of the records, e.g. to construct the rtree using packing
+    algorithm without reading the shapes into memory
+\tparam Box the type of the bounding boxes
+\tparam Point point type of the records
+\param shp the view of the shapefile
+*/
+template <typename Box, typename Point>
+inline boost::iterator_range<shp_envelope_iterator<Box, Point> >
+    shp_envelopes(shp_view<Point> const& shp)
+{
+    typedef shp_envelope_iterator<Box, Point> iterator_type;
+    return boost::iterator_range<iterator_type>(
+                iterator_type(shp.begin(), shp.end()),
+                iterator_type(shp.end(), shp.end()));
+}
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_EXT_GIS_IO_SHAPEFILE_SHP_VIEW_HPP
@@ -0,0 +1,543 @@
+// Boost.Geometry Index
+//
+// R-tree allowing concurrent, non-blocking queries
+//
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_CONCURRENT_RTREE_HPP
+#define BOOST_GEOMETRY_INDEX_CONCURRENT_RTREE_HPP
+
+#include <iterator>
+#include <vector>
+
+#include <boost/config.hpp>
+
+// The container is synchronized with C++11 atomics, mutexes and threads
+#if defined(BOOST_NO_CXX11_HDR_THREAD) \
+ || defined(BOOST_NO_CXX11_HDR_MUTEX) \
+ || defined(BOOST_NO_CXX11_HDR_ATOMIC) \
+ || defined(BOOST_NO_CXX11_HDR_FUNCTIONAL)
+#error "concurrent_rtree requires C++11 threading support"
+#endif
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <boost/geometry/index/rtree.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree {
+
+// Counter of readers using one of the versions of the concurrent_rtree.
+// It's split into several counters placed in separate cache lines
+// to decrease the contention.
+class read_indicator
+{
+    static const std::size_t counters_count = 16;
+    static const std::size_t padding_size = 64;
+
+    struct counter
+    {
+        counter() : value(0) {}
+
+        std::atomic<std::size_t> value;
+        char padding[padding_size - sizeof(std::atomic<std::size_t>)];
+    };
+
+    read_indicator(read_indicator const&);
+    read_indicator & operator=(read_indicator const&);
+
+public:
+    read_indicator() {}
+
+    static std::size_t current_slot()
+    {
+        return std::hash<std::thread::id>()(std::this_thread::get_id()) % counters_count;
+    }
+
+    void arrive(std::size_t slot)
+    {
+        m_counters[slot].value.fetch_add(1);
+    }
+
+    void depart(std::size_t slot)
+    {
+        m_counters[slot].value.fetch_sub(1);
+    }
+
+    bool is_empty() const
+    {
+        for ( std::size_t i = 0 ; i < counters_count ; ++i )
+        {
+            if ( m_counters[i].value.load() != 0 )
+                return false;
+        }
+        return true;
+    }
+
+    void wait_until_empty() const
+    {
+        while ( !is_empty() )
+            std::this_thread::yield();
+    }
+
+private:
+    counter m_counters[counters_count];
+};
+
+}} // namespace detail::rtree
+
+/*!
+\brief The R-tree spatial index allowing concurrent queries and modifications.
+
+This container stores two instances of the rtree. Readers always access
+the instance which is not currently modified so they never wait for
+writers nor for other readers. A writer modifies the inactive instance,
+atomically publishes it, waits until the readers of the previous instance
+finish and then repeats the same modification on the other instance
+(Left-Right concurrency control). Writers are serialized.
+
+The cost of this approach is that twice as much memory is used and modifications
+are performed twice. Furthermore, a writer has to wait for the readers
+which started before the modification was published.
+
+\tparam Value           The type of objects stored in the container.
+\tparam Parameters      Compile-time parameters.
+\tparam IndexableGetter The function object extracting Indexable from Value.
+\tparam EqualTo         The function object comparing objects of type Value.
+\tparam Allocator       The allocator used to allocate/deallocate memory,
+                        construct/destroy nodes and Values.
+*/
+template
+<
+    typename Value,
+    typename Parameters,
+    typename IndexableGetter = index::indexable<Value>,
+    typename EqualTo = index::equal_to<Value>,
+    typename Allocator = boost::container::new_allocator<Value>
+>
+class concurrent_rtree
+{
+    concurrent_rtree(concurrent_rtree const&);
+    concurrent_rtree & operator=(concurrent_rtree const&);
+
+public:
+    /*! \brief The type of the rtree instances. */
+    typedef index::rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> rtree_type;
+
+    /*! \brief The type of Value stored in the container. */
+    typedef typename rtree_type::value_type value_type;
+    /*! \brief R-tree parameters type. */
+    typedef typename rtree_type::parameters_type parameters_type;
+    /*! \brief The function object extracting Indexable from Value. */
+    typedef typename rtree_type::indexable_getter indexable_getter;
+    /*! \brief The function object comparing objects of type Value. */
+    typedef typename rtree_type::value_equal value_equal;
+    /*! \brief The type of allocator used by the container. */
+    typedef typename rtree_type::allocator_type allocator_type;
+    /*! \brief The Indexable type to which Value is translated. */
+    typedef typename rtree_type::indexable_type indexable_type;
+    /*! \brief The Box type used by the R-tree. */
+    typedef typename rtree_type::bounds_type bounds_type;
+    /*! \brief Unsigned integral type used by the container. */
+    typedef typename rtree_type::size_type size_type;
+
+    /*!
+    \brief The read access to the current state of the container.
+
+    As long as an object of this type exists the rtree it refers to
+    is not modified. So e.g. query iterators may be safely used.
+    Modifications of the container wait until all snapshots
+    referring to the previous state are destroyed.
+
+    \warning
+    The container must not be modified in a thread owning a snapshot
+    because the modification would wait forever.
+    */
+    class const_snapshot
+    {
+        const_snapshot & operator=(const_snapshot const&);
+
+    public:
+        const_snapshot(const_snapshot const& other)
+            : m_owner(other.m_owner)
+            , m_version(other.m_version)
+            , m_slot(other.m_slot)
+            , m_tree(other.m_tree)
+        {
+            // the version can't be switched while other is alive
+            m_owner->m_read_indicators[m_version].arrive(m_slot);
+        }
+
+        ~const_snapshot()
+        {
+            m_owner->m_read_indicators[m_version].depart(m_slot);
+        }
+
+        rtree_type const& operator*() const { return *m_tree; }
+        rtree_type const* operator->() const { return m_tree; }
+
+    private:
+        friend class concurrent_rtree;
+
+        explicit const_snapshot(concurrent_rtree const* owner)
+            : m_owner(owner)
+            , m_version(owner->m_version_index.load())
+            , m_slot(detail::rtree::read_indicator::current_slot())
+        {
+            m_owner->m_read_indicators[m_version].arrive(m_slot);
+            m_tree = &m_owner->tree(m_owner->m_active_index.load());
+        }
+
+        concurrent_rtree const* m_owner;
+        std::size_t m_version;
+        std::size_t m_slot;
+        rtree_type const* m_tree;
+    };
+
+    /*!
+    \brief The constructor.
+
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+    */
+    inline explicit concurrent_rtree(parameters_type const& parameters = parameters_type(),
+                                     indexable_getter const& getter = indexable_getter(),
+                                     value_equal const& equal = value_equal(),
+                                     allocator_type const& allocator = allocator_type())
+        : m_tree_0(parameters, getter, equal, allocator)
+        , m_tree_1(parameters, getter, equal, allocator)
+        , m_active_index(0)
+        , m_version_index(0)
+    {}
+
+    /*!
+    \brief The constructor.
+
+    The trees are created using packing algorithm.
+
+    \param first        The beginning of the range of Values.
+    \param last         The end of the range of Values.
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+    */
+    template <typename Iterator>
+    inline concurrent_rtree(Iterator first, Iterator last,
+                            parameters_type const& parameters = parameters_type(),
+                            indexable_getter const& getter = indexable_getter(),
+                            value_equal const& equal = value_equal(),
+                            allocator_type const& allocator = allocator_type())
+        : m_tree_0(first, last, parameters, getter, equal, allocator)
+        , m_tree_1(m_tree_0)
+        , m_active_index(0)
+        , m_version_index(0)
+    {}
+
+    /*!
+    \brief Returns the read access to the current state of the container.
+
+    \par Throws
+    Nothing.
+    */
+    const_snapshot snapshot() const
+    {
+        return const_snapshot(this);
+    }
+
+    /*!
+    \brief Finds values meeting passed predicates.
+
+    The query is performed on the current state of the container without
+    waiting for writers. See rtree::query() for more information.
+
+    \param predicates   Predicates.
+    \param out_it       The output iterator, e.g. generated by std::back_inserter().
+
+    \return             The number of values found.
+    */
+    template <typename Predicates, typename OutIter>
+    size_type query(Predicates const& predicates, OutIter out_it) const
+    {
+        const_snapshot s(this);
+        return s->query(predicates, out_it);
+    }
+
+    /*!
+    \brief Count values equal to passed Value or Indexable.
+    */
+    template <typename ValueOrIndexable>
+    size_type count(ValueOrIndexable const& vori) const
+    {
+        const_snapshot s(this);
+        return s->count(vori);
+    }
+
+    /*!
+    \brief Returns the number of stored values.
+    */
+    size_type size() const
+    {
+        const_snapshot s(this);
+        return s->size();
+    }
+
+    /*!
+    \brief Query if the container is empty.
+    */
+    bool empty() const
+    {
+        const_snapshot s(this);
+        return s->empty();
+    }
+
+    /*!
+    \brief Returns the box able to contain all values stored in the container.
+    */
+    bounds_type bounds() const
+    {
+        const_snapshot s(this);
+        return s->bounds();
+    }
+
+    /*!
+    \brief Applies a modifying function object to the container.
+
+    The function object is called two times, once for each rtree instance.
+    Both calls must result in the same modification. This function may be
+    used to perform many modifications at once, e.g. insert and remove
+    values, and to publish them all together.
+
+    \param modifier     The function object taking rtree_type &.
+
+    \par Throws
+    If modifier throws. In this case the state of the container
+    is restored from the other instance.
+    */
+    template <typename Modifier>
+    void modify(Modifier modifier)
+    {
+        std::lock_guard<std::mutex> lock(m_write_mutex);
+
+        std::size_t const active = m_active_index.load();
+        std::size_t const inactive = 1 - active;
+
+        // readers don't access the inactive instance
+        BOOST_TRY
+        {
+            modifier(tree(inactive));                                                // MAY THROW
+        }
+        BOOST_CATCH(...)
+        {
+            tree(inactive) = tree(active);                                        // MAY THROW
+            BOOST_RETHROW                                                               // RETHROW
+        }
+        BOOST_CATCH_END
+
+        // publish the modified instance
+        m_active_index.store(inactive);
+
+        // wait for the readers which may still access the previously active instance
+        std::size_t const prev_version = m_version_index.load();
+        std::size_t const next_version = 1 - prev_version;
+        m_read_indicators[next_version].wait_until_empty();
+        m_version_index.store(next_version);
+        m_read_indicators[prev_version].wait_until_empty();
+
+        // now nobody accesses the previously active instance
+        BOOST_TRY
+        {
+            modifier(tree(active));                                                    // MAY THROW
+        }
+        BOOST_CATCH(...)
+        {
+            tree(active) = tree(inactive);                                        // MAY THROW
+            BOOST_RETHROW                                                               // RETHROW
+        }
+        BOOST_CATCH_END
+    }
+
+    /*!
+    \brief Insert a value to the container.
+
+    \param value    The value which will be stored in the container.
+    */
+    inline void insert(value_type const& value)
+    {
+        modify(inserter<value_type const&>(value));
+    }
+
+    /*!
+    \brief Insert a range of values to the container.
+
+    The values of a single-pass range, e.g. defined by input iterators,
+    are copied before the modification.
+
+    \param first    The beginning of the range of values.
+    \param last     The end of the range of values.
+    */
+    template <typename Iterator>
+    inline void insert(Iterator first, Iterator last)
+    {
+        insert_range(first, last, typename std::iterator_traits<Iterator>::iterator_category());
+    }
+
+    /*!
+    \brief Insert a value created using convertible object or a range of values to the container.
+
+    \param conv_or_rng      An object of type convertible to value_type or a range of values.
+    */
+    template <typename ConvertibleOrRange>
+    inline void insert(ConvertibleOrRange const& conv_or_rng)
+    {
+        modify(inserter<ConvertibleOrRange const&>(conv_or_rng));
+    }
+
+    /*!
+    \brief Remove a value from the container.
+
+    \param value    The value which will be removed from the container.
+
+    \return         1 if the value was removed, 0 otherwise.
+    */
+    inline size_type remove(value_type const& value)
+    {
+        size_type result = 0;
+        modify(remover<value_type const&>(value, result));
+        return result;
+    }
+
+    /*!
+    \brief Remove a range of values from the container.
+
+    The values of a single-pass range, e.g. defined by input iterators,
+    are copied before the modification.
+
+    \param first    The beginning of the range of values.
+    \param last     The end of the range of values.
+
+    \return         The number of removed values.
+    */
+    template <typename Iterator>
+    inline size_type remove(Iterator first, Iterator last)
+    {
+        return remove_range(first, last, typename std::iterator_traits<Iterator>::iterator_category());
+    }
+
+    /*!
+    \brief Remove value corresponding to an object convertible to it or a range of values from the container.
+
+    \param conv_or_rng      The object of type convertible to value_type or a range of values.
+
+    \return         The number of removed values.
+    */
+    template <typename ConvertibleOrRange>
+    inline size_type remove(ConvertibleOrRange const& conv_or_rng)
+    {
+        size_type result = 0;
+        modify(remover<ConvertibleOrRange const&>(conv_or_rng, result));
+        return result;
+    }
+
+    /*!
+    \brief Removes all values stored in the container.
+    */
+    inline void clear()
+    {
+        modify(clearer());
+    }
+
+private:
+    // The modifier is applied to both instances so the range is traversed
+    // two times. Multi-pass ranges are passed directly.
+    template <typename Iterator>
+    void insert_range(Iterator first, Iterator last, std::forward_iterator_tag)
+    {
+        modify(range_inserter<Iterator>(first, last));
+    }
+
+    template <typename Iterator>
+    void insert_range(Iterator first, Iterator last, std::input_iterator_tag)
+    {
+        std::vector<value_type> const values(first, last);                          // MAY THROW
+        insert_range(values.begin(), values.end(), std::forward_iterator_tag());
+    }
+
+    template <typename Iterator>
+    size_type remove_range(Iterator first, Iterator last, std::forward_iterator_tag)
+    {
+        size_type result = 0;
+        modify(range_remover<Iterator>(first, last, result));
+        return result;
+    }
+
+    template <typename Iterator>
+    size_type remove_range(Iterator first, Iterator last, std::input_iterator_tag)
+    {
+        std::vector<value_type> const values(first, last);                          // MAY THROW
+        return remove_range(values.begin(), values.end(), std::forward_iterator_tag());
+    }
+
+    template <typename T>
+    struct inserter
+    {
+        explicit inserter(T t) : arg(t) {}
+        void operator()(rtree_type & tree) const { tree.insert(arg); }
+        T arg;
+    };
+
+    template <typename Iterator>
+    struct range_inserter
+    {
+        range_inserter(Iterator f, Iterator l) : first(f), last(l) {}
+        void operator()(rtree_type & tree) const { tree.insert(first, last); }
+        Iterator first, last;
+    };
+
+    template <typename T>
+    struct remover
+    {
+        remover(T t, size_type & r) : arg(t), result(r) {}
+        void operator()(rtree_type & tree) const { result = tree.remove(arg); }
+        T arg;
+        size_type & result;
+    };
+
+    template <typename Iterator>
+    struct range_remover
+    {
+        range_remover(Iterator f, Iterator l, size_type & r) : first(f), last(l), result(r) {}
+        void operator()(rtree_type & tree) const { result = tree.remove(first, last); }
+        Iterator first, last;
+        size_type & result;
+    };
+
+    struct clearer
+    {
+        void operator()(rtree_type & tree) const { tree.clear(); }
+    };
+
+    rtree_type & tree(std::size_t i) { return i == 0 ? m_tree_0 : m_tree_1; }
+    rtree_type const& tree(std::size_t i) const { return i == 0 ? m_tree_0 : m_tree_1; }
+
+    rtree_type m_tree_0;
+    rtree_type m_tree_1;
+    std::atomic<std::size_t> m_active_index;
+    std::atomic<std::size_t> m_version_index;
+    mutable detail::rtree::read_indicator m_read_indicators[2];
+    std::mutex m_write_mutex;
+};
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_CONCURRENT_RTREE_HPP
@@ -3,7 +3,7 @@
 // Spatial index distance predicates, calculators and checkers
 // used in nearest query - specialized for envelopes
 //
-// Copyright (c) 2011-2015 Adam Wulkiewicz, Lodz, Poland.
+// Copyright (c) 2011-2018 Adam Wulkiewicz, Lodz, Poland.
 //
 // Use, modification and distribution is subject to the Boost Software License,
 // Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
@@ -19,6 +19,9 @@
 
 #include <boost/geometry/index/detail/tags.hpp>
 
+#include <boost/geometry/algorithms/detail/distance/default_strategies.hpp>
+#include <boost/geometry/strategies/distance.hpp>
+
 namespace boost { namespace geometry { namespace index { namespace detail {
 
 // ------------------------------------------------------------------ //
@@ -92,6 +95,39 @@ struct relation< to_furthest<T> >
     static inline T & value(to_furthest<T> & r) { return r.value; }
 };
 
+// ------------------------------------------------------------------ //
+// max_distance
+// ------------------------------------------------------------------ //
+
+// Checks if the comparable distance between the Geometry and the Indexable
+// is not greater than the maximum distance of the nearest predicate.
+// The maximum distance is converted to the comparable distance calculated
+// by the comparable strategy corresponding to the default distance strategy,
+// e.g. squared in cartesian coordinate system.
+template <typename Geometry, typename Indexable, typename PointRelation, typename ComparableDistance>
+inline bool is_within_max_distance(predicates::nearest<PointRelation> const& p,
+                                   ComparableDistance const& comparable_distance)
+{
+    if ( ! p.has_max_distance() )
+        return true;
+
+    typedef typename geometry::detail::distance::default_strategy
+        <
+            Geometry, Indexable
+        >::type strategy_type;
+    typedef typename strategy::distance::services::comparable_type
+        <
+            strategy_type
+        >::type comparable_strategy_type;
+
+    return ! (strategy::distance::services::result_from_distance
+                <
+                    comparable_strategy_type,
+                    typename geometry::point_type<Geometry>::type,
+                    typename geometry::point_type<Indexable>::type
+                >::apply(comparable_strategy_type(), p.max_distance) < comparable_distance);
+}
+
 // ------------------------------------------------------------------ //
 // calculate_distance
 // ------------------------------------------------------------------ //
@@ -113,7 +149,7 @@ struct calculate_distance< predicates::nearest<PointRelation>, Indexable, Tag >
     static inline bool apply(predicates::nearest<PointRelation> const& p, Indexable const& i, result_type & result)
     {
         result = geometry::comparable_distance(relation::value(p.point_or_relation), i);
-        return true;
+        return is_within_max_distance<point_type, Indexable>(p, result);
     }
 };
 
@@ -126,7 +162,7 @@ struct calculate_distance< predicates::nearest< to_centroid<Point> >, Indexable,
     static inline bool apply(predicates::nearest< to_centroid<Point> > const& p, Indexable const& i, result_type & result)
     {
         result = index::detail::comparable_distance_centroid(p.point_or_relation.value, i);
-        return true;
+        return is_within_max_distance<point_type, Indexable>(p, result);
     }
 };
 
@@ -139,7 +175,7 @@ struct calculate_distance< predicates::nearest< to_furthest<Point> >, Indexable,
     static inline bool apply(predicates::nearest< to_furthest<Point> > const& p, Indexable const& i, result_type & result)
     {
         result = index::detail::comparable_distance_far(p.point_or_relation.value, i);
-        return true;
+        return is_within_max_distance<point_type, Indexable>(p, result);
     }
 };
 
@@ -2,7 +2,7 @@
 //
 // Spatial query predicates definition and checks.
 //
-// Copyright (c) 2011-2015 Adam Wulkiewicz, Lodz, Poland.
+// Copyright (c) 2011-2018 Adam Wulkiewicz, Lodz, Poland.
 //
 // Use, modification and distribution is subject to the Boost Software License,
 // Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
@@ -84,14 +84,23 @@ template <typename PointOrRelation>
 struct nearest
 {
     nearest()
-//        : count(0)
+        : max_distance(-1)
     {}
     nearest(PointOrRelation const& por, unsigned k)
         : point_or_relation(por)
         , count(k)
+        , max_distance(-1)
+    {}
+    nearest(PointOrRelation const& por, unsigned k, double max_dist)
+        : point_or_relation(por)
+        , count(k)
+        , max_distance(max_dist)
     {}
+    bool has_max_distance() const { return 0 <= max_distance; }
     PointOrRelation point_or_relation;
     unsigned count;
+    // negative if the distance is not limited
+    double max_distance;
 };
 
 template <typename SegmentOrLinestring>
@@ -0,0 +1,279 @@
+// Boost.Geometry Index
+//
+// R-tree kmeans split algorithm implementation
+//
+// Copyright (c) 2011-2018 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_KMEANS_REDISTRIBUTE_ELEMENTS_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_KMEANS_REDISTRIBUTE_ELEMENTS_HPP
+
+#include <algorithm>
+#include <utility>
+
+#include <boost/geometry/algorithms/assign.hpp>
+#include <boost/geometry/algorithms/detail/assign_indexed_point.hpp>
+#include <boost/geometry/arithmetic/arithmetic.hpp>
+#include <boost/geometry/arithmetic/dot_product.hpp>
+#include <boost/geometry/core/coordinate_dimension.hpp>
+#include <boost/geometry/core/coordinate_type.hpp>
+#include <boost/geometry/geometries/point.hpp>
+#include <boost/geometry/util/select_most_precise.hpp>
+
+#include <boost/geometry/index/detail/rtree/node/node.hpp>
+#include <boost/geometry/index/detail/rtree/visitors/insert.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree {
+
+namespace kmeans {
+
+// The maximum number of iterations of the k-means algorithm, usually
+// the clusters of the elements of a node are found in a few iterations
+static const size_t max_iterations = 8;
+
+template <typename Box>
+struct center_type
+{
+    typedef typename geometry::select_most_precise
+        <
+            typename geometry::coordinate_type<Box>::type,
+            double
+        >::type calculation_type;
+
+    typedef geometry::model::point
+        <
+            calculation_type,
+            geometry::dimension<Box>::value,
+            cs::cartesian
+        > type;
+};
+
+// Center of the box
+template <typename Box, typename Point>
+inline void box_center(Box const& box, Point & center)
+{
+    Point max_corner;
+    geometry::detail::assign_point_from_index<0>(box, center);
+    geometry::detail::assign_point_from_index<1>(box, max_corner);
+    geometry::add_point(center, max_corner);
+    geometry::divide_value(center, 2);
+}
+
+template <typename Point>
+inline typename geometry::coordinate_type<Point>::type
+comparable_distance(Point const& p1, Point const& p2)
+{
+    Point d(p1);
+    geometry::subtract_point(d, p2);
+    return geometry::dot_product(d, d);
+}
+
+// Mean of the centers of the elements of a cluster
+template <typename Centers, typename Keys, typename Point>
+inline void mean(Centers const& centers, Keys const& keys,
+                 size_t first, size_t last, Point & result)
+{
+    geometry::assign_zero(result);
+    for ( size_t i = first ; i < last ; ++i )
+        geometry::add_point(result, centers[keys[i].second]);
+    geometry::divide_value(result, last - first);
+}
+
+// Index of the center which is the farthest from the point
+template <typename Centers, typename Point>
+inline size_t farthest(Centers const& centers, Point const& point)
+{
+    typedef typename geometry::coordinate_type<Point>::type calculation_type;
+
+    size_t result = 0;
+    calculation_type greatest_distance = 0;
+    for ( size_t i = 0 ; i < centers.size() ; ++i )
+    {
+        calculation_type d = kmeans::comparable_distance(centers[i], point);
+        if ( greatest_distance < d )
+        {
+            greatest_distance = d;
+            result = i;
+        }
+    }
+    return result;
+}
+
+// Divide the centers into two clusters. The keys are sorted so the indexes
+// of the elements of the first cluster are stored first. The number of
+// elements in the first cluster is returned, it's in range [min, size-min].
+template <typename Centers, typename Keys>
+inline size_t cluster(Centers const& centers, size_t min_elements, Keys & keys)
+{
+    typedef typename Centers::value_type point_type;
+
+    size_t const count = centers.size();
+    BOOST_GEOMETRY_INDEX_ASSERT(2 <= count && min_elements <= count - min_elements,
+                                "unexpected number of elements");
+
+    for ( size_t i = 0 ; i < count ; ++i )
+        keys[i].second = i;
+
+    // the initial means are the centers far from the mean of all centers
+    // and far from each other
+    point_type mean1, mean2;
+    kmeans::mean(centers, keys, 0, count, mean1);
+    size_t const seed1 = kmeans::farthest(centers, mean1);
+    size_t const seed2 = kmeans::farthest(centers, centers[seed1]);
+    mean1 = centers[seed1];
+    mean2 = centers[seed2];
+
+    size_t count1 = 0;
+    point_type new_mean1, new_mean2;
+    for ( size_t iteration = 0 ; iteration < max_iterations ; ++iteration )
+    {
+        // the elements closer to the first mean are sorted first
+        for ( size_t i = 0 ; i < count ; ++i )
+        {
+            point_type const& c = centers[i];
+            keys[i].first = kmeans::comparable_distance(c, mean1)
+                          - kmeans::comparable_distance(c, mean2);
+            keys[i].second = i;
+        }
+        std::sort(keys.begin(), keys.end());
+
+        count1 = 0;
+        while ( count1 < count && keys[count1].first < 0 )
+            ++count1;
+
+        // the clusters must contain at least min elements,
+        // the elements of the greater cluster closest to the other one are moved
+        count1 = (std::max)(count1, min_elements);
+        count1 = (std::min)(count1, count - min_elements);
+
+        kmeans::mean(centers, keys, 0, count1, new_mean1);
+        kmeans::mean(centers, keys, count1, count, new_mean2);
+
+        // if the means are not changing the clusters would not change either,
+        // the sizes of the clusters are not compared because the elements
+        // may be swapped between the clusters without changing the sizes
+        if ( kmeans::comparable_distance(mean1, new_mean1) == 0
+          && kmeans::comparable_distance(mean2, new_mean2) == 0 )
+            break;
+
+        mean1 = new_mean1;
+        mean2 = new_mean2;
+    }
+
+    return count1;
+}
+
+} // namespace kmeans
+
+template <typename Value, typename Options, typename Translator, typename Box, typename Allocators>
+struct redistribute_elements<Value, Options, Translator, Box, Allocators, kmeans_tag>
+{
+    typedef typename Options::parameters_type parameters_type;
+
+    typedef typename rtree::node<Value, parameters_type, Box, Allocators, typename Options::node_tag>::type node;
+    typedef typename rtree::internal_node<Value, parameters_type, Box, Allocators, typename Options::node_tag>::type internal_node;
+    typedef typename rtree::leaf<Value, parameters_type, Box, Allocators, typename Options::node_tag>::type leaf;
+
+    typedef typename kmeans::center_type<Box>::type center_type;
+    typedef typename kmeans::center_type<Box>::calculation_type calculation_type;
+
+    template <typename Node>
+    static inline void apply(Node & n,
+                             Node & second_node,
+                             Box & box1,
+                             Box & box2,
+                             parameters_type const& parameters,
+                             Translator const& translator,
+                             Allocators & allocators)
+    {
+        typedef typename rtree::elements_type<Node>::type elements_type;
+        typedef typename elements_type::value_type element_type;
+
+        elements_type & elements1 = rtree::elements(n);
+        elements_type & elements2 = rtree::elements(second_node);
+
+        BOOST_GEOMETRY_INDEX_ASSERT(elements1.size() == parameters.get_max_elements() + 1, "unexpected elements number");
+
+        // copy original elements - use in-memory storage (std::allocator)
+        // TODO: move if noexcept
+        typedef typename rtree::container_from_elements_type<elements_type, element_type>::type
+            container_type;
+        container_type elements_copy(elements1.begin(), elements1.end());                                   // MAY THROW, STRONG (alloc, copy)
+        container_type elements_backup(elements1.begin(), elements1.end());                                 // MAY THROW, STRONG (alloc, copy)
+
+        size_t const elements_count = elements_copy.size();
+
+        // calculate the centers of the elements
+        typedef typename rtree::container_from_elements_type<elements_type, center_type>::type
+            centers_type;
+        typedef typename rtree::container_from_elements_type
+            <
+                elements_type, std::pair<calculation_type, size_t>
+            >::type keys_type;
+        centers_type centers(elements_count);                                                               // MAY THROW, STRONG (alloc)
+        keys_type keys(elements_count);                                                                     // MAY THROW, STRONG (alloc)
+        for ( size_t i = 0 ; i < elements_count ; ++i )
+        {
+            Box b;
+            detail::bounds(rtree::element_indexable(elements_copy[i], translator), b);
+            kmeans::box_center(b, centers[i]);
+        }
+
+        size_t const count1 = kmeans::cluster(centers, parameters.get_min_elements(), keys);
+
+        // prepare nodes' elements containers
+        elements1.clear();
+        BOOST_GEOMETRY_INDEX_ASSERT(elements2.empty(), "second node's elements container should be empty");
+
+        BOOST_TRY
+        {
+            for ( size_t i = 0 ; i < elements_count ; ++i )
+            {
+                element_type const& elem = elements_copy[keys[i].second];
+                bool const first_in_group = i == 0 || i == count1;
+
+                if ( i < count1 )
+                {
+                    elements1.push_back(elem);                                                              // MAY THROW, STRONG (copy)
+                    expand(box1, rtree::element_indexable(elem, translator), first_in_group);
+                }
+                else
+                {
+                    elements2.push_back(elem);                                                              // MAY THROW, STRONG (alloc, copy)
+                    expand(box2, rtree::element_indexable(elem, translator), first_in_group);
+                }
+            }
+        }
+        BOOST_CATCH(...)
+        {
+            elements1.clear();
+            elements2.clear();
+
+            rtree::destroy_elements<Value, Options, Translator, Box, Allocators>::apply(elements_backup, allocators);
+
+            BOOST_RETHROW                                                                                     // RETHROW, BASIC
+        }
+        BOOST_CATCH_END
+    }
+
+private:
+    template <typename Indexable>
+    static inline void expand(Box & box, Indexable const& indexable, bool first)
+    {
+        if ( first )
+            detail::bounds(indexable, box);
+        else
+            geometry::expand(box, indexable);
+    }
+};
+
+}} // namespace detail::rtree
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_KMEANS_REDISTRIBUTE_ELEMENTS_HPP
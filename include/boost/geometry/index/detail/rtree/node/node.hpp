@@ -2,7 +2,7 @@
 //
 // R-tree nodes
 //
-// Copyright (c) 2011-2015 Adam Wulkiewicz, Lodz, Poland.
+// Copyright (c) 2011-2018 Adam Wulkiewicz, Lodz, Poland.
 //
 // Use, modification and distribution is subject to the Boost Software License,
 // Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
@@ -26,6 +26,7 @@
 #include <boost/geometry/index/detail/rtree/node/variant_visitor.hpp>
 #include <boost/geometry/index/detail/rtree/node/variant_dynamic.hpp>
 #include <boost/geometry/index/detail/rtree/node/variant_static.hpp>
+#include <boost/geometry/index/detail/rtree/node/variant_static_soa.hpp>
 
 #include <boost/geometry/index/detail/rtree/node/subtree_destroyer.hpp>
 
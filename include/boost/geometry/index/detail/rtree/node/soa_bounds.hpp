@@ -0,0 +1,319 @@
+// Boost.Geometry Index
+//
+// R-tree nodes elements bounds stored in the SoA layout
+//
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_NODE_SOA_BOUNDS_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_NODE_SOA_BOUNDS_HPP
+
+#include <iterator>
+#include <limits>
+
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/coordinate_dimension.hpp>
+#include <boost/geometry/core/coordinate_type.hpp>
+#include <boost/geometry/core/cs.hpp>
+#include <boost/geometry/core/tags.hpp>
+
+#include <boost/geometry/index/detail/algorithms/bounds.hpp>
+#include <boost/geometry/index/detail/predicates.hpp>
+#include <boost/geometry/index/detail/rtree/node/node_elements.hpp>
+#include <boost/geometry/index/detail/rtree/node/soa_kernels.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree {
+
+// The bounds of the elements of a node. For each dimension the min and max
+// coordinates of all elements are stored in contiguous arrays so the elements
+// may be tested against a query geometry in a single pass, one dimension
+// at a time, by the kernels defined in soa_kernels.hpp.
+// The overflowing elements are stored only temporarily during the
+// modification of the tree so there is no room for them.
+// The capacity is a multiple of the kernels block size so the whole vectors
+// may be processed. The unused slots contain inverse boxes.
+// Only the blocks containing the elements are checked.
+
+template <std::size_t Capacity>
+struct soa_bounds_mask
+{
+    static const std::size_t blocks_count = Capacity / soa_block_size;
+
+    inline bool operator[](std::size_t i) const
+    {
+        return ((blocks[i / soa_block_size] >> (i % soa_block_size)) & 1u) != 0;
+    }
+
+    // Returns the index of the first set element not lesser than i
+    // or Capacity if there are no such elements.
+    inline std::size_t next(std::size_t i) const
+    {
+        std::size_t b = i / soa_block_size;
+        if ( b >= blocks_count )
+            return Capacity;
+
+        soa_block_mask m = blocks[b] & (~soa_block_mask(0) << (i % soa_block_size));
+        while ( m == 0 )
+        {
+            if ( ++b >= blocks_count )
+                return Capacity;
+            m = blocks[b];
+        }
+
+        return b * soa_block_size + soa_lowest_bit(m);
+    }
+
+    soa_block_mask blocks[blocks_count];
+};
+
+template <typename Box, std::size_t MaxCount>
+struct soa_bounds
+{
+    typedef typename geometry::coordinate_type<Box>::type coordinate_type;
+    static const std::size_t dimension = geometry::dimension<Box>::value;
+    static const std::size_t capacity = (MaxCount + soa_block_size - 1) / soa_block_size * soa_block_size;
+
+    typedef soa_bounds_mask<capacity> mask_type;
+
+    // Returns false if there are too many elements
+    template <typename It, typename Translator>
+    inline bool assign(It first, It last, Translator const& tr)
+    {
+        if ( static_cast<std::size_t>(std::distance(first, last)) > capacity )
+            return false;
+
+        count = 0;
+        for ( ; first != last ; ++first, ++count )
+        {
+            Box b;
+            index::detail::bounds(rtree::element_indexable(*first, tr), b);
+            assign_dimension<0>::apply(*this, count, b);
+        }
+
+        for ( std::size_t i = count ; i < capacity ; ++i )
+        {
+            for ( std::size_t d = 0 ; d < dimension ; ++d )
+            {
+                min_coords[d][i] = (std::numeric_limits<coordinate_type>::max)();
+                max_coords[d][i] = std::numeric_limits<coordinate_type>::is_integer
+                                 ? (std::numeric_limits<coordinate_type>::min)()
+                                 : -(std::numeric_limits<coordinate_type>::max)();
+            }
+        }
+
+        return true;
+    }
+
+    // result[i] = intersects(element[i], [qmin, qmax]) for i in [0, count)
+    inline void intersects(coordinate_type const* qmin, coordinate_type const* qmax,
+                           mask_type & result) const
+    {
+        std::size_t const blocks = (count + soa_block_size - 1) / soa_block_size;
+        soa_intersects_kernel<coordinate_type, dimension, capacity>
+            ::apply(&min_coords[0][0], &max_coords[0][0], blocks * soa_block_size,
+                    qmin, qmax, result.blocks);
+
+        // the unused slots may intersect infinite query geometries
+        std::size_t const rem = count % soa_block_size;
+        if ( rem != 0 )
+            result.blocks[blocks - 1] &= (soa_block_mask(1) << rem) - 1;
+        for ( std::size_t b = blocks ; b < mask_type::blocks_count ; ++b )
+            result.blocks[b] = 0;
+    }
+
+    template <std::size_t D, std::size_t Dim = dimension>
+    struct assign_dimension
+    {
+        static inline void apply(soa_bounds & s, std::size_t i, Box const& b)
+        {
+            s.min_coords[D][i] = geometry::get<min_corner, D>(b);
+            s.max_coords[D][i] = geometry::get<max_corner, D>(b);
+            assign_dimension<D + 1, Dim>::apply(s, i, b);
+        }
+    };
+
+    template <std::size_t Dim>
+    struct assign_dimension<Dim, Dim>
+    {
+        static inline void apply(soa_bounds &, std::size_t, Box const&) {}
+    };
+
+    coordinate_type min_coords[dimension][capacity];
+    coordinate_type max_coords[dimension][capacity];
+    std::size_t count;
+};
+
+// The predicates which may be checked using the SoA bounds.
+// Currently a single spatial predicate for which the bounds are checked
+// with intersects() and the query Point or Box using the same cartesian
+// coordinates as the bounds of elements.
+
+template <typename Tag>
+struct soa_bounds_intersects_tag
+    : boost::mpl::false_
+{};
+
+template <> struct soa_bounds_intersects_tag<predicates::intersects_tag> : boost::mpl::true_ {};
+template <> struct soa_bounds_intersects_tag<predicates::covered_by_tag> : boost::mpl::true_ {};
+template <> struct soa_bounds_intersects_tag<predicates::overlaps_tag> : boost::mpl::true_ {};
+template <> struct soa_bounds_intersects_tag<predicates::touches_tag> : boost::mpl::true_ {};
+template <> struct soa_bounds_intersects_tag<predicates::within_tag> : boost::mpl::true_ {};
+
+template <typename Geometry, typename Box,
+          typename GeometryTag = typename geometry::tag<Geometry>::type>
+struct soa_bounds_query_geometry
+{
+    static const bool value = false;
+};
+
+template <typename Geometry, typename Box>
+struct soa_bounds_query_geometry<Geometry, Box, point_tag>
+{
+    static const bool value
+        = boost::is_same<typename geometry::cs_tag<Geometry>::type, cartesian_tag>::value
+       && boost::is_same<typename geometry::cs_tag<Box>::type, cartesian_tag>::value
+       && boost::is_same<typename geometry::coordinate_type<Geometry>::type,
+                         typename geometry::coordinate_type<Box>::type>::value
+       && geometry::dimension<Geometry>::value == geometry::dimension<Box>::value;
+
+    template <std::size_t D, typename Coordinate>
+    static inline void get(Geometry const& g, Coordinate * qmin, Coordinate * qmax)
+    {
+        qmin[D] = qmax[D] = geometry::get<D>(g);
+    }
+};
+
+template <typename Geometry, typename Box>
+struct soa_bounds_query_geometry<Geometry, Box, box_tag>
+{
+    static const bool value
+        = boost::is_same<typename geometry::cs_tag<Geometry>::type, cartesian_tag>::value
+       && boost::is_same<typename geometry::cs_tag<Box>::type, cartesian_tag>::value
+       && boost::is_same<typename geometry::coordinate_type<Geometry>::type,
+                         typename geometry::coordinate_type<Box>::type>::value
+       && geometry::dimension<Geometry>::value == geometry::dimension<Box>::value;
+
+    template <std::size_t D, typename Coordinate>
+    static inline void get(Geometry const& g, Coordinate * qmin, Coordinate * qmax)
+    {
+        qmin[D] = geometry::get<min_corner, D>(g);
+        qmax[D] = geometry::get<max_corner, D>(g);
+    }
+};
+
+template <typename Predicates, typename Box>
+struct soa_bounds_predicates
+{
+    static const bool value = false;
+};
+
+template <typename Geometry, typename Tag, typename Box>
+struct soa_bounds_predicates<predicates::spatial_predicate<Geometry, Tag, false>, Box>
+{
+    typedef soa_bounds_query_geometry<Geometry, Box> query_geometry;
+
+    static const bool value = soa_bounds_intersects_tag<Tag>::value
+                           && query_geometry::value;
+
+    template <std::size_t D, std::size_t Dim, typename Coordinate>
+    static inline void get(Geometry const& g, Coordinate * qmin, Coordinate * qmax,
+                           boost::mpl::bool_<true> const& /*continue*/)
+    {
+        query_geometry::template get<D>(g, qmin, qmax);
+        get<D + 1, Dim>(g, qmin, qmax, boost::mpl::bool_<(D + 1 < Dim)>());
+    }
+
+    template <std::size_t D, std::size_t Dim, typename Coordinate>
+    static inline void get(Geometry const& , Coordinate * , Coordinate * ,
+                           boost::mpl::bool_<false> const& /*continue*/)
+    {}
+
+    template <typename Bounds>
+    static inline void apply(predicates::spatial_predicate<Geometry, Tag, false> const& p,
+                             Bounds const& bounds,
+                             typename Bounds::mask_type & result)
+    {
+        typename Bounds::coordinate_type qmin[Bounds::dimension];
+        typename Bounds::coordinate_type qmax[Bounds::dimension];
+        get<0, Bounds::dimension>(p.geometry, qmin, qmax, boost::mpl::bool_<true>());
+        bounds.intersects(qmin, qmax, result);
+    }
+};
+
+// The predicates for which the result of the bounds check is the same as
+// the result of the check of the Indexable.
+template <typename Predicates, typename Indexable,
+          typename IndexableTag = typename geometry::tag<Indexable>::type>
+struct soa_bounds_exact
+{
+    static const bool value = false;
+};
+
+template <typename Geometry, typename Indexable>
+struct soa_bounds_exact<predicates::spatial_predicate<Geometry, predicates::intersects_tag, false>, Indexable, point_tag>
+{
+    static const bool value = true;
+};
+
+template <typename Geometry, typename Indexable>
+struct soa_bounds_exact<predicates::spatial_predicate<Geometry, predicates::covered_by_tag, false>, Indexable, point_tag>
+{
+    static const bool value = true;
+};
+
+template <typename Geometry, typename Indexable>
+struct soa_bounds_exact<predicates::spatial_predicate<Geometry, predicates::intersects_tag, false>, Indexable, box_tag>
+{
+    static const bool value = true;
+};
+
+// SoA bounds of the node elements, by default not available
+
+struct soa_bounds_no_mask
+{
+    inline bool operator[](std::size_t) const
+    {
+        return false;
+    }
+
+    inline std::size_t next(std::size_t) const
+    {
+        return (std::numeric_limits<std::size_t>::max)();
+    }
+};
+
+template <typename Node>
+struct soa_mask
+{
+    typedef soa_bounds_no_mask type;
+};
+
+template <typename Node, typename Predicates>
+inline bool soa_predicates_check(Node const&, Predicates const&, soa_bounds_no_mask &)
+{
+    return false;
+}
+
+// Updates the SoA bounds of modified nodes, by default does nothing
+template <typename Value, typename Options, typename Translator, typename Box, typename Allocators,
+          typename NodeTag = typename Options::node_tag>
+struct update_soa_bounds
+{
+    template <typename NodePtr>
+    static inline void apply(NodePtr, Translator const&)
+    {}
+};
+
+}} // namespace detail::rtree
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_NODE_SOA_BOUNDS_HPP
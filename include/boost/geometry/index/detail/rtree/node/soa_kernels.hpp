@@ -0,0 +1,205 @@
+// Boost.Geometry Index
+//
+// R-tree kernels checking the SoA bounds of nodes elements
+//
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_NODE_SOA_KERNELS_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_NODE_SOA_KERNELS_HPP
+
+#include <cstddef>
+
+// The kernels are selected at compile time depending on the instruction sets
+// enabled for the compiler, e.g. with -mavx2 or /arch:AVX2. The vectorized
+// kernels may be disabled by defining BOOST_GEOMETRY_INDEX_NO_SIMD.
+#if ! defined(BOOST_GEOMETRY_INDEX_NO_SIMD)
+#  if defined(__AVX512F__)
+#    define BOOST_GEOMETRY_INDEX_DETAIL_SIMD_AVX512
+#  elif defined(__AVX2__)
+#    define BOOST_GEOMETRY_INDEX_DETAIL_SIMD_AVX2
+#  endif
+#endif
+
+#if defined(BOOST_GEOMETRY_INDEX_DETAIL_SIMD_AVX512) \
+ || defined(BOOST_GEOMETRY_INDEX_DETAIL_SIMD_AVX2)
+#include <immintrin.h>
+#endif
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree {
+
+// The number of elements processed by the kernels at once. The capacity of
+// the SoA bounds is a multiple of it. The result of each block is stored
+// as a bit mask in one word. It's the number of floats in an AVX-512
+// register, the double kernels check two registers of 8 values per block.
+static const std::size_t soa_block_size = 16;
+typedef unsigned int soa_block_mask;
+
+// Returns the index of the lowest set bit of the non-zero mask
+inline std::size_t soa_lowest_bit(soa_block_mask mask)
+{
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_ctz(mask));
+#else
+    std::size_t result = 0;
+    for ( ; (mask & 1u) == 0 ; mask >>= 1 )
+        ++result;
+    return result;
+#endif
+}
+
+// Checks intersects(element, [qmin, qmax]) for the first size elements of
+// the SoA bounds. mins and maxs are arrays of Dimension rows of Capacity
+// coordinates. size and Capacity are multiples of soa_block_size.
+// For each block of soa_block_size elements a bit mask is stored in result.
+template <typename Coordinate, std::size_t Dimension, std::size_t Capacity>
+struct soa_intersects_kernel
+{
+    static inline void apply(Coordinate const* mins, Coordinate const* maxs,
+                             std::size_t size, Coordinate const* qmin, Coordinate const* qmax,
+                             soa_block_mask * result)
+    {
+        for ( std::size_t b = 0 ; b < size ; b += soa_block_size )
+        {
+            // one dimension at a time so the loops may be vectorized
+            unsigned char ok[soa_block_size];
+            for ( std::size_t j = 0 ; j < soa_block_size ; ++j )
+                ok[j] = 1;
+
+            for ( std::size_t d = 0 ; d < Dimension ; ++d )
+            {
+                Coordinate const* mins_d = mins + d * Capacity + b;
+                Coordinate const* maxs_d = maxs + d * Capacity + b;
+                Coordinate const qmin_d = qmin[d];
+                Coordinate const qmax_d = qmax[d];
+                for ( std::size_t j = 0 ; j < soa_block_size ; ++j )
+                {
+                    ok[j] &= static_cast<unsigned char>(
+                        (mins_d[j] <= qmax_d) & (qmin_d <= maxs_d[j]));
+                }
+            }
+
+            soa_block_mask mask = 0;
+            for ( std::size_t j = 0 ; j < soa_block_size ; ++j )
+                mask |= soa_block_mask(ok[j]) << j;
+            result[b / soa_block_size] = mask;
+        }
+    }
+};
+
+#if defined(BOOST_GEOMETRY_INDEX_DETAIL_SIMD_AVX512)
+
+template <std::size_t Dimension, std::size_t Capacity>
+struct soa_intersects_kernel<double, Dimension, Capacity>
+{
+    static inline void apply(double const* mins, double const* maxs,
+                             std::size_t size, double const* qmin, double const* qmax,
+                             soa_block_mask * result)
+    {
+        for ( std::size_t b = 0 ; b < size ; b += soa_block_size )
+        {
+            __mmask8 m0 = 0xFF, m1 = 0xFF;
+            for ( std::size_t d = 0 ; d < Dimension ; ++d )
+            {
+                std::size_t const i = d * Capacity + b;
+                __m512d const vqmin = _mm512_set1_pd(qmin[d]);
+                __m512d const vqmax = _mm512_set1_pd(qmax[d]);
+                m0 = _mm512_mask_cmp_pd_mask(m0, _mm512_loadu_pd(mins + i), vqmax, _CMP_LE_OQ);
+                m0 = _mm512_mask_cmp_pd_mask(m0, vqmin, _mm512_loadu_pd(maxs + i), _CMP_LE_OQ);
+                m1 = _mm512_mask_cmp_pd_mask(m1, _mm512_loadu_pd(mins + i + 8), vqmax, _CMP_LE_OQ);
+                m1 = _mm512_mask_cmp_pd_mask(m1, vqmin, _mm512_loadu_pd(maxs + i + 8), _CMP_LE_OQ);
+            }
+            result[b / soa_block_size] = soa_block_mask(m0) | (soa_block_mask(m1) << 8);
+        }
+    }
+};
+
+template <std::size_t Dimension, std::size_t Capacity>
+struct soa_intersects_kernel<float, Dimension, Capacity>
+{
+    static inline void apply(float const* mins, float const* maxs,
+                             std::size_t size, float const* qmin, float const* qmax,
+                             soa_block_mask * result)
+    {
+        for ( std::size_t b = 0 ; b < size ; b += soa_block_size )
+        {
+            __mmask16 m = 0xFFFF;
+            for ( std::size_t d = 0 ; d < Dimension ; ++d )
+            {
+                std::size_t const i = d * Capacity + b;
+                m = _mm512_mask_cmp_ps_mask(m, _mm512_loadu_ps(mins + i), _mm512_set1_ps(qmax[d]), _CMP_LE_OQ);
+                m = _mm512_mask_cmp_ps_mask(m, _mm512_set1_ps(qmin[d]), _mm512_loadu_ps(maxs + i), _CMP_LE_OQ);
+            }
+            result[b / soa_block_size] = soa_block_mask(m);
+        }
+    }
+};
+
+#elif defined(BOOST_GEOMETRY_INDEX_DETAIL_SIMD_AVX2)
+
+template <std::size_t Dimension, std::size_t Capacity>
+struct soa_intersects_kernel<double, Dimension, Capacity>
+{
+    static inline void apply(double const* mins, double const* maxs,
+                             std::size_t size, double const* qmin, double const* qmax,
+                             soa_block_mask * result)
+    {
+        for ( std::size_t b = 0 ; b < size ; b += soa_block_size )
+        {
+            soa_block_mask mask = 0;
+            for ( std::size_t k = 0 ; k < soa_block_size ; k += 4 )
+            {
+                __m256d m = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+                for ( std::size_t d = 0 ; d < Dimension ; ++d )
+                {
+                    std::size_t const i = d * Capacity + b + k;
+                    __m256d const c1 = _mm256_cmp_pd(_mm256_loadu_pd(mins + i), _mm256_set1_pd(qmax[d]), _CMP_LE_OQ);
+                    __m256d const c2 = _mm256_cmp_pd(_mm256_set1_pd(qmin[d]), _mm256_loadu_pd(maxs + i), _CMP_LE_OQ);
+                    m = _mm256_and_pd(m, _mm256_and_pd(c1, c2));
+                }
+                mask |= soa_block_mask(_mm256_movemask_pd(m)) << k;
+            }
+            result[b / soa_block_size] = mask;
+        }
+    }
+};
+
+template <std::size_t Dimension, std::size_t Capacity>
+struct soa_intersects_kernel<float, Dimension, Capacity>
+{
+    static inline void apply(float const* mins, float const* maxs,
+                             std::size_t size, float const* qmin, float const* qmax,
+                             soa_block_mask * result)
+    {
+        for ( std::size_t b = 0 ; b < size ; b += soa_block_size )
+        {
+            soa_block_mask mask = 0;
+            for ( std::size_t k = 0 ; k < soa_block_size ; k += 8 )
+            {
+                __m256 m = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+                for ( std::size_t d = 0 ; d < Dimension ; ++d )
+                {
+                    std::size_t const i = d * Capacity + b + k;
+                    __m256 const c1 = _mm256_cmp_ps(_mm256_loadu_ps(mins + i), _mm256_set1_ps(qmax[d]), _CMP_LE_OQ);
+                    __m256 const c2 = _mm256_cmp_ps(_mm256_set1_ps(qmin[d]), _mm256_loadu_ps(maxs + i), _CMP_LE_OQ);
+                    m = _mm256_and_ps(m, _mm256_and_ps(c1, c2));
+                }
+                mask |= soa_block_mask(_mm256_movemask_ps(m)) << k;
+            }
+            result[b / soa_block_size] = mask;
+        }
+    }
+};
+
+#endif
+
+}} // namespace detail::rtree
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_NODE_SOA_KERNELS_HPP
@@ -0,0 +1,313 @@
+// Boost.Geometry Index
+//
+// R-tree nodes based on Boost.Variant, storing static-size containers
+// and the bounds of elements in the SoA layout
+//
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_NODE_VARIANT_STATIC_SOA_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_NODE_VARIANT_STATIC_SOA_HPP
+
+#include <boost/geometry/index/detail/rtree/node/soa_bounds.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree {
+
+// The elements are stored the same way as in the case of static nodes.
+// Additionally the nodes store the bounds of the elements in the SoA layout.
+// Each mutable access to the elements marks the bounds as outdated. They're
+// updated by update_soa_bounds after the modification of the tree. Outdated
+// bounds are not used by the queries.
+
+// nodes default types
+
+template <typename Value, typename Parameters, typename Box, typename Allocators>
+struct variant_internal_node<Value, Parameters, Box, Allocators, node_variant_static_soa_tag>
+{
+    typedef detail::varray<
+        rtree::ptr_pair<Box, typename Allocators::node_pointer>,
+        Parameters::max_elements + 1
+    > elements_type;
+
+    typedef soa_bounds<Box, Parameters::max_elements> soa_bounds_type;
+
+    template <typename Alloc>
+    inline variant_internal_node(Alloc const&) : soa(), soa_outdated(true) {}
+
+    elements_type elements;
+    soa_bounds_type soa;
+    bool soa_outdated;
+};
+
+template <typename Value, typename Parameters, typename Box, typename Allocators>
+struct variant_leaf<Value, Parameters, Box, Allocators, node_variant_static_soa_tag>
+{
+    typedef detail::varray<
+        Value,
+        Parameters::max_elements + 1
+    > elements_type;
+
+    typedef soa_bounds<Box, Parameters::max_elements> soa_bounds_type;
+
+    template <typename Alloc>
+    inline variant_leaf(Alloc const&) : soa(), soa_outdated(true) {}
+
+    elements_type elements;
+    soa_bounds_type soa;
+    bool soa_outdated;
+};
+
+// nodes traits
+
+template <typename Value, typename Parameters, typename Box, typename Allocators>
+struct node<Value, Parameters, Box, Allocators, node_variant_static_soa_tag>
+{
+    typedef boost::variant<
+        variant_leaf<Value, Parameters, Box, Allocators, node_variant_static_soa_tag>,
+        variant_internal_node<Value, Parameters, Box, Allocators, node_variant_static_soa_tag>
+    > type;
+};
+
+template <typename Value, typename Parameters, typename Box, typename Allocators>
+struct internal_node<Value, Parameters, Box, Allocators, node_variant_static_soa_tag>
+{
+    typedef variant_internal_node<Value, Parameters, Box, Allocators, node_variant_static_soa_tag> type;
+};
+
+template <typename Value, typename Parameters, typename Box, typename Allocators>
+struct leaf<Value, Parameters, Box, Allocators, node_variant_static_soa_tag>
+{
+    typedef variant_leaf<Value, Parameters, Box, Allocators, node_variant_static_soa_tag> type;
+};
+
+// nodes elements
+
+template <typename Value, typename Parameters, typename Box, typename Allocators>
+inline typename variant_internal_node<Value, Parameters, Box, Allocators, node_variant_static_soa_tag>::elements_type &
+elements(variant_internal_node<Value, Parameters, Box, Allocators, node_variant_static_soa_tag> & n)
+{
+    n.soa_outdated = true;
+    return n.elements;
+}
+
+template <typename Value, typename Parameters, typename Box, typename Allocators>
+inline typename variant_leaf<Value, Parameters, Box, Allocators, node_variant_static_soa_tag>::elements_type &
+elements(variant_leaf<Value, Parameters, Box, Allocators, node_variant_static_soa_tag> & n)
+{
+    n.soa_outdated = true;
+    return n.elements;
+}
+
+// SoA bounds
+
+template <typename Value, typename Parameters, typename Box, typename Allocators>
+struct soa_mask< variant_internal_node<Value, Parameters, Box, Allocators, node_variant_static_soa_tag> >
+{
+    typedef typename variant_internal_node
+        <
+            Value, Parameters, Box, Allocators, node_variant_static_soa_tag
+        >::soa_bounds_type::mask_type type;
+};
+
+template <typename Value, typename Parameters, typename Box, typename Allocators>
+struct soa_mask< variant_leaf<Value, Parameters, Box, Allocators, node_variant_static_soa_tag> >
+{
+    typedef typename variant_leaf
+        <
+            Value, Parameters, Box, Allocators, node_variant_static_soa_tag
+        >::soa_bounds_type::mask_type type;
+};
+
+template <typename Predicates, typename Box,
+          bool IsSupported = soa_bounds_predicates<Predicates, Box>::value>
+struct soa_predicates_check_impl
+{
+    template <typename Node, typename Mask>
+    static inline bool apply(Node const& n, Predicates const& p, Mask & result)
+    {
+        if ( n.soa_outdated )
+            return false;
+
+        soa_bounds_predicates<Predicates, Box>::apply(p, n.soa, result);
+        return true;
+    }
+};
+
+template <typename Predicates, typename Box>
+struct soa_predicates_check_impl<Predicates, Box, false>
+{
+    template <typename Node, typename Mask>
+    static inline bool apply(Node const&, Predicates const&, Mask &)
+    {
+        return false;
+    }
+};
+
+// If possible checks the bounds predicates for all elements of a node
+// using the SoA bounds and returns true. Otherwise returns false.
+template <typename Value, typename Parameters, typename Box, typename Allocators, typename Predicates>
+inline bool soa_predicates_check(variant_internal_node<Value, Parameters, Box, Allocators, node_variant_static_soa_tag> const& n,
+                                 Predicates const& p,
+                                 typename soa_mask<variant_internal_node<Value, Parameters, Box, Allocators, node_variant_static_soa_tag> >::type & result)
+{
+    return soa_predicates_check_impl<Predicates, Box>::apply(n, p, result);
+}
+
+template <typename Value, typename Parameters, typename Box, typename Allocators, typename Predicates>
+inline bool soa_predicates_check(variant_leaf<Value, Parameters, Box, Allocators, node_variant_static_soa_tag> const& n,
+                                 Predicates const& p,
+                                 typename soa_mask<variant_leaf<Value, Parameters, Box, Allocators, node_variant_static_soa_tag> >::type & result)
+{
+    return soa_predicates_check_impl<Predicates, Box>::apply(n, p, result);
+}
+
+template <typename Value, typename Options, typename Translator, typename Box, typename Allocators>
+class update_soa_bounds_visitor
+    : public rtree::visitor<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag, false>::type
+{
+    typedef typename rtree::internal_node<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type internal_node;
+    typedef typename rtree::leaf<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type leaf;
+
+public:
+    explicit update_soa_bounds_visitor(Translator const& tr)
+        : m_tr(tr)
+    {}
+
+    // The parents of the modified nodes are also marked as outdated
+    // because they're accessed in order to traverse the tree.
+    inline void operator()(internal_node & n)
+    {
+        if ( ! n.soa_outdated )
+            return;
+
+        n.soa_outdated = ! n.soa.assign(n.elements.begin(), n.elements.end(), m_tr);
+
+        for ( typename internal_node::elements_type::iterator it = n.elements.begin() ;
+              it != n.elements.end() ; ++it )
+        {
+            rtree::apply_visitor(*this, *it->second);
+        }
+    }
+
+    inline void operator()(leaf & n)
+    {
+        if ( ! n.soa_outdated )
+            return;
+
+        n.soa_outdated = ! n.soa.assign(n.elements.begin(), n.elements.end(), m_tr);
+    }
+
+private:
+    Translator const& m_tr;
+};
+
+template <typename Value, typename Options, typename Translator, typename Box, typename Allocators>
+struct update_soa_bounds<Value, Options, Translator, Box, Allocators, node_variant_static_soa_tag>
+{
+    template <typename NodePtr>
+    static inline void apply(NodePtr root, Translator const& tr)
+    {
+        if ( root )
+        {
+            update_soa_bounds_visitor<Value, Options, Translator, Box, Allocators> v(tr);
+            rtree::apply_visitor(v, *root);
+        }
+    }
+};
+
+// visitor traits
+
+template <typename Value, typename Parameters, typename Box, typename Allocators, bool IsVisitableConst>
+struct visitor<Value, Parameters, Box, Allocators, node_variant_static_soa_tag, IsVisitableConst>
+{
+    typedef static_visitor<> type;
+};
+
+// allocators
+
+template <typename Allocator, typename Value, typename Parameters, typename Box>
+class allocators<Allocator, Value, Parameters, Box, node_variant_static_soa_tag>
+    : public detail::rtree::node_alloc
+        <
+            Allocator, Value, Parameters, Box, node_variant_static_soa_tag
+        >::type
+{
+    typedef detail::rtree::node_alloc
+        <
+            Allocator, Value, Parameters, Box, node_variant_static_soa_tag
+        > node_alloc;
+
+public:
+    typedef typename node_alloc::type node_allocator_type;
+    typedef typename node_alloc::traits::pointer node_pointer;
+
+private:
+    typedef typename boost::container::allocator_traits
+        <
+            node_allocator_type
+        >::template rebind_alloc<Value> value_allocator_type;
+    typedef boost::container::allocator_traits<value_allocator_type> value_allocator_traits;
+
+public:
+    typedef Allocator allocator_type;
+
+    typedef Value value_type;
+    typedef typename value_allocator_traits::reference reference;
+    typedef typename value_allocator_traits::const_reference const_reference;
+    typedef typename value_allocator_traits::size_type size_type;
+    typedef typename value_allocator_traits::difference_type difference_type;
+    typedef typename value_allocator_traits::pointer pointer;
+    typedef typename value_allocator_traits::const_pointer const_pointer;
+
+    inline allocators()
+        : node_allocator_type()
+    {}
+
+    template <typename Alloc>
+    inline explicit allocators(Alloc const& alloc)
+        : node_allocator_type(alloc)
+    {}
+
+    inline allocators(BOOST_FWD_REF(allocators) a)
+        : node_allocator_type(boost::move(a.node_allocator()))
+    {}
+
+    inline allocators & operator=(BOOST_FWD_REF(allocators) a)
+    {
+        node_allocator() = boost::move(a.node_allocator());
+        return *this;
+    }
+
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    inline allocators & operator=(allocators const& a)
+    {
+        node_allocator() = a.node_allocator();
+        return *this;
+    }
+#endif
+
+    void swap(allocators & a)
+    {
+        boost::swap(node_allocator(), a.node_allocator());
+    }
+
+    bool operator==(allocators const& a) const { return node_allocator() == a.node_allocator(); }
+    template <typename Alloc>
+    bool operator==(Alloc const& a) const { return node_allocator() == node_allocator_type(a); }
+
+    Allocator allocator() const { return Allocator(node_allocator()); }
+
+    node_allocator_type & node_allocator() { return *this; }
+    node_allocator_type const& node_allocator() const { return *this; }
+};
+
+}} // namespace detail::rtree
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_NODE_VARIANT_STATIC_SOA_HPP
@@ -39,6 +39,16 @@ inline V & get(
     return boost::get<V>(v);
 }
 
+template <typename V, typename Value, typename Parameters, typename Box, typename Allocators, typename Tag>
+inline V const& get(
+    boost::variant<
+        variant_leaf<Value, Parameters, Box, Allocators, Tag>,
+        variant_internal_node<Value, Parameters, Box, Allocators, Tag>
+    > const& v)
+{
+    return boost::get<V>(v);
+}
+
 // apply visitor
 
 template <typename Visitor, typename Value, typename Parameters, typename Box, typename Allocators, typename Tag>
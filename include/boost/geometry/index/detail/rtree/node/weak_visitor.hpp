@@ -40,6 +40,12 @@ inline Derived & get(weak_node<Value, Parameters, Box, Allocators, Tag> & n)
     return static_cast<Derived&>(n);
 }
 
+template <typename Derived, typename Value, typename Parameters, typename Box, typename Allocators, typename Tag>
+inline Derived const& get(weak_node<Value, Parameters, Box, Allocators, Tag> const& n)
+{
+    return static_cast<Derived const&>(n);
+}
+
 // apply visitor
 
 template <typename Visitor, typename Value, typename Parameters, typename Box, typename Allocators, typename Tag>
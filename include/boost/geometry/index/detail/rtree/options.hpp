@@ -2,7 +2,7 @@
 //
 // R-tree options, algorithms, parameters
 //
-// Copyright (c) 2011-2014 Adam Wulkiewicz, Lodz, Poland.
+// Copyright (c) 2011-2018 Adam Wulkiewicz, Lodz, Poland.
 //
 // Use, modification and distribution is subject to the Boost Software License,
 // Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
@@ -11,6 +11,9 @@
 #ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_OPTIONS_HPP
 #define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_OPTIONS_HPP
 
+#include <boost/mpl/assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+
 #include <boost/geometry/index/parameters.hpp>
 
 namespace boost { namespace geometry { namespace index {
@@ -27,16 +30,17 @@ struct choose_by_overlap_diff_tag {};
 
 // SplitTag
 struct split_default_tag {};
-//struct split_kmeans_tag {};
 
 // RedistributeTag
 struct linear_tag {};
 struct quadratic_tag {};
 struct rstar_tag {};
+struct kmeans_tag {};
 
 // NodeTag
 struct node_variant_dynamic_tag {};
 struct node_variant_static_tag {};
+struct node_variant_static_soa_tag {};
 //struct node_weak_dynamic_tag {};
 //struct node_weak_static_tag {};
 
@@ -96,18 +100,36 @@ struct options_type< index::rstar<MaxElements, MinElements, OverlapCostThreshold
     > type;
 };
 
-//template <size_t MaxElements, size_t MinElements>
-//struct options_type< kmeans<MaxElements, MinElements> >
-//{
-//    typedef options<
-//        kmeans<MaxElements, MinElements>,
-//        insert_default_tag,
-//        choose_by_content_diff_tag, // change it?
-//        split_kmeans_tag,
-//        int, // dummy tag - not used for now
-//        node_variant_static_tag
-//    > type;
-//};
+template <typename Parameters>
+struct options_type< index::soa_layout<Parameters> >
+{
+    typedef typename options_type<Parameters>::type options_base;
+
+    BOOST_MPL_ASSERT_MSG((boost::is_same<typename options_base::node_tag, node_variant_static_tag>::value),
+                         SOA_LAYOUT_REQUIRES_STATIC_PARAMETERS, (Parameters));
+
+    typedef options<
+        index::soa_layout<Parameters>,
+        typename options_base::insert_tag,
+        typename options_base::choose_next_node_tag,
+        typename options_base::split_tag,
+        typename options_base::redistribute_tag,
+        node_variant_static_soa_tag
+    > type;
+};
+
+template <size_t MaxElements, size_t MinElements>
+struct options_type< index::kmeans<MaxElements, MinElements> >
+{
+    typedef options<
+        index::kmeans<MaxElements, MinElements>,
+        insert_default_tag,
+        choose_by_content_diff_tag,
+        split_default_tag,
+        kmeans_tag,
+        node_variant_static_tag
+    > type;
+};
 
 template <>
 struct options_type< index::dynamic_linear >
@@ -148,6 +170,19 @@ struct options_type< index::dynamic_rstar >
     > type;
 };
 
+template <>
+struct options_type< index::dynamic_kmeans >
+{
+    typedef options<
+        index::dynamic_kmeans,
+        insert_default_tag,
+        choose_by_content_diff_tag,
+        split_default_tag,
+        kmeans_tag,
+        node_variant_dynamic_tag
+    > type;
+};
+
 }} // namespace detail::rtree
 
 }}} // namespace boost::geometry::index
@@ -2,7 +2,7 @@
 //
 // R-tree initial packing
 //
-// Copyright (c) 2011-2017 Adam Wulkiewicz, Lodz, Poland.
+// Copyright (c) 2011-2018 Adam Wulkiewicz, Lodz, Poland.
 //
 // Use, modification and distribution is subject to the Boost Software License,
 // Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
@@ -19,6 +19,8 @@
 
 #include <boost/geometry/algorithms/detail/expand_by_epsilon.hpp>
 
+#include <boost/geometry/util/parallel.hpp>
+
 namespace boost { namespace geometry { namespace index { namespace detail { namespace rtree {
 
 namespace pack_utils {
@@ -121,6 +123,12 @@ struct nth_element_and_half_boxes<Dimension, Dimension>
 // L1          125               52
 // L2  25  25  25  25  25   25  17    10
 // L3  5x5 5x5 5x5 5x5 5x5  5x5 3x5+2 2x5
+//
+// The packets created by the median split are independent so they may be
+// created in parallel. The recursion is forked until the number of threads
+// is exhausted. Since the splits are the same the resulting tree is
+// the same as the one created sequentially. The allocator has to be
+// thread-safe in this case.
 
 template <typename Value, typename Options, typename Translator, typename Box, typename Allocators>
 class pack
@@ -152,6 +160,15 @@ public:
     template <typename InIt> inline static
     node_pointer apply(InIt first, InIt last, size_type & values_count, size_type & leafs_level,
                        parameters_type const& parameters, Translator const& translator, Allocators & allocators)
+    {
+        return apply(first, last, values_count, leafs_level, parameters, translator, allocators, 1);
+    }
+
+    // Arbitrary iterators, the tree is created using up to threads threads
+    template <typename InIt> inline static
+    node_pointer apply(InIt first, InIt last, size_type & values_count, size_type & leafs_level,
+                       parameters_type const& parameters, Translator const& translator, Allocators & allocators,
+                       std::size_t threads)
     {
         typedef typename std::iterator_traits<InIt>::difference_type diff_type;
             
@@ -188,7 +205,10 @@ public:
 
         subtree_elements_counts subtree_counts = calculate_subtree_elements_counts(values_count, parameters, leafs_level);
         internal_element el = per_level(entries.begin(), entries.end(), hint_box.get(), values_count, subtree_counts,
-                                        parameters, translator, allocators);
+                                        parameters, translator, allocators, threads);
+
+        // fill the SoA bounds if they're stored in nodes
+        rtree::update_soa_bounds<Value, Options, Translator, Box, Allocators>::apply(el.second, translator);
 
         return el.second;
     }
@@ -251,7 +271,8 @@ private:
 
     template <typename EIt> inline static
     internal_element per_level(EIt first, EIt last, Box const& hint_box, std::size_t values_count, subtree_elements_counts const& subtree_counts,
-                               parameters_type const& parameters, Translator const& translator, Allocators & allocators)
+                               parameters_type const& parameters, Translator const& translator, Allocators & allocators,
+                               std::size_t threads)
     {
         BOOST_GEOMETRY_INDEX_ASSERT(0 < std::distance(first, last) && static_cast<std::size_t>(std::distance(first, last)) == values_count,
                                     "unexpected parameters");
@@ -323,19 +344,20 @@ private:
         
         per_level_packets(first, last, hint_box, values_count, subtree_counts, next_subtree_counts,
                           rtree::elements(in), elements_box,
-                          parameters, translator, allocators);
+                          parameters, translator, allocators, threads);
 
         auto_remover.release();
         return internal_element(elements_box.get(), n);
     }
 
-    template <typename EIt, typename ExpandableBox> inline static
+    template <typename EIt, typename Elements, typename ExpandableBox> inline static
     void per_level_packets(EIt first, EIt last, Box const& hint_box,
                            std::size_t values_count,
                            subtree_elements_counts const& subtree_counts,
                            subtree_elements_counts const& next_subtree_counts,
-                           internal_elements & elements, ExpandableBox & elements_box,
-                           parameters_type const& parameters, Translator const& translator, Allocators & allocators)
+                           Elements & elements, ExpandableBox & elements_box,
+                           parameters_type const& parameters, Translator const& translator, Allocators & allocators,
+                           std::size_t threads)
     {
         BOOST_GEOMETRY_INDEX_ASSERT(0 < std::distance(first, last) && static_cast<std::size_t>(std::distance(first, last)) == values_count,
                                     "unexpected parameters");
@@ -348,7 +370,7 @@ private:
         {
             // the end, move to the next level
             internal_element el = per_level(first, last, hint_box, values_count, next_subtree_counts,
-                                            parameters, translator, allocators);
+                                            parameters, translator, allocators, threads);
 
             // in case if push_back() do throw here
             // and even if this is not probable (previously reserved memory, nonthrowing pairs copy)
@@ -371,17 +393,103 @@ private:
         Box left, right;
         pack_utils::nth_element_and_half_boxes<0, dimension>
             ::apply(first, median, last, hint_box, left, right, greatest_dim_index);
+
+        if ( 1 < threads )
+        {
+            std::size_t left_threads = threads / 2;
+            packets_task<EIt> left_task(first, median, left,
+                                        median_count, subtree_counts, next_subtree_counts,
+                                        parameters, translator, allocators, left_threads);
+            packets_task<EIt> right_task(median, last, right,
+                                         values_count - median_count, subtree_counts, next_subtree_counts,
+                                         parameters, translator, allocators, threads - left_threads);
+
+            geometry::detail::parallel::invoke(left_task, right_task, true);                             // MAY THROW
+
+            left_task.move_to(elements, elements_box);                                                  // MAY THROW (A?,C)
+            right_task.move_to(elements, elements_box);                                                 // MAY THROW (A?,C)
+            return;
+        }
         
         per_level_packets(first, median, left,
                           median_count, subtree_counts, next_subtree_counts,
                           elements, elements_box,
-                          parameters, translator, allocators);
+                          parameters, translator, allocators, 1);
         per_level_packets(median, last, right,
                           values_count - median_count, subtree_counts, next_subtree_counts,
                           elements, elements_box,
-                          parameters, translator, allocators);
+                          parameters, translator, allocators, 1);
     }
 
+    // Creates the packets of a range of elements into a temporary container,
+    // used to create the subtrees in parallel
+    template <typename EIt>
+    class packets_task
+    {
+        packets_task(packets_task const&);
+        packets_task & operator=(packets_task const&);
+
+    public:
+        packets_task(EIt first, EIt last, Box const& hint_box,
+                     std::size_t values_count,
+                     subtree_elements_counts const& subtree_counts,
+                     subtree_elements_counts const& next_subtree_counts,
+                     parameters_type const& parameters, Translator const& translator, Allocators & allocators,
+                     std::size_t threads)
+            : m_first(first), m_last(last), m_hint_box(hint_box)
+            , m_values_count(values_count)
+            , m_subtree_counts(subtree_counts), m_next_subtree_counts(next_subtree_counts)
+            , m_parameters(parameters), m_translator(translator), m_allocators(allocators)
+            , m_threads(threads)
+        {}
+
+        ~packets_task()
+        {
+            // destroy subtrees which weren't moved, e.g. if an exception was thrown
+            for ( typename std::vector<internal_element>::iterator it = m_elements.begin() ;
+                  it != m_elements.end() ; ++it )
+            {
+                subtree_destroyer auto_remover(it->second, m_allocators);
+            }
+        }
+
+        void operator()()
+        {
+            per_level_packets(m_first, m_last, m_hint_box, m_values_count,
+                              m_subtree_counts, m_next_subtree_counts,
+                              m_elements, m_elements_box,
+                              m_parameters, m_translator, m_allocators, m_threads);
+        }
+
+        template <typename Elements, typename ExpandableBox>
+        void move_to(Elements & elements, ExpandableBox & elements_box)
+        {
+            for ( typename std::vector<internal_element>::iterator it = m_elements.begin() ;
+                  it != m_elements.end() ; ++it )
+            {
+                // this container should have memory allocated, reserve() called outside
+                elements.push_back(*it);                                                                // MAY THROW (A?,C)
+                it->second = node_pointer(0);
+            }
+
+            elements_box.expand(m_elements_box.get());
+        }
+
+    private:
+        EIt m_first, m_last;
+        Box const& m_hint_box;
+        std::size_t m_values_count;
+        subtree_elements_counts const& m_subtree_counts;
+        subtree_elements_counts const& m_next_subtree_counts;
+        parameters_type const& m_parameters;
+        Translator const& m_translator;
+        Allocators & m_allocators;
+        std::size_t m_threads;
+
+        std::vector<internal_element> m_elements;
+        expandable_box<Box> m_elements_box;
+    };
+
     inline static
     subtree_elements_counts calculate_subtree_elements_counts(std::size_t elements_count, parameters_type const& parameters, size_type & leafs_level)
     {
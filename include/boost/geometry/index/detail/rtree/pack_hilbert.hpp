@@ -0,0 +1,471 @@
+// Boost.Geometry Index
+//
+// R-tree packing using Hilbert curve
+//
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_PACK_HILBERT_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_PACK_HILBERT_HPP
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include <boost/geometry/algorithms/centroid.hpp>
+#include <boost/geometry/algorithms/expand.hpp>
+#include <boost/geometry/index/detail/algorithms/bounds.hpp>
+
+#include <boost/geometry/algorithms/detail/expand_by_epsilon.hpp>
+
+namespace boost { namespace geometry { namespace index { namespace detail { namespace rtree {
+
+namespace pack_utils {
+
+// Maps the coordinates of a point to the grid of 2^Bits cells
+// in each dimension covering the box
+template <std::size_t Bits, std::size_t I, std::size_t Dimension>
+struct hilbert_grid
+{
+    template <typename Point, typename Box, typename Coord>
+    static inline void apply(Point const& point, Box const& box, Coord * x)
+    {
+        double const min = static_cast<double>(geometry::get<min_corner, I>(box));
+        double const max = static_cast<double>(geometry::get<max_corner, I>(box));
+        double const c = static_cast<double>(geometry::get<I>(point));
+        double const cells = static_cast<double>((boost::uint64_t(1) << Bits) - 1);
+
+        x[I] = min < max && min < c
+             ? static_cast<Coord>((std::min)((c - min) / (max - min), 1.0) * cells)
+             : 0;
+
+        hilbert_grid<Bits, I + 1, Dimension>::apply(point, box, x);
+    }
+};
+
+template <std::size_t Bits, std::size_t Dimension>
+struct hilbert_grid<Bits, Dimension, Dimension>
+{
+    template <typename Point, typename Box, typename Coord>
+    static inline void apply(Point const& , Box const& , Coord * ) {}
+};
+
+// Calculates the position of a point on the Hilbert curve filling the box.
+// The coordinates are mapped to the grid of 2^bits cells in each dimension,
+// the number of bits is chosen so the key fits in 64 bits.
+template <std::size_t Dimension>
+struct hilbert_key
+{
+    typedef boost::uint64_t key_type;
+    typedef boost::uint32_t coord_type;
+
+    static const std::size_t bits = 64 / Dimension < 32 ? 64 / Dimension : 32;
+
+    template <typename Point, typename Box>
+    static inline key_type apply(Point const& point, Box const& box)
+    {
+        coord_type x[Dimension];
+        hilbert_grid<bits, 0, Dimension>::apply(point, box, x);
+        axes_to_transpose(x);
+
+        // interleave the bits of transposed coordinates
+        key_type key = 0;
+        for ( std::size_t b = bits ; b > 0 ; --b )
+        {
+            for ( std::size_t i = 0 ; i < Dimension ; ++i )
+                key = (key << 1) | ((x[i] >> (b - 1)) & 1u);
+        }
+        return key;
+    }
+
+private:
+    // J. Skilling, Programming the Hilbert curve, AIP Conf. Proc. 707, 2004
+    static inline void axes_to_transpose(coord_type * x)
+    {
+        coord_type const m = coord_type(1) << (bits - 1);
+
+        // inverse undo
+        for ( coord_type q = m ; q > 1 ; q >>= 1 )
+        {
+            coord_type const p = q - 1;
+            for ( std::size_t i = 0 ; i < Dimension ; ++i )
+            {
+                if ( x[i] & q )
+                {
+                    x[0] ^= p; // invert
+                }
+                else
+                {
+                    coord_type const t = (x[0] ^ x[i]) & p; // exchange
+                    x[0] ^= t;
+                    x[i] ^= t;
+                }
+            }
+        }
+
+        // Gray encode
+        for ( std::size_t i = 1 ; i < Dimension ; ++i )
+            x[i] ^= x[i - 1];
+        coord_type t = 0;
+        for ( coord_type q = m ; q > 1 ; q >>= 1 )
+        {
+            if ( x[Dimension - 1] & q )
+                t ^= q - 1;
+        }
+        for ( std::size_t i = 0 ; i < Dimension ; ++i )
+            x[i] ^= t;
+    }
+};
+
+// In 2D the key is calculated without loops and branches using the parallel
+// prefix scan of the states of the curve for all bits at once. The grid
+// has 2^16 cells in each dimension which is enough to order the values
+// stored in different leafs.
+template <>
+struct hilbert_key<2>
+{
+    typedef boost::uint32_t key_type;
+    typedef boost::uint32_t coord_type;
+
+    static const std::size_t bits = 16;
+
+    template <typename Point, typename Box>
+    static inline key_type apply(Point const& point, Box const& box)
+    {
+        coord_type xy[2];
+        hilbert_grid<bits, 0, 2>::apply(point, box, xy);
+        coord_type const x = xy[0];
+        coord_type const y = xy[1];
+
+        coord_type A, B, C, D;
+
+        // initial prefix scan round
+        {
+            coord_type const a = x ^ y;
+            coord_type const b = 0xFFFF ^ a;
+            coord_type const c = 0xFFFF ^ (x | y);
+            coord_type const d = x & (y ^ 0xFFFF);
+
+            A = a | (b >> 1);
+            B = (a >> 1) ^ a;
+            C = ((c >> 1) ^ (b & (d >> 1))) ^ c;
+            D = ((a & (c >> 1)) ^ (d >> 1)) ^ d;
+        }
+
+        prefix_scan_round<2>(A, B, C, D);
+        prefix_scan_round<4>(A, B, C, D);
+
+        // final round
+        {
+            coord_type const a = A;
+            coord_type const b = B;
+            coord_type const c = C;
+            coord_type const d = D;
+
+            C ^= (a & (c >> 8)) ^ (b & (d >> 8));
+            D ^= (b & (c >> 8)) ^ ((a ^ b) & (d >> 8));
+        }
+
+        // undo the transformation of the prefix scan and recover the bits
+        coord_type const a = C ^ (C >> 1);
+        coord_type const b = D ^ (D >> 1);
+        coord_type const i0 = x ^ y;
+        coord_type const i1 = b | (0xFFFF ^ (i0 | a));
+
+        return (interleave(i1) << 1) | interleave(i0);
+    }
+
+private:
+    template <std::size_t Shift>
+    static inline void prefix_scan_round(coord_type & A, coord_type & B, coord_type & C, coord_type & D)
+    {
+        coord_type const a = A;
+        coord_type const b = B;
+        coord_type const c = C;
+        coord_type const d = D;
+
+        A = (a & (a >> Shift)) ^ (b & (b >> Shift));
+        B = (a & (b >> Shift)) ^ (b & ((a ^ b) >> Shift));
+        C ^= (a & (c >> Shift)) ^ (b & (d >> Shift));
+        D ^= (b & (c >> Shift)) ^ ((a ^ b) & (d >> Shift));
+    }
+
+    // spreads 16 bits to even bits
+    static inline coord_type interleave(coord_type x)
+    {
+        x = (x | (x << 8)) & 0x00FF00FFu;
+        x = (x | (x << 4)) & 0x0F0F0F0Fu;
+        x = (x | (x << 2)) & 0x33333333u;
+        x = (x | (x << 1)) & 0x55555555u;
+        return x;
+    }
+};
+
+struct hilbert_entries_comparer
+{
+    template <typename Entry>
+    bool operator()(Entry const& e1, Entry const& e2) const
+    {
+        return e1.first < e2.first;
+    }
+};
+
+} // namespace pack_utils
+
+// Hilbert R-tree packing
+//
+// The values are sorted by the positions of the centroids of their indexables
+// on the Hilbert curve filling the bounding box of all values. Then the tree
+// is built bottom-up, consecutive values are stored in leafs and consecutive
+// nodes of a level are stored in the nodes of the level above.
+// So in contrast to the top-down algorithm in pack_create.hpp the values are
+// sorted only once.
+//
+// Each node, except the root, is filled with Max elements. If the remainder
+// of a level is smaller than Min the elements of the last two nodes
+// are divided so the last node has Min elements,
+// e.g. for 177 values Max = 5 and Min = 2 the leafs level contains
+// 35 nodes with 5 values and one node with 2 values.
+//
+// This algorithm gives good results for points and small, similar boxes,
+// e.g. GPS positions or buildings. For big or elongated boxes the nodes
+// may overlap more than the nodes created by the top-down algorithm.
+
+template <typename Value, typename Options, typename Translator, typename Box, typename Allocators>
+class pack_hilbert
+{
+    typedef typename rtree::node<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type node;
+    typedef typename rtree::internal_node<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type internal_node;
+    typedef typename rtree::leaf<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type leaf;
+
+    typedef typename Allocators::node_pointer node_pointer;
+    typedef rtree::subtree_destroyer<Value, Options, Translator, Box, Allocators> subtree_destroyer;
+    typedef typename Allocators::size_type size_type;
+
+    typedef typename geometry::point_type<Box>::type point_type;
+    typedef typename Options::parameters_type parameters_type;
+    static const std::size_t dimension = geometry::dimension<point_type>::value;
+
+    typedef pack_utils::hilbert_key<dimension> hilbert_key;
+
+    typedef typename rtree::elements_type<internal_node>::type internal_elements;
+    typedef typename internal_elements::value_type internal_element;
+
+public:
+    template <typename InIt> inline static
+    node_pointer apply(InIt first, InIt last, size_type & values_count, size_type & leafs_level,
+                       parameters_type const& parameters, Translator const& translator, Allocators & allocators)
+    {
+        typedef typename std::iterator_traits<InIt>::difference_type diff_type;
+
+        diff_type diff = std::distance(first, last);
+        if ( diff <= 0 )
+            return node_pointer(0);
+
+        values_count = static_cast<size_type>(diff);
+
+        // calculate the bounding box of all values
+        typedef std::pair<typename hilbert_key::key_type, InIt> entry_type;
+        std::vector<entry_type> entries;
+        entries.reserve(values_count);
+
+        Box hint_box;
+        bool hint_box_initialized = false;
+        for ( ; first != last ; ++first )
+        {
+            // NOTE: support for iterators not returning true references adapted
+            // to Geometry concept and default translator returning true reference
+            typename std::iterator_traits<InIt>::reference in_ref = *first;
+            typename Translator::result_type indexable = translator(in_ref);
+
+            // NOTE: added for consistency with insert()
+            BOOST_GEOMETRY_INDEX_ASSERT(detail::is_valid(indexable), "Indexable is invalid");
+
+            expand(hint_box, indexable, hint_box_initialized);
+
+            entries.push_back(std::make_pair(typename hilbert_key::key_type(0), first));
+        }
+
+        // sort the values by the Hilbert keys of the centroids
+        for ( typename std::vector<entry_type>::iterator it = entries.begin() ;
+              it != entries.end() ; ++it )
+        {
+            typename std::iterator_traits<InIt>::reference in_ref = *(it->second);
+            point_type pt;
+            geometry::centroid(translator(in_ref), pt);
+            it->first = hilbert_key::apply(pt, hint_box);
+        }
+
+        std::sort(entries.begin(), entries.end(), pack_utils::hilbert_entries_comparer());
+
+        // create leafs
+        elements_holder level(allocators);
+        level.elements.reserve(nodes_count(values_count, parameters));
+        for ( std::size_t i = 0 ; i < values_count ; )
+        {
+            std::size_t const count = node_elements_count(values_count, i, parameters);
+            level.elements.push_back(create_leaf(entries.begin() + i, entries.begin() + i + count,
+                                                 translator, allocators));                                  // MAY THROW (A,C)
+            i += count;
+        }
+
+        // create internal nodes, level by level
+        leafs_level = 0;
+        while ( 1 < level.elements.size() )
+        {
+            elements_holder next_level(allocators);
+            next_level.elements.reserve(nodes_count(level.elements.size(), parameters));
+            for ( std::size_t i = 0 ; i < level.elements.size() ; )
+            {
+                std::size_t const count = node_elements_count(level.elements.size(), i, parameters);
+                next_level.elements.push_back(create_internal_node(level, i, i + count, allocators));     // MAY THROW (A)
+                i += count;
+            }
+            level.swap(next_level);
+            ++leafs_level;
+        }
+
+        node_pointer root = level.elements.front().second;
+        level.elements.clear();
+
+        // fill the SoA bounds if they're stored in nodes
+        rtree::update_soa_bounds<Value, Options, Translator, Box, Allocators>::apply(root, translator);
+
+        return root;
+    }
+
+private:
+    // Destroys the subtrees of a level if an exception is thrown
+    struct elements_holder
+    {
+        explicit elements_holder(Allocators & a) : allocators(a) {}
+
+        ~elements_holder()
+        {
+            for ( typename std::vector<internal_element>::iterator it = elements.begin() ;
+                  it != elements.end() ; ++it )
+            {
+                subtree_destroyer auto_remover(it->second, allocators);
+            }
+        }
+
+        void swap(elements_holder & other)
+        {
+            elements.swap(other.elements);
+        }
+
+        std::vector<internal_element> elements;
+        Allocators & allocators;
+    };
+
+    // The number of elements of the node starting at index i
+    inline static
+    std::size_t node_elements_count(std::size_t count, std::size_t i, parameters_type const& parameters)
+    {
+        std::size_t const max_count = parameters.get_max_elements();
+        std::size_t const min_count = parameters.get_min_elements();
+        std::size_t const rest = count - i;
+
+        // the last node or the root
+        if ( rest <= max_count )
+            return rest;
+
+        // the last two nodes, the last one would have less than Min elements
+        if ( rest < max_count + min_count )
+            return rest - min_count;
+
+        return max_count;
+    }
+
+    inline static
+    std::size_t nodes_count(std::size_t count, parameters_type const& parameters)
+    {
+        std::size_t const max_count = parameters.get_max_elements();
+        return (count + max_count - 1) / max_count;
+    }
+
+    template <typename EIt> inline static
+    internal_element create_leaf(EIt first, EIt last, Translator const& translator, Allocators & allocators)
+    {
+        node_pointer n = rtree::create_node<Allocators, leaf>::apply(allocators);                           // MAY THROW (A)
+        subtree_destroyer auto_remover(n, allocators);
+        leaf & l = rtree::get<leaf>(*n);
+
+        // reserve space for values
+        rtree::elements(l).reserve(std::distance(first, last));                                             // MAY THROW (A)
+
+        Box box;
+        bool box_initialized = false;
+        for ( ; first != last ; ++first )
+        {
+            // NOTE: push_back() must be called at the end in order to support move_iterator.
+            //       The iterator is dereferenced 2x (no temporary reference) to support
+            //       non-true reference types and move_iterator without boost::forward<>.
+            expand(box, translator(*(first->second)), box_initialized);
+            rtree::elements(l).push_back(*(first->second));                                                 // MAY THROW (A?,C)
+        }
+
+#ifdef BOOST_GEOMETRY_INDEX_EXPERIMENTAL_ENLARGE_BY_EPSILON
+        // Enlarge bounds of a leaf node, see pack_create.hpp
+        if ( BOOST_GEOMETRY_CONDITION((
+                ! index::detail::is_bounding_geometry
+                    <
+                        typename indexable_type<Translator>::type
+                    >::value )) )
+        {
+            geometry::detail::expand_by_epsilon(box);
+        }
+#endif
+
+        auto_remover.release();
+        return internal_element(box, n);
+    }
+
+    inline static
+    internal_element create_internal_node(elements_holder & level, std::size_t first, std::size_t last,
+                                          Allocators & allocators)
+    {
+        node_pointer n = rtree::create_node<Allocators, internal_node>::apply(allocators);                  // MAY THROW (A)
+        subtree_destroyer auto_remover(n, allocators);
+        internal_node & in = rtree::get<internal_node>(*n);
+
+        // reserve space for elements
+        rtree::elements(in).reserve(last - first);                                                          // MAY THROW (A)
+
+        Box box;
+        bool box_initialized = false;
+        for ( std::size_t i = first ; i < last ; ++i )
+        {
+            expand(box, level.elements[i].first, box_initialized);
+            // this container should have memory allocated, reserve() called above
+            rtree::elements(in).push_back(level.elements[i]);                                               // MAY THROW (A?,C)
+            // the subtree is owned by the new node now
+            level.elements[i].second = node_pointer(0);
+        }
+
+        auto_remover.release();
+        return internal_element(box, n);
+    }
+
+    template <typename Indexable> inline static
+    void expand(Box & box, Indexable const& indexable, bool & initialized)
+    {
+        if ( !initialized )
+        {
+            detail::bounds(indexable, box);
+            initialized = true;
+        }
+        else
+        {
+            geometry::expand(box, indexable);
+        }
+    }
+};
+
+}}}}} // namespace boost::geometry::index::detail::rtree
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_PACK_HILBERT_HPP
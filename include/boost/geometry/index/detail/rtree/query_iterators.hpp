@@ -2,7 +2,7 @@
 //
 // R-tree query iterators
 //
-// Copyright (c) 2011-2015 Adam Wulkiewicz, Lodz, Poland.
+// Copyright (c) 2011-2018 Adam Wulkiewicz, Lodz, Poland.
 //
 // Use, modification and distribution is subject to the Boost Software License,
 // Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
@@ -11,10 +11,21 @@
 #ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_QUERY_ITERATORS_HPP
 #define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_QUERY_ITERATORS_HPP
 
-#include <boost/scoped_ptr.hpp>
+#include <new>
+
+#include <boost/move/utility_core.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/integral_constant.hpp>
 
 //#define BOOST_GEOMETRY_INDEX_DETAIL_QUERY_ITERATORS_USE_MOVE
 
+// The size of the memory of query_iterator in which the wrapped iterators
+// are stored, bigger iterators are allocated on the heap
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_QUERY_ITERATORS_BUFFER_SIZE
+#define BOOST_GEOMETRY_INDEX_DETAIL_QUERY_ITERATORS_BUFFER_SIZE (32 * sizeof(void*))
+#endif
+
 namespace boost { namespace geometry { namespace index { namespace detail { namespace rtree { namespace iterators {
 
 template <typename Value, typename Allocators>
@@ -202,6 +213,24 @@ inline bool operator!=(L const& l, R const& r)
 }
 
 
+struct query_iterator_buffer
+{
+    static const std::size_t size = BOOST_GEOMETRY_INDEX_DETAIL_QUERY_ITERATORS_BUFFER_SIZE;
+    static const std::size_t alignment = boost::alignment_of<long double>::value;
+
+    typedef boost::aligned_storage<size, alignment> type;
+
+    // Check if the object may be stored in the buffer
+    template <typename T>
+    struct fits
+        : boost::integral_constant
+            <
+                bool,
+                sizeof(T) <= size && alignment % boost::alignment_of<T>::value == 0
+            >
+    {};
+};
+
 template <typename Value, typename Allocators>
 class query_iterator_base
 {
@@ -214,7 +243,10 @@ public:
 
     virtual ~query_iterator_base() {}
 
-    virtual query_iterator_base * clone() const = 0;
+    // Creates the copy in the buffer if it fits, otherwise on the heap
+    virtual query_iterator_base * clone(void * buffer) const = 0;
+    // Moves the iterator stored in the buffer to the other buffer
+    virtual query_iterator_base * move(void * buffer) = 0;
     
     virtual bool is_end() const = 0;
     virtual reference dereference() const = 0;
@@ -238,7 +270,14 @@ public:
     query_iterator_wrapper() : m_iterator() {}
     explicit query_iterator_wrapper(Iterator const& it) : m_iterator(it) {}
 
-    virtual base_t * clone() const { return new query_iterator_wrapper(m_iterator); }
+    // Creates the wrapper in the buffer if it fits, otherwise on the heap
+    static base_t * create(Iterator const& it, void * buffer)
+    {
+        return create(it, buffer, query_iterator_buffer::fits<query_iterator_wrapper>());
+    }
+
+    virtual base_t * clone(void * buffer) const { return create(m_iterator, buffer); }
+    virtual base_t * move(void * buffer) { return new (buffer) query_iterator_wrapper(boost::move(m_iterator), 0); }
 
     virtual bool is_end() const { return m_iterator == end_query_iterator<Value, Allocators>(); }
     virtual reference dereference() const { return *m_iterator; }
@@ -251,6 +290,19 @@ public:
     }
 
 private:
+    template <typename It>
+    query_iterator_wrapper(BOOST_FWD_REF(It) it, int) : m_iterator(boost::forward<It>(it)) {}
+
+    static base_t * create(Iterator const& it, void * buffer, boost::true_type /*fits*/)
+    {
+        return new (buffer) query_iterator_wrapper(it);
+    }
+
+    static base_t * create(Iterator const& it, void * , boost::false_type /*fits*/)
+    {
+        return new query_iterator_wrapper(it);
+    }
+
     Iterator m_iterator;
 };
 
@@ -259,7 +311,7 @@ template <typename Value, typename Allocators>
 class query_iterator
 {
     typedef query_iterator_base<Value, Allocators> iterator_base;
-    typedef boost::scoped_ptr<iterator_base> iterator_ptr;
+    typedef query_iterator_buffer::type buffer_type;
 
 public:
     typedef std::forward_iterator_tag iterator_category;
@@ -269,27 +321,34 @@ public:
     typedef typename Allocators::const_pointer pointer;
 
     query_iterator()
+        : m_ptr(0)
     {}
 
     template <typename It>
     query_iterator(It const& it)
-        : m_ptr(static_cast<iterator_base*>(
-                    new query_iterator_wrapper<Value, Allocators, It>(it) ))
+        : m_ptr(query_iterator_wrapper<Value, Allocators, It>::create(it, m_buffer.address()))
     {}
 
     query_iterator(end_query_iterator<Value, Allocators> const& /*it*/)
+        : m_ptr(0)
     {}
 
     query_iterator(query_iterator const& o)
-        : m_ptr(o.m_ptr.get() ? o.m_ptr->clone() : 0)
+        : m_ptr(o.m_ptr ? o.m_ptr->clone(m_buffer.address()) : 0)
     {}
 
+    ~query_iterator()
+    {
+        destroy();
+    }
+
 #ifndef BOOST_GEOMETRY_INDEX_DETAIL_QUERY_ITERATORS_USE_MOVE
     query_iterator & operator=(query_iterator const& o)
     {
         if ( this != boost::addressof(o) )
         {
-            m_ptr.reset(o.m_ptr.get() ? o.m_ptr->clone() : 0);
+            destroy();
+            m_ptr = o.m_ptr ? o.m_ptr->clone(m_buffer.address()) : 0;
         }
         return *this;
     }
@@ -297,14 +356,14 @@ public:
     query_iterator(query_iterator && o)
         : m_ptr(0)
     {
-        m_ptr.swap(o.m_ptr);
+        take(o);
     }
     query_iterator & operator=(query_iterator && o)
     {
         if ( this != boost::addressof(o) )
         {
-            m_ptr.swap(o.m_ptr);
-            o.m_ptr.reset();
+            destroy();
+            take(o);
         }
         return *this;
     }
@@ -317,21 +376,22 @@ public:
     {
         if ( this != boost::addressof(o) )
         {
-            m_ptr.reset(o.m_ptr.get() ? o.m_ptr->clone() : 0);
+            destroy();
+            m_ptr = o.m_ptr ? o.m_ptr->clone(m_buffer.address()) : 0;
         }
         return *this;
     }
     query_iterator(BOOST_RV_REF(query_iterator) o)
         : m_ptr(0)
     {
-        m_ptr.swap(o.m_ptr);
+        take(o);
     }
     query_iterator & operator=(BOOST_RV_REF(query_iterator) o)
     {
         if ( this != boost::addressof(o) )
         {
-            m_ptr.swap(o.m_ptr);
-            o.m_ptr.reset();
+            destroy();
+            take(o);
         }
         return *this;
     }
@@ -362,16 +422,16 @@ public:
 
     friend bool operator==(query_iterator const& l, query_iterator const& r)
     {
-        if ( l.m_ptr.get() )
+        if ( l.m_ptr )
         {
-            if ( r.m_ptr.get() )
+            if ( r.m_ptr )
                 return l.m_ptr->equals(*r.m_ptr);
             else
                 return l.m_ptr->is_end();
         }
         else
         {
-            if ( r.m_ptr.get() )
+            if ( r.m_ptr )
                 return r.m_ptr->is_end();
             else
                 return true;
@@ -379,7 +439,43 @@ public:
     }
 
 private:
-    iterator_ptr m_ptr;
+    bool is_local() const
+    {
+        return dynamic_cast<const void *>(m_ptr) == m_buffer.address();
+    }
+
+    void destroy()
+    {
+        if ( m_ptr )
+        {
+            if ( is_local() )
+                m_ptr->~iterator_base();
+            else
+                delete m_ptr;
+
+            m_ptr = 0;
+        }
+    }
+
+    // The iterator allocated on the heap is taken over,
+    // the one stored in the buffer is moved
+    void take(query_iterator & o)
+    {
+        if ( o.m_ptr && o.is_local() )
+        {
+            m_ptr = o.m_ptr->move(m_buffer.address());
+            o.destroy();
+        }
+        else
+        {
+            m_ptr = o.m_ptr;
+            o.m_ptr = 0;
+        }
+    }
+
+    // declared first since the iterator is constructed in the buffer
+    buffer_type m_buffer;
+    iterator_base * m_ptr;
 };
 
 }}}}}} // namespace boost::geometry::index::detail::rtree::iterators
@@ -0,0 +1,310 @@
+// Boost.Geometry Index
+//
+// R-tree spatial join implementation
+//
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_SPATIAL_JOIN_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_SPATIAL_JOIN_HPP
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <boost/geometry/algorithms/detail/intersects/interface.hpp>
+#include <boost/geometry/util/parallel.hpp>
+
+#include <boost/geometry/index/detail/rtree/node/node.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree {
+
+// Finds the pairs of values of two rtrees which indexables intersect.
+// The trees are traversed synchronously, only the pairs of nodes which
+// boxes intersect are visited. If the trees have different heights
+// the higher one is traversed alone after reaching the leafs of the
+// lower one.
+//
+// In parallel version the pairs of nodes are expanded level by level
+// until there are enough of them to keep the threads busy. Then the
+// pairs are joined in parallel, each one into a separate container.
+// The containers are copied to the output iterator in the order of the
+// pairs so the result is the same as the one of the sequential version.
+template <typename Value1, typename Options1, typename Translator1, typename Box1, typename Allocators1,
+          typename Value2, typename Options2, typename Translator2, typename Box2, typename Allocators2>
+class spatial_join
+{
+    typedef typename rtree::internal_node<Value1, typename Options1::parameters_type, Box1, Allocators1, typename Options1::node_tag>::type internal_node1;
+    typedef typename rtree::leaf<Value1, typename Options1::parameters_type, Box1, Allocators1, typename Options1::node_tag>::type leaf1;
+    typedef typename rtree::internal_node<Value2, typename Options2::parameters_type, Box2, Allocators2, typename Options2::node_tag>::type internal_node2;
+    typedef typename rtree::leaf<Value2, typename Options2::parameters_type, Box2, Allocators2, typename Options2::node_tag>::type leaf2;
+
+    typedef typename Allocators1::node_pointer node_pointer1;
+    typedef typename Allocators2::node_pointer node_pointer2;
+
+    // The number of pairs of nodes per thread created before the parallel join
+    static const std::size_t pairs_per_thread = 16;
+
+public:
+    typedef typename Allocators1::size_type size_type;
+    typedef std::pair<Value1, Value2> result_type;
+
+    // The nodes and their boxes, the depth is the number of levels
+    // of internal nodes below the node, 0 for leafs
+    struct node_pair
+    {
+        node_pair(node_pointer1 n1, Box1 const& b1, std::size_t d1,
+                  node_pointer2 n2, Box2 const& b2, std::size_t d2)
+            : node1(n1), box1(b1), depth1(d1)
+            , node2(n2), box2(b2), depth2(d2)
+        {}
+
+        node_pointer1 node1;
+        Box1 box1;
+        std::size_t depth1;
+        node_pointer2 node2;
+        Box2 box2;
+        std::size_t depth2;
+    };
+
+    spatial_join(Translator1 const& tr1, Translator2 const& tr2)
+        : m_tr1(tr1), m_tr2(tr2)
+    {}
+
+    template <typename OutIter>
+    size_type apply(node_pair const& roots, OutIter out_it) const
+    {
+        size_type found_count = 0;
+        join(roots, out_it, found_count);
+        return found_count;
+    }
+
+    template <typename OutIter>
+    size_type apply(node_pair const& roots, OutIter out_it, std::size_t threads) const
+    {
+        if ( threads <= 1 )
+            return apply(roots, out_it);
+
+        std::vector<node_pair> pairs;
+        pairs.push_back(roots);
+        expand(pairs, threads * pairs_per_thread);                                              // MAY THROW (A)
+
+        std::vector<std::vector<result_type> > results(pairs.size());                           // MAY THROW (A)
+        join_task task(*this, pairs, results);
+        geometry::detail::parallel::for_each_index(pairs.size(), task, threads);                // MAY THROW
+
+        size_type found_count = 0;
+        for ( std::size_t i = 0 ; i < results.size() ; ++i )
+        {
+            out_it = std::copy(results[i].begin(), results[i].end(), out_it);                   // MAY THROW (C)
+            found_count += results[i].size();
+        }
+        return found_count;
+    }
+
+private:
+    template <typename OutIter>
+    struct join_children
+    {
+        join_children(spatial_join const& sj, OutIter & out_it, size_type & found_count)
+            : m_sj(sj), m_out_iter(out_it), m_found_count(found_count)
+        {}
+
+        void operator()(node_pair const& p)
+        {
+            m_sj.join(p, m_out_iter, m_found_count);
+        }
+
+        spatial_join const& m_sj;
+        OutIter & m_out_iter;
+        size_type & m_found_count;
+    };
+
+    struct push_back_pair
+    {
+        explicit push_back_pair(std::vector<node_pair> & pairs)
+            : m_pairs(pairs)
+        {}
+
+        void operator()(node_pair const& p)
+        {
+            m_pairs.push_back(p);
+        }
+
+        std::vector<node_pair> & m_pairs;
+    };
+
+    struct join_task
+    {
+        join_task(spatial_join const& sj,
+                  std::vector<node_pair> const& pairs,
+                  std::vector<std::vector<result_type> > & results)
+            : m_sj(sj), m_pairs(pairs), m_results(results)
+        {}
+
+        void operator()(std::size_t i)
+        {
+            m_sj.apply(m_pairs[i], std::back_inserter(m_results[i]));
+        }
+
+        spatial_join const& m_sj;
+        std::vector<node_pair> const& m_pairs;
+        std::vector<std::vector<result_type> > & m_results;
+    };
+
+    template <typename OutIter>
+    void join(node_pair const& p, OutIter & out_it, size_type & found_count) const
+    {
+        if ( p.depth1 == 0 && p.depth2 == 0 )
+        {
+            join_leafs(p, out_it, found_count);
+        }
+        else
+        {
+            join_children<OutIter> f(*this, out_it, found_count);
+            for_each_children_pair(p, f);
+        }
+    }
+
+    // Replaces the pairs with the pairs of their children as long as
+    // the number of pairs is smaller than the requested one
+    void expand(std::vector<node_pair> & pairs, std::size_t count) const
+    {
+        while ( pairs.size() < count )
+        {
+            std::vector<node_pair> children;
+            push_back_pair f(children);
+            bool expanded = false;
+            for ( std::size_t i = 0 ; i < pairs.size() ; ++i )
+            {
+                if ( pairs[i].depth1 == 0 && pairs[i].depth2 == 0 )
+                {
+                    children.push_back(pairs[i]);
+                }
+                else
+                {
+                    for_each_children_pair(pairs[i], f);
+                    expanded = true;
+                }
+            }
+
+            if ( !expanded )
+                break;
+
+            pairs.swap(children);
+        }
+    }
+
+    // Calls f for each pair of the children of nodes which boxes intersect.
+    // If one of the nodes is a leaf the children of the other one
+    // intersecting the leaf's box are paired with the leaf.
+    template <typename F>
+    void for_each_children_pair(node_pair const& p, F & f) const
+    {
+        if ( 0 < p.depth1 && 0 < p.depth2 )
+        {
+            typedef typename rtree::elements_type<internal_node1>::type elements1_type;
+            typedef typename rtree::elements_type<internal_node2>::type elements2_type;
+            elements1_type const& elements1 = rtree::elements(rtree::get<internal_node1>(const_node(*p.node1)));
+            elements2_type const& elements2 = rtree::elements(rtree::get<internal_node2>(const_node(*p.node2)));
+
+            for ( typename elements1_type::const_iterator it1 = elements1.begin() ;
+                  it1 != elements1.end() ; ++it1 )
+            {
+                if ( !geometry::intersects(it1->first, p.box2) )
+                    continue;
+
+                for ( typename elements2_type::const_iterator it2 = elements2.begin() ;
+                      it2 != elements2.end() ; ++it2 )
+                {
+                    if ( geometry::intersects(it1->first, it2->first) )
+                    {
+                        f(node_pair(it1->second, it1->first, p.depth1 - 1,
+                                    it2->second, it2->first, p.depth2 - 1));
+                    }
+                }
+            }
+        }
+        else if ( 0 < p.depth1 )
+        {
+            typedef typename rtree::elements_type<internal_node1>::type elements1_type;
+            elements1_type const& elements1 = rtree::elements(rtree::get<internal_node1>(const_node(*p.node1)));
+
+            for ( typename elements1_type::const_iterator it1 = elements1.begin() ;
+                  it1 != elements1.end() ; ++it1 )
+            {
+                if ( geometry::intersects(it1->first, p.box2) )
+                {
+                    f(node_pair(it1->second, it1->first, p.depth1 - 1,
+                                p.node2, p.box2, 0));
+                }
+            }
+        }
+        else
+        {
+            typedef typename rtree::elements_type<internal_node2>::type elements2_type;
+            elements2_type const& elements2 = rtree::elements(rtree::get<internal_node2>(const_node(*p.node2)));
+
+            for ( typename elements2_type::const_iterator it2 = elements2.begin() ;
+                  it2 != elements2.end() ; ++it2 )
+            {
+                if ( geometry::intersects(p.box1, it2->first) )
+                {
+                    f(node_pair(p.node1, p.box1, 0,
+                                it2->second, it2->first, p.depth2 - 1));
+                }
+            }
+        }
+    }
+
+    // The nodes are accessed only through const references, the mutable
+    // access to the elements could e.g. mark the SoA bounds as outdated.
+    template <typename Node>
+    static inline Node const& const_node(Node const& n)
+    {
+        return n;
+    }
+
+    template <typename OutIter>
+    void join_leafs(node_pair const& p, OutIter & out_it, size_type & found_count) const
+    {
+        typedef typename rtree::elements_type<leaf1>::type elements1_type;
+        typedef typename rtree::elements_type<leaf2>::type elements2_type;
+        elements1_type const& elements1 = rtree::elements(rtree::get<leaf1>(const_node(*p.node1)));
+        elements2_type const& elements2 = rtree::elements(rtree::get<leaf2>(const_node(*p.node2)));
+
+        for ( typename elements1_type::const_iterator it1 = elements1.begin() ;
+              it1 != elements1.end() ; ++it1 )
+        {
+            typename indexable_type<Translator1>::type const& indexable1 = m_tr1(*it1);
+            if ( !geometry::intersects(indexable1, p.box2) )
+                continue;
+
+            for ( typename elements2_type::const_iterator it2 = elements2.begin() ;
+                  it2 != elements2.end() ; ++it2 )
+            {
+                if ( geometry::intersects(indexable1, m_tr2(*it2)) )
+                {
+                    *out_it = result_type(*it1, *it2);                                          // MAY THROW (C)
+                    ++out_it;
+                    ++found_count;
+                }
+            }
+        }
+    }
+
+    Translator1 const& m_tr1;
+    Translator2 const& m_tr2;
+};
+
+}} // namespace detail::rtree
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_SPATIAL_JOIN_HPP
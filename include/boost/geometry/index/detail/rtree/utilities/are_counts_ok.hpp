@@ -2,7 +2,7 @@
 //
 // R-tree nodes elements numbers validating visitor implementation
 //
-// Copyright (c) 2011-2015 Adam Wulkiewicz, Lodz, Poland.
+// Copyright (c) 2011-2018 Adam Wulkiewicz, Lodz, Poland.
 //
 // Use, modification and distribution is subject to the Boost Software License,
 // Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
@@ -93,12 +93,15 @@ bool are_counts_ok(Rtree const& tree)
     typedef utilities::view<Rtree> RTV;
     RTV rtv(tree);
 
+    // the visitor stores a reference, parameters() returns by value
+    typename RTV::options_type::parameters_type const parameters = tree.parameters();
+
     visitors::are_counts_ok<
         typename RTV::value_type,
         typename RTV::options_type,
         typename RTV::box_type,
         typename RTV::allocators_type
-    > v(tree.parameters());
+    > v(parameters);
     
     rtv.apply_visitor(v);
 
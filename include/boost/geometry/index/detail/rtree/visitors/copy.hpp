@@ -2,7 +2,7 @@
 //
 // R-tree deep copying visitor implementation
 //
-// Copyright (c) 2011-2015 Adam Wulkiewicz, Lodz, Poland.
+// Copyright (c) 2011-2018 Adam Wulkiewicz, Lodz, Poland.
 //
 // Use, modification and distribution is subject to the Boost Software License,
 // Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
@@ -38,11 +38,13 @@ public:
         subtree_destroyer new_node(raw_new_node, m_allocators);
 
         typedef typename rtree::elements_type<internal_node>::type elements_type;
-        elements_type & elements = rtree::elements(n);
+        // the source is not modified
+        internal_node const& src = n;
+        elements_type const& elements = rtree::elements(src);
 
         elements_type & elements_dst = rtree::elements(rtree::get<internal_node>(*new_node));
 
-        for (typename elements_type::iterator it = elements.begin();
+        for (typename elements_type::const_iterator it = elements.begin();
             it != elements.end(); ++it)
         {
             rtree::apply_visitor(*this, *it->second);                                                   // MAY THROW (V, E: alloc, copy, N: alloc) 
@@ -65,11 +67,13 @@ public:
         subtree_destroyer new_node(raw_new_node, m_allocators);
 
         typedef typename rtree::elements_type<leaf>::type elements_type;
-        elements_type & elements = rtree::elements(l);
+        // the source is not modified
+        leaf const& src = l;
+        elements_type const& elements = rtree::elements(src);
 
         elements_type & elements_dst = rtree::elements(rtree::get<leaf>(*new_node));
 
-        for (typename elements_type::iterator it = elements.begin();
+        for (typename elements_type::const_iterator it = elements.begin();
             it != elements.end(); ++it)
         {
             elements_dst.push_back(*it);                                                                // MAY THROW, STRONG (V: alloc, copy)
@@ -0,0 +1,131 @@
+// Boost.Geometry Index
+//
+// R-tree spatial batch query visitor implementation
+//
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_SPATIAL_BATCH_QUERY_HPP
+#define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_SPATIAL_BATCH_QUERY_HPP
+
+#include <utility>
+#include <vector>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree { namespace visitors {
+
+// Performs many spatial queries in one traversal of the tree. For each node
+// the indexes of queries which predicates are met by the node's box are
+// stored. Only these queries are checked for the children so the upper
+// levels of the tree common for many queries are traversed once.
+// The indexes of all visited nodes are stored in one buffer, the indexes
+// of the current node are in range [m_first, m_last).
+template <typename Value, typename Options, typename Translator, typename Box, typename Allocators, typename PredicatesIterator, typename OutIter>
+struct spatial_batch_query
+    : public rtree::visitor<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag, true>::type
+{
+    typedef typename rtree::node<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type node;
+    typedef typename rtree::internal_node<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type internal_node;
+    typedef typename rtree::leaf<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type leaf;
+
+    typedef typename Allocators::size_type size_type;
+
+    typedef typename std::iterator_traits<PredicatesIterator>::value_type predicates_type;
+    static const unsigned predicates_len = index::detail::predicates_length<predicates_type>::value;
+
+    inline spatial_batch_query(Translator const& t, PredicatesIterator first, std::size_t count, OutIter out_it)
+        : tr(t), pred_first(first), out_iter(out_it), found_count(0)
+        , m_first(0), m_last(count)
+    {
+        m_indexes.reserve(count);
+        for ( std::size_t i = 0 ; i < count ; ++i )
+            m_indexes.push_back(i);
+    }
+
+    inline void operator()(internal_node const& n)
+    {
+        typedef typename rtree::elements_type<internal_node>::type elements_type;
+        elements_type const& elements = rtree::elements(n);
+
+        std::size_t const first = m_first;
+        std::size_t const last = m_last;
+
+        // traverse nodes meeting predicates of at least one query
+        for (typename elements_type::const_iterator it = elements.begin();
+            it != elements.end(); ++it)
+        {
+            std::size_t const child_first = m_indexes.size();
+
+            for ( std::size_t i = first ; i < last ; ++i )
+            {
+                std::size_t const query_index = m_indexes[i];
+                // 0 - dummy value
+                if ( index::detail::predicates_check<index::detail::bounds_tag, 0, predicates_len>(
+                        *(pred_first + query_index), 0, it->first) )
+                {
+                    m_indexes.push_back(query_index);
+                }
+            }
+
+            if ( child_first < m_indexes.size() )
+            {
+                m_first = child_first;
+                m_last = m_indexes.size();
+
+                rtree::apply_visitor(*this, *it->second);
+            }
+
+            m_indexes.resize(child_first);
+        }
+
+        m_first = first;
+        m_last = last;
+    }
+
+    inline void operator()(leaf const& n)
+    {
+        typedef typename rtree::elements_type<leaf>::type elements_type;
+        elements_type const& elements = rtree::elements(n);
+
+        // get all values meeting predicates of active queries
+        for (typename elements_type::const_iterator it = elements.begin();
+            it != elements.end(); ++it)
+        {
+            for ( std::size_t i = m_first ; i < m_last ; ++i )
+            {
+                std::size_t const query_index = m_indexes[i];
+                // if value meets predicates
+                if ( index::detail::predicates_check<index::detail::value_tag, 0, predicates_len>(
+                        *(pred_first + query_index), *it, tr(*it)) )
+                {
+                    *out_iter = std::make_pair(query_index, *it);
+                    ++out_iter;
+
+                    ++found_count;
+                }
+            }
+        }
+    }
+
+    Translator const& tr;
+
+    PredicatesIterator pred_first;
+
+    OutIter out_iter;
+    size_type found_count;
+
+private:
+    std::vector<std::size_t> m_indexes;
+    std::size_t m_first;
+    std::size_t m_last;
+};
+
+}}} // namespace detail::rtree::visitors
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_SPATIAL_BATCH_QUERY_HPP
@@ -2,7 +2,7 @@
 //
 // R-tree spatial query visitor implementation
 //
-// Copyright (c) 2011-2014 Adam Wulkiewicz, Lodz, Poland.
+// Copyright (c) 2011-2018 Adam Wulkiewicz, Lodz, Poland.
 //
 // Use, modification and distribution is subject to the Boost Software License,
 // Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
@@ -11,6 +11,14 @@
 #ifndef BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_SPATIAL_QUERY_HPP
 #define BOOST_GEOMETRY_INDEX_DETAIL_RTREE_VISITORS_SPATIAL_QUERY_HPP
 
+#include <boost/container/small_vector.hpp>
+
+// The number of levels of the tree traversed by the incremental spatial query
+// without allocating memory
+#ifndef BOOST_GEOMETRY_INDEX_DETAIL_SPATIAL_QUERY_INCREMENTAL_LEVELS
+#define BOOST_GEOMETRY_INDEX_DETAIL_SPATIAL_QUERY_INCREMENTAL_LEVELS 8
+#endif
+
 namespace boost { namespace geometry { namespace index {
 
 namespace detail { namespace rtree { namespace visitors {
@@ -36,6 +44,15 @@ struct spatial_query
         typedef typename rtree::elements_type<internal_node>::type elements_type;
         elements_type const& elements = rtree::elements(n);
 
+        // check all elements at once if the node supports it
+        typename rtree::soa_mask<internal_node>::type mask;
+        if ( rtree::soa_predicates_check(n, pred, mask) )
+        {
+            for ( std::size_t i = mask.next(0) ; i < elements.size() ; i = mask.next(i + 1) )
+                rtree::apply_visitor(*this, *elements[i].second);
+            return;
+        }
+
         // traverse nodes meeting predicates
         for (typename elements_type::const_iterator it = elements.begin();
             it != elements.end(); ++it)
@@ -52,6 +69,29 @@ struct spatial_query
         typedef typename rtree::elements_type<leaf>::type elements_type;
         elements_type const& elements = rtree::elements(n);
 
+        // the bounds of values not meeting the predicates may be rejected at once
+        typename rtree::soa_mask<leaf>::type mask;
+        if ( rtree::soa_predicates_check(n, pred, mask) )
+        {
+            static const bool is_exact = rtree::soa_bounds_exact
+                <
+                    Predicates, typename index::detail::indexable_type<Translator>::type
+                >::value;
+
+            for ( std::size_t i = mask.next(0) ; i < elements.size() ; i = mask.next(i + 1) )
+            {
+                if ( is_exact
+                  || index::detail::predicates_check<index::detail::value_tag, 0, predicates_len>(pred, elements[i], tr(elements[i])) )
+                {
+                    *out_iter = elements[i];
+                    ++out_iter;
+
+                    ++found_count;
+                }
+            }
+            return;
+        }
+
         // get all values meeting predicates
         for (typename elements_type::const_iterator it = elements.begin();
             it != elements.end(); ++it)
@@ -202,7 +242,11 @@ private:
 
     Predicates m_pred;
 
-    std::vector< std::pair<internal_iterator, internal_iterator> > m_internal_stack;
+    boost::container::small_vector
+        <
+            std::pair<internal_iterator, internal_iterator>,
+            BOOST_GEOMETRY_INDEX_DETAIL_SPATIAL_QUERY_INCREMENTAL_LEVELS
+        > m_internal_stack;
     const leaf_elements * m_values;
     leaf_iterator m_current;
 };
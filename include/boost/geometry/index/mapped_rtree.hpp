@@ -0,0 +1,709 @@
+// Boost.Geometry Index
+//
+// R-tree flat image and read-only memory-mapped R-tree
+//
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_MAPPED_RTREE_HPP
+#define BOOST_GEOMETRY_INDEX_MAPPED_RTREE_HPP
+
+#include <cstring>
+#include <ostream>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/mpl/assert.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/has_trivial_copy.hpp>
+#include <boost/type_traits/has_trivial_destructor.hpp>
+
+#include <boost/geometry/index/rtree.hpp>
+
+namespace boost { namespace geometry { namespace index {
+
+namespace detail { namespace rtree { namespace flat {
+
+// The image consists of:
+// - the header and the bounds of all values,
+// - the nodes stored in breadth-first order, starting at the page boundary.
+// Each node consists of the node header and the array of elements.
+// Internal nodes store the boxes and the offsets of the children relative
+// to the beginning of the image so the image may be placed at any address.
+// Leafs store the Values. Therefore the Values have to be trivially copyable.
+// The data is stored using the native byte order and types layout.
+
+static const boost::uint32_t image_version = 1;
+static const boost::uint32_t image_endianness = 0x01020304;
+static const boost::uint64_t image_page_size = 4096;
+
+struct image_header
+{
+    char magic[8];
+    boost::uint32_t endianness;
+    boost::uint32_t version;
+    boost::uint32_t dimension;
+    boost::uint32_t coordinate_size;
+    boost::uint32_t value_size;
+    boost::uint32_t internal_element_size;
+    boost::uint32_t alignment;
+    boost::uint32_t reserved;
+    boost::uint64_t values_count;
+    boost::uint64_t leafs_level;
+    boost::uint64_t nodes_count;
+    boost::uint64_t root_offset;
+    boost::uint64_t image_size;
+};
+
+struct node_header
+{
+    boost::uint32_t is_leaf;
+    boost::uint32_t count;
+};
+
+template <typename Box>
+struct internal_element
+{
+    Box box;
+    boost::uint64_t offset;
+};
+
+inline const char * image_magic()
+{
+    return "BGIRTREE";
+}
+
+inline boost::uint64_t align_up(boost::uint64_t offset, boost::uint64_t alignment)
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+template <typename Value, typename Box>
+struct image_traits
+{
+    BOOST_MPL_ASSERT_MSG((boost::has_trivial_copy<Value>::value
+                          && boost::has_trivial_destructor<Value>::value),
+                         VALUE_MUST_BE_TRIVIALLY_COPYABLE,
+                         (Value));
+
+    static const std::size_t internal_alignment = boost::alignment_of< internal_element<Box> >::value;
+    static const std::size_t value_alignment = boost::alignment_of<Value>::value;
+    static const std::size_t header_alignment = boost::alignment_of<image_header>::value;
+
+    static const std::size_t alignment1 = internal_alignment < value_alignment ? value_alignment : internal_alignment;
+    static const std::size_t alignment = alignment1 < header_alignment ? header_alignment : alignment1;
+
+    static boost::uint64_t bounds_offset()
+    {
+        return align_up(sizeof(image_header), alignment);
+    }
+
+    static boost::uint64_t elements_offset()
+    {
+        return align_up(sizeof(node_header), alignment);
+    }
+
+    static boost::uint64_t node_size(bool is_leaf, std::size_t count)
+    {
+        return align_up(elements_offset()
+                        + count * (is_leaf ? sizeof(Value) : sizeof(internal_element<Box>)),
+                        alignment);
+    }
+};
+
+// Visits the nodes in breadth-first order. For each node calls
+// Policy::apply(node_index, is_leaf, elements, first_child_index).
+template <typename Value, typename Options, typename Translator, typename Box, typename Allocators, typename Policy>
+class breadth_first_visitor
+    : public rtree::visitor<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag, true>::type
+{
+    typedef typename rtree::internal_node<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type internal_node;
+    typedef typename rtree::leaf<Value, typename Options::parameters_type, Box, Allocators, typename Options::node_tag>::type leaf;
+    typedef typename Allocators::node_pointer node_pointer;
+
+public:
+    explicit breadth_first_visitor(Policy & policy)
+        : m_policy(policy), m_current(0)
+    {}
+
+    // called for the root
+    template <typename RtreeView>
+    void apply(RtreeView const& view)
+    {
+        m_nodes.clear();
+        m_nodes.push_back(node_pointer(0));
+        m_current = 0;
+
+        view.apply_visitor(*this);
+
+        for ( m_current = 1 ; m_current < m_nodes.size() ; ++m_current )
+            rtree::apply_visitor(*this, *m_nodes[m_current]);
+    }
+
+    inline void operator()(internal_node const& n)
+    {
+        typedef typename rtree::elements_type<internal_node>::type elements_type;
+        elements_type const& elements = rtree::elements(n);
+
+        std::size_t const first_child = m_nodes.size();
+        for ( typename elements_type::const_iterator it = elements.begin() ;
+              it != elements.end() ; ++it )
+        {
+            m_nodes.push_back(it->second);
+        }
+
+        m_policy.apply(m_current, false, elements, first_child);
+    }
+
+    inline void operator()(leaf const& n)
+    {
+        m_policy.apply(m_current, true, rtree::elements(n), 0);
+    }
+
+private:
+    Policy & m_policy;
+    std::vector<node_pointer> m_nodes;
+    std::size_t m_current;
+};
+
+template <typename Value, typename Box>
+struct layout_policy
+{
+    typedef image_traits<Value, Box> traits;
+
+    layout_policy()
+        : size(0)
+    {}
+
+    template <typename Elements>
+    void apply(std::size_t node_index, bool is_leaf, Elements const& elements, std::size_t /*first_child*/)
+    {
+        BOOST_GEOMETRY_INDEX_ASSERT(node_index == offsets.size(), "unexpected node index");
+        boost::ignore_unused(node_index);
+
+        offsets.push_back(size);
+        size += traits::node_size(is_leaf, elements.size());
+    }
+
+    std::vector<boost::uint64_t> offsets;
+    boost::uint64_t size;
+};
+
+inline void write_padding(std::ostream & os, boost::uint64_t count)
+{
+    static const char zeros[64] = { 0 };
+    while ( count > 0 )
+    {
+        std::size_t const n = count < sizeof(zeros) ? static_cast<std::size_t>(count) : sizeof(zeros);
+        os.write(zeros, n);
+        count -= n;
+    }
+}
+
+template <typename Value, typename Box>
+struct write_policy
+{
+    typedef image_traits<Value, Box> traits;
+
+    write_policy(std::ostream & s, std::vector<boost::uint64_t> const& o, boost::uint64_t b)
+        : os(s), offsets(o), base(b)
+    {}
+
+    template <typename Elements>
+    void apply(std::size_t node_index, bool is_leaf, Elements const& elements, std::size_t first_child)
+    {
+        node_header header;
+        header.is_leaf = is_leaf ? 1 : 0;
+        header.count = static_cast<boost::uint32_t>(elements.size());
+        os.write(reinterpret_cast<const char*>(&header), sizeof(node_header));
+        write_padding(os, traits::elements_offset() - sizeof(node_header));
+
+        std::size_t i = 0;
+        for ( typename Elements::const_iterator it = elements.begin() ;
+              it != elements.end() ; ++it, ++i )
+        {
+            write_element(*it, first_child + i);
+        }
+
+        boost::uint64_t const written = traits::elements_offset()
+            + elements.size() * (is_leaf ? sizeof(Value) : sizeof(internal_element<Box>));
+        write_padding(os, traits::node_size(is_leaf, elements.size()) - written);
+
+        boost::ignore_unused(node_index);
+    }
+
+    template <typename NodePtr>
+    void write_element(rtree::ptr_pair<Box, NodePtr> const& el, std::size_t child_index)
+    {
+        internal_element<Box> e;
+        std::memset(&e, 0, sizeof(e));
+        geometry::convert(el.first, e.box);
+        e.offset = base + offsets[child_index];
+        os.write(reinterpret_cast<const char*>(&e), sizeof(e));
+    }
+
+    void write_element(Value const& v, std::size_t /*child_index*/)
+    {
+        os.write(reinterpret_cast<const char*>(&v), sizeof(Value));
+    }
+
+    std::ostream & os;
+    std::vector<boost::uint64_t> const& offsets;
+    boost::uint64_t base;
+};
+
+// Returns the header of the node placed at offset, throws if the node or its
+// elements are not placed within the image or the kind of the node is invalid.
+// The children are stored after the parent so the offsets can't form a cycle.
+template <typename Value, typename Box>
+inline node_header const& checked_node(const char * data, image_header const& image,
+                                       boost::uint64_t offset, boost::uint64_t parent_offset,
+                                       bool is_leaf)
+{
+    typedef image_traits<Value, Box> traits;
+
+    if ( offset <= parent_offset
+      || offset < traits::bounds_offset() + sizeof(Box)
+      || offset % traits::alignment != 0
+      || offset > image.image_size
+      || image.image_size - offset < traits::elements_offset() )
+        index::detail::throw_runtime_error("boost::geometry::index::flat_rtree_view: invalid node offset");
+
+    node_header const& header = *reinterpret_cast<node_header const*>(data + offset);
+    boost::uint64_t const element_size = is_leaf ? sizeof(Value) : sizeof(internal_element<Box>);
+
+    if ( header.is_leaf != (is_leaf ? 1u : 0u)
+      || header.count == 0
+      || header.count > (image.image_size - offset - traits::elements_offset()) / element_size )
+        index::detail::throw_runtime_error("boost::geometry::index::flat_rtree_view: invalid node");
+
+    return header;
+}
+
+// Spatial query performed on the image, the nodes are checked when visited
+template <typename Value, typename Box, typename Translator, typename Predicates, typename OutIter>
+struct spatial_query
+{
+    typedef internal_element<Box> internal_element_type;
+    typedef image_traits<Value, Box> traits;
+
+    static const unsigned predicates_len = index::detail::predicates_length<Predicates>::value;
+
+    spatial_query(const char * d, image_header const& i, Translator const& t, Predicates const& p, OutIter out_it)
+        : data(d), image(i), tr(t), pred(p), out_iter(out_it), found_count(0)
+    {}
+
+    void apply(boost::uint64_t offset, boost::uint64_t parent_offset, boost::uint64_t level)
+    {
+        bool const is_leaf = level == image.leafs_level;
+        node_header const& header = checked_node<Value, Box>(data, image, offset, parent_offset, is_leaf);
+        const char * elements = data + offset + traits::elements_offset();
+
+        if ( is_leaf )
+        {
+            Value const* first = reinterpret_cast<Value const*>(elements);
+            Value const* last = first + header.count;
+            for ( ; first != last ; ++first )
+            {
+                if ( index::detail::predicates_check<index::detail::value_tag, 0, predicates_len>(pred, *first, tr(*first)) )
+                {
+                    *out_iter = *first;
+                    ++out_iter;
+                    ++found_count;
+                }
+            }
+        }
+        else
+        {
+            internal_element_type const* first = reinterpret_cast<internal_element_type const*>(elements);
+            internal_element_type const* last = first + header.count;
+            for ( ; first != last ; ++first )
+            {
+                // 0 - dummy value
+                if ( index::detail::predicates_check<index::detail::bounds_tag, 0, predicates_len>(pred, 0, first->box) )
+                    apply(first->offset, offset, level + 1);
+            }
+        }
+    }
+
+    const char * data;
+    image_header const& image;
+    Translator const& tr;
+    Predicates const& pred;
+    OutIter out_iter;
+    std::size_t found_count;
+};
+
+}}} // namespace detail::rtree::flat
+
+/*!
+\brief Writes the flat image of the rtree.
+
+The image may be mapped into memory and used by the \c flat_rtree_view or
+\c mapped_rtree without loading. The Values are copied bitwise so they have
+to be trivially copyable. The image uses native byte order and types layout.
+
+\ingroup rtree_functions
+
+\param tree     The rtree.
+\param os       The output stream opened in binary mode.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator>
+inline void write_flat_image(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree,
+                             std::ostream & os)
+{
+    typedef rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> rtree_type;
+    typedef detail::rtree::utilities::view<rtree_type> view_type;
+    typedef typename view_type::box_type box_type;
+    typedef detail::rtree::flat::image_traits<Value, box_type> traits;
+    typedef detail::rtree::flat::layout_policy<Value, box_type> layout_policy;
+    typedef detail::rtree::flat::write_policy<Value, box_type> write_policy;
+
+    view_type view(tree);
+
+    // calculate the offsets of nodes
+    layout_policy layout;
+    if ( ! tree.empty() )
+    {
+        detail::rtree::flat::breadth_first_visitor
+            <
+                Value, typename view_type::options_type, typename view_type::translator_type,
+                box_type, typename view_type::allocators_type, layout_policy
+            > layout_v(layout);
+        layout_v.apply(view);
+    }
+
+    boost::uint64_t const nodes_offset = detail::rtree::flat::image_page_size;
+
+    detail::rtree::flat::image_header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, detail::rtree::flat::image_magic(), sizeof(header.magic));
+    header.endianness = detail::rtree::flat::image_endianness;
+    header.version = detail::rtree::flat::image_version;
+    header.dimension = geometry::dimension<box_type>::value;
+    header.coordinate_size = sizeof(typename coordinate_type<box_type>::type);
+    header.value_size = sizeof(Value);
+    header.internal_element_size = sizeof(detail::rtree::flat::internal_element<box_type>);
+    header.alignment = traits::alignment;
+    header.values_count = tree.size();
+    header.leafs_level = view.depth();
+    header.nodes_count = layout.offsets.size();
+    header.root_offset = tree.empty() ? 0 : nodes_offset;
+    header.image_size = nodes_offset + layout.size;
+
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    detail::rtree::flat::write_padding(os, traits::bounds_offset() - sizeof(header));
+
+    box_type bounds = tree.bounds();
+    os.write(reinterpret_cast<const char*>(&bounds), sizeof(box_type));
+    detail::rtree::flat::write_padding(os, nodes_offset - traits::bounds_offset() - sizeof(box_type));
+
+    if ( ! tree.empty() )
+    {
+        write_policy writer(os, layout.offsets, nodes_offset);
+        detail::rtree::flat::breadth_first_visitor
+            <
+                Value, typename view_type::options_type, typename view_type::translator_type,
+                box_type, typename view_type::allocators_type, write_policy
+            > write_v(writer);
+        write_v.apply(view);
+    }
+}
+
+/*!
+\brief The read-only R-tree stored in the flat image.
+
+The object of this type doesn't own the data. The queries are performed
+directly on the image, e.g. written by \c write_flat_image() and mapped
+into memory. The data must be aligned at least as the Values and
+coordinates, e.g. at the page boundary. Only the header of the image is
+checked in the constructor so opening the image takes constant time. The
+nodes are checked when they are visited by a query. The whole image may be
+checked explicitly with \c validate().
+
+\tparam Value           The type of objects stored in the image.
+\tparam IndexableGetter The function object extracting Indexable from Value.
+\tparam EqualTo         The function object comparing objects of type Value.
+*/
+template
+<
+    typename Value,
+    typename IndexableGetter = index::indexable<Value>,
+    typename EqualTo = index::equal_to<Value>
+>
+class flat_rtree_view
+{
+    typedef detail::translator<IndexableGetter, EqualTo> translator_type;
+
+public:
+    /*! \brief The type of Value stored in the container. */
+    typedef Value value_type;
+    /*! \brief The Indexable type to which Value is translated. */
+    typedef typename index::detail::indexable_type<translator_type>::type indexable_type;
+    /*! \brief The Box type used by the R-tree. */
+    typedef geometry::model::box<
+                geometry::model::point<
+                    typename coordinate_type<indexable_type>::type,
+                    dimension<indexable_type>::value,
+                    typename coordinate_system<indexable_type>::type
+                >
+            > bounds_type;
+    /*! \brief Unsigned integral type used by the container. */
+    typedef std::size_t size_type;
+
+private:
+    typedef detail::rtree::flat::image_traits<Value, bounds_type> traits;
+
+public:
+    /*!
+    \brief The constructor of the empty view.
+    */
+    flat_rtree_view()
+        : m_data(0), m_header(0), m_translator(IndexableGetter(), EqualTo())
+    {}
+
+    /*!
+    \brief The constructor.
+
+    \param data     The pointer to the image.
+    \param size     The size of the image.
+    \param getter   The function object extracting Indexable from Value.
+    \param equal    The function object comparing Values.
+
+    \par Throws
+    std::runtime_error if the header of the image is invalid or incompatible
+    with the types.
+    */
+    flat_rtree_view(const void * data, std::size_t size,
+                    IndexableGetter const& getter = IndexableGetter(),
+                    EqualTo const& equal = EqualTo())
+        : m_data(static_cast<const char*>(data))
+        , m_header(static_cast<detail::rtree::flat::image_header const*>(data))
+        , m_translator(getter, equal)
+    {
+        check(size);
+    }
+
+    /*!
+    \brief Finds values meeting passed spatial predicates.
+
+    \param predicates   Spatial predicates.
+    \param out_it       The output iterator, e.g. generated by std::back_inserter().
+
+    \return             The number of values found.
+
+    \par Throws
+    std::runtime_error if a visited node is invalid.
+    */
+    template <typename Predicates, typename OutIter>
+    size_type query(Predicates const& predicates, OutIter out_it) const
+    {
+        BOOST_MPL_ASSERT_MSG((detail::predicates_count_distance<Predicates>::value == 0),
+                             DISTANCE_PREDICATES_ARE_NOT_SUPPORTED,
+                             (Predicates));
+
+        if ( empty() )
+            return 0;
+
+        detail::rtree::flat::spatial_query
+            <
+                Value, bounds_type, translator_type, Predicates, OutIter
+            > query_v(m_data, *m_header, m_translator, predicates, out_it);
+
+        query_v.apply(m_header->root_offset, 0, 0);
+
+        return query_v.found_count;
+    }
+
+    /*!
+    \brief Returns the number of stored values.
+    */
+    size_type size() const
+    {
+        return m_header ? static_cast<size_type>(m_header->values_count) : 0;
+    }
+
+    /*!
+    \brief Query if the container is empty.
+    */
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    /*!
+    \brief Returns the box able to contain all values stored in the container.
+    */
+    bounds_type bounds() const
+    {
+        bounds_type result;
+        if ( empty() )
+            geometry::assign_inverse(result);
+        else
+            std::memcpy(&result, m_data + traits::bounds_offset(), sizeof(bounds_type));
+        return result;
+    }
+
+    /*!
+    \brief Returns the depth of the tree.
+    */
+    size_type depth() const
+    {
+        return m_header ? static_cast<size_type>(m_header->leafs_level) : 0;
+    }
+
+    /*!
+    \brief Checks the structure of the whole image.
+
+    All nodes are visited so all pages of the image are accessed. The nodes
+    and their elements have to be placed within the image, the leafs have
+    to be at the same level and the number of values has to match.
+
+    \par Throws
+    std::runtime_error if the image is invalid.
+    */
+    void validate() const
+    {
+        namespace flat = detail::rtree::flat;
+
+        if ( empty() )
+            return;
+
+        boost::uint64_t values_count = 0;
+        boost::uint64_t nodes_count = 0;
+
+        // offset, parent offset and level of nodes
+        std::vector< boost::tuple<boost::uint64_t, boost::uint64_t, boost::uint64_t> > stack;
+        stack.push_back(boost::make_tuple(m_header->root_offset, boost::uint64_t(0), boost::uint64_t(0)));
+
+        while ( ! stack.empty() )
+        {
+            boost::uint64_t const offset = boost::get<0>(stack.back());
+            boost::uint64_t const parent_offset = boost::get<1>(stack.back());
+            boost::uint64_t const level = boost::get<2>(stack.back());
+            stack.pop_back();
+
+            if ( ++nodes_count > m_header->nodes_count )
+                detail::throw_runtime_error("boost::geometry::index::flat_rtree_view: invalid nodes count");
+
+            bool const is_leaf = level == m_header->leafs_level;
+            flat::node_header const& header
+                = flat::checked_node<Value, bounds_type>(m_data, *m_header, offset, parent_offset, is_leaf);
+
+            if ( is_leaf )
+            {
+                values_count += header.count;
+            }
+            else
+            {
+                flat::internal_element<bounds_type> const* elements
+                    = reinterpret_cast<flat::internal_element<bounds_type> const*>(m_data + offset + traits::elements_offset());
+                for ( boost::uint32_t i = 0 ; i < header.count ; ++i )
+                    stack.push_back(boost::make_tuple(elements[i].offset, offset, level + 1));
+            }
+        }
+
+        if ( values_count != m_header->values_count )
+            detail::throw_runtime_error("boost::geometry::index::flat_rtree_view: invalid values count");
+    }
+
+private:
+    void check(std::size_t size) const
+    {
+        namespace flat = detail::rtree::flat;
+
+        if ( size < sizeof(flat::image_header)
+          || std::memcmp(m_header->magic, flat::image_magic(), sizeof(m_header->magic)) != 0 )
+            detail::throw_runtime_error("boost::geometry::index::flat_rtree_view: invalid image");
+
+        if ( m_header->endianness != flat::image_endianness
+          || m_header->version != flat::image_version )
+            detail::throw_runtime_error("boost::geometry::index::flat_rtree_view: unsupported image version or byte order");
+
+        if ( m_header->dimension != geometry::dimension<bounds_type>::value
+          || m_header->coordinate_size != sizeof(typename coordinate_type<bounds_type>::type)
+          || m_header->value_size != sizeof(Value)
+          || m_header->internal_element_size != sizeof(flat::internal_element<bounds_type>)
+          || m_header->alignment != traits::alignment )
+            detail::throw_runtime_error("boost::geometry::index::flat_rtree_view: incompatible types");
+
+        if ( m_header->image_size > size
+          || m_header->image_size < traits::bounds_offset() + sizeof(bounds_type) )
+            detail::throw_runtime_error("boost::geometry::index::flat_rtree_view: truncated image");
+
+        BOOST_GEOMETRY_INDEX_ASSERT(reinterpret_cast<std::size_t>(m_data) % traits::alignment == 0,
+                                    "misaligned image");
+
+        // each level contains at least one node
+        if ( m_header->values_count > 0
+          && m_header->leafs_level >= m_header->nodes_count )
+            detail::throw_runtime_error("boost::geometry::index::flat_rtree_view: invalid depth");
+    }
+
+    const char * m_data;
+    detail::rtree::flat::image_header const* m_header;
+    translator_type m_translator;
+};
+
+/*!
+\brief The read-only R-tree stored in the memory-mapped file.
+
+The file containing the image written by \c write_flat_image() is mapped
+into memory. Only the header is read when the file is opened. The nodes are
+loaded by the operating system when they are accessed for the first time by
+a query. The pages are shared by all processes mapping the same file.
+
+\tparam Value           The type of objects stored in the image.
+\tparam IndexableGetter The function object extracting Indexable from Value.
+\tparam EqualTo         The function object comparing objects of type Value.
+*/
+template
+<
+    typename Value,
+    typename IndexableGetter = index::indexable<Value>,
+    typename EqualTo = index::equal_to<Value>
+>
+class mapped_rtree
+    : public flat_rtree_view<Value, IndexableGetter, EqualTo>
+{
+    typedef flat_rtree_view<Value, IndexableGetter, EqualTo> view_type;
+
+    mapped_rtree(mapped_rtree const&);
+    mapped_rtree & operator=(mapped_rtree const&);
+
+public:
+    /*!
+    \brief The constructor.
+
+    \param filename The name of the file containing the image.
+    \param getter   The function object extracting Indexable from Value.
+    \param equal    The function object comparing Values.
+
+    \par Throws
+    \li boost::interprocess::interprocess_exception if the file can't be mapped.
+    \li std::runtime_error if the header of the image is invalid or incompatible
+        with the types.
+    */
+    explicit mapped_rtree(const char * filename,
+                          IndexableGetter const& getter = IndexableGetter(),
+                          EqualTo const& equal = EqualTo())
+        : m_mapping(filename, boost::interprocess::read_only)
+        , m_region(m_mapping, boost::interprocess::read_only)
+    {
+        static_cast<view_type&>(*this) = view_type(m_region.get_address(), m_region.get_size(), getter, equal);
+    }
+
+private:
+    boost::interprocess::file_mapping m_mapping;
+    boost::interprocess::mapped_region m_region;
+};
+
+}}} // namespace boost::geometry::index
+
+#endif // BOOST_GEOMETRY_INDEX_MAPPED_RTREE_HPP
@@ -2,7 +2,7 @@
 //
 // R-tree algorithms parameters
 //
-// Copyright (c) 2011-2017 Adam Wulkiewicz, Lodz, Poland.
+// Copyright (c) 2011-2018 Adam Wulkiewicz, Lodz, Poland.
 //
 // Use, modification and distribution is subject to the Boost Software License,
 // Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
@@ -143,12 +143,48 @@ struct rstar
     static size_t get_overlap_cost_threshold() { return OverlapCostThreshold; }
 };
 
-//template <size_t MaxElements, size_t MinElements>
-//struct kmeans
-//{
-//    static const size_t max_elements = MaxElements;
-//    static const size_t min_elements = MinElements;
-//};
+/*!
+\brief R-tree parameters storing the bounds of nodes elements in the SoA layout.
+
+The nodes additionally store the min and max coordinates of their elements
+in per-dimension contiguous arrays. This way the elements of a node may be
+tested in a single pass in spatial queries using Point or Box in cartesian
+coordinate system. The modifications of the tree are slower and the nodes
+take more memory. The arrays are padded to a multiple of 16 elements, the
+number of elements checked at once, e.g. a node of rstar<20> stores the
+coordinates of 32 elements.
+
+\tparam Parameters    Static parameters, e.g. linear, quadratic, rstar or kmeans.
+*/
+template <typename Parameters>
+struct soa_layout
+    : public Parameters
+{};
+
+/*!
+\brief K-means r-tree creation algorithm parameters.
+
+The elements of the overflowing node are divided into two clusters of the
+closest centers of their bounding boxes with k-means algorithm. Nodes
+created this way have small overlap for clustered data and the split is
+cheaper than the one of quadratic and R* algorithms.
+
+\tparam MaxElements     Maximum number of elements in nodes.
+\tparam MinElements     Minimum number of elements in nodes. Default: 0.3*Max.
+*/
+template <size_t MaxElements,
+          size_t MinElements = detail::default_min_elements_s<MaxElements>::value>
+struct kmeans
+{
+    BOOST_MPL_ASSERT_MSG((0 < MinElements && 2*MinElements <= MaxElements+1),
+                         INVALID_STATIC_MIN_MAX_PARAMETERS, (kmeans));
+
+    static const size_t max_elements = MaxElements;
+    static const size_t min_elements = MinElements;
+
+    static size_t get_max_elements() { return MaxElements; }
+    static size_t get_min_elements() { return MinElements; }
+};
 
 /*!
 \brief Linear r-tree creation algorithm parameters - run-time version.
@@ -253,6 +289,46 @@ private:
     size_t m_overlap_cost_threshold;
 };
 
+/*!
+\brief K-means r-tree creation algorithm parameters - run-time version.
+*/
+class dynamic_kmeans
+{
+public:
+    /*!
+    \brief The constructor.
+
+    \param max_elements     Maximum number of elements in nodes.
+    \param min_elements     Minimum number of elements in nodes. Default: 0.3*Max.
+    */
+    explicit dynamic_kmeans(size_t max_elements,
+                            size_t min_elements = detail::default_min_elements_d())
+        : m_max_elements(max_elements)
+        , m_min_elements(detail::default_min_elements_d_calc(max_elements, min_elements))
+    {
+        if (!(0 < m_min_elements && 2*m_min_elements <= m_max_elements+1))
+            detail::throw_invalid_argument("invalid min or/and max parameters of dynamic_kmeans");
+    }
+
+    size_t get_max_elements() const { return m_max_elements; }
+    size_t get_min_elements() const { return m_min_elements; }
+
+private:
+    size_t m_max_elements;
+    size_t m_min_elements;
+};
+
+/*!
+\brief Hilbert R-tree packing algorithm.
+
+Passed to the packing constructor of the rtree. The values are sorted once
+by the positions of the centroids of their Indexables on the Hilbert curve
+and the nodes are created bottom-up. The tree is created faster than with
+the default top-down algorithm and has good structure for Points and small
+Boxes. For big or elongated Boxes the nodes may overlap more.
+*/
+struct hilbert_packing {};
+
 }}} // namespace boost::geometry::index
 
 #endif // BOOST_GEOMETRY_INDEX_PARAMETERS_HPP
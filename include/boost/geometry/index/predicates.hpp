@@ -11,6 +11,7 @@
 #ifndef BOOST_GEOMETRY_INDEX_PREDICATES_HPP
 #define BOOST_GEOMETRY_INDEX_PREDICATES_HPP
 
+#include <boost/geometry/index/detail/exception.hpp>
 #include <boost/geometry/index/detail/predicates.hpp>
 #include <boost/geometry/index/detail/tuples.hpp>
 
@@ -339,6 +340,42 @@ nearest(Geometry const& geometry, unsigned k)
     return detail::predicates::nearest<Geometry>(geometry, k);
 }
 
+/*!
+\brief Generate nearest() predicate with maximum distance.
+
+When nearest predicate is passed to the query, k-nearest neighbour search will be performed.
+Only \c Values not further than \c max_distance from the \c Geometry are returned and
+the nodes of the rtree further than \c max_distance are not traversed. The distance is
+expressed in the units of boost::geometry::distance() for the \c Geometry and \c Values,
+e.g. in the units of coordinates in cartesian coordinate system.
+
+\par Example
+\verbatim
+bgi::query(spatial_index, bgi::nearest(pt, 5, 50.0), std::back_inserter(result));
+\endverbatim
+
+\warning
+Only one \c nearest() predicate may be used in a query.
+
+\ingroup predicates
+
+\param geometry     The geometry from which distance is calculated.
+\param k            The maximum number of values to return.
+\param max_distance The maximum distance of returned values, must not be negative.
+
+\par Throws
+std::invalid_argument if \c max_distance is negative or NaN.
+*/
+template <typename Geometry> inline
+detail::predicates::nearest<Geometry>
+nearest(Geometry const& geometry, unsigned k, double max_distance)
+{
+    if ( !(0 <= max_distance) )
+        detail::throw_invalid_argument("negative max_distance of nearest predicate");
+
+    return detail::predicates::nearest<Geometry>(geometry, k, max_distance);
+}
+
 #ifdef BOOST_GEOMETRY_INDEX_DETAIL_EXPERIMENTAL
 
 /*!
@@ -17,6 +17,7 @@
 
 // Boost
 #include <boost/container/new_allocator.hpp>
+#include <boost/core/ignore_unused.hpp>
 #include <boost/move/move.hpp>
 #include <boost/tuple/tuple.hpp>
 
@@ -34,6 +35,8 @@
 #include <boost/geometry/geometries/point.hpp>
 #include <boost/geometry/geometries/box.hpp>
 
+#include <boost/geometry/util/parallel.hpp>
+
 // Boost.Geometry.Index
 #include <boost/geometry/index/detail/config_begin.hpp>
 
@@ -63,6 +66,7 @@
 #include <boost/geometry/index/detail/rtree/visitors/copy.hpp>
 #include <boost/geometry/index/detail/rtree/visitors/destroy.hpp>
 #include <boost/geometry/index/detail/rtree/visitors/spatial_query.hpp>
+#include <boost/geometry/index/detail/rtree/visitors/spatial_batch_query.hpp>
 #include <boost/geometry/index/detail/rtree/visitors/distance_query.hpp>
 #include <boost/geometry/index/detail/rtree/visitors/count.hpp>
 #include <boost/geometry/index/detail/rtree/visitors/children_box.hpp>
@@ -70,9 +74,11 @@
 #include <boost/geometry/index/detail/rtree/linear/linear.hpp>
 #include <boost/geometry/index/detail/rtree/quadratic/quadratic.hpp>
 #include <boost/geometry/index/detail/rtree/rstar/rstar.hpp>
-//#include <boost/geometry/extensions/index/detail/rtree/kmeans/kmeans.hpp>
+#include <boost/geometry/index/detail/rtree/kmeans/kmeans.hpp>
 
 #include <boost/geometry/index/detail/rtree/pack_create.hpp>
+#include <boost/geometry/index/detail/rtree/pack_hilbert.hpp>
+#include <boost/geometry/index/detail/rtree/spatial_join.hpp>
 
 #include <boost/geometry/index/inserter.hpp>
 
@@ -109,13 +115,15 @@ algorithm with specific parameters like min and max number of elements in node.
 Predefined algorithms with compile-time parameters are:
 \li <tt>boost::geometry::index::linear</tt>,
  \li <tt>boost::geometry::index::quadratic</tt>,
- \li <tt>boost::geometry::index::rstar</tt>.
+ \li <tt>boost::geometry::index::rstar</tt>,
+ \li <tt>boost::geometry::index::kmeans</tt>.
 
 \par
 Predefined algorithms with run-time parameters are:
  \li \c boost::geometry::index::dynamic_linear,
  \li \c boost::geometry::index::dynamic_quadratic,
- \li \c boost::geometry::index::dynamic_rstar.
+ \li \c boost::geometry::index::dynamic_rstar,
+ \li \c boost::geometry::index::dynamic_kmeans.
 
 \par IndexableGetter
 The object of IndexableGetter type translates from Value to Indexable each time
@@ -201,6 +209,9 @@ private:
     typedef ::boost::container::allocator_traits<Allocator> allocator_traits_type;
     typedef detail::rtree::subtree_destroyer<value_type, options_type, translator_type, box_type, allocators_type> subtree_destroyer;
 
+    template <typename V, typename P, typename I, typename E, typename A>
+    friend class rtree;
+
     friend class detail::rtree::utilities::view<rtree>;
 #ifdef BOOST_GEOMETRY_INDEX_DETAIL_EXPERIMENTAL
     friend class detail::rtree::private_view<rtree>;
@@ -335,6 +346,158 @@ public:
         m_members.leafs_level = ll;
     }
 
+    /*!
+    \brief The constructor.
+
+    The tree is created using packing algorithm in parallel. The resulting
+    tree is the same as the one created by the sequential version.
+
+    \param policy       The parallel execution policy.
+    \param first        The beginning of the range of Values.
+    \param last         The end of the range of Values.
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    \li If thread synchronization throws.
+
+    \warning
+    The allocator is used concurrently by many threads so it has to be thread-safe.
+    */
+    template<typename Iterator>
+    inline rtree(geometry::execution::parallel_policy const& policy,
+                 Iterator first, Iterator last,
+                 parameters_type const& parameters = parameters_type(),
+                 indexable_getter const& getter = indexable_getter(),
+                 value_equal const& equal = value_equal(),
+                 allocator_type const& allocator = allocator_type())
+        : m_members(getter, equal, parameters, allocator)
+    {
+        typedef detail::rtree::pack<value_type, options_type, translator_type, box_type, allocators_type> pack;
+        size_type vc = 0, ll = 0;
+        m_members.root = pack::apply(first, last, vc, ll,
+                                     m_members.parameters(), m_members.translator(), m_members.allocators(),
+                                     policy.threads());
+        m_members.values_count = vc;
+        m_members.leafs_level = ll;
+    }
+
+    /*!
+    \brief The constructor.
+
+    The tree is created using packing algorithm in parallel. The resulting
+    tree is the same as the one created by the sequential version.
+
+    \param policy       The parallel execution policy.
+    \param rng          The range of Values.
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    \li If thread synchronization throws.
+
+    \warning
+    The allocator is used concurrently by many threads so it has to be thread-safe.
+    */
+    template<typename Range>
+    inline rtree(geometry::execution::parallel_policy const& policy,
+                 Range const& rng,
+                 parameters_type const& parameters = parameters_type(),
+                 indexable_getter const& getter = indexable_getter(),
+                 value_equal const& equal = value_equal(),
+                 allocator_type const& allocator = allocator_type())
+        : m_members(getter, equal, parameters, allocator)
+    {
+        typedef detail::rtree::pack<value_type, options_type, translator_type, box_type, allocators_type> pack;
+        size_type vc = 0, ll = 0;
+        m_members.root = pack::apply(::boost::begin(rng), ::boost::end(rng), vc, ll,
+                                     m_members.parameters(), m_members.translator(), m_members.allocators(),
+                                     policy.threads());
+        m_members.values_count = vc;
+        m_members.leafs_level = ll;
+    }
+
+    /*!
+    \brief The constructor.
+
+    The tree is created using Hilbert R-tree packing algorithm.
+
+    \param packing      The packing algorithm tag.
+    \param first        The beginning of the range of Values.
+    \param last         The end of the range of Values.
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    */
+    template<typename Iterator>
+    inline rtree(index::hilbert_packing const& packing,
+                 Iterator first, Iterator last,
+                 parameters_type const& parameters = parameters_type(),
+                 indexable_getter const& getter = indexable_getter(),
+                 value_equal const& equal = value_equal(),
+                 allocator_type const& allocator = allocator_type())
+        : m_members(getter, equal, parameters, allocator)
+    {
+        boost::ignore_unused(packing);
+        typedef detail::rtree::pack_hilbert<value_type, options_type, translator_type, box_type, allocators_type> pack;
+        size_type vc = 0, ll = 0;
+        m_members.root = pack::apply(first, last, vc, ll,
+                                     m_members.parameters(), m_members.translator(), m_members.allocators());
+        m_members.values_count = vc;
+        m_members.leafs_level = ll;
+    }
+
+    /*!
+    \brief The constructor.
+
+    The tree is created using Hilbert R-tree packing algorithm.
+
+    \param packing      The packing algorithm tag.
+    \param rng          The range of Values.
+    \param parameters   The parameters object.
+    \param getter       The function object extracting Indexable from Value.
+    \param equal        The function object comparing Values.
+    \param allocator    The allocator object.
+
+    \par Throws
+    \li If allocator copy constructor throws.
+    \li If Value copy constructor or copy assignment throws.
+    \li If allocation throws or returns invalid value.
+    */
+    template<typename Range>
+    inline rtree(index::hilbert_packing const& packing,
+                 Range const& rng,
+                 parameters_type const& parameters = parameters_type(),
+                 indexable_getter const& getter = indexable_getter(),
+                 value_equal const& equal = value_equal(),
+                 allocator_type const& allocator = allocator_type())
+        : m_members(getter, equal, parameters, allocator)
+    {
+        boost::ignore_unused(packing);
+        typedef detail::rtree::pack_hilbert<value_type, options_type, translator_type, box_type, allocators_type> pack;
+        size_type vc = 0, ll = 0;
+        m_members.root = pack::apply(::boost::begin(rng), ::boost::end(rng), vc, ll,
+                                     m_members.parameters(), m_members.translator(), m_members.allocators());
+        m_members.values_count = vc;
+        m_members.leafs_level = ll;
+    }
+
     /*!
     \brief The destructor.
 
@@ -838,6 +1001,194 @@ public:
         return query_dispatch(predicates, out_it, boost::mpl::bool_<is_distance_predicate>());
     }
 
+    /*!
+    \brief Finds values nearest to some point and passes them to the function object one by one.
+
+    This query function performs the k-nearest neighbours search and calls the function object
+    for each found value, starting from the closest one. The traversal of the rtree is incremental
+    so only the nodes required to find the values passed so far are visited. If the function object
+    returns \c false the query is stopped and no other values are searched for. The search may also be
+    limited by passing the maximum distance to the \c nearest() predicate.
+
+    Exactly one \c nearest() predicate must be passed. It may be connected with spatial and value
+    predicates with \c operator&&().
+
+    \par Example
+    \verbatim
+    // pass the values nearest to pt to do_something
+    // until do_something returns false
+    tree.query_nearest(bgi::nearest(pt, 1000), do_something());
+    // find the nearest value closer than 10 units to pt satisfying my_fun
+    tree.query_nearest(bgi::nearest(pt, 1, 10.0) && bgi::satisfies(my_fun), store_value());
+    \endverbatim
+
+    \par Throws
+    If Value copy constructor or copy assignment throws.
+    If predicates copy throws.
+    If allocation throws.
+    If the function object throws.
+
+    \param predicates   Predicates.
+    \param fun          The function object called for each found value. It returns \c true
+                        if the query should be continued and \c false otherwise.
+
+    \return             The number of values passed to the function object.
+    */
+    template <typename Predicates, typename UnaryFunction>
+    size_type query_nearest(Predicates const& predicates, UnaryFunction fun) const
+    {
+        static const unsigned distance_predicates_count = detail::predicates_count_distance<Predicates>::value;
+        BOOST_MPL_ASSERT_MSG((distance_predicates_count == 1), PASS_EXACTLY_ONE_DISTANCE_PREDICATE, (Predicates));
+
+        if ( !m_members.root )
+            return 0;
+
+        static const unsigned distance_predicate_index = detail::predicates_find_distance<Predicates>::value;
+        detail::rtree::visitors::distance_query_incremental<
+            value_type,
+            options_type,
+            translator_type,
+            box_type,
+            allocators_type,
+            Predicates,
+            distance_predicate_index
+        > distance_v(m_members.translator(), predicates);
+
+        distance_v.initialize(m_members.root);
+
+        size_type found_count = 0;
+        for ( ; !distance_v.is_end() ; distance_v.increment() )
+        {
+            ++found_count;
+            if ( !fun(distance_v.dereference()) )
+                break;
+        }
+
+        return found_count;
+    }
+
+    /*!
+    \brief Performs many spatial queries at once.
+
+    This function performs spatial queries for all predicates stored in the range.
+    The tree is traversed once. The nodes are visited only if at least one of the
+    queries may be satisfied by the elements stored in them. So if the queries
+    are close to each other, e.g. sorted, the upper levels of the tree are
+    traversed once for all of them.
+
+    The results are returned as <tt>std::pair<std::size_t, value_type></tt>
+    where the first member is the index of the query which predicates were met
+    by the value. The order of the results is not specified.
+
+    Only spatial predicates and satisfies() can be passed. All queries must
+    be represented by the predicates of the same type.
+
+    \par Example
+    \verbatim
+    // C++11 (decltype)
+    std::vector<decltype(bgi::intersects(box_type()))> preds;
+    for ( box_type const& b : boxes )
+        preds.push_back(bgi::intersects(b));
+    std::vector<std::pair<std::size_t, Value> > result;
+    tree.batch_query(preds, std::back_inserter(result));
+    \endverbatim
+
+    \par Throws
+    If Value copy constructor or copy assignment throws.
+    If allocation throws.
+
+    \param predicates   The random access range of Predicates.
+    \param out_it       The output iterator, e.g. generated by std::back_inserter().
+
+    \return             The number of pairs found.
+    */
+    template <typename PredicatesRange, typename OutIter>
+    size_type batch_query(PredicatesRange const& predicates, OutIter out_it) const
+    {
+        typedef typename boost::range_const_iterator<PredicatesRange>::type predicates_iterator;
+        typedef typename boost::range_value<PredicatesRange>::type predicates_type;
+
+        BOOST_MPL_ASSERT_MSG((detail::predicates_count_distance<predicates_type>::value == 0),
+                             DISTANCE_PREDICATES_ARE_NOT_SUPPORTED_BY_BATCH_QUERY,
+                             (predicates_type));
+
+        std::size_t const count = boost::size(predicates);
+
+        if ( !m_members.root || count == 0 )
+            return 0;
+
+        detail::rtree::visitors::spatial_batch_query
+            <
+                value_type, options_type, translator_type, box_type, allocators_type,
+                predicates_iterator, OutIter
+            > find_v(m_members.translator(), boost::const_begin(predicates), count, out_it);
+
+        detail::rtree::apply_visitor(find_v, *m_members.root);
+
+        return find_v.found_count;
+    }
+
+    /*!
+    \brief Finds the pairs of intersecting values of this and other rtree.
+
+    This function performs the spatial join of two rtrees. The trees are traversed
+    synchronously and only the pairs of nodes which boxes intersect are visited.
+    For each pair of values which indexables intersect <tt>std::pair<value_type, OtherValue></tt>
+    is returned, where the first member is the value of this rtree and the second member is
+    the value of the other rtree.
+
+    \par Example
+    \verbatim
+    std::vector< std::pair<Building, Parcel> > result;
+    buildings.spatial_join(parcels, std::back_inserter(result));
+    \endverbatim
+
+    \par Throws
+    If Value copy constructor or copy assignment throws.
+
+    \param other        The other rtree.
+    \param out_it       The output iterator, e.g. generated by std::back_inserter().
+
+    \return             The number of pairs found.
+    */
+    template <typename V, typename P, typename I, typename E, typename A, typename OutIter>
+    size_type spatial_join(rtree<V, P, I, E, A> const& other, OutIter out_it) const
+    {
+        return spatial_join_dispatch(other, out_it, 1);
+    }
+
+    /*!
+    \brief Finds the pairs of intersecting values of this and other rtree in parallel.
+
+    This function performs the spatial join of two rtrees, like the sequential version.
+    The pairs of subtrees are joined in parallel using the number of threads requested by
+    the execution policy. The returned pairs and their order are the same as the ones
+    returned by the sequential version.
+
+    \par Example
+    \verbatim
+    std::vector< std::pair<Building, Parcel> > result;
+    buildings.spatial_join(bg::execution::parallel_policy(), parcels, std::back_inserter(result));
+    \endverbatim
+
+    \par Throws
+    If Value copy constructor or copy assignment throws.
+    If allocation throws.
+    If the thread creation throws.
+
+    \param policy       The parallel execution policy.
+    \param other        The other rtree.
+    \param out_it       The output iterator, e.g. generated by std::back_inserter().
+
+    \return             The number of pairs found.
+    */
+    template <typename V, typename P, typename I, typename E, typename A, typename OutIter>
+    size_type spatial_join(geometry::execution::parallel_policy const& policy,
+                           rtree<V, P, I, E, A> const& other, OutIter out_it) const
+    {
+        return spatial_join_dispatch(other, out_it, policy.threads());
+    }
+
     /*!
     \brief Returns a query iterator pointing at the begin of the query range.
 
@@ -929,9 +1280,6 @@ public:
         return const_query_iterator();
     }
 
-#ifndef BOOST_GEOMETRY_INDEX_DETAIL_EXPERIMENTAL
-private:
-#endif
     /*!
     \brief Returns a query iterator pointing at the begin of the query range.
 
@@ -943,6 +1291,10 @@ private:
     returned by this method you may get the type e.g. by using C++11 decltype or Boost.Typeof library.
     This iterator may be compared with iterators returned by both versions of qend() method.
 
+    Contrary to const_query_iterator this iterator is not type-erased, so it's not created on the heap
+    and no virtual functions are called when it's incremented. The spatial query iterator doesn't
+    allocate memory unless the tree is very deep.
+
     \par Example
     \verbatim
     // Store the result in the container using std::copy() - it requires both iterators of the same type
@@ -1454,6 +1806,9 @@ private:
 
         detail::rtree::apply_visitor(insert_v, *m_members.root);
 
+        detail::rtree::update_soa_bounds<value_type, options_type, translator_type, box_type, allocators_type>
+            ::apply(m_members.root, m_members.translator());
+
 // TODO
 // Think about this: If exception is thrown, may the root be removed?
 // Or it is just cleared?
@@ -1483,6 +1838,9 @@ private:
 
         detail::rtree::apply_visitor(remove_v, *m_members.root);
 
+        detail::rtree::update_soa_bounds<value_type, options_type, translator_type, box_type, allocators_type>
+            ::apply(m_members.root, m_members.translator());
+
         // If exception is thrown, m_values_count may be invalid
 
         if ( remove_v.is_value_removed() )
@@ -1569,6 +1927,9 @@ private:
             dst.m_members.root = 0;
         }
 
+        detail::rtree::update_soa_bounds<value_type, options_type, translator_type, box_type, allocators_type>
+            ::apply(copy_v.result, dst.m_members.translator());
+
         dst.m_members.root = copy_v.result;
         dst.m_members.values_count = src.m_members.values_count;
         dst.m_members.leafs_level = src.m_members.leafs_level;
@@ -1648,6 +2009,40 @@ private:
         return result;
     }
 
+    /*!
+    \brief Find the pairs of intersecting values of this and other rtree.
+
+    \par Exception-safety
+    basic
+    */
+    template <typename V, typename P, typename I, typename E, typename A, typename OutIter>
+    size_type spatial_join_dispatch(rtree<V, P, I, E, A> const& other, OutIter out_it, std::size_t threads) const
+    {
+        typedef rtree<V, P, I, E, A> other_type;
+        typedef detail::rtree::spatial_join
+            <
+                value_type, options_type, translator_type, box_type, allocators_type,
+                typename other_type::value_type, typename other_type::options_type,
+                typename other_type::translator_type, typename other_type::box_type,
+                typename other_type::allocators_type
+            > spatial_join_type;
+        typedef typename spatial_join_type::node_pair node_pair;
+
+        if ( !m_members.root || !other.m_members.root )
+            return 0;
+
+        box_type const box = this->bounds();
+        typename other_type::box_type const other_box = other.bounds();
+        if ( !geometry::intersects(box, other_box) )
+            return 0;
+
+        spatial_join_type join(m_members.translator(), other.m_members.translator());
+        node_pair roots(m_members.root, box, m_members.leafs_level,
+                        other.m_members.root, other_box, other.m_members.leafs_level);
+
+        return join.apply(roots, out_it, threads);                                          // MAY THROW
+    }
+
     /*!
     \brief Return values meeting predicates.
 
@@ -1986,6 +2381,117 @@ query(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree,
     return tree.query(predicates, out_it);
 }
 
+/*!
+\brief Finds values nearest to some point and passes them to the function object one by one.
+
+This query function performs the k-nearest neighbours search and calls the function object
+for each found value, starting from the closest one. If the function object returns \c false
+the query is stopped. For more information see rtree::query_nearest().
+
+\par Example
+\verbatim
+// pass the values nearest to pt to do_something
+// until do_something returns false
+bgi::query_nearest(tree, bgi::nearest(pt, 1000), do_something());
+// find the nearest value closer than 10 units to pt satisfying my_fun
+bgi::query_nearest(tree, bgi::nearest(pt, 1, 10.0) && bgi::satisfies(my_fun), store_value());
+\endverbatim
+
+\par Throws
+If Value copy constructor or copy assignment throws.
+If allocation throws.
+If the function object throws.
+
+\ingroup rtree_functions
+
+\param tree         The rtree.
+\param predicates   Predicates.
+\param fun          The function object called for each found value.
+
+\return             The number of values passed to the function object.
+*/
+template <typename Value, typename Parameters, typename IndexableGetter, typename EqualTo, typename Allocator,
+          typename Predicates, typename UnaryFunction> inline
+typename rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator>::size_type
+query_nearest(rtree<Value, Parameters, IndexableGetter, EqualTo, Allocator> const& tree,
+              Predicates const& predicates,
+              UnaryFunction fun)
+{
+    return tree.query_nearest(predicates, fun);
+}
+
+/*!
+\brief Finds the pairs of intersecting values of two rtrees.
+
+This function performs the spatial join of two rtrees. For each pair of values which
+indexables intersect <tt>std::pair<Value1, Value2></tt> is returned. For more information
+see rtree::spatial_join().
+
+\par Example
+\verbatim
+std::vector< std::pair<Building, Parcel> > result;
+bgi::spatial_join(buildings, parcels, std::back_inserter(result));
+\endverbatim
+
+\par Throws
+If Value copy constructor or copy assignment throws.
+
+\ingroup rtree_functions
+
+\param tree1        The first rtree.
+\param tree2        The second rtree.
+\param out_it       The output iterator, e.g. generated by std::back_inserter().
+
+\return             The number of pairs found.
+*/
+template <typename Value1, typename Parameters1, typename IndexableGetter1, typename EqualTo1, typename Allocator1,
+          typename Value2, typename Parameters2, typename IndexableGetter2, typename EqualTo2, typename Allocator2,
+          typename OutIter> inline
+typename rtree<Value1, Parameters1, IndexableGetter1, EqualTo1, Allocator1>::size_type
+spatial_join(rtree<Value1, Parameters1, IndexableGetter1, EqualTo1, Allocator1> const& tree1,
+             rtree<Value2, Parameters2, IndexableGetter2, EqualTo2, Allocator2> const& tree2,
+             OutIter out_it)
+{
+    return tree1.spatial_join(tree2, out_it);
+}
+
+/*!
+\brief Finds the pairs of intersecting values of two rtrees in parallel.
+
+For more information see rtree::spatial_join().
+
+\par Example
+\verbatim
+std::vector< std::pair<Building, Parcel> > result;
+bgi::spatial_join(bg::execution::parallel_policy(), buildings, parcels, std::back_inserter(result));
+\endverbatim
+
+\par Throws
+If Value copy constructor or copy assignment throws.
+If allocation throws.
+If the thread creation throws.
+
+\ingroup rtree_functions
+
+\param policy       The parallel execution policy.
+\param tree1        The first rtree.
+\param tree2        The second rtree.
+\param out_it       The output iterator, e.g. generated by std::back_inserter().
+
+\return             The number of pairs found.
+*/
+template <typename Value1, typename Parameters1, typename IndexableGetter1, typename EqualTo1, typename Allocator1,
+          typename Value2, typename Parameters2, typename IndexableGetter2, typename EqualTo2, typename Allocator2,
+          typename OutIter> inline
+typename rtree<Value1, Parameters1, IndexableGetter1, EqualTo1, Allocator1>::size_type
+spatial_join(geometry::execution::parallel_policy const& policy,
+             rtree<Value1, Parameters1, IndexableGetter1, EqualTo1, Allocator1> const& tree1,
+             rtree<Value2, Parameters2, IndexableGetter2, EqualTo2, Allocator2> const& tree2,
+             OutIter out_it)
+{
+    return tree1.spatial_join(policy, tree2, out_it);
+}
+
 /*!
 \brief Returns the query iterator pointing at the begin of the query range.
 
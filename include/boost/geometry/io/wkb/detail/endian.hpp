@@ -0,0 +1,124 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_IO_WKB_DETAIL_ENDIAN_HPP
+#define BOOST_GEOMETRY_IO_WKB_DETAIL_ENDIAN_HPP
+
+
+#include <algorithm>
+#include <cstring>
+
+#include <boost/cstdint.hpp>
+#include <boost/predef/other/endian.h>
+#include <boost/static_assert.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace wkb
+{
+
+
+struct byte_order_type
+{
+    enum enum_t
+    {
+        xdr     = 0, // wkbXDR, big-endian
+        ndr     = 1, // wkbNDR, little-endian
+        unknown = 2  // not defined by OGC
+    };
+};
+
+inline byte_order_type::enum_t native_byte_order()
+{
+#if BOOST_ENDIAN_BIG_BYTE
+    return byte_order_type::xdr;
+#else
+    return byte_order_type::ndr;
+#endif
+}
+
+
+inline boost::uint32_t byte_swap(boost::uint32_t value)
+{
+    return (value >> 24)
+         | ((value >> 8) & 0x0000FF00u)
+         | ((value << 8) & 0x00FF0000u)
+         | (value << 24);
+}
+
+inline boost::uint64_t byte_swap(boost::uint64_t value)
+{
+    return (static_cast<boost::uint64_t>(byte_swap(static_cast<boost::uint32_t>(value))) << 32)
+         | byte_swap(static_cast<boost::uint32_t>(value >> 32));
+}
+
+
+// The bytes are copied at once and swapped in a register. For pointers and
+// the iterators of contiguous containers std::copy results in a single load.
+template <typename UInt, typename Iterator>
+inline UInt load_unsigned(Iterator it)
+{
+    unsigned char bytes[sizeof(UInt)];
+    std::copy(it, it + sizeof(UInt), bytes);
+    UInt value;
+    std::memcpy(&value, bytes, sizeof(UInt));
+    return value;
+}
+
+template <typename Iterator>
+inline boost::uint32_t load_uint32(Iterator it, bool swap)
+{
+    boost::uint32_t const value = load_unsigned<boost::uint32_t>(it);
+    return swap ? byte_swap(value) : value;
+}
+
+template <bool Swap, typename Iterator>
+inline double load_double(Iterator it)
+{
+    BOOST_STATIC_ASSERT(sizeof(double) == sizeof(boost::uint64_t));
+
+    boost::uint64_t value = load_unsigned<boost::uint64_t>(it);
+    if (Swap)
+    {
+        value = byte_swap(value);
+    }
+    double result;
+    std::memcpy(&result, &value, sizeof(double));
+    return result;
+}
+
+
+template <typename OutputIterator>
+inline void store_uint32(boost::uint32_t value, OutputIterator& out)
+{
+    unsigned char bytes[sizeof(boost::uint32_t)];
+    std::memcpy(bytes, &value, sizeof(boost::uint32_t));
+    out = std::copy(bytes, bytes + sizeof(boost::uint32_t), out);
+}
+
+template <typename OutputIterator>
+inline void store_double(double value, OutputIterator& out)
+{
+    unsigned char bytes[sizeof(double)];
+    std::memcpy(bytes, &value, sizeof(double));
+    out = std::copy(bytes, bytes + sizeof(double), out);
+}
+
+
+}} // namespace detail::wkb
+#endif // DOXYGEN_NO_DETAIL
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_IO_WKB_DETAIL_ENDIAN_HPP
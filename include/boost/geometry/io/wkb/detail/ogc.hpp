@@ -0,0 +1,151 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_IO_WKB_DETAIL_OGC_HPP
+#define BOOST_GEOMETRY_IO_WKB_DETAIL_OGC_HPP
+
+
+#include <cstddef>
+
+#include <boost/cstdint.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace wkb
+{
+
+
+struct geometry_type_ogc
+{
+    enum enum_t
+    {
+        point      = 1,
+        linestring = 2,
+        polygon    = 3,
+        multipoint = 4,
+        multilinestring = 5,
+        multipolygon = 6,
+        collection = 7
+    };
+};
+
+// The flags of the extended WKB (EWKB) of PostGIS, the ISO WKB instead
+// adds 1000 for Z, 2000 for M and 3000 for ZM to the geometry type
+boost::uint32_t const ewkb_z = 0x80000000u;
+boost::uint32_t const ewkb_m = 0x40000000u;
+boost::uint32_t const ewkb_srid = 0x20000000u;
+boost::uint32_t const ewkb_flags = ewkb_z | ewkb_m | ewkb_srid;
+
+
+// The header of a WKB geometry, also used to define the form of the output
+struct header
+{
+    header()
+        : type(0)
+        , has_z(false)
+        , has_m(false)
+        , has_srid(false)
+        , extended(false)
+        , swap(false)
+        , srid(0)
+    {}
+
+    boost::uint32_t type;
+    bool has_z;
+    bool has_m;
+    bool has_srid;
+    bool extended;
+    bool swap;
+    boost::uint32_t srid;
+};
+
+inline bool decode_type(boost::uint32_t code, header& h)
+{
+    h.has_z = (code & ewkb_z) != 0;
+    h.has_m = (code & ewkb_m) != 0;
+    h.has_srid = (code & ewkb_srid) != 0;
+    h.extended = (code & ewkb_flags) != 0;
+
+    code &= ~ewkb_flags;
+    boost::uint32_t const iso = code / 1000;
+    h.type = code % 1000;
+
+    if (iso > 3 || (h.extended && iso > 0)
+     || h.type < geometry_type_ogc::point
+     || h.type > geometry_type_ogc::collection)
+    {
+        return false;
+    }
+
+    h.has_z = h.has_z || iso == 1 || iso == 3;
+    h.has_m = h.has_m || iso == 2 || iso == 3;
+    return true;
+}
+
+inline boost::uint32_t encode_type(header const& h)
+{
+    if (h.extended)
+    {
+        return h.type
+            | (h.has_z ? ewkb_z : 0u)
+            | (h.has_m ? ewkb_m : 0u)
+            | (h.has_srid ? ewkb_srid : 0u);
+    }
+
+    return h.type
+        + (h.has_z ? 1000u : 0u)
+        + (h.has_m ? 2000u : 0u);
+}
+
+
+// The position of the coordinates of a point, in bytes
+struct point_layout
+{
+    point_layout()
+        : size(16)
+        , z_offset(-1)
+        , zm_offset(-1)
+        , swap(false)
+    {}
+
+    explicit point_layout(header const& h)
+        : size(16 + (h.has_z ? 8 : 0) + (h.has_m ? 8 : 0))
+        , z_offset(h.has_z ? 16 : -1)
+        , zm_offset(h.has_z && h.has_m ? 24 : -1)
+        , swap(h.swap)
+    {}
+
+    // The offset of the coordinate stored in a given dimension, or -1 if
+    // there is no such coordinate. M is stored only together with Z.
+    inline int offset(std::size_t dimension) const
+    {
+        return dimension < 2 ? static_cast<int>(dimension) * 8
+             : dimension == 2 ? z_offset
+             : dimension == 3 ? zm_offset
+             : -1;
+    }
+
+    std::size_t size;
+    int z_offset;
+    int zm_offset;
+    bool swap;
+};
+
+
+}} // namespace detail::wkb
+#endif // DOXYGEN_NO_DETAIL
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_IO_WKB_DETAIL_OGC_HPP
@@ -0,0 +1,373 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2009-2012 Mateusz Loskot, London, UK.
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_IO_WKB_DETAIL_PARSER_HPP
+#define BOOST_GEOMETRY_IO_WKB_DETAIL_PARSER_HPP
+
+
+#include <algorithm>
+#include <cstddef>
+
+#include <boost/cstdint.hpp>
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/value_type.hpp>
+#include <boost/type_traits/remove_reference.hpp>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/closure.hpp>
+#include <boost/geometry/core/coordinate_dimension.hpp>
+#include <boost/geometry/core/coordinate_type.hpp>
+#include <boost/geometry/core/exception.hpp>
+#include <boost/geometry/core/exterior_ring.hpp>
+#include <boost/geometry/core/interior_rings.hpp>
+#include <boost/geometry/core/point_type.hpp>
+
+#include <boost/geometry/io/wkb/detail/endian.hpp>
+#include <boost/geometry/io/wkb/detail/ogc.hpp>
+
+#include <boost/geometry/util/range.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+/*!
+\brief Read WKB Exception
+\ingroup core
+\details The read_wkb_exception is thrown when there is an error in wkb parsing
+ */
+class read_wkb_exception : public geometry::exception
+{
+public:
+
+    inline read_wkb_exception() {}
+
+    virtual char const* what() const throw()
+    {
+        return "Boost.Geometry Read WKB exception";
+    }
+};
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace wkb
+{
+
+
+template <typename Iterator>
+inline bool read_uint32(Iterator& it, Iterator end, bool swap,
+                        boost::uint32_t& value)
+{
+    if (end - it < 4)
+    {
+        return false;
+    }
+    value = load_uint32(it, swap);
+    it += 4;
+    return true;
+}
+
+// Reads the byte order, the type and the SRID of a geometry
+template <typename Iterator>
+inline bool read_header(Iterator& it, Iterator end,
+                        boost::uint32_t expected_type, header& h)
+{
+    if (it == end)
+    {
+        return false;
+    }
+
+    unsigned int const order = static_cast<unsigned char>(*it);
+    if (order != byte_order_type::xdr && order != byte_order_type::ndr)
+    {
+        return false;
+    }
+    ++it;
+    h.swap = order != static_cast<unsigned int>(native_byte_order());
+
+    boost::uint32_t code = 0;
+    if (! read_uint32(it, end, h.swap, code)
+     || ! decode_type(code, h)
+     || h.type != expected_type)
+    {
+        return false;
+    }
+
+    return h.has_srid ? read_uint32(it, end, h.swap, h.srid) : true;
+}
+
+// Z can't be stored in a point having less than 3 dimensions
+template <typename Point>
+inline bool check_dimensions(header const& h)
+{
+    return ! h.has_z || dimension<Point>::value >= 3;
+}
+
+// Checks if there are enough bytes for the number of elements without
+// overflowing, before anything is allocated
+template <typename Iterator>
+inline bool check_count(Iterator it, Iterator end,
+                        boost::uint32_t count, std::size_t element_size)
+{
+    return count <= static_cast<std::size_t>(end - it) / element_size;
+}
+
+
+template
+<
+    bool Swap,
+    typename Point,
+    std::size_t Dimension = 0,
+    std::size_t DimensionCount = dimension<Point>::value
+>
+struct load_coordinates
+{
+    template <typename Iterator>
+    static inline void apply(Iterator it, point_layout const& layout, Point& point)
+    {
+        typedef typename coordinate_type<Point>::type coordinate_type;
+
+        int const offset = layout.offset(Dimension);
+        set<Dimension>(point, offset < 0
+                                ? coordinate_type(0)
+                                : static_cast<coordinate_type>(
+                                    load_double<Swap>(it + offset)));
+
+        load_coordinates
+            <
+                Swap, Point, Dimension + 1, DimensionCount
+            >::apply(it, layout, point);
+    }
+};
+
+template <bool Swap, typename Point, std::size_t DimensionCount>
+struct load_coordinates<Swap, Point, DimensionCount, DimensionCount>
+{
+    template <typename Iterator>
+    static inline void apply(Iterator, point_layout const&, Point&)
+    {}
+};
+
+template <typename Iterator, typename Point>
+inline void load_point(Iterator it, point_layout const& layout, Point& point)
+{
+    if (layout.swap)
+    {
+        load_coordinates<true, Point>::apply(it, layout, point);
+    }
+    else
+    {
+        load_coordinates<false, Point>::apply(it, layout, point);
+    }
+}
+
+// The byte order is checked once for the whole block of coordinates
+template <bool Swap, typename Iterator, typename Range>
+inline void load_points(Iterator it, point_layout const& layout, Range& range)
+{
+    typedef typename boost::range_iterator<Range>::type iterator_type;
+    typedef typename boost::range_value<Range>::type point_type;
+
+    for (iterator_type pit = boost::begin(range);
+         pit != boost::end(range);
+         ++pit, it += layout.size)
+    {
+        load_coordinates<Swap, point_type>::apply(it, layout, *pit);
+    }
+}
+
+// Parses the number of points and the points, the closing point of a ring
+// is skipped if the ring is open
+template <typename Iterator, typename Range>
+inline bool parse_points(Iterator& it, Iterator end, point_layout const& layout,
+                         Range& range, bool is_open)
+{
+    boost::uint32_t count = 0;
+    if (! read_uint32(it, end, layout.swap, count)
+     || ! check_count(it, end, count, layout.size))
+    {
+        return false;
+    }
+
+    Iterator const first = it;
+    it += count * layout.size;
+
+    // The same way as in WKT, see stateful_range_appender
+    std::size_t size = count;
+    if (is_open && size > core_detail::closure::minimum_ring_size<open>::value
+     && std::equal(first, first + layout.size, it - layout.size))
+    {
+        --size;
+    }
+
+    range::resize(range, size);
+    if (layout.swap)
+    {
+        load_points<true>(first, layout, range);
+    }
+    else
+    {
+        load_points<false>(first, layout, range);
+    }
+    return true;
+}
+
+
+template <typename Point>
+struct point_parser
+{
+    template <typename Iterator>
+    static inline bool apply(Iterator& it, Iterator end, Point& point, header& h)
+    {
+        if (! read_header(it, end, geometry_type_ogc::point, h)
+         || ! check_dimensions<Point>(h))
+        {
+            return false;
+        }
+
+        point_layout const layout(h);
+        if (static_cast<std::size_t>(end - it) < layout.size)
+        {
+            return false;
+        }
+
+        load_point(it, layout, point);
+        it += layout.size;
+        return true;
+    }
+};
+
+template <typename Linestring>
+struct linestring_parser
+{
+    template <typename Iterator>
+    static inline bool apply(Iterator& it, Iterator end, Linestring& linestring,
+                             header& h)
+    {
+        return read_header(it, end, geometry_type_ogc::linestring, h)
+            && check_dimensions<typename point_type<Linestring>::type>(h)
+            && parse_points(it, end, point_layout(h), linestring, false);
+    }
+};
+
+template <typename Ring, typename Iterator>
+inline bool parse_ring(Iterator& it, Iterator end, point_layout const& layout,
+                       Ring& ring)
+{
+    return parse_points(it, end, layout, ring,
+                        geometry::closure<Ring>::value == open);
+}
+
+// A ring is read from a polygon without interior rings
+template <typename Ring>
+struct ring_parser
+{
+    template <typename Iterator>
+    static inline bool apply(Iterator& it, Iterator end, Ring& ring, header& h)
+    {
+        boost::uint32_t count = 0;
+        return read_header(it, end, geometry_type_ogc::polygon, h)
+            && check_dimensions<typename point_type<Ring>::type>(h)
+            && read_uint32(it, end, h.swap, count)
+            && count == 1
+            && parse_ring(it, end, point_layout(h), ring);
+    }
+};
+
+template <typename Polygon>
+struct polygon_parser
+{
+    template <typename Iterator>
+    static inline bool apply(Iterator& it, Iterator end, Polygon& polygon,
+                             header& h)
+    {
+        boost::uint32_t count = 0;
+        if (! read_header(it, end, geometry_type_ogc::polygon, h)
+         || ! check_dimensions<typename point_type<Polygon>::type>(h)
+         || ! read_uint32(it, end, h.swap, count)
+         || ! check_count(it, end, count, 4))
+        {
+            return false;
+        }
+
+        point_layout const layout(h);
+
+        if (count == 0)
+        {
+            range::clear(exterior_ring(polygon));
+            range::clear(interior_rings(polygon));
+            return true;
+        }
+
+        if (! parse_ring(it, end, layout, exterior_ring(polygon)))
+        {
+            return false;
+        }
+
+        typedef typename boost::remove_reference
+            <
+                typename traits::interior_mutable_type<Polygon>::type
+            >::type rings_type;
+        typedef typename boost::range_iterator<rings_type>::type iterator_type;
+
+        rings_type& rings = interior_rings(polygon);
+        range::resize(rings, count - 1);
+        for (iterator_type rit = boost::begin(rings); rit != boost::end(rings); ++rit)
+        {
+            if (! parse_ring(it, end, layout, *rit))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// Each geometry of a multi-geometry has its own header, possibly with
+// a different byte order
+template <typename MultiGeometry, typename Parser, boost::uint32_t Type>
+struct multi_parser
+{
+    template <typename Iterator>
+    static inline bool apply(Iterator& it, Iterator end, MultiGeometry& multi,
+                             header& h)
+    {
+        boost::uint32_t count = 0;
+        if (! read_header(it, end, Type, h)
+         || ! read_uint32(it, end, h.swap, count)
+         || ! check_count(it, end, count, 5))
+        {
+            return false;
+        }
+
+        typedef typename boost::range_iterator<MultiGeometry>::type iterator_type;
+
+        range::resize(multi, count);
+        for (iterator_type mit = boost::begin(multi); mit != boost::end(multi); ++mit)
+        {
+            header element_header;
+            if (! Parser::apply(it, end, *mit, element_header))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+
+}} // namespace detail::wkb
+#endif // DOXYGEN_NO_DETAIL
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_IO_WKB_DETAIL_PARSER_HPP
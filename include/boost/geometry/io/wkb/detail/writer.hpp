@@ -0,0 +1,222 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2015 Mats Taraldsvik.
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_IO_WKB_DETAIL_WRITER_HPP
+#define BOOST_GEOMETRY_IO_WKB_DETAIL_WRITER_HPP
+
+
+#include <cstddef>
+
+#include <boost/cstdint.hpp>
+#include <boost/range/begin.hpp>
+#include <boost/range/empty.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+#include <boost/range/size.hpp>
+#include <boost/range/value_type.hpp>
+#include <boost/type_traits/remove_reference.hpp>
+
+#include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/closure.hpp>
+#include <boost/geometry/core/coordinate_dimension.hpp>
+#include <boost/geometry/core/exterior_ring.hpp>
+#include <boost/geometry/core/interior_rings.hpp>
+#include <boost/geometry/core/point_type.hpp>
+
+#include <boost/geometry/io/wkb/detail/endian.hpp>
+#include <boost/geometry/io/wkb/detail/ogc.hpp>
+
+#include <boost/geometry/views/closeable_view.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace wkb
+{
+
+
+// Writes the header of a geometry in the native byte order, Z is written
+// for 3 and M for 4 or more dimensions
+template <typename Geometry, typename OutputIterator>
+inline void write_header(boost::uint32_t type, header const& options,
+                         OutputIterator& out)
+{
+    std::size_t const dimension_count
+        = geometry::dimension<typename point_type<Geometry>::type>::value;
+
+    header h = options;
+    h.type = type;
+    h.has_z = dimension_count >= 3;
+    h.has_m = dimension_count >= 4;
+
+    *out++ = static_cast<unsigned char>(native_byte_order());
+    store_uint32(encode_type(h), out);
+    if (h.has_srid)
+    {
+        store_uint32(h.srid, out);
+    }
+}
+
+
+template
+<
+    typename Point,
+    std::size_t Dimension = 0,
+    std::size_t DimensionCount = (dimension<Point>::value < 4
+                                  ? dimension<Point>::value : 4)
+>
+struct store_coordinates
+{
+    template <typename OutputIterator>
+    static inline void apply(Point const& point, OutputIterator& out)
+    {
+        store_double(static_cast<double>(get<Dimension>(point)), out);
+        store_coordinates<Point, Dimension + 1, DimensionCount>::apply(point, out);
+    }
+};
+
+template <typename Point, std::size_t DimensionCount>
+struct store_coordinates<Point, DimensionCount, DimensionCount>
+{
+    template <typename OutputIterator>
+    static inline void apply(Point const&, OutputIterator&)
+    {}
+};
+
+template <typename Range, typename OutputIterator>
+inline void write_points(Range const& range, OutputIterator& out)
+{
+    typedef typename boost::range_iterator<Range const>::type iterator_type;
+    typedef typename boost::range_value<Range>::type point_type;
+
+    store_uint32(static_cast<boost::uint32_t>(boost::size(range)), out);
+    for (iterator_type it = boost::begin(range); it != boost::end(range); ++it)
+    {
+        store_coordinates<point_type>::apply(*it, out);
+    }
+}
+
+// The rings are always written closed
+template <typename Ring, typename OutputIterator>
+inline void write_ring(Ring const& ring, OutputIterator& out)
+{
+    typedef typename closeable_view
+        <
+            Ring const, geometry::closure<Ring>::value
+        >::type view_type;
+
+    write_points(view_type(ring), out);
+}
+
+
+template <typename Point>
+struct point_writer
+{
+    template <typename OutputIterator>
+    static inline void apply(Point const& point, OutputIterator& out,
+                             header const& options)
+    {
+        write_header<Point>(geometry_type_ogc::point, options, out);
+        store_coordinates<Point>::apply(point, out);
+    }
+};
+
+template <typename Linestring>
+struct linestring_writer
+{
+    template <typename OutputIterator>
+    static inline void apply(Linestring const& linestring, OutputIterator& out,
+                             header const& options)
+    {
+        write_header<Linestring>(geometry_type_ogc::linestring, options, out);
+        write_points(linestring, out);
+    }
+};
+
+// A ring is written as a polygon without interior rings
+template <typename Ring>
+struct ring_writer
+{
+    template <typename OutputIterator>
+    static inline void apply(Ring const& ring, OutputIterator& out,
+                             header const& options)
+    {
+        write_header<Ring>(geometry_type_ogc::polygon, options, out);
+        store_uint32(1, out);
+        write_ring(ring, out);
+    }
+};
+
+template <typename Polygon>
+struct polygon_writer
+{
+    template <typename OutputIterator>
+    static inline void apply(Polygon const& polygon, OutputIterator& out,
+                             header const& options)
+    {
+        typedef typename interior_return_type<Polygon const>::type rings_type;
+        typedef typename boost::range_iterator
+            <
+                typename boost::remove_reference<rings_type>::type
+            >::type iterator_type;
+
+        rings_type rings = interior_rings(polygon);
+
+        write_header<Polygon>(geometry_type_ogc::polygon, options, out);
+
+        // An empty polygon has no rings
+        if (boost::empty(exterior_ring(polygon)) && boost::empty(rings))
+        {
+            store_uint32(0, out);
+            return;
+        }
+
+        store_uint32(static_cast<boost::uint32_t>(boost::size(rings) + 1), out);
+        write_ring(exterior_ring(polygon), out);
+        for (iterator_type it = boost::begin(rings); it != boost::end(rings); ++it)
+        {
+            write_ring(*it, out);
+        }
+    }
+};
+
+// The SRID is written only in the header of the multi-geometry
+template <typename MultiGeometry, typename Writer, boost::uint32_t Type>
+struct multi_writer
+{
+    template <typename OutputIterator>
+    static inline void apply(MultiGeometry const& multi, OutputIterator& out,
+                             header const& options)
+    {
+        typedef typename boost::range_iterator<MultiGeometry const>::type iterator_type;
+
+        header element_options = options;
+        element_options.has_srid = false;
+
+        write_header<MultiGeometry>(Type, options, out);
+        store_uint32(static_cast<boost::uint32_t>(boost::size(multi)), out);
+        for (iterator_type it = boost::begin(multi); it != boost::end(multi); ++it)
+        {
+            Writer::apply(*it, out, element_options);
+        }
+    }
+};
+
+
+}} // namespace detail::wkb
+#endif // DOXYGEN_NO_DETAIL
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_IO_WKB_DETAIL_WRITER_HPP
@@ -0,0 +1,200 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2009-2012 Mateusz Loskot, London, UK.
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_IO_WKB_READ_HPP
+#define BOOST_GEOMETRY_IO_WKB_READ_HPP
+
+
+#include <cstddef>
+#include <iterator>
+
+#include <boost/cstdint.hpp>
+#include <boost/range/value_type.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#include <boost/geometry/algorithms/clear.hpp>
+#include <boost/geometry/algorithms/not_implemented.hpp>
+
+#include <boost/geometry/core/tag.hpp>
+#include <boost/geometry/core/tags.hpp>
+
+#include <boost/geometry/geometries/concepts/check.hpp>
+
+#include <boost/geometry/io/wkb/detail/parser.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+#ifndef DOXYGEN_NO_DISPATCH
+namespace dispatch
+{
+
+
+template <typename Geometry, typename Tag = typename tag<Geometry>::type>
+struct read_wkb : not_implemented<Tag>
+{};
+
+template <typename Point>
+struct read_wkb<Point, point_tag>
+    : detail::wkb::point_parser<Point>
+{};
+
+template <typename Linestring>
+struct read_wkb<Linestring, linestring_tag>
+    : detail::wkb::linestring_parser<Linestring>
+{};
+
+template <typename Ring>
+struct read_wkb<Ring, ring_tag>
+    : detail::wkb::ring_parser<Ring>
+{};
+
+template <typename Polygon>
+struct read_wkb<Polygon, polygon_tag>
+    : detail::wkb::polygon_parser<Polygon>
+{};
+
+template <typename MultiPoint>
+struct read_wkb<MultiPoint, multi_point_tag>
+    : detail::wkb::multi_parser
+        <
+            MultiPoint,
+            detail::wkb::point_parser
+                <
+                    typename boost::range_value<MultiPoint>::type
+                >,
+            detail::wkb::geometry_type_ogc::multipoint
+        >
+{};
+
+template <typename MultiLinestring>
+struct read_wkb<MultiLinestring, multi_linestring_tag>
+    : detail::wkb::multi_parser
+        <
+            MultiLinestring,
+            detail::wkb::linestring_parser
+                <
+                    typename boost::range_value<MultiLinestring>::type
+                >,
+            detail::wkb::geometry_type_ogc::multilinestring
+        >
+{};
+
+template <typename MultiPolygon>
+struct read_wkb<MultiPolygon, multi_polygon_tag>
+    : detail::wkb::multi_parser
+        <
+            MultiPolygon,
+            detail::wkb::polygon_parser
+                <
+                    typename boost::range_value<MultiPolygon>::type
+                >,
+            detail::wkb::geometry_type_ogc::multipolygon
+        >
+{};
+
+
+} // namespace dispatch
+#endif // DOXYGEN_NO_DISPATCH
+
+
+/*!
+\brief Parses OGC Well-Known Binary (\ref WKB) into a geometry,
+    also reading the SRID of the extended WKB of PostGIS
+\ingroup wkb
+\details The geometries of the ISO WKB with Z, M or ZM coordinates are
+    supported as well as the extended WKB of PostGIS. Z is read into the
+    third coordinate and M into the fourth one if both Z and M are present,
+    otherwise M is skipped. The coordinates which are not present are set
+    to zero. The bytes are parsed in place, with the byte order checked
+    once per block of coordinates.
+\tparam Iterator random access iterator of bytes
+\tparam Geometry \tparam_geometry
+\param begin iterator to the first byte
+\param end iterator past the last byte
+\param geometry \param_geometry which is cleared and filled
+\param srid set to the SRID of the geometry, or 0 if it is not stored
+\return true if the geometry was parsed, false if the bytes are not
+    a valid WKB of the geometry, e.g. if Z is stored and the geometry
+    has less than 3 dimensions
+*/
+template <typename Iterator, typename Geometry>
+inline bool read_wkb(Iterator begin, Iterator end, Geometry& geometry,
+                     boost::uint32_t& srid)
+{
+    concepts::check<Geometry>();
+
+    // Stream of bytes can only be parsed using random access iterator.
+    BOOST_STATIC_ASSERT((
+        boost::is_convertible
+        <
+            typename std::iterator_traits<Iterator>::iterator_category,
+            const std::random_access_iterator_tag&
+        >::value));
+
+    geometry::clear(geometry);
+
+    detail::wkb::header h;
+    if (! dispatch::read_wkb<Geometry>::apply(begin, end, geometry, h))
+    {
+        return false;
+    }
+
+    srid = h.srid;
+    return true;
+}
+
+/*!
+\brief Parses OGC Well-Known Binary (\ref WKB) into a geometry
+\ingroup wkb
+\tparam Iterator random access iterator of bytes
+\tparam Geometry \tparam_geometry
+\param begin iterator to the first byte
+\param end iterator past the last byte
+\param geometry \param_geometry which is cleared and filled
+\return true if the geometry was parsed
+*/
+template <typename Iterator, typename Geometry>
+inline bool read_wkb(Iterator begin, Iterator end, Geometry& geometry)
+{
+    boost::uint32_t srid = 0;
+    return read_wkb(begin, end, geometry, srid);
+}
+
+/*!
+\brief Parses OGC Well-Known Binary (\ref WKB) stored in a contiguous
+    block of bytes into a geometry
+\ingroup wkb
+\tparam ByteType integral type of the size of a byte
+\tparam Geometry \tparam_geometry
+\param bytes pointer to the first byte
+\param length the number of bytes
+\param geometry \param_geometry which is cleared and filled
+\return true if the geometry was parsed
+*/
+template <typename ByteType, typename Geometry>
+inline bool read_wkb(ByteType const* bytes, std::size_t length, Geometry& geometry)
+{
+    BOOST_STATIC_ASSERT((boost::is_integral<ByteType>::value));
+    BOOST_STATIC_ASSERT((sizeof(boost::uint8_t) == sizeof(ByteType)));
+
+    ByteType const* begin = bytes;
+    ByteType const* const end = bytes + length;
+    return read_wkb(begin, end, geometry);
+}
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_IO_WKB_READ_HPP
@@ -0,0 +1,421 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_IO_WKB_VIEW_HPP
+#define BOOST_GEOMETRY_IO_WKB_VIEW_HPP
+
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/iterator/iterator_categories.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#include <boost/geometry/core/closure.hpp>
+#include <boost/geometry/core/exterior_ring.hpp>
+#include <boost/geometry/core/interior_rings.hpp>
+#include <boost/geometry/core/point_order.hpp>
+#include <boost/geometry/core/ring_type.hpp>
+#include <boost/geometry/core/tag.hpp>
+#include <boost/geometry/core/tags.hpp>
+
+#include <boost/geometry/io/wkb/detail/parser.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace wkb
+{
+
+
+// Random access iterator converting the coordinates to a point
+// when dereferenced
+template <typename Point>
+class point_iterator
+    : public boost::iterator_facade
+        <
+            point_iterator<Point>,
+            Point const,
+            boost::random_access_traversal_tag,
+            Point
+        >
+{
+public:
+    inline point_iterator()
+        : m_position(NULL)
+    {}
+
+    inline point_iterator(unsigned char const* position,
+                          point_layout const& layout)
+        : m_position(position)
+        , m_layout(layout)
+    {}
+
+private:
+    friend class boost::iterator_core_access;
+
+    inline Point dereference() const
+    {
+        Point point;
+        load_point(m_position, m_layout, point);
+        return point;
+    }
+
+    inline bool equal(point_iterator const& other) const
+    {
+        return m_position == other.m_position;
+    }
+
+    inline void increment() { m_position += m_layout.size; }
+    inline void decrement() { m_position -= m_layout.size; }
+
+    inline void advance(std::ptrdiff_t n)
+    {
+        m_position += n * static_cast<std::ptrdiff_t>(m_layout.size);
+    }
+
+    inline std::ptrdiff_t distance_to(point_iterator const& other) const
+    {
+        return (other.m_position - m_position)
+             / static_cast<std::ptrdiff_t>(m_layout.size);
+    }
+
+    unsigned char const* m_position;
+    point_layout m_layout;
+};
+
+
+// The points stored in WKB, preceded by their number
+template <typename Point>
+class points_view
+{
+public:
+    typedef point_iterator<Point> iterator;
+    typedef point_iterator<Point> const_iterator;
+
+    inline points_view()
+        : m_first(NULL)
+        , m_count(0)
+    {}
+
+    inline points_view(unsigned char const* first, std::size_t count,
+                       point_layout const& layout)
+        : m_first(first)
+        , m_count(count)
+        , m_layout(layout)
+    {}
+
+    inline const_iterator begin() const
+    {
+        return const_iterator(m_first, m_layout);
+    }
+
+    inline const_iterator end() const
+    {
+        return const_iterator(m_first + m_count * m_layout.size, m_layout);
+    }
+
+    inline std::size_t size() const { return m_count; }
+    inline bool empty() const { return m_count == 0; }
+
+    inline bool assign(unsigned char const*& it, unsigned char const* end,
+                       point_layout const& layout)
+    {
+        boost::uint32_t count = 0;
+        if (! read_uint32(it, end, layout.swap, count)
+         || ! check_count(it, end, count, layout.size))
+        {
+            return false;
+        }
+
+        m_first = it;
+        m_count = count;
+        m_layout = layout;
+        it += count * layout.size;
+        return true;
+    }
+
+private:
+    unsigned char const* m_first;
+    std::size_t m_count;
+    point_layout m_layout;
+};
+
+
+template <typename ByteType>
+inline unsigned char const* to_bytes(ByteType const* bytes)
+{
+    BOOST_STATIC_ASSERT((boost::is_integral<ByteType>::value));
+    BOOST_STATIC_ASSERT((sizeof(boost::uint8_t) == sizeof(ByteType)));
+
+    return reinterpret_cast<unsigned char const*>(bytes);
+}
+
+
+}} // namespace detail::wkb
+#endif // DOXYGEN_NO_DETAIL
+
+
+/*!
+\brief Linestring stored in Well-Known Binary (\ref WKB), used without
+    copying the bytes
+\ingroup wkb
+\details The view is a read-only linestring whose points are converted from
+    the bytes when the iterator is dereferenced. The bytes have to outlive
+    the view. The coordinates are handled the same way as by read_wkb().
+\tparam Point point type the coordinates are converted to
+*/
+template <typename Point>
+class wkb_linestring_view
+    : public detail::wkb::points_view<Point>
+{
+public:
+    inline wkb_linestring_view()
+    {}
+
+    inline explicit wkb_linestring_view(detail::wkb::points_view<Point> const& points)
+        : detail::wkb::points_view<Point>(points)
+    {}
+
+    /*!
+    \brief Constructs the view of a WKB linestring
+    \param first pointer to the first byte
+    \param last pointer past the last byte
+    \note Throws read_wkb_exception if the bytes are not a valid WKB
+        linestring
+    */
+    template <typename ByteType>
+    inline wkb_linestring_view(ByteType const* first, ByteType const* last)
+    {
+        namespace wkb = detail::wkb;
+
+        unsigned char const* it = wkb::to_bytes(first);
+        unsigned char const* const end = wkb::to_bytes(last);
+
+        wkb::header h;
+        if (! wkb::read_header(it, end, wkb::geometry_type_ogc::linestring, h)
+         || ! wkb::check_dimensions<Point>(h)
+         || ! this->assign(it, end, wkb::point_layout(h)))
+        {
+            throw read_wkb_exception();
+        }
+    }
+};
+
+
+/*!
+\brief Ring of a polygon stored in Well-Known Binary (\ref WKB), used
+    without copying the bytes
+\ingroup wkb
+\details The ring is closed since the rings are always stored closed.
+\tparam Point point type the coordinates are converted to
+\tparam ClockWise true for clockwise direction, false for counterclockwise
+*/
+template <typename Point, bool ClockWise = true>
+class wkb_ring_view
+    : public detail::wkb::points_view<Point>
+{
+public:
+    inline wkb_ring_view()
+    {}
+
+    inline explicit wkb_ring_view(detail::wkb::points_view<Point> const& points)
+        : detail::wkb::points_view<Point>(points)
+    {}
+};
+
+
+/*!
+\brief Polygon stored in Well-Known Binary (\ref WKB), used without copying
+    the coordinates
+\ingroup wkb
+\details The view is a read-only polygon, only the positions of the rings are
+    stored at construction. The bytes have to outlive the view.
+\tparam Point point type the coordinates are converted to
+\tparam ClockWise true for clockwise direction, false for counterclockwise
+*/
+template <typename Point, bool ClockWise = true>
+class wkb_polygon_view
+{
+public:
+    typedef wkb_ring_view<Point, ClockWise> ring_type;
+    typedef std::vector<ring_type> inner_container_type;
+
+    inline wkb_polygon_view()
+    {}
+
+    /*!
+    \brief Constructs the view of a WKB polygon
+    \param first pointer to the first byte
+    \param last pointer past the last byte
+    \note Throws read_wkb_exception if the bytes are not a valid WKB polygon
+    */
+    template <typename ByteType>
+    inline wkb_polygon_view(ByteType const* first, ByteType const* last)
+    {
+        namespace wkb = detail::wkb;
+
+        unsigned char const* it = wkb::to_bytes(first);
+        unsigned char const* const end = wkb::to_bytes(last);
+
+        wkb::header h;
+        boost::uint32_t count = 0;
+        if (! wkb::read_header(it, end, wkb::geometry_type_ogc::polygon, h)
+         || ! wkb::check_dimensions<Point>(h)
+         || ! wkb::read_uint32(it, end, h.swap, count)
+         || ! wkb::check_count(it, end, count, 4))
+        {
+            throw read_wkb_exception();
+        }
+
+        wkb::point_layout const layout(h);
+        if (count > 0)
+        {
+            m_inners.reserve(count - 1);
+        }
+        for (boost::uint32_t i = 0; i < count; ++i)
+        {
+            wkb::points_view<Point> points;
+            if (! points.assign(it, end, layout))
+            {
+                throw read_wkb_exception();
+            }
+
+            if (i == 0)
+            {
+                m_outer = ring_type(points);
+            }
+            else
+            {
+                m_inners.push_back(ring_type(points));
+            }
+        }
+    }
+
+    inline ring_type const& outer() const { return m_outer; }
+    inline inner_container_type const& inners() const { return m_inners; }
+
+private:
+    ring_type m_outer;
+    inner_container_type m_inners;
+};
+
+
+// Traits specializations for the views
+#ifndef DOXYGEN_NO_TRAITS_SPECIALIZATIONS
+namespace traits
+{
+
+
+template <typename Point>
+struct tag<wkb_linestring_view<Point> >
+{
+    typedef linestring_tag type;
+};
+
+
+template <typename Point, bool ClockWise>
+struct tag<wkb_ring_view<Point, ClockWise> >
+{
+    typedef ring_tag type;
+};
+
+template <typename Point>
+struct point_order<wkb_ring_view<Point, false> >
+{
+    static const order_selector value = counterclockwise;
+};
+
+template <typename Point>
+struct point_order<wkb_ring_view<Point, true> >
+{
+    static const order_selector value = clockwise;
+};
+
+template <typename Point, bool ClockWise>
+struct closure<wkb_ring_view<Point, ClockWise> >
+{
+    static const closure_selector value = closed;
+};
+
+
+template <typename Point, bool ClockWise>
+struct tag<wkb_polygon_view<Point, ClockWise> >
+{
+    typedef polygon_tag type;
+};
+
+template <typename Point, bool ClockWise>
+struct ring_const_type<wkb_polygon_view<Point, ClockWise> >
+{
+    typedef typename wkb_polygon_view<Point, ClockWise>::ring_type const& type;
+};
+
+template <typename Point, bool ClockWise>
+struct ring_mutable_type<wkb_polygon_view<Point, ClockWise> >
+{
+    typedef typename wkb_polygon_view<Point, ClockWise>::ring_type const& type;
+};
+
+template <typename Point, bool ClockWise>
+struct interior_const_type<wkb_polygon_view<Point, ClockWise> >
+{
+    typedef typename wkb_polygon_view
+        <
+            Point, ClockWise
+        >::inner_container_type const& type;
+};
+
+template <typename Point, bool ClockWise>
+struct interior_mutable_type<wkb_polygon_view<Point, ClockWise> >
+{
+    typedef typename wkb_polygon_view
+        <
+            Point, ClockWise
+        >::inner_container_type const& type;
+};
+
+template <typename Point, bool ClockWise>
+struct exterior_ring<wkb_polygon_view<Point, ClockWise> >
+{
+    typedef wkb_polygon_view<Point, ClockWise> polygon_type;
+
+    static inline typename polygon_type::ring_type const&
+        get(polygon_type const& p)
+    {
+        return p.outer();
+    }
+};
+
+template <typename Point, bool ClockWise>
+struct interior_rings<wkb_polygon_view<Point, ClockWise> >
+{
+    typedef wkb_polygon_view<Point, ClockWise> polygon_type;
+
+    static inline typename polygon_type::inner_container_type const&
+        get(polygon_type const& p)
+    {
+        return p.inners();
+    }
+};
+
+
+} // namespace traits
+#endif // DOXYGEN_NO_TRAITS_SPECIALIZATIONS
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_IO_WKB_VIEW_HPP
@@ -0,0 +1,159 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2015 Mats Taraldsvik.
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_IO_WKB_WRITE_HPP
+#define BOOST_GEOMETRY_IO_WKB_WRITE_HPP
+
+
+#include <boost/cstdint.hpp>
+#include <boost/range/value_type.hpp>
+
+#include <boost/geometry/algorithms/not_implemented.hpp>
+
+#include <boost/geometry/core/tag.hpp>
+#include <boost/geometry/core/tags.hpp>
+
+#include <boost/geometry/geometries/concepts/check.hpp>
+
+#include <boost/geometry/io/wkb/detail/writer.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+#ifndef DOXYGEN_NO_DISPATCH
+namespace dispatch
+{
+
+
+template <typename Geometry, typename Tag = typename tag<Geometry>::type>
+struct write_wkb : not_implemented<Tag>
+{};
+
+template <typename Point>
+struct write_wkb<Point, point_tag>
+    : detail::wkb::point_writer<Point>
+{};
+
+template <typename Linestring>
+struct write_wkb<Linestring, linestring_tag>
+    : detail::wkb::linestring_writer<Linestring>
+{};
+
+template <typename Ring>
+struct write_wkb<Ring, ring_tag>
+    : detail::wkb::ring_writer<Ring>
+{};
+
+template <typename Polygon>
+struct write_wkb<Polygon, polygon_tag>
+    : detail::wkb::polygon_writer<Polygon>
+{};
+
+template <typename MultiPoint>
+struct write_wkb<MultiPoint, multi_point_tag>
+    : detail::wkb::multi_writer
+        <
+            MultiPoint,
+            detail::wkb::point_writer
+                <
+                    typename boost::range_value<MultiPoint>::type
+                >,
+            detail::wkb::geometry_type_ogc::multipoint
+        >
+{};
+
+template <typename MultiLinestring>
+struct write_wkb<MultiLinestring, multi_linestring_tag>
+    : detail::wkb::multi_writer
+        <
+            MultiLinestring,
+            detail::wkb::linestring_writer
+                <
+                    typename boost::range_value<MultiLinestring>::type
+                >,
+            detail::wkb::geometry_type_ogc::multilinestring
+        >
+{};
+
+template <typename MultiPolygon>
+struct write_wkb<MultiPolygon, multi_polygon_tag>
+    : detail::wkb::multi_writer
+        <
+            MultiPolygon,
+            detail::wkb::polygon_writer
+                <
+                    typename boost::range_value<MultiPolygon>::type
+                >,
+            detail::wkb::geometry_type_ogc::multipolygon
+        >
+{};
+
+
+} // namespace dispatch
+#endif // DOXYGEN_NO_DISPATCH
+
+
+/*!
+\brief Writes OGC Well-Known Binary (\ref WKB) of a geometry
+\ingroup wkb
+\details The bytes are written in the native byte order. The geometries
+    having 3 dimensions are written with Z and having 4 or more dimensions
+    with ZM coordinates, with the geometry types defined by ISO.
+    The rings are written as polygons.
+\tparam Geometry \tparam_geometry
+\tparam OutputIterator output iterator of bytes
+\param geometry \param_geometry
+\param out iterator the bytes are written to
+\return true
+*/
+template <typename Geometry, typename OutputIterator>
+inline bool write_wkb(Geometry const& geometry, OutputIterator out)
+{
+    concepts::check<Geometry const>();
+
+    detail::wkb::header const options;
+    dispatch::write_wkb<Geometry>::apply(geometry, out, options);
+    return true;
+}
+
+/*!
+\brief Writes the extended WKB of PostGIS (EWKB) of a geometry with SRID
+\ingroup wkb
+\details The bytes are written in the native byte order. Z and M
+    coordinates are written the same way as by write_wkb() but with the
+    geometry types of EWKB. The SRID is written only once, for the
+    outermost geometry.
+\tparam Geometry \tparam_geometry
+\tparam OutputIterator output iterator of bytes
+\param geometry \param_geometry
+\param srid the spatial reference identifier
+\param out iterator the bytes are written to
+\return true
+*/
+template <typename Geometry, typename OutputIterator>
+inline bool write_ewkb(Geometry const& geometry, boost::uint32_t srid,
+                       OutputIterator out)
+{
+    concepts::check<Geometry const>();
+
+    detail::wkb::header options;
+    options.extended = true;
+    options.has_srid = true;
+    options.srid = srid;
+    dispatch::write_wkb<Geometry>::apply(geometry, out, options);
+    return true;
+}
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_IO_WKB_WRITE_HPP
@@ -0,0 +1,866 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_IO_WKT_DETAIL_FORMAT_NUMBER_HPP
+#define BOOST_GEOMETRY_IO_WKT_DETAIL_FORMAT_NUMBER_HPP
+
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <iomanip>
+#include <ios>
+#include <locale>
+#include <sstream>
+#include <string>
+
+#include <boost/cstdint.hpp>
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <boost/math/special_functions/sign.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/geometry/io/wkt/detail/parse_number.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace wkt
+{
+
+
+template <typename Buffer>
+inline void append_chars(Buffer& buffer, char const* first, char const* last)
+{
+    buffer.insert(buffer.end(), first, last);
+}
+
+// Writes the digits of the value ending at last, returns the first digit
+inline char* format_digits(boost::uint64_t value, char* last)
+{
+    do
+    {
+        *--last = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    while (value != 0);
+    return last;
+}
+
+inline char* format_copy(char const* str, char* out)
+{
+    for ( ; *str != '\0' ; ++str)
+    {
+        *out++ = *str;
+    }
+    return out;
+}
+
+// Writes the mantissa divided by 10^decimals, returns the end of the output
+inline char* format_fixed_point(bool negative, boost::uint64_t mantissa,
+                                int decimals, char* out)
+{
+    char digits[24];
+    char* const digits_last = digits + sizeof(digits);
+    char const* it = format_digits(mantissa, digits_last);
+    int const count = static_cast<int>(digits_last - it);
+
+    if (negative)
+    {
+        *out++ = '-';
+    }
+
+    if (count <= decimals)
+    {
+        *out++ = '0';
+        *out++ = '.';
+        for (int i = count ; i < decimals ; ++i)
+        {
+            *out++ = '0';
+        }
+    }
+    else
+    {
+        for (int i = decimals ; i < count ; ++i)
+        {
+            *out++ = *it++;
+        }
+        if (decimals > 0)
+        {
+            *out++ = '.';
+        }
+    }
+
+    while (it != digits_last)
+    {
+        *out++ = *it++;
+    }
+
+    return out;
+}
+
+inline double const* decimal_powers()
+{
+    static const double powers[] =
+    {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    return powers;
+}
+
+inline boost::uint32_t const* decimal_powers32()
+{
+    static const boost::uint32_t powers[] =
+    {
+        1u, 10u, 100u, 1000u, 10000u, 100000u, 1000000u, 10000000u,
+        100000000u, 1000000000u
+    };
+    return powers;
+}
+
+// The floating point number f * 2^e with 64-bit significand
+struct diy_fp
+{
+    diy_fp()
+        : f(0), e(0)
+    {}
+
+    diy_fp(boost::uint64_t f_, int e_)
+        : f(f_), e(e_)
+    {}
+
+    boost::uint64_t f;
+    int e;
+};
+
+// The product rounded to 64 bits of the significand
+inline diy_fp diy_fp_multiply(diy_fp const& l, diy_fp const& r)
+{
+    boost::uint64_t const mask = 0xFFFFFFFFu;
+    boost::uint64_t const a = l.f >> 32;
+    boost::uint64_t const b = l.f & mask;
+    boost::uint64_t const c = r.f >> 32;
+    boost::uint64_t const d = r.f & mask;
+    boost::uint64_t const ac = a * c;
+    boost::uint64_t const bc = b * c;
+    boost::uint64_t const ad = a * d;
+    boost::uint64_t const bd = b * d;
+    boost::uint64_t tmp = (bd >> 32) + (ad & mask) + (bc & mask);
+    tmp += boost::uint64_t(1) << 31;
+    return diy_fp(ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), l.e + r.e + 64);
+}
+
+inline diy_fp diy_fp_normalize(diy_fp v)
+{
+    boost::uint64_t const top_bit = boost::uint64_t(1) << 63;
+    while (! (v.f & top_bit))
+    {
+        v.f <<= 1;
+        --v.e;
+    }
+    return v;
+}
+
+// The positive finite value and the boundaries of the numbers rounded to it
+inline void diy_fp_boundaries(double value, diy_fp& v, diy_fp& minus, diy_fp& plus)
+{
+    boost::uint64_t const hidden_bit = boost::uint64_t(1) << 52;
+
+    boost::uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(double));
+    int const biased_e = static_cast<int>((bits >> 52) & 0x7FF);
+    boost::uint64_t const significand = bits & (hidden_bit - 1);
+
+    v = biased_e != 0
+      ? diy_fp(significand + hidden_bit, biased_e - 1075)
+      : diy_fp(significand, -1074);
+
+    plus = diy_fp_normalize(diy_fp((v.f << 1) + 1, v.e - 1));
+    minus = v.f == hidden_bit
+          ? diy_fp((v.f << 2) - 1, v.e - 2)
+          : diy_fp((v.f << 1) - 1, v.e - 1);
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+}
+
+inline void diy_fp_boundaries(float value, diy_fp& v, diy_fp& minus, diy_fp& plus)
+{
+    boost::uint64_t const hidden_bit = boost::uint64_t(1) << 23;
+
+    boost::uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(float));
+    int const biased_e = static_cast<int>((bits >> 23) & 0xFF);
+    boost::uint64_t const significand = bits & (hidden_bit - 1);
+
+    v = biased_e != 0
+      ? diy_fp(significand + hidden_bit, biased_e - 150)
+      : diy_fp(significand, -149);
+
+    plus = diy_fp_normalize(diy_fp((v.f << 1) + 1, v.e - 1));
+    minus = v.f == hidden_bit
+          ? diy_fp((v.f << 2) - 1, v.e - 2)
+          : diy_fp((v.f << 1) - 1, v.e - 1);
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+}
+
+// The power of 10 normalized to 64 bits bringing the binary exponent
+// of the product with 2^e into the range [-60, -32]
+inline diy_fp cached_power(int e, int& k)
+{
+    struct power
+    {
+        boost::uint32_t high;
+        boost::uint32_t low;
+        int e;
+    };
+
+    // 10^-348, 10^-340, ..., 10^340
+    static const power powers[] =
+    {
+        {0xfa8fd5a0, 0x081c0288, -1220}, {0xbaaee17f, 0xa23ebf76, -1193}, {0x8b16fb20, 0x3055ac76, -1166},
+        {0xcf42894a, 0x5dce35ea, -1140}, {0x9a6bb0aa, 0x55653b2d, -1113}, {0xe61acf03, 0x3d1a45df, -1087},
+        {0xab70fe17, 0xc79ac6ca, -1060}, {0xff77b1fc, 0xbebcdc4f, -1034}, {0xbe5691ef, 0x416bd60c, -1007},
+        {0x8dd01fad, 0x907ffc3c, -980}, {0xd3515c28, 0x31559a83, -954}, {0x9d71ac8f, 0xada6c9b5, -927},
+        {0xea9c2277, 0x23ee8bcb, -901}, {0xaecc4991, 0x4078536d, -874}, {0x823c1279, 0x5db6ce57, -847},
+        {0xc2109436, 0x4dfb5637, -821}, {0x9096ea6f, 0x3848984f, -794}, {0xd77485cb, 0x25823ac7, -768},
+        {0xa086cfcd, 0x97bf97f4, -741}, {0xef340a98, 0x172aace5, -715}, {0xb23867fb, 0x2a35b28e, -688},
+        {0x84c8d4df, 0xd2c63f3b, -661}, {0xc5dd4427, 0x1ad3cdba, -635}, {0x936b9fce, 0xbb25c996, -608},
+        {0xdbac6c24, 0x7d62a584, -582}, {0xa3ab6658, 0x0d5fdaf6, -555}, {0xf3e2f893, 0xdec3f126, -529},
+        {0xb5b5ada8, 0xaaff80b8, -502}, {0x87625f05, 0x6c7c4a8b, -475}, {0xc9bcff60, 0x34c13053, -449},
+        {0x964e858c, 0x91ba2655, -422}, {0xdff97724, 0x70297ebd, -396}, {0xa6dfbd9f, 0xb8e5b88f, -369},
+        {0xf8a95fcf, 0x88747d94, -343}, {0xb9447093, 0x8fa89bcf, -316}, {0x8a08f0f8, 0xbf0f156b, -289},
+        {0xcdb02555, 0x653131b6, -263}, {0x993fe2c6, 0xd07b7fac, -236}, {0xe45c10c4, 0x2a2b3b06, -210},
+        {0xaa242499, 0x697392d3, -183}, {0xfd87b5f2, 0x8300ca0e, -157}, {0xbce50864, 0x92111aeb, -130},
+        {0x8cbccc09, 0x6f5088cc, -103}, {0xd1b71758, 0xe219652c, -77}, {0x9c400000, 0x00000000, -50},
+        {0xe8d4a510, 0x00000000, -24}, {0xad78ebc5, 0xac620000, 3}, {0x813f3978, 0xf8940984, 30},
+        {0xc097ce7b, 0xc90715b3, 56}, {0x8f7e32ce, 0x7bea5c70, 83}, {0xd5d238a4, 0xabe98068, 109},
+        {0x9f4f2726, 0x179a2245, 136}, {0xed63a231, 0xd4c4fb27, 162}, {0xb0de6538, 0x8cc8ada8, 189},
+        {0x83c7088e, 0x1aab65db, 216}, {0xc45d1df9, 0x42711d9a, 242}, {0x924d692c, 0xa61be758, 269},
+        {0xda01ee64, 0x1a708dea, 295}, {0xa26da399, 0x9aef774a, 322}, {0xf209787b, 0xb47d6b85, 348},
+        {0xb454e4a1, 0x79dd1877, 375}, {0x865b8692, 0x5b9bc5c2, 402}, {0xc83553c5, 0xc8965d3d, 428},
+        {0x952ab45c, 0xfa97a0b3, 455}, {0xde469fbd, 0x99a05fe3, 481}, {0xa59bc234, 0xdb398c25, 508},
+        {0xf6c69a72, 0xa3989f5c, 534}, {0xb7dcbf53, 0x54e9bece, 561}, {0x88fcf317, 0xf22241e2, 588},
+        {0xcc20ce9b, 0xd35c78a5, 614}, {0x98165af3, 0x7b2153df, 641}, {0xe2a0b5dc, 0x971f303a, 667},
+        {0xa8d9d153, 0x5ce3b396, 694}, {0xfb9b7cd9, 0xa4a7443c, 720}, {0xbb764c4c, 0xa7a44410, 747},
+        {0x8bab8eef, 0xb6409c1a, 774}, {0xd01fef10, 0xa657842c, 800}, {0x9b10a4e5, 0xe9913129, 827},
+        {0xe7109bfb, 0xa19c0c9d, 853}, {0xac2820d9, 0x623bf429, 880}, {0x80444b5e, 0x7aa7cf85, 907},
+        {0xbf21e440, 0x03acdd2d, 933}, {0x8e679c2f, 0x5e44ff8f, 960}, {0xd433179d, 0x9c8cb841, 986},
+        {0x9e19db92, 0xb4e31ba9, 1013}, {0xeb96bf6e, 0xbadf77d9, 1039}, {0xaf87023b, 0x9bf0ee6b, 1066}
+    };
+
+    double const dk = (-61 - e) * 0.30102999566398114 + 347;
+    int ik = static_cast<int>(dk);
+    if (dk - ik > 0.0)
+    {
+        ++ik;
+    }
+
+    int const index = (ik >> 3) + 1;
+    k = -(-348 + (index << 3));
+
+    power const& p = powers[index];
+    return diy_fp((boost::uint64_t(p.high) << 32) | p.low, p.e);
+}
+
+// Moves the last digit closer to the value while it's in the rounding range
+inline void grisu_round(char* digits, int length, boost::uint64_t delta,
+                        boost::uint64_t rest, boost::uint64_t ten_kappa,
+                        boost::uint64_t wp_w)
+{
+    while (rest < wp_w && delta - rest >= ten_kappa
+           && (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w))
+    {
+        digits[length - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+// Generates the shortest digits of the numbers in the range (wm, wp]
+// multiplied by 10^k, where the range is defined by delta = wp - wm
+inline int grisu_digits(diy_fp const& w, diy_fp const& wp,
+                        boost::uint64_t delta, char* digits, int& k)
+{
+    boost::uint32_t const* const powers = decimal_powers32();
+
+    diy_fp const one(boost::uint64_t(1) << -wp.e, wp.e);
+    boost::uint64_t const wp_w = wp.f - w.f;
+    boost::uint32_t p1 = static_cast<boost::uint32_t>(wp.f >> -one.e);
+    boost::uint64_t p2 = wp.f & (one.f - 1);
+
+    int kappa = 1;
+    while (kappa < 10 && p1 >= powers[kappa])
+    {
+        ++kappa;
+    }
+
+    int length = 0;
+    while (kappa > 0)
+    {
+        boost::uint32_t const d = p1 / powers[kappa - 1];
+        p1 %= powers[kappa - 1];
+        if (d != 0 || length != 0)
+        {
+            digits[length++] = static_cast<char>('0' + d);
+        }
+        --kappa;
+        boost::uint64_t const rest = (boost::uint64_t(p1) << -one.e) + p2;
+        if (rest <= delta)
+        {
+            k += kappa;
+            grisu_round(digits, length, delta, rest,
+                        boost::uint64_t(powers[kappa]) << -one.e, wp_w);
+            return length;
+        }
+    }
+
+    for (;;)
+    {
+        p2 *= 10;
+        delta *= 10;
+        char const d = static_cast<char>(p2 >> -one.e);
+        if (d != 0 || length != 0)
+        {
+            digits[length++] = static_cast<char>('0' + d);
+        }
+        p2 &= one.f - 1;
+        --kappa;
+        if (p2 < delta)
+        {
+            k += kappa;
+            boost::uint64_t unit = 0;
+            if (-kappa < 20)
+            {
+                unit = 1;
+                for (int i = 0 ; i < -kappa ; ++i)
+                {
+                    unit *= 10;
+                }
+            }
+            grisu_round(digits, length, delta, p2, one.f, wp_w * unit);
+            return length;
+        }
+    }
+}
+
+// Writes the digits of the mantissa without trailing zeros, the number
+// is equal to the mantissa multiplied by 10^k
+inline int mantissa_digits(boost::uint64_t mantissa, char* digits, int& k)
+{
+    while (mantissa % 10 == 0)
+    {
+        mantissa /= 10;
+        ++k;
+    }
+
+    char str[24];
+    char* const last = str + sizeof(str);
+    char const* const first = format_digits(mantissa, last);
+    int const length = static_cast<int>(last - first);
+    std::memcpy(digits, first, static_cast<std::size_t>(length));
+    return length;
+}
+
+// Grisu2 algorithm of Florian Loitsch generating the digits of a positive
+// finite number multiplied by 10^k. The result is always converted back to
+// the same number and in almost all cases it's the shortest such number.
+template <typename T>
+inline int grisu2_digits(T value, char* digits, int& k)
+{
+    diy_fp v, w_m, w_p;
+    diy_fp_boundaries(value, v, w_m, w_p);
+
+    diy_fp const c_mk = cached_power(w_p.e, k);
+    diy_fp const w = diy_fp_multiply(diy_fp_normalize(v), c_mk);
+    diy_fp wp = diy_fp_multiply(w_p, c_mk);
+    diy_fp wm = diy_fp_multiply(w_m, c_mk);
+    ++wm.f;
+    --wp.f;
+
+    return grisu_digits(w, wp, wp.f - wm.f, digits, k);
+}
+
+// The digits of a positive finite double generated by Grisu2.
+// The rare longer results are shortened if the number rounded to one
+// digit less is converted back to the same number. This is checked exactly
+// with one multiplication and one division of numbers exactly representable
+// as double, the same way the number is converted by parse_floating().
+inline int shortest_digits(double value, char* digits, int& k)
+{
+    static const double max_exact_mantissa = 9007199254740992.0; // 2^53
+
+    int const length = grisu2_digits(value, digits, k);
+
+    // The scaled number may be rounded so its neighbours are checked too
+    int const p = -k - 1;
+    if (length > 1 && p >= -22 && p <= 22)
+    {
+        double const power = decimal_powers()[p < 0 ? -p : p];
+        double const m = std::floor((p < 0 ? value / power : value * power) + 0.5);
+        for (int i = 0 ; i < 3 ; ++i)
+        {
+            double const c = i == 0 ? m : i == 1 ? m - 1 : m + 1;
+            if (c > 0 && c < max_exact_mantissa
+                && (p < 0 ? c * power : c / power) == value)
+            {
+                k = -p;
+                return mantissa_digits(static_cast<boost::uint64_t>(c), digits, k);
+            }
+        }
+    }
+
+    return length;
+}
+
+// Formats the number with the classic locale, the precision is the number
+// of digits after the decimal point in fixed or scientific notation.
+// The memory is allocated by the stream and for the string.
+template <typename T>
+inline std::string format_stream(T const& value, int precision,
+                                 std::ios_base::fmtflags floatfield = std::ios_base::fixed)
+{
+    std::ostringstream out;
+    out.imbue(std::locale::classic());
+    if (precision >= 0)
+    {
+        out.setf(floatfield, std::ios_base::floatfield);
+        out << std::setprecision(precision);
+    }
+    out << value;
+    return out.str();
+}
+
+// Removes the last digit if the number rounded to one digit less, up or
+// down, is converted back to the same float by parse_floating()
+inline bool shorten_digits(float value, char* digits, int& length, int& k)
+{
+    if (length < 2)
+    {
+        return false;
+    }
+
+    boost::uint64_t n = 0;
+    for (int i = 0 ; i < length - 1 ; ++i)
+    {
+        n = n * 10 + static_cast<boost::uint64_t>(digits[i] - '0');
+    }
+
+    // the nearest candidate first
+    boost::uint64_t const candidates[2] =
+    {
+        digits[length - 1] >= '5' ? n + 1 : n,
+        digits[length - 1] >= '5' ? n : n + 1
+    };
+
+    for (int i = 0 ; i < 2 ; ++i)
+    {
+        // "ddde-XX"
+        char str[32];
+        char* const last = str + sizeof(str);
+        int const exponent = k + 1;
+        char* it = format_digits(static_cast<boost::uint64_t>(exponent < 0 ? -exponent : exponent), last);
+        if (exponent < 0)
+        {
+            *--it = '-';
+        }
+        *--it = 'e';
+        it = format_digits(candidates[i], it);
+
+        float parsed = 0;
+        if (parse_floating(it, last, parsed) && parsed == value)
+        {
+            k = exponent;
+            length = mantissa_digits(candidates[i], digits, k);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// The digits of a positive finite float generated by Grisu2 with the
+// boundaries of the float. The results longer than necessary are shortened
+// while the number with one digit less is converted back to the same float.
+inline int shortest_digits(float value, char* digits, int& k)
+{
+    int length = grisu2_digits(value, digits, k);
+    while (shorten_digits(value, digits, length, k))
+    {
+    }
+    return length;
+}
+
+// Writes the digits multiplied by 10^k in fixed notation or, for very
+// large and very small numbers, in scientific notation
+inline char* format_decimal(bool negative, char const* digits, int length,
+                            int k, char* out)
+{
+    if (negative)
+    {
+        *out++ = '-';
+    }
+
+    // 10^(point - 1) <= value < 10^point
+    int const point = length + k;
+
+    if (0 < point && point <= 21)
+    {
+        for (int i = 0 ; i < point ; ++i)
+        {
+            *out++ = i < length ? digits[i] : '0';
+        }
+        if (point < length)
+        {
+            *out++ = '.';
+            for (int i = point ; i < length ; ++i)
+            {
+                *out++ = digits[i];
+            }
+        }
+    }
+    else if (-6 < point && point <= 0)
+    {
+        *out++ = '0';
+        *out++ = '.';
+        for (int i = point ; i < 0 ; ++i)
+        {
+            *out++ = '0';
+        }
+        for (int i = 0 ; i < length ; ++i)
+        {
+            *out++ = digits[i];
+        }
+    }
+    else
+    {
+        *out++ = digits[0];
+        if (length > 1)
+        {
+            *out++ = '.';
+            for (int i = 1 ; i < length ; ++i)
+            {
+                *out++ = digits[i];
+            }
+        }
+
+        int exponent = point - 1;
+        *out++ = 'e';
+        *out++ = exponent < 0 ? '-' : '+';
+        if (exponent < 0)
+        {
+            exponent = -exponent;
+        }
+        if (exponent < 10)
+        {
+            *out++ = '0';
+        }
+        char str[8];
+        char* const last = str + sizeof(str);
+        for (char const* it = format_digits(static_cast<boost::uint64_t>(exponent), last) ;
+             it != last ; ++it)
+        {
+            *out++ = *it;
+        }
+    }
+
+    return out;
+}
+
+// Formats the shortest decimal number converted back to the same value
+template <typename T>
+inline char* format_shortest(T const& value, char* out)
+{
+    bool const negative = boost::math::signbit(value) != 0;
+
+    if (boost::math::isnan(value))
+    {
+        return format_copy("nan", out);
+    }
+    else if (boost::math::isinf(value))
+    {
+        return format_copy(negative ? "-inf" : "inf", out);
+    }
+    else if (value == 0)
+    {
+        return format_copy(negative ? "-0" : "0", out);
+    }
+
+    char digits[32];
+    int k = 0;
+    int const length = shortest_digits(negative ? -value : value, digits, k);
+    return format_decimal(negative, digits, length, k, out);
+}
+
+// Stores the exact decimal value of the positive finite double
+inline void exact_decimal(double value, big_decimal& d)
+{
+    boost::uint64_t const hidden_bit = boost::uint64_t(1) << 52;
+
+    boost::uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(double));
+    int const biased_e = static_cast<int>((bits >> 52) & 0x7FF);
+    boost::uint64_t const significand = bits & (hidden_bit - 1);
+    boost::uint64_t const mantissa = biased_e != 0 ? significand + hidden_bit : significand;
+    int e = biased_e != 0 ? biased_e - 1075 : -1074;
+
+    char str[24];
+    char* const last = str + sizeof(str);
+    char const* it = format_digits(mantissa, last);
+
+    d = big_decimal();
+    for ( ; it != last ; ++it)
+    {
+        d.digits[d.count++] = static_cast<unsigned char>(*it - '0');
+    }
+    d.point = d.count;
+    trim_zeros(d);
+
+    // at most 767 significant digits so the result is exact
+    while (e > 0)
+    {
+        int const shift = e < 60 ? e : 60;
+        shift_left(d, shift);
+        e -= shift;
+    }
+    while (e < 0)
+    {
+        int const shift = -e < 60 ? -e : 60;
+        shift_right(d, shift);
+        e += shift;
+    }
+}
+
+// Rounds the decimal number to precision fraction digits, ties to even
+inline void round_fraction_digits(big_decimal& d, int precision)
+{
+    // the index of the first dropped digit
+    int const cut = d.point + precision;
+    if (cut >= d.count)
+    {
+        return;
+    }
+    if (cut < 0)
+    {
+        d = big_decimal();
+        return;
+    }
+
+    bool const round_up = d.digits[cut] > 5
+        || (d.digits[cut] == 5
+            && (cut + 1 < d.count || d.truncated
+                || (cut > 0 && (d.digits[cut - 1] & 1))));
+
+    d.count = cut;
+    d.truncated = false;
+    if (round_up)
+    {
+        int i = cut - 1;
+        while (i >= 0 && d.digits[i] == 9)
+        {
+            --i;
+        }
+        if (i < 0)
+        {
+            d.digits[0] = 1;
+            d.count = 1;
+            ++d.point;
+        }
+        else
+        {
+            ++d.digits[i];
+            d.count = i + 1;
+        }
+    }
+    trim_zeros(d);
+}
+
+// Appends the characters in chunks written to a small array
+template <typename Buffer>
+class chunked_output
+{
+public:
+    explicit chunked_output(Buffer& buffer)
+        : m_buffer(buffer), m_size(0)
+    {}
+
+    ~chunked_output()
+    {
+        flush();
+    }
+
+    void put(char c)
+    {
+        if (m_size == sizeof(m_chars))
+        {
+            flush();
+        }
+        m_chars[m_size++] = c;
+    }
+
+    void flush()
+    {
+        append_chars(m_buffer, m_chars, m_chars + m_size);
+        m_size = 0;
+    }
+
+private:
+    Buffer& m_buffer;
+    char m_chars[64];
+    std::size_t m_size;
+};
+
+// Formats the number rounded to precision fraction digits from its exact
+// decimal value, the same way as printf() and the streams do
+template <typename Buffer>
+inline void format_exact_fixed(Buffer& buffer, double value, int precision)
+{
+    bool const negative = boost::math::signbit(value) != 0;
+
+    if (boost::math::isnan(value) || boost::math::isinf(value))
+    {
+        char str[8];
+        char* const last = format_copy(boost::math::isnan(value) ? "nan"
+                                     : negative ? "-inf" : "inf", str);
+        append_chars(buffer, str, last);
+        return;
+    }
+
+    big_decimal d;
+    exact_decimal(negative ? -value : value, d);
+    round_fraction_digits(d, precision);
+
+    chunked_output<Buffer> out(buffer);
+    if (negative)
+    {
+        out.put('-');
+    }
+    if (d.point <= 0)
+    {
+        out.put('0');
+    }
+    for (int i = 0 ; i < d.point ; ++i)
+    {
+        out.put(i < d.count ? static_cast<char>('0' + d.digits[i]) : '0');
+    }
+    if (precision > 0)
+    {
+        out.put('.');
+        for (int i = d.point ; i < d.point + precision ; ++i)
+        {
+            out.put(i >= 0 && i < d.count ? static_cast<char>('0' + d.digits[i]) : '0');
+        }
+    }
+}
+
+// Formats the number rounded to precision fraction digits. Below 2^52 the
+// halves are representable so the number scaled with one multiplication is
+// rounded the same way as the exact product, unless it's a tie. The other
+// numbers, e.g. large numbers, big precisions and ties, are rounded exactly
+// from the decimal value of the number.
+template <typename Buffer, typename T>
+inline void format_fixed(Buffer& buffer, T const& value, int precision)
+{
+    static const double max_mantissa = 4503599627370496.0; // 2^52
+
+    double const a = std::fabs(static_cast<double>(value));
+    double const scaled = precision <= 22 ? a * decimal_powers()[precision] : 0;
+    double const integral = std::floor(scaled);
+    double const fraction = scaled - integral;
+
+    if (precision <= 22 && scaled < max_mantissa && fraction != 0.5)
+    {
+        char str[64];
+        bool const negative = boost::math::signbit(value) != 0;
+        boost::uint64_t const m = static_cast<boost::uint64_t>(integral)
+                                + (fraction > 0.5 ? 1 : 0);
+        char* const last = format_fixed_point(negative, m, precision, str);
+        append_chars(buffer, str, last);
+    }
+    else
+    {
+        format_exact_fixed(buffer, static_cast<double>(value), precision);
+    }
+}
+
+// Appends the number to the buffer. A negative precision means the shortest
+// representation converted back to the same value, otherwise the number
+// is rounded to precision fraction digits. No memory is allocated except
+// by the buffer, besides types other than arithmetic types which are
+// formatted by the stream with the classic locale.
+template
+<
+    typename CoordinateType,
+    bool IsIntegral = boost::is_integral<CoordinateType>::value,
+    bool IsFloat = boost::is_same<CoordinateType, double>::value
+                || boost::is_same<CoordinateType, float>::value
+>
+struct format_number
+{
+    template <typename Buffer>
+    static inline void apply(Buffer& buffer, CoordinateType const& value,
+                             int precision)
+    {
+        std::string const str = format_stream(value, precision);
+        append_chars(buffer, str.data(), str.data() + str.size());
+    }
+};
+
+template <typename CoordinateType>
+struct format_number<CoordinateType, true, false>
+{
+    template <typename Buffer>
+    static inline void apply(Buffer& buffer, CoordinateType const& value, int)
+    {
+        char str[24];
+        bool const negative = value < CoordinateType(0);
+        // the absolute value calculated in the unsigned type
+        boost::uint64_t const a = negative
+            ? boost::uint64_t(0) - static_cast<boost::uint64_t>(value)
+            : static_cast<boost::uint64_t>(value);
+        char* it = format_digits(a, str + sizeof(str));
+        if (negative)
+        {
+            *--it = '-';
+        }
+        append_chars(buffer, it, str + sizeof(str));
+    }
+};
+
+template <typename CoordinateType>
+struct format_number<CoordinateType, false, true>
+{
+    template <typename Buffer>
+    static inline void apply(Buffer& buffer, CoordinateType const& value,
+                             int precision)
+    {
+        if (precision >= 0)
+        {
+            format_fixed(buffer, value, precision);
+        }
+        else
+        {
+            char str[64];
+            char* const last = format_shortest(value, str);
+            append_chars(buffer, str, last);
+        }
+    }
+};
+
+
+}} // namespace detail::wkt
+#endif // DOXYGEN_NO_DETAIL
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_IO_WKT_DETAIL_FORMAT_NUMBER_HPP
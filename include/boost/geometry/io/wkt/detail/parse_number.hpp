@@ -0,0 +1,877 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_IO_WKT_DETAIL_PARSE_NUMBER_HPP
+#define BOOST_GEOMETRY_IO_WKT_DETAIL_PARSE_NUMBER_HPP
+
+
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/geometry/io/wkt/detail/powers_of_five.hpp>
+#include <boost/geometry/util/coordinate_cast.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace wkt
+{
+
+
+inline bool is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+// The format of the binary floating point type, the exponents of 10 of the
+// numbers rounded exactly to even by Eisel-Lemire algorithm and the range
+// of the exponents of 10 of numbers which are not rounded to 0 or infinity
+template <typename T>
+struct binary_format
+{
+    typedef boost::uint64_t bits_type;
+    static const int mantissa_bits = 52;
+    static const int minimum_exponent = -1023;
+    static const int infinite_power = 0x7FF;
+    static const int min_exponent_round_to_even = -4;
+    static const int max_exponent_round_to_even = 23;
+    static const int smallest_power_of_ten = -342;
+    static const int largest_power_of_ten = 308;
+    // The range of the exactly representable powers of 10
+    static const int max_exact_exponent = 22;
+};
+
+template <>
+struct binary_format<float>
+{
+    typedef boost::uint32_t bits_type;
+    static const int mantissa_bits = 23;
+    static const int minimum_exponent = -127;
+    static const int infinite_power = 0xFF;
+    static const int min_exponent_round_to_even = -17;
+    static const int max_exponent_round_to_even = 10;
+    static const int smallest_power_of_ten = -65;
+    static const int largest_power_of_ten = 38;
+    static const int max_exact_exponent = 10;
+};
+
+// The value defined by the mantissa without the hidden bit and the biased
+// exponent of 2 as stored in the binary floating point type
+struct binary_mantissa
+{
+    binary_mantissa()
+        : mantissa(0), power2(0)
+    {}
+
+    boost::uint64_t mantissa;
+    int power2;
+};
+
+template <typename T>
+inline T binary_to_floating(bool negative, binary_mantissa const& m)
+{
+    typedef binary_format<T> format;
+    typedef typename format::bits_type bits_type;
+
+    bits_type bits = static_cast<bits_type>(m.mantissa)
+                   | (static_cast<bits_type>(m.power2) << format::mantissa_bits);
+    if (negative)
+    {
+        bits |= bits_type(1) << (sizeof(bits_type) * 8 - 1);
+    }
+
+    T result;
+    std::memcpy(&result, &bits, sizeof(T));
+    return result;
+}
+
+struct uint128
+{
+    boost::uint64_t high;
+    boost::uint64_t low;
+};
+
+inline uint128 full_multiply(boost::uint64_t l, boost::uint64_t r)
+{
+    uint128 result;
+#ifdef BOOST_HAS_INT128
+    boost::uint128_type const product = static_cast<boost::uint128_type>(l) * r;
+    result.high = static_cast<boost::uint64_t>(product >> 64);
+    result.low = static_cast<boost::uint64_t>(product);
+#else
+    boost::uint64_t const mask = 0xFFFFFFFFu;
+    boost::uint64_t const a = l >> 32;
+    boost::uint64_t const b = l & mask;
+    boost::uint64_t const c = r >> 32;
+    boost::uint64_t const d = r & mask;
+    boost::uint64_t const ac = a * c;
+    boost::uint64_t const bc = b * c;
+    boost::uint64_t const ad = a * d;
+    boost::uint64_t const bd = b * d;
+    boost::uint64_t const middle = (bd >> 32) + (ad & mask) + (bc & mask);
+    result.high = ac + (ad >> 32) + (bc >> 32) + (middle >> 32);
+    result.low = (middle << 32) | (bd & mask);
+#endif
+    return result;
+}
+
+inline int leading_zeros(boost::uint64_t value)
+{
+    int result = 0;
+    for (boost::uint64_t const top_bit = boost::uint64_t(1) << 63 ;
+         ! (value & top_bit) ; value <<= 1)
+    {
+        ++result;
+    }
+    return result;
+}
+
+// Eisel-Lemire algorithm converting w * 10^q, where w is a nonzero integer,
+// to the nearest binary floating point number, as described by Daniel Lemire
+// in "Number Parsing at a Gigabyte per Second". The product of w and
+// the truncated power of 5 is exact enough to be rounded correctly except
+// rare cases for which false is returned.
+template <typename T>
+inline bool eisel_lemire(boost::uint64_t w, int q, binary_mantissa& result)
+{
+    typedef binary_format<T> format;
+
+    if (q < format::smallest_power_of_ten)
+    {
+        result = binary_mantissa();
+        return true;
+    }
+    if (q > format::largest_power_of_ten)
+    {
+        result.mantissa = 0;
+        result.power2 = format::infinite_power;
+        return true;
+    }
+
+    int const lz = leading_zeros(w);
+    w <<= lz;
+
+    // The product with the first 64 bits of the power of 5 is enough unless
+    // the bits below the mantissa, the rounding bit and one more bit are all
+    // set so the next 64 bits could change the rounded value
+    power_of_five const& p = power_of_five_128(q);
+    boost::uint64_t const p_high = (boost::uint64_t(p.words[0]) << 32) | p.words[1];
+    boost::uint64_t const p_low = (boost::uint64_t(p.words[2]) << 32) | p.words[3];
+    boost::uint64_t const precision_mask = ~boost::uint64_t(0) >> (format::mantissa_bits + 3);
+
+    uint128 product = full_multiply(w, p_high);
+    if ((product.high & precision_mask) == precision_mask)
+    {
+        uint128 const second = full_multiply(w, p_low);
+        product.low += second.high;
+        if (second.high > product.low)
+        {
+            ++product.high;
+        }
+    }
+    if (product.low == ~boost::uint64_t(0) && (q < -27 || q > 55))
+    {
+        return false;
+    }
+
+    int const upper_bit = static_cast<int>(product.high >> 63);
+    int const shift = upper_bit + 64 - format::mantissa_bits - 3;
+    result.mantissa = product.high >> shift;
+    // floor(log2(10^q)) + 63 + the normalization
+    result.power2 = (((152170 + 65536) * q) >> 16) + 63 + upper_bit - lz
+                  - format::minimum_exponent;
+
+    if (result.power2 <= 0)
+    {
+        // subnormal
+        if (-result.power2 + 1 >= 64)
+        {
+            result = binary_mantissa();
+            return true;
+        }
+        result.mantissa >>= -result.power2 + 1;
+        result.mantissa += result.mantissa & 1;
+        result.mantissa >>= 1;
+        result.power2 = result.mantissa < (boost::uint64_t(1) << format::mantissa_bits) ? 0 : 1;
+        return true;
+    }
+
+    // The product is exact and in the middle between two floating point
+    // numbers so it's rounded to even
+    if (product.low <= 1
+        && q >= format::min_exponent_round_to_even
+        && q <= format::max_exponent_round_to_even
+        && (result.mantissa & 3) == 1
+        && (result.mantissa << shift) == product.high)
+    {
+        result.mantissa &= ~boost::uint64_t(1);
+    }
+
+    result.mantissa += result.mantissa & 1;
+    result.mantissa >>= 1;
+    if (result.mantissa >= (boost::uint64_t(2) << format::mantissa_bits))
+    {
+        result.mantissa = boost::uint64_t(1) << format::mantissa_bits;
+        ++result.power2;
+    }
+    result.mantissa &= ~(boost::uint64_t(1) << format::mantissa_bits);
+
+    if (result.power2 >= format::infinite_power)
+    {
+        result.mantissa = 0;
+        result.power2 = format::infinite_power;
+    }
+    return true;
+}
+
+// The decimal number 0.d1d2d3... * 10^point stored in a fixed buffer.
+// The digits beyond max_digits are dropped, the flag is set if any of
+// them is nonzero. This precision is enough to round every double
+// correctly, see "Simple Decimal Conversion" of Nigel Tao.
+struct big_decimal
+{
+    static const int max_digits = 768;
+    static const int point_range = 2047;
+
+    big_decimal()
+        : count(0), point(0), truncated(false)
+    {}
+
+    int count;
+    int point;
+    bool truncated;
+    // room for the new digits of the left shift written before trimming
+    unsigned char digits[max_digits + 20];
+};
+
+inline void trim_zeros(big_decimal& d)
+{
+    while (d.count > 0 && d.digits[d.count - 1] == 0)
+    {
+        --d.count;
+    }
+}
+
+// Divides the number by 2^shift, where shift <= 60
+inline void shift_right(big_decimal& d, int shift)
+{
+    int read = 0;
+    int write = 0;
+    boost::uint64_t n = 0;
+
+    while ((n >> shift) == 0)
+    {
+        if (read < d.count)
+        {
+            n = 10 * n + d.digits[read++];
+        }
+        else if (n == 0)
+        {
+            return;
+        }
+        else
+        {
+            while ((n >> shift) == 0)
+            {
+                n = 10 * n;
+                ++read;
+            }
+            break;
+        }
+    }
+
+    d.point -= read - 1;
+    if (d.point < -big_decimal::point_range)
+    {
+        d = big_decimal();
+        return;
+    }
+
+    boost::uint64_t const mask = (boost::uint64_t(1) << shift) - 1;
+    while (read < d.count)
+    {
+        unsigned char const digit = static_cast<unsigned char>(n >> shift);
+        n = 10 * (n & mask) + d.digits[read++];
+        d.digits[write++] = digit;
+    }
+    while (n > 0)
+    {
+        unsigned char const digit = static_cast<unsigned char>(n >> shift);
+        n = 10 * (n & mask);
+        if (write < big_decimal::max_digits)
+        {
+            d.digits[write++] = digit;
+        }
+        else if (digit > 0)
+        {
+            d.truncated = true;
+        }
+    }
+
+    d.count = write;
+    trim_zeros(d);
+}
+
+// Multiplies the number by 2^shift, where shift <= 60
+inline void shift_left(big_decimal& d, int shift)
+{
+    if (d.count == 0)
+    {
+        return;
+    }
+
+    // At most floor(shift * log10(2)) + 1 digits are added, the digits are
+    // written starting from the last one and moved if there are less of them
+    int const new_digits = ((shift * 1233) >> 12) + 1;
+    int read = d.count - 1;
+    int write = d.count - 1 + new_digits;
+    boost::uint64_t n = 0;
+
+    while (read >= 0)
+    {
+        n += boost::uint64_t(d.digits[read--]) << shift;
+        boost::uint64_t const quotient = n / 10;
+        d.digits[write--] = static_cast<unsigned char>(n - 10 * quotient);
+        n = quotient;
+    }
+    while (n > 0)
+    {
+        boost::uint64_t const quotient = n / 10;
+        d.digits[write--] = static_cast<unsigned char>(n - 10 * quotient);
+        n = quotient;
+    }
+
+    int const first = write + 1;
+    int count = d.count + new_digits - first;
+    if (first > 0)
+    {
+        std::memmove(d.digits, d.digits + first, static_cast<std::size_t>(count));
+    }
+    d.point += new_digits - first;
+
+    if (count > big_decimal::max_digits)
+    {
+        for (int i = big_decimal::max_digits ; i < count ; ++i)
+        {
+            if (d.digits[i] != 0)
+            {
+                d.truncated = true;
+            }
+        }
+        count = big_decimal::max_digits;
+    }
+    d.count = count;
+    trim_zeros(d);
+}
+
+// The integral part of the number rounded to nearest, ties to even
+inline boost::uint64_t round_decimal(big_decimal const& d)
+{
+    if (d.count == 0 || d.point < 0)
+    {
+        return 0;
+    }
+    if (d.point > 18)
+    {
+        return ~boost::uint64_t(0);
+    }
+
+    boost::uint64_t n = 0;
+    for (int i = 0 ; i < d.point ; ++i)
+    {
+        n = 10 * n + (i < d.count ? d.digits[i] : 0);
+    }
+
+    bool round_up = false;
+    if (d.point < d.count)
+    {
+        round_up = d.digits[d.point] >= 5;
+        if (d.digits[d.point] == 5 && d.point + 1 == d.count)
+        {
+            round_up = d.truncated || (d.point > 0 && (d.digits[d.point - 1] & 1));
+        }
+    }
+    return round_up ? n + 1 : n;
+}
+
+// Converts the decimal number to the nearest binary floating point number
+// by shifting it by powers of 2 until the mantissa is the integral part
+template <typename T>
+inline binary_mantissa decimal_to_binary(big_decimal& d)
+{
+    typedef binary_format<T> format;
+
+    static const int max_shift = 60;
+    // The shifts moving the point by the number of digits
+    static const int shifts[] =
+    {
+        0, 3, 6, 9, 13, 16, 19, 23, 26, 29, 33, 36, 39, 43, 46, 49, 53, 56, 59
+    };
+    static const int shifts_count = sizeof(shifts) / sizeof(shifts[0]);
+
+    binary_mantissa infinity;
+    infinity.power2 = format::infinite_power;
+
+    if (d.count == 0 || d.point < -324)
+    {
+        return binary_mantissa();
+    }
+    if (d.point >= 310)
+    {
+        return infinity;
+    }
+
+    int exp2 = 0;
+    while (d.point > 0)
+    {
+        int const shift = d.point < shifts_count ? shifts[d.point] : max_shift;
+        shift_right(d, shift);
+        if (d.point < -big_decimal::point_range)
+        {
+            return binary_mantissa();
+        }
+        exp2 += shift;
+    }
+
+    // The number is shifted into [1/2, 1)
+    while (d.point <= 0)
+    {
+        int shift = 0;
+        if (d.point == 0)
+        {
+            if (d.digits[0] >= 5)
+            {
+                break;
+            }
+            shift = d.digits[0] < 2 ? 2 : 1;
+        }
+        else
+        {
+            shift = -d.point < shifts_count ? shifts[-d.point] : max_shift;
+        }
+        shift_left(d, shift);
+        if (d.point > big_decimal::point_range)
+        {
+            return infinity;
+        }
+        exp2 -= shift;
+    }
+
+    // and the exponent is adjusted to [1, 2)
+    --exp2;
+
+    while (format::minimum_exponent + 1 > exp2)
+    {
+        int shift = format::minimum_exponent + 1 - exp2;
+        if (shift > max_shift)
+        {
+            shift = max_shift;
+        }
+        shift_right(d, shift);
+        exp2 += shift;
+    }
+
+    if (exp2 - format::minimum_exponent >= format::infinite_power)
+    {
+        return infinity;
+    }
+
+    int const mantissa_size = format::mantissa_bits + 1;
+    shift_left(d, mantissa_size);
+    boost::uint64_t mantissa = round_decimal(d);
+    if (mantissa >= (boost::uint64_t(1) << mantissa_size))
+    {
+        // rounded up to the next power of 2
+        shift_right(d, 1);
+        ++exp2;
+        mantissa = round_decimal(d);
+        if (exp2 - format::minimum_exponent >= format::infinite_power)
+        {
+            return infinity;
+        }
+    }
+
+    binary_mantissa result;
+    result.power2 = exp2 - format::minimum_exponent;
+    if (mantissa < (boost::uint64_t(1) << format::mantissa_bits))
+    {
+        --result.power2;
+    }
+    result.mantissa = mantissa & ((boost::uint64_t(1) << format::mantissa_bits) - 1);
+    return result;
+}
+
+// Stores the digits of the decimal number already checked by parse_floating
+inline void parse_big_decimal(char const* it, char const* last, big_decimal& d)
+{
+    if (*it == '-' || *it == '+')
+    {
+        ++it;
+    }
+
+    bool nonzero_dropped = false;
+    bool fraction = false;
+    for ( ; it != last && *it != 'e' && *it != 'E' ; ++it)
+    {
+        if (*it == '.')
+        {
+            fraction = true;
+            continue;
+        }
+
+        unsigned char const digit = static_cast<unsigned char>(*it - '0');
+        if (d.count == 0 && digit == 0)
+        {
+            // leading zeros
+            if (fraction)
+            {
+                --d.point;
+            }
+            continue;
+        }
+
+        if (d.count < big_decimal::max_digits)
+        {
+            d.digits[d.count++] = digit;
+        }
+        else if (digit != 0)
+        {
+            nonzero_dropped = true;
+        }
+        if (! fraction)
+        {
+            ++d.point;
+        }
+    }
+
+    if (it != last)
+    {
+        ++it;
+        bool const negative_exponent = *it == '-';
+        if (*it == '-' || *it == '+')
+        {
+            ++it;
+        }
+        int e = 0;
+        for ( ; it != last ; ++it)
+        {
+            if (e < 10000)
+            {
+                e = e * 10 + (*it - '0');
+            }
+        }
+        d.point += negative_exponent ? -e : e;
+    }
+
+    d.truncated = nonzero_dropped;
+    trim_zeros(d);
+}
+
+// Parses a decimal floating point number: optional sign, digits with
+// optional decimal point and optional exponent. Other forms accepted
+// by strtod() or streams, e.g. hexadecimal, inf or nan, are rejected as
+// well as the numbers too large for T. The result is correctly rounded and
+// no memory is allocated. The numbers with small mantissas and exponents
+// are converted exactly with one multiplication or division of two exactly
+// representable values of type T. The other numbers with at most 19
+// significant digits are converted with Eisel-Lemire algorithm. The rest
+// are converted with arbitrary precision decimal stored on the stack.
+// Compares the characters with the upper case name, case-insensitive
+inline bool equals_ignore_case(char const* first, char const* last,
+                               char const* name)
+{
+    for ( ; first != last && *name != '\0' ; ++first, ++name)
+    {
+        char const c = *first >= 'a' && *first <= 'z'
+                     ? static_cast<char>(*first - 'a' + 'A')
+                     : *first;
+        if (c != *name)
+        {
+            return false;
+        }
+    }
+    return first == last && *name == '\0';
+}
+
+// Parses "inf", "infinity" and "nan" following the sign, case-insensitive,
+// accepted by lexical_cast as well
+template <typename T>
+inline bool parse_inf_nan(char const* first, char const* last,
+                          bool negative, T& result)
+{
+    if (equals_ignore_case(first, last, "INF")
+     || equals_ignore_case(first, last, "INFINITY"))
+    {
+        result = std::numeric_limits<T>::infinity();
+    }
+    else if (equals_ignore_case(first, last, "NAN"))
+    {
+        result = std::numeric_limits<T>::quiet_NaN();
+    }
+    else
+    {
+        return false;
+    }
+
+    if (negative)
+    {
+        result = -result;
+    }
+    return true;
+}
+
+template <typename T>
+inline bool parse_floating(char const* first, char const* last, T& result)
+{
+    typedef binary_format<T> format;
+
+    static const T powers[] =
+    {
+        T(1e0), T(1e1), T(1e2), T(1e3), T(1e4), T(1e5), T(1e6), T(1e7), T(1e8),
+        T(1e9), T(1e10), T(1e11), T(1e12), T(1e13), T(1e14), T(1e15), T(1e16),
+        T(1e17), T(1e18), T(1e19), T(1e20), T(1e21), T(1e22)
+    };
+    static const boost::uint64_t max_exact_mantissa
+        = boost::uint64_t(2) << format::mantissa_bits;
+
+    char const* it = first;
+    bool negative = false;
+    if (it != last && (*it == '-' || *it == '+'))
+    {
+        negative = *it == '-';
+        ++it;
+    }
+
+    // The first 19 significant digits, the following digits are dropped
+    boost::uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool has_digits = false;
+    bool truncated = false;
+
+    for ( ; it != last && is_digit(*it) ; ++it)
+    {
+        has_digits = true;
+        if (mantissa == 0 && *it == '0')
+        {
+            continue;
+        }
+        if (digits < 19)
+        {
+            mantissa = mantissa * 10 + static_cast<boost::uint64_t>(*it - '0');
+            ++digits;
+        }
+        else
+        {
+            truncated = truncated || *it != '0';
+            ++exponent;
+        }
+    }
+
+    if (it != last && *it == '.')
+    {
+        for (++it ; it != last && is_digit(*it) ; ++it)
+        {
+            has_digits = true;
+            if (mantissa == 0 && *it == '0')
+            {
+                --exponent;
+                continue;
+            }
+            if (digits < 19)
+            {
+                mantissa = mantissa * 10 + static_cast<boost::uint64_t>(*it - '0');
+                ++digits;
+                --exponent;
+            }
+            else
+            {
+                truncated = truncated || *it != '0';
+            }
+        }
+    }
+
+    if (! has_digits)
+    {
+        return parse_inf_nan(it, last, negative, result);
+    }
+
+    if (it != last && (*it == 'e' || *it == 'E'))
+    {
+        ++it;
+        bool negative_exponent = false;
+        if (it != last && (*it == '-' || *it == '+'))
+        {
+            negative_exponent = *it == '-';
+            ++it;
+        }
+
+        int e = 0;
+        bool has_exponent_digits = false;
+        for ( ; it != last && is_digit(*it) ; ++it)
+        {
+            has_exponent_digits = true;
+            if (e < 10000)
+            {
+                e = e * 10 + (*it - '0');
+            }
+        }
+        if (! has_exponent_digits)
+        {
+            return false;
+        }
+        exponent += negative_exponent ? -e : e;
+    }
+
+    if (it != last)
+    {
+        return false;
+    }
+
+    if (mantissa == 0)
+    {
+        result = negative ? -T(0) : T(0);
+        return true;
+    }
+
+    if (! truncated && mantissa <= max_exact_mantissa
+        && exponent >= -format::max_exact_exponent
+        && exponent <= format::max_exact_exponent)
+    {
+        T const m = static_cast<T>(mantissa);
+        result = exponent < 0 ? m / powers[-exponent] : m * powers[exponent];
+        if (negative)
+        {
+            result = -result;
+        }
+        return true;
+    }
+
+    // The dropped digits are between the truncated mantissa and the next
+    // integer so the result is known if both are rounded to the same value
+    binary_mantissa m, upper;
+    if (! eisel_lemire<T>(mantissa, exponent, m)
+        || (truncated && (! eisel_lemire<T>(mantissa + 1, exponent, upper)
+                          || upper.mantissa != m.mantissa
+                          || upper.power2 != m.power2)))
+    {
+        big_decimal d;
+        parse_big_decimal(first, last, d);
+        m = decimal_to_binary<T>(d);
+    }
+
+    if (m.power2 == format::infinite_power)
+    {
+        return false;
+    }
+
+    result = binary_to_floating<T>(negative, m);
+    return true;
+}
+
+template <typename T>
+inline bool parse_integer(char const* first, char const* last, T& result)
+{
+    char const* it = first;
+    bool negative = false;
+    if (it != last && (*it == '-' || *it == '+'))
+    {
+        negative = *it == '-';
+        ++it;
+    }
+
+    if (it == last || (negative && ! std::numeric_limits<T>::is_signed))
+    {
+        return false;
+    }
+
+    T value = 0;
+    T const max_value = (std::numeric_limits<T>::max)();
+    for ( ; it != last ; ++it)
+    {
+        if (! is_digit(*it))
+        {
+            return false;
+        }
+        T const d = static_cast<T>(*it - '0');
+        if (value > (max_value - d) / 10)
+        {
+            return false;
+        }
+        value = static_cast<T>(value * 10 + d);
+    }
+
+    result = negative ? static_cast<T>(-value) : value;
+    return true;
+}
+
+// Converts the characters of a number to the coordinate type.
+// Types other than arithmetic types are converted with coordinate_cast.
+template
+<
+    typename CoordinateType,
+    bool IsIntegral = boost::is_integral<CoordinateType>::value,
+    bool IsFloat = boost::is_same<CoordinateType, double>::value
+                || boost::is_same<CoordinateType, float>::value
+>
+struct parse_number
+{
+    static inline bool apply(char const* first, char const* last,
+                             CoordinateType& result)
+    {
+        try
+        {
+            result = coordinate_cast<CoordinateType>::apply(std::string(first, last));
+        }
+        catch(...)
+        {
+            return false;
+        }
+        return true;
+    }
+};
+
+template <typename CoordinateType>
+struct parse_number<CoordinateType, true, false>
+{
+    static inline bool apply(char const* first, char const* last,
+                             CoordinateType& result)
+    {
+        return parse_integer(first, last, result);
+    }
+};
+
+template <typename CoordinateType>
+struct parse_number<CoordinateType, false, true>
+{
+    static inline bool apply(char const* first, char const* last,
+                             CoordinateType& result)
+    {
+        return parse_floating(first, last, result);
+    }
+};
+
+
+}} // namespace detail::wkt
+#endif // DOXYGEN_NO_DETAIL
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_IO_WKT_DETAIL_PARSE_NUMBER_HPP
@@ -23,15 +23,11 @@
 #include <cstddef>
 #include <string>
 
-#include <boost/lexical_cast.hpp>
-#include <boost/tokenizer.hpp>
-
-#include <boost/algorithm/string.hpp>
-#include <boost/mpl/if.hpp>
 #include <boost/range/begin.hpp>
 #include <boost/range/end.hpp>
 #include <boost/range/size.hpp>
 #include <boost/range/value_type.hpp>
+#include <boost/static_assert.hpp>
 #include <boost/throw_exception.hpp>
 #include <boost/type_traits/is_same.hpp>
 #include <boost/type_traits/remove_reference.hpp>
@@ -39,25 +35,29 @@
 #include <boost/geometry/algorithms/assign.hpp>
 #include <boost/geometry/algorithms/append.hpp>
 #include <boost/geometry/algorithms/clear.hpp>
+#include <boost/geometry/algorithms/detail/assign_indexed_point.hpp>
 #include <boost/geometry/algorithms/detail/equals/point_point.hpp>
 
 #include <boost/geometry/core/access.hpp>
+#include <boost/geometry/core/closure.hpp>
 #include <boost/geometry/core/coordinate_dimension.hpp>
+#include <boost/geometry/core/coordinate_type.hpp>
 #include <boost/geometry/core/exception.hpp>
 #include <boost/geometry/core/exterior_ring.hpp>
-#include <boost/geometry/core/geometry_id.hpp>
 #include <boost/geometry/core/interior_rings.hpp>
 #include <boost/geometry/core/mutable_range.hpp>
 #include <boost/geometry/core/point_type.hpp>
-#include <boost/geometry/core/tag_cast.hpp>
+#include <boost/geometry/core/ring_type.hpp>
+#include <boost/geometry/core/tag.hpp>
 #include <boost/geometry/core/tags.hpp>
 
 #include <boost/geometry/geometries/concepts/check.hpp>
 
-#include <boost/geometry/util/coordinate_cast.hpp>
-
+#include <boost/geometry/io/wkt/detail/parse_number.hpp>
 #include <boost/geometry/io/wkt/detail/prefix.hpp>
 
+#include <boost/geometry/util/bare_type.hpp>
+
 namespace boost { namespace geometry
 {
 
@@ -91,6 +91,19 @@ struct read_wkt_exception : public geometry::exception
         complete = message + "' in (" + wkt.substr(0, 100) + ")";
     }
 
+    read_wkt_exception(std::string const& msg,
+                       std::string const& token,
+                       std::string const& wkt)
+        : message(msg)
+        , wkt(wkt)
+    {
+        if (! token.empty())
+        {
+            source = " at '" + token + "'";
+        }
+        complete = message + source + " in '" + wkt.substr(0, 100) + "'";
+    }
+
     virtual ~read_wkt_exception() throw() {}
 
     virtual const char* what() const throw()
@@ -110,143 +123,6 @@ private :
 namespace detail { namespace wkt
 {
 
-typedef boost::tokenizer<boost::char_separator<char> > tokenizer;
-
-template <typename Point,
-          std::size_t Dimension = 0,
-          std::size_t DimensionCount = geometry::dimension<Point>::value>
-struct parsing_assigner
-{
-    static inline void apply(tokenizer::iterator& it,
-                             tokenizer::iterator const& end,
-                             Point& point,
-                             std::string const& wkt)
-    {
-        typedef typename coordinate_type<Point>::type coordinate_type;
-
-        // Stop at end of tokens, or at "," ot ")"
-        bool finished = (it == end || *it == "," || *it == ")");
-
-        try
-        {
-            // Initialize missing coordinates to default constructor (zero)
-            // OR
-            // Use lexical_cast for conversion to double/int
-            // Note that it is much slower than atof. However, it is more standard
-            // and in parsing the change in performance falls probably away against
-            // the tokenizing
-            set<Dimension>(point, finished
-                    ? coordinate_type()
-                    : coordinate_cast<coordinate_type>::apply(*it));
-        }
-        catch(boost::bad_lexical_cast const& blc)
-        {
-            BOOST_THROW_EXCEPTION(read_wkt_exception(blc.what(), it, end, wkt));
-        }
-        catch(std::exception const& e)
-        {
-            BOOST_THROW_EXCEPTION(read_wkt_exception(e.what(), it, end, wkt));
-        }
-        catch(...)
-        {
-            BOOST_THROW_EXCEPTION(read_wkt_exception("", it, end, wkt));
-        }
-
-        parsing_assigner<Point, Dimension + 1, DimensionCount>::apply(
-                        (finished ? it : ++it), end, point, wkt);
-    }
-};
-
-template <typename Point, std::size_t DimensionCount>
-struct parsing_assigner<Point, DimensionCount, DimensionCount>
-{
-    static inline void apply(tokenizer::iterator&,
-                             tokenizer::iterator const&,
-                             Point&,
-                             std::string const&)
-    {
-    }
-};
-
-
-
-template <typename Iterator>
-inline void handle_open_parenthesis(Iterator& it,
-                                    Iterator const& end,
-                                    std::string const& wkt)
-{
-    if (it == end || *it != "(")
-    {
-        BOOST_THROW_EXCEPTION(read_wkt_exception("Expected '('", it, end, wkt));
-    }
-    ++it;
-}
-
-
-template <typename Iterator>
-inline void handle_close_parenthesis(Iterator& it,
-                                     Iterator const& end,
-                                     std::string const& wkt)
-{
-    if (it != end && *it == ")")
-    {
-        ++it;
-    }
-    else
-    {
-        BOOST_THROW_EXCEPTION(read_wkt_exception("Expected ')'", it, end, wkt));
-    }
-}
-
-template <typename Iterator>
-inline void check_end(Iterator& it,
-                      Iterator const& end,
-                      std::string const& wkt)
-{
-    if (it != end)
-    {
-        BOOST_THROW_EXCEPTION(read_wkt_exception("Too many tokens", it, end, wkt));
-    }
-}
-
-/*!
-\brief Internal, parses coordinate sequences, strings are formated like "(1 2,3 4,...)"
-\param it token-iterator, should be pre-positioned at "(", is post-positions after last ")"
-\param end end-token-iterator
-\param out Output itererator receiving coordinates
-*/
-template <typename Point>
-struct container_inserter
-{
-    // Version with output iterator
-    template <typename OutputIterator>
-    static inline void apply(tokenizer::iterator& it,
-                             tokenizer::iterator const& end,
-                             std::string const& wkt,
-                             OutputIterator out)
-    {
-        handle_open_parenthesis(it, end, wkt);
-
-        Point point;
-
-        // Parse points until closing parenthesis
-
-        while (it != end && *it != ")")
-        {
-            parsing_assigner<Point>::apply(it, end, point, wkt);
-            out = point;
-            ++out;
-            if (it != end && *it == ",")
-            {
-                ++it;
-            }
-        }
-
-        handle_close_parenthesis(it, end, wkt);
-    }
-};
-
-
 template <typename Geometry,
           closure_selector Closure = closure<Geometry>::value>
 struct stateful_range_appender
@@ -310,422 +186,489 @@ private:
     point_type first_point;
 };
 
-// Geometry is a value-type or reference-type
-template <typename Geometry>
-struct container_appender
+// Splits the characters of WKT into tokens without copying them
+class char_lexer
 {
-    typedef typename geometry::point_type<Geometry>::type point_type;
+public:
+    char_lexer(char const* first, char const* last)
+        : m_it(first)
+        , m_end(last)
+        , m_first(first)
+    {}
 
-    static inline void apply(tokenizer::iterator& it,
-                             tokenizer::iterator const& end,
-                             std::string const& wkt,
-                             Geometry out)
+    inline char const* position() const
     {
-        handle_open_parenthesis(it, end, wkt);
+        return m_it;
+    }
 
-        stateful_range_appender<Geometry> appender;
+    inline void reset(char const* position)
+    {
+        m_it = position;
+        m_first = position;
+    }
 
-        // Parse points until closing parenthesis
-        while (it != end && *it != ")")
+    inline void skip_whitespace()
+    {
+        while (m_it != m_end && is_whitespace(*m_it))
         {
-            point_type point;
+            ++m_it;
+        }
+    }
 
-            parsing_assigner<point_type>::apply(it, end, point, wkt);
+    inline bool at_end()
+    {
+        skip_whitespace();
+        return m_it == m_end;
+    }
 
-            bool const is_next_expected = it != end && *it == ",";
+    inline bool next_is(char c)
+    {
+        skip_whitespace();
+        return m_it != m_end && *m_it == c;
+    }
 
-            appender.append(out, point, is_next_expected);
+    inline bool accept(char c)
+    {
+        if (next_is(c))
+        {
+            ++m_it;
+            return true;
+        }
+        return false;
+    }
+
+    inline void expect(char c)
+    {
+        if (! accept(c))
+        {
+            throw_error(std::string("Expected '") + c + "'");
+        }
+    }
 
-            if (is_next_expected)
+    // Consumes the word if it's equal to name, case-insensitive
+    inline bool accept_word(char const* name)
+    {
+        skip_whitespace();
+        char const* it = m_it;
+        for ( ; *name != '\0' ; ++name, ++it)
+        {
+            if (it == m_end || to_upper(*it) != *name)
             {
-                ++it;
+                return false;
             }
         }
-
-        handle_close_parenthesis(it, end, wkt);
+        // The word has to be followed by a whitespace, a separator
+        // or a semicolon separating geometries
+        if (it != m_end && ! is_whitespace(*it) && ! is_separator(*it)
+            && *it != ';')
+        {
+            return false;
+        }
+        m_it = it;
+        return true;
     }
-};
 
-/*!
-\brief Internal, parses a point from a string like this "(x y)"
-\note used for parsing points and multi-points
-*/
-template <typename P>
-struct point_parser
-{
-    static inline void apply(tokenizer::iterator& it,
-                             tokenizer::iterator const& end,
-                             std::string const& wkt,
-                             P& point)
+    // Returns true if the next token is the closing parenthesis or the end,
+    // the elements are parsed until it's found
+    inline bool at_close()
     {
-        handle_open_parenthesis(it, end, wkt);
-        parsing_assigner<P>::apply(it, end, point, wkt);
-        handle_close_parenthesis(it, end, wkt);
+        skip_whitespace();
+        return m_it == m_end || *m_it == ')';
     }
-};
-
 
-template <typename Geometry>
-struct linestring_parser
-{
-    static inline void apply(tokenizer::iterator& it,
-                             tokenizer::iterator const& end,
-                             std::string const& wkt,
-                             Geometry& geometry)
+    // Returns true if the next token should be a number,
+    // i.e. the coordinates of a point are not finished
+    inline bool at_number()
     {
-        container_appender<Geometry&>::apply(it, end, wkt, geometry);
+        skip_whitespace();
+        return m_it != m_end && *m_it != ',' && *m_it != ')';
     }
-};
 
+    template <typename CoordinateType>
+    inline void number(CoordinateType& result)
+    {
+        skip_whitespace();
+        char const* const first = m_it;
+        while (m_it != m_end && ! is_whitespace(*m_it) && ! is_separator(*m_it))
+        {
+            ++m_it;
+        }
 
-template <typename Ring>
-struct ring_parser
-{
-    static inline void apply(tokenizer::iterator& it,
-                             tokenizer::iterator const& end,
-                             std::string const& wkt,
-                             Ring& ring)
-    {
-        // A ring should look like polygon((x y,x y,x y...))
-        // So handle the extra opening/closing parentheses
-        // and in between parse using the container-inserter
-        handle_open_parenthesis(it, end, wkt);
-        container_appender<Ring&>::apply(it, end, wkt, ring);
-        handle_close_parenthesis(it, end, wkt);
+        if (! parse_number<CoordinateType>::apply(first, m_it, result))
+        {
+            m_it = first;
+            throw_error("Bad lexical cast: source type value could not be interpreted as target");
+        }
     }
-};
-
 
-/*!
-\brief Internal, parses a polygon from a string like this "((x y,x y),(x y,x y))"
-\note used for parsing polygons and multi-polygons
-*/
-template <typename Polygon>
-struct polygon_parser
-{
-    typedef typename ring_return_type<Polygon>::type ring_return_type;
-    typedef container_appender<ring_return_type> appender;
-
-    static inline void apply(tokenizer::iterator& it,
-                             tokenizer::iterator const& end,
-                             std::string const& wkt,
-                             Polygon& poly)
+    inline void throw_error(std::string const& message) const
     {
-
-        handle_open_parenthesis(it, end, wkt);
-
-        int n = -1;
-
-        // Stop at ")"
-        while (it != end && *it != ")")
+        // The token at which the error was found, empty at the end
+        char const* it = m_it;
+        if (it != m_end && is_separator(*it))
         {
-            // Parse ring
-            if (++n == 0)
-            {
-                appender::apply(it, end, wkt, exterior_ring(poly));
-            }
-            else
-            {
-                typename ring_type<Polygon>::type ring;
-                appender::apply(it, end, wkt, ring);
-                traits::push_back
-                    <
-                        typename boost::remove_reference
-                        <
-                            typename traits::interior_mutable_type<Polygon>::type
-                        >::type
-                    >::apply(interior_rings(poly), ring);
-            }
-
-            if (it != end && *it == ",")
+            ++it;
+        }
+        else
+        {
+            while (it != m_end && ! is_whitespace(*it) && ! is_separator(*it))
             {
-                // Skip "," after ring is parsed
                 ++it;
             }
         }
 
-        handle_close_parenthesis(it, end, wkt);
+        char const* last = m_end;
+        if (last - m_first > 100)
+        {
+            last = m_first + 100;
+        }
+        BOOST_THROW_EXCEPTION(read_wkt_exception(message,
+                                                 std::string(m_it, it),
+                                                 std::string(m_first, last)));
     }
-};
 
+private:
+    static inline bool is_whitespace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r'
+            || c == '\v' || c == '\f';
+    }
 
-inline bool one_of(tokenizer::iterator const& it,
-                   std::string const& value,
-                   bool& is_present)
-{
-    if (boost::iequals(*it, value))
+    static inline bool is_separator(char c)
     {
-        is_present = true;
-        return true;
+        return c == '(' || c == ')' || c == ',';
     }
-    return false;
-}
 
-inline bool one_of(tokenizer::iterator const& it,
-                   std::string const& value,
-                   bool& present1,
-                   bool& present2)
-{
-    if (boost::iequals(*it, value))
+    static inline char to_upper(char c)
     {
-        present1 = true;
-        present2 = true;
-        return true;
+        return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
     }
-    return false;
-}
 
+    char const* m_it;
+    char const* m_end;
+    char const* m_first;
+};
 
-inline void handle_empty_z_m(tokenizer::iterator& it,
-                             tokenizer::iterator const& end,
-                             bool& has_empty,
-                             bool& has_z,
-                             bool& has_m)
+// Parses the name of the geometry and the optional Z, M and EMPTY.
+// Returns false for empty geometries.
+template <typename Geometry>
+inline bool lexer_initialize(char_lexer& lexer, char const* geometry_name)
 {
-    has_empty = false;
-    has_z = false;
-    has_m = false;
-
-    // WKT can optionally have Z and M (measured) values as in
-    // POINT ZM (1 1 5 60), POINT M (1 1 80), POINT Z (1 1 5)
-    // GGL supports any of them as coordinate values, but is not aware
-    // of any Measured value.
-    while (it != end
-           && (one_of(it, "M", has_m)
-               || one_of(it, "Z", has_z)
-               || one_of(it, "EMPTY", has_empty)
-               || one_of(it, "MZ", has_m, has_z)
-               || one_of(it, "ZM", has_z, has_m)
-               )
-           )
-    {
-        ++it;
+    if (! lexer.accept_word(geometry_name))
+    {
+        lexer.throw_error(std::string("Should start with '") + geometry_name + "'");
     }
-}
 
-/*!
-\brief Internal, starts parsing
-\param tokens boost tokens, parsed with separator " " and keeping separator "()"
-\param geometry string to compare with first token
-*/
-template <typename Geometry>
-inline bool initialize(tokenizer const& tokens,
-                       std::string const& geometry_name,
-                       std::string const& wkt,
-                       tokenizer::iterator& it,
-                       tokenizer::iterator& end)
-{
-    it = tokens.begin();
-    end = tokens.end();
+    bool has_empty = false;
+    bool has_z = false;
+    for (;;)
+    {
+        if (lexer.accept_word("EMPTY"))
+        {
+            has_empty = true;
+        }
+        else if (lexer.accept_word("Z") || lexer.accept_word("ZM")
+              || lexer.accept_word("MZ"))
+        {
+            has_z = true;
+        }
+        else if (! lexer.accept_word("M"))
+        {
+            break;
+        }
+    }
 
-    if (it == end || ! boost::iequals(*it++, geometry_name))
+    if (has_z && dimension<Geometry>::type::value < 3)
     {
-        BOOST_THROW_EXCEPTION(read_wkt_exception(std::string("Should start with '") + geometry_name + "'", wkt));
+        lexer.throw_error("Z only allowed for 3 or more dimensions");
     }
 
-    bool has_empty, has_z, has_m;
+    return ! has_empty;
+}
 
-    handle_empty_z_m(it, end, has_empty, has_z, has_m);
+template <typename Point,
+          std::size_t Dimension = 0,
+          std::size_t DimensionCount = geometry::dimension<Point>::value>
+struct lexer_coordinates_parser
+{
+    static inline void apply(char_lexer& lexer, Point& point)
+    {
+        typedef typename coordinate_type<Point>::type coordinate_type;
 
-// Silence warning C4127: conditional expression is constant
-#if defined(_MSC_VER)
-#pragma warning(push)  
-#pragma warning(disable : 4127)  
-#endif
+        // Initialize missing coordinates to zero
+        coordinate_type value = coordinate_type();
+        if (lexer.at_number())
+        {
+            lexer.number(value);
+        }
+        set<Dimension>(point, value);
 
-    if (has_z && dimension<Geometry>::type::value < 3)
-    {
-        BOOST_THROW_EXCEPTION(read_wkt_exception("Z only allowed for 3 or more dimensions", wkt));
+        lexer_coordinates_parser<Point, Dimension + 1, DimensionCount>::apply(lexer, point);
     }
+};
 
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
+template <typename Point, std::size_t DimensionCount>
+struct lexer_coordinates_parser<Point, DimensionCount, DimensionCount>
+{
+    static inline void apply(char_lexer&, Point&)
+    {}
+};
 
-    if (has_empty)
+// Parses "(x y)"
+template <typename Point>
+struct lexer_point_parser
+{
+    static inline void apply(char_lexer& lexer, Point& point)
     {
-        check_end(it, end, wkt);
-        return false;
+        lexer.expect('(');
+        lexer_coordinates_parser<Point>::apply(lexer, point);
+        lexer.expect(')');
     }
-    // M is ignored at all.
-    
-    return true;
-}
-
+};
 
-template <typename Geometry, template<typename> class Parser, typename PrefixPolicy>
-struct geometry_parser
+// Parses "(x y,x y,...)"
+template <typename Geometry>
+struct lexer_range_parser
 {
-    static inline void apply(std::string const& wkt, Geometry& geometry)
+    typedef typename boost::remove_reference<Geometry>::type range_type;
+    typedef typename geometry::point_type<range_type>::type point_type;
+
+    static inline void apply(char_lexer& lexer, range_type& range)
     {
-        geometry::clear(geometry);
+        lexer.expect('(');
+
+        stateful_range_appender<range_type&> appender;
 
-        tokenizer tokens(wkt, boost::char_separator<char>(" ", ",()"));
-        tokenizer::iterator it, end;
-        if (initialize<Geometry>(tokens, PrefixPolicy::apply(), wkt, it, end))
+        while (! lexer.at_close())
         {
-            Parser<Geometry>::apply(it, end, wkt, geometry);
-            check_end(it, end, wkt);
+            point_type point;
+            lexer_coordinates_parser<point_type>::apply(lexer, point);
+
+            bool const is_next_expected = lexer.accept(',');
+            appender.append(range, point, is_next_expected);
         }
+
+        lexer.expect(')');
     }
 };
 
+template <typename Linestring>
+struct lexer_linestring_parser
+{
+    static inline void apply(char_lexer& lexer, Linestring& linestring)
+    {
+        lexer_range_parser<Linestring>::apply(lexer, linestring);
+    }
+};
 
-template <typename MultiGeometry, template<typename> class Parser, typename PrefixPolicy>
-struct multi_parser
+// Parses "((x y,x y,...))"
+template <typename Ring>
+struct lexer_ring_parser
 {
-    static inline void apply(std::string const& wkt, MultiGeometry& geometry)
+    static inline void apply(char_lexer& lexer, Ring& ring)
     {
-        traits::clear<MultiGeometry>::apply(geometry);
+        lexer.expect('(');
+        lexer_range_parser<Ring>::apply(lexer, ring);
+        lexer.expect(')');
+    }
+};
 
-        tokenizer tokens(wkt, boost::char_separator<char>(" ", ",()"));
-        tokenizer::iterator it, end;
-        if (initialize<MultiGeometry>(tokens, PrefixPolicy::apply(), wkt, it, end))
-        {
-            handle_open_parenthesis(it, end, wkt);
+// Parses "((x y,x y,...),(x y,x y,...),...)"
+template <typename Polygon>
+struct lexer_polygon_parser
+{
+    typedef typename ring_type<Polygon>::type ring_type;
+
+    static inline void apply(char_lexer& lexer, Polygon& polygon)
+    {
+        lexer.expect('(');
 
-            // Parse sub-geometries
-            while(it != end && *it != ")")
+        bool is_exterior = true;
+        while (! lexer.at_close())
+        {
+            if (is_exterior)
+            {
+                lexer_range_parser<ring_type>::apply(lexer, exterior_ring(polygon));
+                is_exterior = false;
+            }
+            else
             {
-                traits::resize<MultiGeometry>::apply(geometry, boost::size(geometry) + 1);
-                Parser
+                ring_type ring;
+                lexer_range_parser<ring_type>::apply(lexer, ring);
+                traits::push_back
                     <
-                        typename boost::range_value<MultiGeometry>::type
-                    >::apply(it, end, wkt, *(boost::end(geometry) - 1));
-                if (it != end && *it == ",")
-                {
-                    // Skip "," after multi-element is parsed
-                    ++it;
-                }
+                        typename boost::remove_reference
+                        <
+                            typename traits::interior_mutable_type<Polygon>::type
+                        >::type
+                    >::apply(interior_rings(polygon), ring);
             }
 
-            handle_close_parenthesis(it, end, wkt);
+            lexer.accept(',');
         }
 
-        check_end(it, end, wkt);
+        lexer.expect(')');
     }
 };
 
-template <typename P>
-struct noparenthesis_point_parser
+template <typename Geometry, template<typename> class Parser, typename PrefixPolicy>
+struct lexer_geometry_parser
 {
-    static inline void apply(tokenizer::iterator& it,
-                             tokenizer::iterator const& end,
-                             std::string const& wkt,
-                             P& point)
+    static inline void apply(char_lexer& lexer, Geometry& geometry)
     {
-        parsing_assigner<P>::apply(it, end, point, wkt);
+        geometry::clear(geometry);
+
+        if (lexer_initialize<Geometry>(lexer, PrefixPolicy::apply()))
+        {
+            Parser<Geometry>::apply(lexer, geometry);
+        }
     }
 };
 
-template <typename MultiGeometry, typename PrefixPolicy>
-struct multi_point_parser
+template <typename MultiGeometry, template<typename> class Parser, typename PrefixPolicy>
+struct lexer_multi_parser
 {
-    static inline void apply(std::string const& wkt, MultiGeometry& geometry)
+    static inline void apply(char_lexer& lexer, MultiGeometry& geometry)
     {
         traits::clear<MultiGeometry>::apply(geometry);
 
-        tokenizer tokens(wkt, boost::char_separator<char>(" ", ",()"));
-        tokenizer::iterator it, end;
+        if (! lexer_initialize<MultiGeometry>(lexer, PrefixPolicy::apply()))
+        {
+            return;
+        }
+
+        lexer.expect('(');
 
-        if (initialize<MultiGeometry>(tokens, PrefixPolicy::apply(), wkt, it, end))
+        while (! lexer.at_close())
         {
-            handle_open_parenthesis(it, end, wkt);
+            traits::resize<MultiGeometry>::apply(geometry, boost::size(geometry) + 1);
+            Parser
+                <
+                    typename boost::range_value<MultiGeometry>::type
+                >::apply(lexer, *(boost::end(geometry) - 1));
 
-            // If first point definition starts with "(" then parse points as (x y)
-            // otherwise as "x y"
-            bool using_brackets = (it != end && *it == "(");
+            lexer.accept(',');
+        }
 
-            while(it != end && *it != ")")
-            {
-                traits::resize<MultiGeometry>::apply(geometry, boost::size(geometry) + 1);
+        lexer.expect(')');
+    }
+};
 
-                if (using_brackets)
-                {
-                    point_parser
-                        <
-                            typename boost::range_value<MultiGeometry>::type
-                        >::apply(it, end, wkt, *(boost::end(geometry) - 1));
-                }
-                else
-                {
-                    noparenthesis_point_parser
-                        <
-                            typename boost::range_value<MultiGeometry>::type
-                        >::apply(it, end, wkt, *(boost::end(geometry) - 1));
-                }
+// Parses "((x y),(x y),...)" or "(x y,x y,...)", the syntax of the first
+// point is used for all of them
+template <typename MultiPoint, typename PrefixPolicy>
+struct lexer_multi_point_parser
+{
+    static inline void apply(char_lexer& lexer, MultiPoint& geometry)
+    {
+        typedef typename boost::range_value<MultiPoint>::type point_type;
 
-                if (it != end && *it == ",")
-                {
-                    // Skip "," after point is parsed
-                    ++it;
-                }
+        traits::clear<MultiPoint>::apply(geometry);
+
+        if (! lexer_initialize<MultiPoint>(lexer, PrefixPolicy::apply()))
+        {
+            return;
+        }
+
+        lexer.expect('(');
+
+        bool const using_brackets = lexer.next_is('(');
+        while (! lexer.at_close())
+        {
+            traits::resize<MultiPoint>::apply(geometry, boost::size(geometry) + 1);
+            point_type& point = *(boost::end(geometry) - 1);
+            if (using_brackets)
+            {
+                lexer_point_parser<point_type>::apply(lexer, point);
+            }
+            else
+            {
+                lexer_coordinates_parser<point_type>::apply(lexer, point);
             }
 
-            handle_close_parenthesis(it, end, wkt);
+            lexer.accept(',');
         }
 
-        check_end(it, end, wkt);
+        lexer.expect(')');
     }
 };
 
+// Parses at most MaxCount points of "(x y,x y,...)" into an array
+template <typename Point, std::size_t MaxCount>
+inline std::size_t lexer_points(char_lexer& lexer, Point (&points)[MaxCount])
+{
+    lexer.expect('(');
+
+    std::size_t count = 0;
+    while (! lexer.at_close())
+    {
+        Point point;
+        lexer_coordinates_parser<Point>::apply(lexer, point);
+        if (count < MaxCount)
+        {
+            points[count] = point;
+        }
+        ++count;
 
-/*!
-\brief Supports box parsing
-\note OGC does not define the box geometry, and WKT does not support boxes.
-    However, to be generic GGL supports reading and writing from and to boxes.
-    Boxes are outputted as a standard POLYGON. GGL can read boxes from
-    a standard POLYGON, from a POLYGON with 2 points of from a BOX
-\tparam Box the box
-*/
+        lexer.accept(',');
+    }
+
+    lexer.expect(')');
+
+    return count;
+}
+
+// Parses "BOX(x y,x y)" or "POLYGON((x y,x y,...))" with 2, 4 or 5 points
 template <typename Box>
-struct box_parser
+struct lexer_box_parser
 {
-    static inline void apply(std::string const& wkt, Box& box)
+    static inline void apply(char_lexer& lexer, Box& box)
     {
+        typedef typename point_type<Box>::type point_type;
+
         bool should_close = false;
-        tokenizer tokens(wkt, boost::char_separator<char>(" ", ",()"));
-        tokenizer::iterator it = tokens.begin();
-        tokenizer::iterator end = tokens.end();
-        if (it != end && boost::iequals(*it, "POLYGON"))
+        if (lexer.accept_word("POLYGON"))
         {
-            ++it;
-            bool has_empty, has_z, has_m;
-            handle_empty_z_m(it, end, has_empty, has_z, has_m);
+            bool has_empty = false;
+            for (;;)
+            {
+                if (lexer.accept_word("EMPTY"))
+                {
+                    has_empty = true;
+                }
+                else if (! (lexer.accept_word("Z") || lexer.accept_word("M")
+                         || lexer.accept_word("ZM") || lexer.accept_word("MZ")))
+                {
+                    break;
+                }
+            }
             if (has_empty)
             {
                 assign_zero(box);
                 return;
             }
-            handle_open_parenthesis(it, end, wkt);
+            lexer.expect('(');
             should_close = true;
         }
-        else if (it != end && boost::iequals(*it, "BOX"))
+        else if (! lexer.accept_word("BOX"))
         {
-            ++it;
-        }
-        else
-        {
-            BOOST_THROW_EXCEPTION(read_wkt_exception("Should start with 'POLYGON' or 'BOX'", wkt));
+            lexer.throw_error("Should start with 'POLYGON' or 'BOX'");
         }
 
-        typedef typename point_type<Box>::type point_type;
-        std::vector<point_type> points;
-        container_inserter<point_type>::apply(it, end, wkt, std::back_inserter(points));
+        point_type points[5];
+        std::size_t const count = lexer_points(lexer, points);
 
         if (should_close)
         {
-            handle_close_parenthesis(it, end, wkt);
+            lexer.expect(')');
         }
-        check_end(it, end, wkt);
 
-        unsigned int index = 0;
-        std::size_t n = boost::size(points);
-        if (n == 2)
+        std::size_t index = 0;
+        if (count == 2)
         {
             index = 1;
         }
-        else if (n == 4 || n == 5)
+        else if (count == 4 || count == 5)
         {
             // In case of 4 or 5 points, we do not check the other ones, just
             // take the opposite corner which is always 2
@@ -733,56 +676,35 @@ struct box_parser
         }
         else
         {
-            BOOST_THROW_EXCEPTION(read_wkt_exception("Box should have 2,4 or 5 points", wkt));
+            lexer.throw_error("Box should have 2,4 or 5 points");
         }
 
-        geometry::detail::assign_point_to_index<min_corner>(points.front(), box);
+        geometry::detail::assign_point_to_index<min_corner>(points[0], box);
         geometry::detail::assign_point_to_index<max_corner>(points[index], box);
     }
 };
 
-
-/*!
-\brief Supports segment parsing
-\note OGC does not define the segment, and WKT does not support segmentes.
-    However, it is useful to implement it, also for testing purposes
-\tparam Segment the segment
-*/
+// Parses "SEGMENT(x y,x y)" or "LINESTRING(x y,x y)"
 template <typename Segment>
-struct segment_parser
+struct lexer_segment_parser
 {
-    static inline void apply(std::string const& wkt, Segment& segment)
+    static inline void apply(char_lexer& lexer, Segment& segment)
     {
-        tokenizer tokens(wkt, boost::char_separator<char>(" ", ",()"));
-        tokenizer::iterator it = tokens.begin();
-        tokenizer::iterator end = tokens.end();
-        if (it != end &&
-            (boost::iequals(*it, "SEGMENT")
-            || boost::iequals(*it, "LINESTRING") ))
-        {
-            ++it;
-        }
-        else
-        {
-            BOOST_THROW_EXCEPTION(read_wkt_exception("Should start with 'LINESTRING' or 'SEGMENT'", wkt));
-        }
-
         typedef typename point_type<Segment>::type point_type;
-        std::vector<point_type> points;
-        container_inserter<point_type>::apply(it, end, wkt, std::back_inserter(points));
-
-        check_end(it, end, wkt);
 
-        if (boost::size(points) == 2)
+        if (! lexer.accept_word("SEGMENT") && ! lexer.accept_word("LINESTRING"))
         {
-            geometry::detail::assign_point_to_index<0>(points.front(), segment);
-            geometry::detail::assign_point_to_index<1>(points.back(), segment);
+            lexer.throw_error("Should start with 'LINESTRING' or 'SEGMENT'");
         }
-        else
+
+        point_type points[2];
+        if (lexer_points(lexer, points) != 2)
         {
-            BOOST_THROW_EXCEPTION(read_wkt_exception("Segment should have 2 points", wkt));
+            lexer.throw_error("Segment should have 2 points");
         }
 
+        geometry::detail::assign_point_to_index<0>(points[0], segment);
+        geometry::detail::assign_point_to_index<1>(points[1], segment);
     }
 };
 
@@ -790,98 +712,113 @@ struct segment_parser
 }} // namespace detail::wkt
 #endif // DOXYGEN_NO_DETAIL
 
+
 #ifndef DOXYGEN_NO_DISPATCH
 namespace dispatch
 {
 
 template <typename Tag, typename Geometry>
-struct read_wkt {};
-
+struct read_wkt_lexer {};
 
 template <typename Point>
-struct read_wkt<point_tag, Point>
-    : detail::wkt::geometry_parser
+struct read_wkt_lexer<point_tag, Point>
+    : detail::wkt::lexer_geometry_parser
         <
             Point,
-            detail::wkt::point_parser,
+            detail::wkt::lexer_point_parser,
             detail::wkt::prefix_point
         >
 {};
 
-
-template <typename L>
-struct read_wkt<linestring_tag, L>
-    : detail::wkt::geometry_parser
+template <typename Linestring>
+struct read_wkt_lexer<linestring_tag, Linestring>
+    : detail::wkt::lexer_geometry_parser
         <
-            L,
-            detail::wkt::linestring_parser,
+            Linestring,
+            detail::wkt::lexer_linestring_parser,
             detail::wkt::prefix_linestring
         >
 {};
 
 template <typename Ring>
-struct read_wkt<ring_tag, Ring>
-    : detail::wkt::geometry_parser
+struct read_wkt_lexer<ring_tag, Ring>
+    : detail::wkt::lexer_geometry_parser
         <
             Ring,
-            detail::wkt::ring_parser,
+            detail::wkt::lexer_ring_parser,
             detail::wkt::prefix_polygon
         >
 {};
 
-template <typename Geometry>
-struct read_wkt<polygon_tag, Geometry>
-    : detail::wkt::geometry_parser
+template <typename Polygon>
+struct read_wkt_lexer<polygon_tag, Polygon>
+    : detail::wkt::lexer_geometry_parser
         <
-            Geometry,
-            detail::wkt::polygon_parser,
+            Polygon,
+            detail::wkt::lexer_polygon_parser,
             detail::wkt::prefix_polygon
         >
 {};
 
-
-template <typename MultiGeometry>
-struct read_wkt<multi_point_tag, MultiGeometry>
-    : detail::wkt::multi_point_parser
-            <
-                MultiGeometry,
-                detail::wkt::prefix_multipoint
-            >
+template <typename MultiPoint>
+struct read_wkt_lexer<multi_point_tag, MultiPoint>
+    : detail::wkt::lexer_multi_point_parser
+        <
+            MultiPoint,
+            detail::wkt::prefix_multipoint
+        >
 {};
 
-template <typename MultiGeometry>
-struct read_wkt<multi_linestring_tag, MultiGeometry>
-    : detail::wkt::multi_parser
-            <
-                MultiGeometry,
-                detail::wkt::linestring_parser,
-                detail::wkt::prefix_multilinestring
-            >
+template <typename MultiLinestring>
+struct read_wkt_lexer<multi_linestring_tag, MultiLinestring>
+    : detail::wkt::lexer_multi_parser
+        <
+            MultiLinestring,
+            detail::wkt::lexer_linestring_parser,
+            detail::wkt::prefix_multilinestring
+        >
 {};
 
-template <typename MultiGeometry>
-struct read_wkt<multi_polygon_tag, MultiGeometry>
-    : detail::wkt::multi_parser
-            <
-                MultiGeometry,
-                detail::wkt::polygon_parser,
-                detail::wkt::prefix_multipolygon
-            >
+template <typename MultiPolygon>
+struct read_wkt_lexer<multi_polygon_tag, MultiPolygon>
+    : detail::wkt::lexer_multi_parser
+        <
+            MultiPolygon,
+            detail::wkt::lexer_polygon_parser,
+            detail::wkt::prefix_multipolygon
+        >
 {};
 
-
 // Box (Non-OGC)
 template <typename Box>
-struct read_wkt<box_tag, Box>
-    : detail::wkt::box_parser<Box>
+struct read_wkt_lexer<box_tag, Box>
+    : detail::wkt::lexer_box_parser<Box>
 {};
 
 // Segment (Non-OGC)
 template <typename Segment>
-struct read_wkt<segment_tag, Segment>
-    : detail::wkt::segment_parser<Segment>
+struct read_wkt_lexer<segment_tag, Segment>
+    : detail::wkt::lexer_segment_parser<Segment>
 {};
 
+// Parses the whole string, the characters following the geometry
+// other than whitespaces are not allowed
+template <typename Tag, typename Geometry>
+struct read_wkt
+{
+    static inline void apply(std::string const& wkt, Geometry& geometry)
+    {
+        char const* const first = wkt.c_str();
+        detail::wkt::char_lexer lexer(first, first + wkt.size());
+
+        read_wkt_lexer<Tag, Geometry>::apply(lexer, geometry);
+
+        if (! lexer.at_end())
+        {
+            lexer.throw_error("Too many tokens");
+        }
+    }
+};
 
 } // namespace dispatch
 #endif // DOXYGEN_NO_DISPATCH
@@ -0,0 +1,111 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_IO_WKT_READER_HPP
+#define BOOST_GEOMETRY_IO_WKT_READER_HPP
+
+
+#include <boost/geometry/core/tag.hpp>
+
+#include <boost/geometry/geometries/concepts/check.hpp>
+
+#include <boost/geometry/io/wkt/read.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+/*!
+\brief Parses OGC Well-Known Text (\ref WKT) stored in a range of characters
+    into a geometry (any geometry)
+\ingroup wkt
+\details The characters are parsed in place, without tokenizing them into
+    strings and without allocating memory for the coordinates, e.g. from
+    a buffer or a memory-mapped file. Only one geometry is parsed, the
+    characters following it are not analysed.
+\tparam Geometry \tparam_geometry
+\param first pointer to the first character of \ref WKT
+\param last pointer to one past the last character of \ref WKT
+\param geometry \param_geometry output geometry
+\return pointer to the character following the parsed geometry
+*/
+template <typename Geometry>
+inline char const* read_wkt(char const* first, char const* last, Geometry& geometry)
+{
+    geometry::concepts::check<Geometry>();
+
+    detail::wkt::char_lexer lexer(first, last);
+    dispatch::read_wkt_lexer<typename tag<Geometry>::type, Geometry>::apply(lexer, geometry);
+    return lexer.position();
+}
+
+
+/*!
+\brief Reads consecutive geometries stored as \ref WKT in a range of characters
+\ingroup wkt
+\details The geometries are separated with whitespaces, e.g. new lines, or
+    with semicolons. They're parsed in place one at a time, without copying
+    the characters and without allocating memory for the coordinates, so
+    large files can be read e.g. from a memory-mapped file geometry by
+    geometry. The reader doesn't own the characters, they must exist as
+    long as the reader is used.
+*/
+class wkt_reader
+{
+public:
+    /*!
+    \brief The constructor taking the range of characters.
+    \param first pointer to the first character
+    \param last pointer to one past the last character
+    */
+    wkt_reader(char const* first, char const* last)
+        : m_lexer(first, last)
+    {}
+
+    /*!
+    \brief Reads the next geometry.
+    \tparam Geometry \tparam_geometry
+    \param geometry \param_geometry output geometry
+    \return false if there are no more geometries, true otherwise
+    */
+    template <typename Geometry>
+    inline bool read(Geometry& geometry)
+    {
+        geometry::concepts::check<Geometry>();
+
+        while (m_lexer.accept(';'))
+        {}
+
+        if (m_lexer.at_end())
+        {
+            return false;
+        }
+
+        m_lexer.reset(m_lexer.position());
+        dispatch::read_wkt_lexer<typename tag<Geometry>::type, Geometry>::apply(m_lexer, geometry);
+        return true;
+    }
+
+    /*!
+    \brief Returns the pointer to the character following the last read geometry.
+    */
+    char const* position() const
+    {
+        return m_lexer.position();
+    }
+
+private:
+    detail::wkt::char_lexer m_lexer;
+};
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_IO_WKT_READER_HPP
@@ -3,6 +3,7 @@
 // Copyright (c) 2007-2012 Barend Gehrels, Amsterdam, the Netherlands.
 // Copyright (c) 2008-2012 Bruno Lalande, Paris, France.
 // Copyright (c) 2009-2012 Mateusz Loskot, London, UK.
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
 
 // Parts of Boost.Geometry are redesigned from Geodan's Geographic Library
 // (geolib/GGL), copyright (c) 1995-2010 Geodan, Amsterdam, the Netherlands.
@@ -15,7 +16,9 @@
 #define BOOST_GEOMETRY_IO_WKT_WKT_HPP
 
 #include <boost/geometry/io/wkt/read.hpp>
+#include <boost/geometry/io/wkt/reader.hpp>
 #include <boost/geometry/io/wkt/write.hpp>
+#include <boost/geometry/io/wkt/writer.hpp>
 
 // BSG 2011-02-03
 // We don't include stream.hpp by default. That tries to stream anything not known
@@ -0,0 +1,124 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_IO_WKT_WRITER_HPP
+#define BOOST_GEOMETRY_IO_WKT_WRITER_HPP
+
+
+#include <cstring>
+
+#include <boost/core/addressof.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/geometry/core/tag.hpp>
+#include <boost/geometry/core/tags.hpp>
+
+#include <boost/geometry/geometries/concepts/check.hpp>
+
+#include <boost/geometry/io/wkt/detail/format_number.hpp>
+#include <boost/geometry/io/wkt/write.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace wkt
+{
+
+
+// Output stream used in place of std::ostream by the WKT algorithms,
+// appending the characters to the buffer
+template <typename Buffer>
+class buffer_output
+{
+public:
+    buffer_output(Buffer& buffer, int precision)
+        : m_buffer(boost::addressof(buffer))
+        , m_precision(precision)
+    {}
+
+    inline buffer_output& operator<<(char const* str)
+    {
+        append_chars(*m_buffer, str, str + std::strlen(str));
+        return *this;
+    }
+
+    template <typename CoordinateType>
+    inline buffer_output& operator<<(CoordinateType value)
+    {
+        format_number<CoordinateType>::apply(*m_buffer, value, m_precision);
+        return *this;
+    }
+
+private:
+    Buffer* m_buffer;
+    int m_precision;
+};
+
+
+}} // namespace detail::wkt
+#endif // DOXYGEN_NO_DETAIL
+
+
+/*!
+\brief Appends \ref WKT of a geometry to a buffer of characters
+\ingroup wkt
+\details The coordinates are formatted with the representation read back
+    as the same value, in almost all cases the shortest one, and with the
+    classic locale, independently of the global locale. The characters
+    are appended without streaming so this is considerably faster than
+    writing with the wkt() manipulator. No memory is allocated except by
+    the buffer, unless the coordinates are not of arithmetic types. These
+    are formatted by a stream.
+\tparam Geometry \tparam_geometry
+\tparam Buffer container of characters, e.g. std::string or std::vector<char>
+\param geometry \param_geometry
+\param buffer the buffer the characters are appended to
+*/
+template <typename Geometry, typename Buffer>
+inline void write_wkt(Geometry const& geometry, Buffer& buffer)
+{
+    concepts::check<Geometry const>();
+
+    detail::wkt::buffer_output<Buffer> out(buffer, -1);
+    dispatch::devarianted_wkt<Geometry>::apply(out, geometry,
+        ! boost::is_same<typename tag<Geometry>::type, ring_tag>::value);
+}
+
+/*!
+\brief Appends \ref WKT of a geometry to a buffer of characters, with
+    the coordinates rounded to a number of fraction digits
+\ingroup wkt
+\details The coordinates are formatted with fixed notation and the classic
+    locale, independently of the global locale, the same way as by
+    std::ostream with std::fixed and std::setprecision(). No memory is
+    allocated except by the buffer, unless the coordinates are not of
+    arithmetic types. These are formatted by a stream.
+\tparam Geometry \tparam_geometry
+\tparam Buffer container of characters, e.g. std::string or std::vector<char>
+\param geometry \param_geometry
+\param buffer the buffer the characters are appended to
+\param precision the number of fraction digits
+*/
+template <typename Geometry, typename Buffer>
+inline void write_wkt(Geometry const& geometry, Buffer& buffer, int precision)
+{
+    concepts::check<Geometry const>();
+
+    detail::wkt::buffer_output<Buffer> out(buffer, precision < 0 ? 0 : precision);
+    dispatch::devarianted_wkt<Geometry>::apply(out, geometry,
+        ! boost::is_same<typename tag<Geometry>::type, ring_tag>::value);
+}
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_IO_WKT_WRITER_HPP
@@ -0,0 +1,18 @@
+// Boost.Geometry
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_SRS_LOCKFREE_SHARED_GRIDS_HPP
+#define BOOST_GEOMETRY_SRS_LOCKFREE_SHARED_GRIDS_HPP
+
+
+#include <boost/geometry/srs/projections/impl/pj_apply_gridshift_lockfree.hpp>
+#include <boost/geometry/srs/projections/impl/pj_gridlist_lockfree.hpp>
+#include <boost/geometry/srs/projections/lockfree_shared_grids.hpp>
+
+
+#endif // BOOST_GEOMETRY_SRS_LOCKFREE_SHARED_GRIDS_HPP
@@ -1,6 +1,7 @@
 // Boost.Geometry (aka GGL, Generic Geometry Library)
 
 // Copyright (c) 2008-2012 Barend Gehrels, Amsterdam, the Netherlands.
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
 
 // This file was modified by Oracle on 2017, 2018.
 // Modifications copyright (c) 2017-2018, Oracle and/or its affiliates.
@@ -14,6 +15,8 @@
 #define BOOST_GEOMETRY_SRS_PROJECTION_HPP
 
 
+#include <algorithm>
+#include <cstddef>
 #include <string>
 
 #include <boost/geometry/algorithms/convert.hpp>
@@ -288,6 +291,106 @@ struct project_geometry<MultiPolygon, PointPolicy, multi_polygon_tag>
         >
 {};
 
+// Projects arrays of coordinates in batches, the angles are in degrees.
+// The invalid points are not projected.
+template <typename CalcT>
+struct project_arrays
+{
+    template <typename T, typename Proj>
+    static inline bool forward(T const* lon, T const* lat, T* x, T* y,
+                               std::size_t count, Proj const& proj)
+    {
+        return apply<forward_policy>(lon, lat, x, y, count, proj);
+    }
+
+    template <typename T, typename Proj>
+    static inline bool inverse(T const* x, T const* y, T* lon, T* lat,
+                               std::size_t count, Proj const& proj)
+    {
+        return apply<inverse_policy>(x, y, lon, lat, count, proj);
+    }
+
+private:
+    struct forward_policy
+    {
+        static inline CalcT input_factor() { return geometry::math::d2r<CalcT>(); }
+        static inline CalcT output_factor() { return CalcT(1); }
+
+        template <typename Proj>
+        static inline void apply(Proj const& proj, CalcT * c1, CalcT * c2,
+                                 int * errors, std::size_t count)
+        {
+            proj.forward_n(c1, c2, c1, c2, errors, count);
+        }
+    };
+
+    struct inverse_policy
+    {
+        static inline CalcT input_factor() { return CalcT(1); }
+        static inline CalcT output_factor() { return geometry::math::r2d<CalcT>(); }
+
+        template <typename Proj>
+        static inline void apply(Proj const& proj, CalcT * c1, CalcT * c2,
+                                 int * errors, std::size_t count)
+        {
+            proj.inverse_n(c1, c2, c1, c2, errors, count);
+        }
+    };
+
+    template <typename Policy, typename T, typename Proj>
+    static inline bool apply(T const* in1, T const* in2, T* out1, T* out2,
+                             std::size_t count, Proj const& proj)
+    {
+        CalcT c1[pj_batch_size];
+        CalcT c2[pj_batch_size];
+        int errors[pj_batch_size];
+        std::size_t indexes[pj_batch_size];
+
+        CalcT const input_factor = Policy::input_factor();
+        CalcT const output_factor = Policy::output_factor();
+
+        bool result = true;
+        std::size_t i = 0;
+        while (i < count)
+        {
+            std::size_t n = 0;
+            for ( ; i < count && n < pj_batch_size ; ++i)
+            {
+                if (in1[i] == HUGE_VAL)
+                {
+                    out1[i] = in1[i];
+                    out2[i] = in2[i];
+                    result = false;
+                    continue;
+                }
+
+                c1[n] = in1[i] * input_factor;
+                c2[n] = in2[i] * input_factor;
+                indexes[n] = i;
+                ++n;
+            }
+
+            Policy::apply(proj, c1, c2, errors, n);
+
+            for (std::size_t k = 0; k < n; ++k)
+            {
+                if (errors[k] != 0)
+                {
+                    out1[indexes[k]] = static_cast<T>(HUGE_VAL);
+                    out2[indexes[k]] = static_cast<T>(HUGE_VAL);
+                    result = false;
+                }
+                else
+                {
+                    out1[indexes[k]] = static_cast<T>(c1[k] * output_factor);
+                    out2[indexes[k]] = static_cast<T>(c2[k] * output_factor);
+                }
+            }
+        }
+        return result;
+    }
+};
+
 
 } // namespace detail
 #endif // DOXYGEN_NO_DETAIL
@@ -487,6 +590,41 @@ public:
                     projections::detail::inverse_point_projection_policy
                 >::apply(xy, ll, base_t::proj());
     }
+
+    /*!
+    \brief Forward projection of arrays of coordinates
+    \details The points are projected in batches, with the kernel of the
+        projection called once per batch. The longitudes and latitudes are in
+        degrees. The points which could not be projected are set to HUGE_VAL,
+        the points already set to HUGE_VAL are not projected. The output
+        arrays may be the same as the input arrays.
+    \return true if all of the points were projected
+    */
+    template <typename T>
+    inline bool forward(T const* lon, T const* lat, T* x, T* y,
+                        std::size_t count) const
+    {
+        return projections::detail::project_arrays
+                <
+                    typename projections::detail::promote_to_double<CT>::type
+                >::forward(lon, lat, x, y, count, base_t::proj());
+    }
+
+    /*!
+    \brief Inverse projection of arrays of coordinates
+    \details The points are projected the same way as by forward(). The
+        longitudes and latitudes are in degrees.
+    \return true if all of the points were projected
+    */
+    template <typename T>
+    inline bool inverse(T const* x, T const* y, T* lon, T* lat,
+                        std::size_t count) const
+    {
+        return projections::detail::project_arrays
+                <
+                    typename projections::detail::promote_to_double<CT>::type
+                >::inverse(x, y, lon, lat, count, base_t::proj());
+    }
 };
 
 } // namespace projections
@@ -25,6 +25,8 @@ namespace srs
 
 // Forward declarations for functions declarations below
 class grids;
+class shared_grids;
+class lockfree_shared_grids;
 
 template <typename GridsStorage>
 class projection_grids;
@@ -45,6 +47,32 @@ inline bool pj_apply_gridshift_3(StreamPolicy const& stream_policy,
                                  srs::grids & grids,
                                  std::vector<std::size_t> const& gridindexes);
 
+// Forward declarations of the overloads for shared_grids, defined in
+// srs/shared_grids.hpp, have to be visible before the calls in the templates
+template <typename StreamPolicy>
+inline bool pj_gridlist_merge_gridfile(std::string const& gridname,
+                                       StreamPolicy const& stream_policy,
+                                       srs::shared_grids & grids,
+                                       std::vector<std::size_t> & gridindexes);
+template <bool Inverse, typename CalcT, typename StreamPolicy, typename Range>
+inline bool pj_apply_gridshift_3(StreamPolicy const& stream_policy,
+                                 Range & range,
+                                 srs::shared_grids & grids,
+                                 std::vector<std::size_t> const& gridindexes);
+
+// The overloads for lockfree_shared_grids, defined in
+// srs/lockfree_shared_grids.hpp
+template <typename StreamPolicy>
+inline bool pj_gridlist_merge_gridfile(std::string const& gridname,
+                                       StreamPolicy const& stream_policy,
+                                       srs::lockfree_shared_grids & grids,
+                                       std::vector<std::size_t> & gridindexes);
+template <bool Inverse, typename CalcT, typename StreamPolicy, typename Range>
+inline bool pj_apply_gridshift_3(StreamPolicy const& stream_policy,
+                                 Range & range,
+                                 srs::lockfree_shared_grids & grids,
+                                 std::vector<std::size_t> const& gridindexes);
+
 // Forward declaratios of projection_grids friends
 template <typename Par, typename GridsStorage>
 inline void pj_gridlist_from_nadgrids(Par const& defn,
@@ -171,6 +199,32 @@ namespace detail
 struct empty_grids_storage {};
 struct empty_projection_grids {};
 
+// Grids which may be used by many threads at the same time, the grids loaded
+// lazily have to be guarded
+template <typename GridsStorage>
+struct is_thread_safe_grids_storage
+{
+    static const bool value = false;
+};
+
+template <>
+struct is_thread_safe_grids_storage<empty_grids_storage>
+{
+    static const bool value = true;
+};
+
+template <typename StreamPolicy>
+struct is_thread_safe_grids_storage<grids_storage<StreamPolicy, shared_grids> >
+{
+    static const bool value = true;
+};
+
+template <typename StreamPolicy>
+struct is_thread_safe_grids_storage<grids_storage<StreamPolicy, lockfree_shared_grids> >
+{
+    static const bool value = true;
+};
+
 } // namespace detail
 
 
@@ -1,6 +1,7 @@
 // Boost.Geometry (aka GGL, Generic Geometry Library)
 
 // Copyright (c) 2007-2012 Barend Gehrels, Amsterdam, the Netherlands.
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
 
 // This file was modified by Oracle on 2017, 2018.
 // Modifications copyright (c) 2017-2018, Oracle and/or its affiliates.
@@ -13,9 +14,12 @@
 #ifndef BOOST_GEOMETRY_PROJECTIONS_IMPL_BASE_DYNAMIC_HPP
 #define BOOST_GEOMETRY_PROJECTIONS_IMPL_BASE_DYNAMIC_HPP
 
+#include <cstddef>
 #include <string>
 
 #include <boost/geometry/srs/projections/exception.hpp>
+#include <boost/geometry/srs/projections/impl/pj_fwd.hpp>
+#include <boost/geometry/srs/projections/impl/pj_inv.hpp>
 #include <boost/geometry/srs/projections/impl/projects.hpp>
 
 namespace boost { namespace geometry { namespace projections
@@ -70,12 +74,36 @@ public :
         }
     }
 
+    /// Forward projection of arrays of coordinates in radians
+    template <typename T>
+    inline void forward_n(T const* lon, T const* lat, T* x, T* y,
+                          int* errors, std::size_t count) const
+    {
+        pj_fwd_n(*this, this->params(), lon, lat, x, y, errors, count);
+    }
+
+    /// Inverse projection of arrays of coordinates, to radians
+    template <typename T>
+    inline void inverse_n(T const* x, T const* y, T* lon, T* lat,
+                          int* errors, std::size_t count) const
+    {
+        pj_inv_n(*this, this->params(), x, y, lon, lat, errors, count);
+    }
+
     /// Forward projection using lon / lat and x / y separately
     virtual void fwd(CT const& lp_lon, CT const& lp_lat, CT& xy_x, CT& xy_y) const = 0;
 
     /// Inverse projection using x / y and lon / lat
     virtual void inv(CT const& xy_x, CT const& xy_y, CT& lp_lon, CT& lp_lat) const = 0;
 
+    /// Forward projection of arrays of lon / lat, called once per batch
+    virtual void fwd_n(CT const* lp_lon, CT const* lp_lat, CT* xy_x, CT* xy_y,
+                       int* errors, std::size_t count) const = 0;
+
+    /// Inverse projection of arrays of x / y, called once per batch
+    virtual void inv_n(CT const* xy_x, CT const* xy_y, CT* lp_lon, CT* lp_lat,
+                       int* errors, std::size_t count) const = 0;
+
     /// Returns name of projection
     virtual std::string name() const = 0;
 
@@ -117,6 +145,17 @@ public:
         BOOST_THROW_EXCEPTION(projection_not_invertible_exception(params().id.name));
     }
 
+    virtual void fwd_n(CT const* lp_lon, CT const* lp_lat, CT* xy_x, CT* xy_y,
+                       int* errors, std::size_t count) const
+    {
+        m_proj.fwd_n(lp_lon, lp_lat, xy_x, xy_y, errors, count);
+    }
+
+    virtual void inv_n(CT const* , CT const* , CT* , CT* , int* , std::size_t ) const
+    {
+        BOOST_THROW_EXCEPTION(projection_not_invertible_exception(params().id.name));
+    }
+
     virtual std::string name() const { return m_proj.name(); }
 
     virtual P const& params() const { return m_proj.params(); }
@@ -152,6 +191,12 @@ public:
     {
         this->m_proj.inv(xy_x, xy_y, lp_lon, lp_lat);
     }
+
+    virtual void inv_n(CT const* xy_x, CT const* xy_y, CT* lp_lon, CT* lp_lat,
+                       int* errors, std::size_t count) const
+    {
+        this->m_proj.inv_n(xy_x, xy_y, lp_lon, lp_lat, errors, count);
+    }
 };
 
 } // namespace detail
@@ -1,6 +1,7 @@
 // Boost.Geometry (aka GGL, Generic Geometry Library)
 
 // Copyright (c) 2007-2012 Barend Gehrels, Amsterdam, the Netherlands.
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
 
 // This file was modified by Oracle on 2017, 2018.
 // Modifications copyright (c) 2017-2018, Oracle and/or its affiliates.
@@ -19,10 +20,12 @@
 #endif // defined(_MSC_VER)
 
 
+#include <cstddef>
 #include <string>
 
 #include <boost/geometry/core/tags.hpp>
 
+#include <boost/geometry/srs/projections/exception.hpp>
 #include <boost/geometry/srs/projections/impl/pj_fwd.hpp>
 #include <boost/geometry/srs/projections/impl/pj_inv.hpp>
 
@@ -85,6 +88,14 @@ public:
         }
     }
 
+    /// Forward projection of arrays of coordinates in radians
+    template <typename T>
+    inline void forward_n(T const* lon, T const* lat, T* x, T* y,
+                          int* errors, std::size_t count) const
+    {
+        pj_fwd_n(m_prj, m_par, lon, lat, x, y, errors, count);
+    }
+
     template <typename XY, typename LL>
     inline bool inverse(XY const& , LL& ) const
     {
@@ -94,6 +105,39 @@ public:
         return false;
     }
 
+    template <typename T>
+    inline void inverse_n(T const* , T const* , T* , T* , int* , std::size_t ) const
+    {
+        BOOST_MPL_ASSERT_MSG((false),
+                             PROJECTION_IS_NOT_INVERTABLE,
+                             (Prj));
+    }
+
+    // Forward projection of arrays of normalized coordinates, called by
+    // pj_fwd_n(). Projections may hide it with a kernel written for arrays.
+    // The try block is entered again only after an exception is thrown.
+    inline void fwd_n(CT const* lp_lon, CT const* lp_lat, CT* xy_x, CT* xy_y,
+                      int* errors, std::size_t count) const
+    {
+        std::size_t i = 0;
+        while (i < count)
+        {
+            try
+            {
+                for ( ; i < count ; ++i)
+                {
+                    m_prj.fwd(lp_lon[i], lp_lat[i], xy_x[i], xy_y[i]);
+                    errors[i] = 0;
+                }
+            }
+            catch (projection_exception const& e)
+            {
+                errors[i] = e.code();
+                ++i;
+            }
+        }
+    }
+
     inline std::string name() const
     {
         return this->m_par.id.name;
@@ -127,6 +171,37 @@ public :
             return false;
         }
     }
+
+    /// Inverse projection of arrays of coordinates, to radians
+    template <typename T>
+    inline void inverse_n(T const* x, T const* y, T* lon, T* lat,
+                          int* errors, std::size_t count) const
+    {
+        pj_inv_n(this->m_prj, this->m_par, x, y, lon, lat, errors, count);
+    }
+
+    // Inverse projection of arrays of coordinates, called by pj_inv_n()
+    inline void inv_n(CT const* xy_x, CT const* xy_y, CT* lp_lon, CT* lp_lat,
+                      int* errors, std::size_t count) const
+    {
+        std::size_t i = 0;
+        while (i < count)
+        {
+            try
+            {
+                for ( ; i < count ; ++i)
+                {
+                    this->m_prj.inv(xy_x[i], xy_y[i], lp_lon[i], lp_lat[i]);
+                    errors[i] = 0;
+                }
+            }
+            catch (projection_exception const& e)
+            {
+                errors[i] = e.code();
+                ++i;
+            }
+        }
+    }
 };
 
 } // namespace detail
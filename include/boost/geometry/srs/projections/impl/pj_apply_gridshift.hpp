@@ -44,8 +44,12 @@
 #include <boost/geometry/core/assert.hpp>
 #include <boost/geometry/core/radian_access.hpp>
 
+#include <boost/geometry/srs/projections/impl/adjlon.hpp>
+#include <boost/geometry/srs/projections/impl/function_overloads.hpp>
 #include <boost/geometry/srs/projections/impl/pj_gridlist.hpp>
 
+#include <boost/geometry/util/range.hpp>
+
 
 namespace boost { namespace geometry { namespace projections
 {
@@ -96,11 +100,11 @@ inline void nad_intr(CalcT in_lon, CalcT in_lat,
 			return;
 	}
 	boost::int32_t index = indx.phi * ct.lim.lam + indx.lam;
-	pj_ctable::flp_t const& f00 = ct.cvs[index++];
-	pj_ctable::flp_t const& f10 = ct.cvs[index];
+	pj_ctable::flp_t const f00 = ct.cell(index++);
+	pj_ctable::flp_t const f10 = ct.cell(index);
 	index += ct.lim.lam;
-	pj_ctable::flp_t const& f11 = ct.cvs[index--];
-	pj_ctable::flp_t const& f01 = ct.cvs[index];
+	pj_ctable::flp_t const f11 = ct.cell(index--);
+	pj_ctable::flp_t const f01 = ct.cell(index);
     CalcT m00, m10, m01, m11;
 	m11 = m10 = frct.lam;
 	m00 = m01 = 1. - frct.lam;
@@ -119,7 +123,7 @@ inline void nad_intr(CalcT in_lon, CalcT in_lat,
 template <bool Inverse, typename CalcT>
 inline void nad_cvt(CalcT const& in_lon, CalcT const& in_lat,
                     CalcT & out_lon, CalcT & out_lat,
-                    pj_gi const& gi)
+                    pj_gi_load const& gi)
 {
     static const int max_iterations = 10;
     static const CalcT tol = 1e-12;
@@ -303,7 +307,7 @@ template <typename StreamPolicy>
 inline bool load_grid(StreamPolicy const& stream_policy, pj_gi_load & gi)
 {
     // load the grid shift info if we don't have it.
-    if (gi.ct.cvs.empty())
+    if (! gi.ct.is_loaded())
     {
         typename StreamPolicy::stream_type is;
         stream_policy.open(is, gi.gridname);
@@ -356,7 +360,7 @@ inline bool pj_apply_gridshift_3(StreamPolicy const& stream_policy,
         if ( gip != NULL )
         {
             // load the grid shift info if we don't have it.
-            if (! gip->ct.cvs.empty() || load_grid(stream_policy, *gip))
+            if (gip->ct.is_loaded() || load_grid(stream_policy, *gip))
             {
                 // TODO: use set_invalid_point() or similar mechanism
                 CalcT out_lon = HUGE_VAL;
@@ -0,0 +1,172 @@
+// Boost.Geometry
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_SRS_PROJECTIONS_IMPL_PJ_APPLY_GRIDSHIFT_LOCKFREE_HPP
+#define BOOST_GEOMETRY_SRS_PROJECTIONS_IMPL_PJ_APPLY_GRIDSHIFT_LOCKFREE_HPP
+
+
+#include <boost/container/small_vector.hpp>
+
+#include <boost/geometry/core/assert.hpp>
+#include <boost/geometry/core/radian_access.hpp>
+
+#include <boost/geometry/srs/projections/impl/pj_apply_gridshift.hpp>
+#include <boost/geometry/srs/projections/impl/pj_gridlist_lockfree.hpp>
+
+
+// The number of grids of a transformation resolved without allocating memory
+#ifndef BOOST_GEOMETRY_SRS_DETAIL_GRIDSHIFT_STATIC_GRIDS
+#define BOOST_GEOMETRY_SRS_DETAIL_GRIDSHIFT_STATIC_GRIDS 8
+#endif
+
+
+namespace boost { namespace geometry { namespace projections
+{
+
+namespace detail
+{
+
+template <typename T, typename Grids>
+inline pj_lockfree_gi const* find_grid(T const& lam,
+                                       T const& phi,
+                                       Grids const& grids)
+{
+    pj_lockfree_gi const* gip = NULL;
+
+    for (std::size_t i = 0 ; i < grids.size() ; ++i)
+    {
+        pj_gi_load const& gi = grids[i]->header;
+
+        // skip tables that don't match our point at all
+        // and vertical grids
+        if (! grid_disjoint(lam, phi, gi.ct) && gi.format != pj_gi::gtx)
+        {
+            gip = grids[i];
+            break;
+        }
+    }
+
+    if (gip == NULL)
+        return gip;
+
+    // If we have child nodes, check to see if any of them apply.
+    pj_lockfree_gi const* child = find_grid(lam, phi, gip->children);
+    if (child != NULL)
+        gip = child;
+
+    return gip;
+}
+
+// Load the cells of the grid and publish them,
+// returns the cells loaded by this or other thread
+template <typename StreamPolicy>
+inline pj_gi_load const* load_grid(StreamPolicy const& stream_policy,
+                                   pj_lockfree_gi const& gi)
+{
+    pj_gi_load * local_gi = new pj_gi_load(gi.header);
+
+    bool loaded = false;
+    try
+    {
+        loaded = load_grid(stream_policy, *local_gi);
+    }
+    catch (...)
+    {
+        delete local_gi;
+        throw;
+    }
+
+    if (! loaded)
+    {
+        delete local_gi;
+        return NULL;
+    }
+
+    return gi.publish(local_gi);
+}
+
+template <bool Inverse, typename CalcT, typename StreamPolicy, typename Range>
+inline bool pj_apply_gridshift_3(StreamPolicy const& stream_policy,
+                                 Range & range,
+                                 srs::lockfree_shared_grids & grids,
+                                 std::vector<std::size_t> const& gridindexes)
+{
+    typedef typename boost::range_size<Range>::type size_type;
+
+    // If the grids are empty the indexes are as well
+    if (gridindexes.empty())
+    {
+        //pj_ctx_set_errno(ctx, PJD_ERR_FAILED_TO_LOAD_GRID);
+        //return PJD_ERR_FAILED_TO_LOAD_GRID;
+        return false;
+    }
+
+    // The grids are found once, they are not moved nor destroyed
+    // when other files are added.
+    pj_lockfree_gridfile const* last = grids.last.load(boost::memory_order_acquire);
+    // Typically there are only a few grids so they're stored on the stack.
+    boost::container::small_vector
+        <
+            pj_lockfree_gi const*,
+            BOOST_GEOMETRY_SRS_DETAIL_GRIDSHIFT_STATIC_GRIDS
+        > gis;
+    gis.reserve(gridindexes.size());
+    for (std::size_t i = 0 ; i < gridindexes.size() ; ++i)
+    {
+        pj_lockfree_gi const* gi = pj_gridlist_at(last, gridindexes[i]);
+        BOOST_GEOMETRY_ASSERT(gi != NULL);
+        gis.push_back(gi);
+    }
+
+    size_type point_count = boost::size(range);
+
+    for (size_type i = 0 ; i < point_count ; ++i)
+    {
+        typename boost::range_reference<Range>::type
+            point = range::at(range, i);
+
+        CalcT in_lon = geometry::get_as_radian<0>(point);
+        CalcT in_lat = geometry::get_as_radian<1>(point);
+
+        pj_lockfree_gi const* gip = find_grid(in_lon, in_lat, gis);
+
+        if (gip != NULL)
+        {
+            pj_gi_load const* cells = gip->cells();
+            if (cells == NULL)
+            {
+                cells = load_grid(stream_policy, *gip);
+            }
+
+            if (cells != NULL)
+            {
+                // TODO: use set_invalid_point() or similar mechanism
+                CalcT out_lon = HUGE_VAL;
+                CalcT out_lat = HUGE_VAL;
+
+                nad_cvt<Inverse>(in_lon, in_lat, out_lon, out_lat, *cells);
+
+                // TODO: check differently
+                if (out_lon != HUGE_VAL)
+                {
+                    geometry::set_from_radian<0>(point, out_lon);
+                    geometry::set_from_radian<1>(point, out_lat);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+
+} // namespace detail
+
+}}} // namespace boost::geometry::projections
+
+#endif // BOOST_GEOMETRY_SRS_PROJECTIONS_IMPL_PJ_APPLY_GRIDSHIFT_LOCKFREE_HPP
@@ -99,7 +99,7 @@ inline bool pj_apply_gridshift_3(StreamPolicy const& stream_policy,
                 {
                     // do nothing
                 }
-                else if (! gip->ct.cvs.empty())
+                else if (gip->ct.is_loaded())
                 {
                     // TODO: use set_invalid_point() or similar mechanism
                     CalcT out_lon = HUGE_VAL;
@@ -133,7 +133,7 @@ inline bool pj_apply_gridshift_3(StreamPolicy const& stream_policy,
                 // check again in case other thread already loaded the grid.
                 pj_gi * gip = find_grid(in_lon, in_lat, grids.gridinfo, gridindexes);
 
-                if (gip != NULL && gip->ct.cvs.empty())
+                if (gip != NULL && ! gip->ct.is_loaded())
                 {
                     // swap loaded local storage with empty grid
                     local_gi.swap(*gip);
@@ -2,6 +2,7 @@
 // This file is manually converted from PROJ4
 
 // Copyright (c) 2008-2012 Barend Gehrels, Amsterdam, the Netherlands.
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
 
 // This file was modified by Oracle on 2017, 2018.
 // Modifications copyright (c) 2017-2018, Oracle and/or its affiliates.
@@ -39,6 +40,9 @@
 #ifndef BOOST_GEOMETRY_PROJECTIONS_IMPL_PJ_FWD_HPP
 #define BOOST_GEOMETRY_PROJECTIONS_IMPL_PJ_FWD_HPP
 
+#include <algorithm>
+#include <cstddef>
+
 #include <boost/geometry/core/radian_access.hpp>
 #include <boost/geometry/util/math.hpp>
 
@@ -95,6 +99,89 @@ inline void pj_fwd(Prj const& prj, P const& par, LL const& ll, XY& xy)
     geometry::set<1>(xy, par.fr_meter * (par.a * y + par.y0));
 }
 
+/* forward projection entry for arrays of coordinates */
+// The longitudes and latitudes are in radians. The points are projected in
+// batches, with one call of fwd_n() of the projection per batch. The error
+// code is stored for each point, 0 if the point was projected. The points
+// which could not be projected are set to HUGE_VAL. The arrays may overlap.
+template <typename Prj, typename P, typename T>
+inline void pj_fwd_n(Prj const& prj, P const& par,
+                     T const* lon, T const* lat, T* x, T* y,
+                     int* errors, std::size_t count)
+{
+    typedef typename P::type calc_t;
+    static const calc_t EPS = 1.0e-12;
+
+    using namespace detail;
+
+    calc_t lp_lon[pj_batch_size];
+    calc_t lp_lat[pj_batch_size];
+    calc_t xy_x[pj_batch_size];
+    calc_t xy_y[pj_batch_size];
+    int prj_errors[pj_batch_size];
+
+    for (std::size_t first = 0; first < count; first += pj_batch_size)
+    {
+        std::size_t const n = (std::min)(count - first, pj_batch_size);
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            calc_t lon_i = lon[first + i];
+            calc_t lat_i = lat[first + i];
+            calc_t const t = geometry::math::abs(lat_i) - geometry::math::half_pi<calc_t>();
+
+            errors[first + i] = 0;
+
+            /* check for forward and latitude or longitude overange */
+            if (t > EPS || geometry::math::abs(lon_i) > 10.)
+            {
+                // the point is passed to the projection but the result is ignored
+                errors[first + i] = error_lat_or_lon_exceed_limit;
+                lon_i = 0;
+                lat_i = 0;
+            }
+            else if (geometry::math::abs(t) <= EPS)
+            {
+                lat_i = lat_i < 0. ? -geometry::math::half_pi<calc_t>() : geometry::math::half_pi<calc_t>();
+            }
+            else if (par.geoc)
+            {
+                lat_i = atan(par.rone_es * tan(lat_i));
+            }
+
+            lon_i -= par.lam0;    /* compute del lp.lam */
+            if (! par.over)
+            {
+                lon_i = adjlon(lon_i); /* post_forward del longitude */
+            }
+
+            lp_lon[i] = lon_i;
+            lp_lat[i] = lat_i;
+        }
+
+        prj.fwd_n(lp_lon, lp_lat, xy_x, xy_y, prj_errors, n);
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (errors[first + i] == 0)
+            {
+                errors[first + i] = prj_errors[i];
+            }
+
+            if (errors[first + i] == 0)
+            {
+                x[first + i] = par.fr_meter * (par.a * xy_x[i] + par.x0);
+                y[first + i] = par.fr_meter * (par.a * xy_y[i] + par.y0);
+            }
+            else
+            {
+                x[first + i] = HUGE_VAL;
+                y[first + i] = HUGE_VAL;
+            }
+        }
+    }
+}
+
 } // namespace detail
 }}} // namespace boost::geometry::projections
 
@@ -1,6 +1,8 @@
 // Boost.Geometry
 // This file is manually converted from PROJ4
 
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
 // This file was modified by Oracle on 2018.
 // Modifications copyright (c) 2018, Oracle and/or its affiliates.
 // Contributed and/or modified by Adam Wulkiewicz, on behalf of Oracle
@@ -44,10 +46,14 @@
 #include <boost/algorithm/string.hpp>
 
 #include <boost/geometry/core/assert.hpp>
+#include <boost/geometry/util/math.hpp>
 
 #include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
 
 #include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -105,11 +111,47 @@ struct pj_ctable
     struct flp_t { float lam, phi; };
     struct ilp_t { boost::int32_t lam, phi; };
 
+    // Conversion matrix stored in the memory-mapped file in the format
+    // of the file, the cells are converted when accessed
+    struct cells_t
+    {
+        // native - the cells of ctable and ctable2 formats
+        // ntv1 - rows from east to west, phi and lam in seconds as doubles
+        // ntv2 - rows from east to west, phi, lam and accuracies in seconds
+        //        as floats
+        enum layout_t { native = 0, ntv1, ntv2 };
+
+        cells_t()
+            : data(NULL), layout(native), swap(false)
+        {}
+
+        static inline std::size_t cell_size(layout_t l)
+        {
+            return l == native ? sizeof(flp_t) : 16;
+        }
+
+        const char * data;              // first cell or NULL if not mapped
+        layout_t layout;
+        bool swap;                      // byte order different than native
+        boost::shared_ptr<void> mapping; // keeps the file mapped
+    };
+
     std::string id;         // ascii info
     lp_t ll;                // lower left corner coordinates
     lp_t del;               // size of cells
     ilp_t lim;              // limits of conversion matrix
     std::vector<flp_t> cvs; // conversion matrix
+    cells_t cells;          // conversion matrix in mapped memory
+
+    inline bool is_loaded() const
+    {
+        return ! cvs.empty() || cells.data != NULL;
+    }
+
+    inline flp_t cell(boost::int32_t index) const
+    {
+        return cells.data == NULL ? cvs[index] : mapped_cell(index);
+    }
 
     inline void swap(pj_ctable & r)
     {
@@ -118,6 +160,56 @@ struct pj_ctable
         std::swap(del, r.del);
         std::swap(lim, r.lim);
         cvs.swap(r.cvs);
+        std::swap(cells, r.cells);
+    }
+
+private:
+    // The same conversions as the ones done while loading the grids
+    inline flp_t mapped_cell(boost::int32_t index) const
+    {
+        static const double s2r = math::d2r<double>() / 3600.0;
+
+        flp_t result;
+
+        if (cells.layout == cells_t::native)
+        {
+            std::memcpy(&result, cells.data + std::size_t(index) * sizeof(flp_t), sizeof(flp_t));
+            if (cells.swap)
+            {
+                swap_words(reinterpret_cast<char*>(&result), 4, 2);
+            }
+            return result;
+        }
+
+        boost::int32_t const row = index / lim.lam;
+        boost::int32_t const i = lim.lam - index % lim.lam - 1;
+        const char * const p = cells.data + (std::size_t(row) * lim.lam + i) * 16;
+
+        if (cells.layout == cells_t::ntv1)
+        {
+            double v[2];
+            std::memcpy(v, p, sizeof(v));
+            if (cells.swap)
+            {
+                swap_words(reinterpret_cast<char*>(v), 8, 2);
+            }
+            result.phi = (float) (v[0] * s2r);
+            result.lam = (float) (v[1] * s2r);
+        }
+        else
+        {
+            // skip accuracy values
+            float v[2];
+            std::memcpy(v, p, sizeof(v));
+            if (cells.swap)
+            {
+                swap_words(reinterpret_cast<char*>(v), 4, 2);
+            }
+            result.phi = (float) (v[0] * s2r);
+            result.lam = (float) (v[1] * s2r);
+        }
+
+        return result;
     }
 };
 
@@ -178,6 +270,27 @@ struct pj_gi
 typedef std::vector<pj_gi> pj_gridinfo;
 
 
+// Sets the cells of the grids initialized from the stream, starting from
+// first, to the memory of the stream instead of loading them. By default
+// the cells are loaded on first use, specialized for the mapped files.
+template <typename IStream>
+struct pj_gridinfo_map
+{
+    static inline void apply(IStream const& , pj_gridinfo & , std::size_t )
+    {}
+};
+
+
+// The size of the header of proj4 original CTABLE
+inline std::size_t pj_gridinfo_ctable_header_size()
+{
+    return 80
+         + 2 * sizeof(pj_ctable::lp_t)
+         + sizeof(pj_ctable::ilp_t)
+         + sizeof(pj_ctable::flp_t*);
+}
+
+
 /************************************************************************/
 /*                   pj_gridinfo_load_ctable()                          */
 /*                                                                      */
@@ -191,11 +304,7 @@ bool pj_gridinfo_load_ctable(IStream & is, pj_gi_load & gi)
     pj_ctable & ct = gi.ct;
     
     // Move the input stream by the size of the proj4 original CTABLE
-    std::size_t header_size = 80
-                            + 2 * sizeof(pj_ctable::lp_t)
-                            + sizeof(pj_ctable::ilp_t)
-                            + sizeof(pj_ctable::flp_t*);
-    is.seekg(header_size);
+    is.seekg(pj_gridinfo_ctable_header_size());
     
     // read all the actual shift values
     std::size_t a_size = ct.lim.lam * ct.lim.phi;
@@ -400,7 +509,7 @@ inline bool pj_gridinfo_load_gtx(IStream & is, pj_gi_load & gi)
 template <typename IStream>
 inline bool pj_gridinfo_load(IStream & is, pj_gi_load & gi)
 {
-    if (! gi.ct.cvs.empty())
+    if (gi.ct.is_loaded())
     {
         return true;
     }
@@ -925,31 +1034,41 @@ inline bool pj_gridinfo_init(std::string const& gridname,
     
     is.seekg(0);
 
+    std::size_t const orig_size = gridinfo.size();
+    bool result = false;
+
     // Determine file type.
     if ( cstr_equal(header + 0, "HEADER", 6)
       && cstr_equal(header + 96, "W GRID", 6)
       && cstr_equal(header + 144, "TO      NAD83   ", 16) )
     {
-        return pj_gridinfo_init_ntv1(gridname, is, gridinfo);
+        result = pj_gridinfo_init_ntv1(gridname, is, gridinfo);
     }
     else if( cstr_equal(header + 0, "NUM_OREC", 8)
           && cstr_equal(header + 48, "GS_TYPE", 7) )
     {
-        return pj_gridinfo_init_ntv2(gridname, is, gridinfo);
+        result = pj_gridinfo_init_ntv2(gridname, is, gridinfo);
     }
     else if( boost::algorithm::ends_with(gridname, "gtx")
           || boost::algorithm::ends_with(gridname, "GTX") )
     {
-        return pj_gridinfo_init_gtx(gridname, is, gridinfo);
+        result = pj_gridinfo_init_gtx(gridname, is, gridinfo);
     }
     else if( cstr_equal(header + 0, "CTABLE V2", 9) )
     {
-        return pj_gridinfo_init_ctable2(gridname, is, gridinfo);
+        result = pj_gridinfo_init_ctable2(gridname, is, gridinfo);
     }
     else
     {
-        return pj_gridinfo_init_ctable(gridname, is, gridinfo);
+        result = pj_gridinfo_init_ctable(gridname, is, gridinfo);
+    }
+
+    if (result)
+    {
+        pj_gridinfo_map<IStream>::apply(is, gridinfo, orig_size);
     }
+
+    return result;
 }
 
 
@@ -0,0 +1,125 @@
+// Boost.Geometry
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_SRS_PROJECTIONS_IMPL_PJ_GRIDLIST_LOCKFREE_HPP
+#define BOOST_GEOMETRY_SRS_PROJECTIONS_IMPL_PJ_GRIDLIST_LOCKFREE_HPP
+
+
+#include <boost/thread/lock_guard.hpp>
+
+#include <boost/geometry/srs/projections/lockfree_shared_grids.hpp>
+#include <boost/geometry/srs/projections/impl/pj_gridinfo.hpp>
+#include <boost/geometry/srs/projections/impl/pj_gridlist.hpp>
+
+
+namespace boost { namespace geometry { namespace projections
+{
+
+namespace detail
+{
+
+
+// Find all grids of the file in the list of files
+inline bool pj_gridlist_find_all(std::string const& gridname,
+                                 pj_lockfree_gridfile const* file,
+                                 std::vector<std::size_t> & gridindexes)
+{
+    for ( ; file != NULL ; file = file->next)
+    {
+        if (file->gridname == gridname)
+        {
+            pj_gridlist_add_seq_inc(gridindexes, file->first,
+                                    file->first + file->grids.size());
+            return true;
+        }
+    }
+    return false;
+}
+
+// Find the grid of the given index in the list of files
+inline pj_lockfree_gi const* pj_gridlist_at(pj_lockfree_gridfile const* file,
+                                            std::size_t index)
+{
+    for ( ; file != NULL ; file = file->next)
+    {
+        if (index >= file->first)
+        {
+            return index < file->first + file->grids.size()
+                 ? file->grids[index - file->first]
+                 : NULL;
+        }
+    }
+    return NULL;
+}
+
+
+/************************************************************************/
+/*                       pj_gridlist_merge_grid()                       */
+/*                                                                      */
+/*      Find/load the named gridfile and merge it into the              */
+/*      last_nadgrids_list.                                             */
+/************************************************************************/
+
+// Generic stream policy and lock-free shared grids
+template <typename StreamPolicy>
+inline bool pj_gridlist_merge_gridfile(std::string const& gridname,
+                                       StreamPolicy const& stream_policy,
+                                       srs::lockfree_shared_grids & grids,
+                                       std::vector<std::size_t> & gridindexes)
+{
+    // Try to find in the existing list of files without locking,
+    // the files are never modified after they are published.
+    if (pj_gridlist_find_all(gridname,
+                             grids.last.load(boost::memory_order_acquire),
+                             gridindexes))
+        return true;
+
+    // Try to load the named grid.
+    typename StreamPolicy::stream_type is;
+    stream_policy.open(is, gridname);
+
+    pj_gridinfo new_grids;
+
+    if (! pj_gridinfo_init(gridname, is, new_grids))
+    {
+        return false;
+    }
+
+    // Add the file now that it is loaded.
+
+    std::size_t first = 0;
+    std::size_t last = 0;
+
+    {
+        boost::lock_guard<boost::mutex> lock(grids.mutex);
+
+        pj_lockfree_gridfile const* prev = grids.last.load(boost::memory_order_acquire);
+
+        // Try to find in the existing list of files again
+        // in case other thread already added it.
+        if (pj_gridlist_find_all(gridname, prev, gridindexes))
+            return true;
+
+        pj_lockfree_gridfile const* file = new pj_lockfree_gridfile(gridname, new_grids, prev);
+        first = file->first;
+        last = first + file->grids.size();
+
+        grids.last.store(file, boost::memory_order_release);
+    }
+
+    pj_gridlist_add_seq_inc(gridindexes, first, last);
+
+    return true;
+}
+
+
+} // namespace detail
+
+}}} // namespace boost::geometry::projections
+
+#endif // BOOST_GEOMETRY_SRS_PROJECTIONS_IMPL_PJ_GRIDLIST_LOCKFREE_HPP
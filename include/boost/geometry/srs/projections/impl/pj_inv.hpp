@@ -2,6 +2,7 @@
 // This file is manually converted from PROJ4
 
 // Copyright (c) 2008-2012 Barend Gehrels, Amsterdam, the Netherlands.
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
 
 // This file was modified by Oracle on 2017.
 // Modifications copyright (c) 2017, Oracle and/or its affiliates.
@@ -41,7 +42,11 @@
 
 
 
+#include <algorithm>
+#include <cstddef>
+
 #include <boost/geometry/srs/projections/impl/adjlon.hpp>
+#include <boost/geometry/srs/projections/impl/projects.hpp>
 #include <boost/geometry/core/radian_access.hpp>
 #include <boost/geometry/util/math.hpp>
 
@@ -76,6 +81,59 @@ inline void pj_inv(PRJ const& prj, PAR const& par, XY const& xy, LL& ll)
     geometry::set_from_radian<1>(ll, lat);
 }
 
+/* inverse projection entry for arrays of coordinates */
+// The longitudes and latitudes are in radians. The points are projected in
+// batches, with one call of inv_n() of the projection per batch. The error
+// code is stored for each point, 0 if the point was projected. The points
+// which could not be projected are set to HUGE_VAL. The arrays may overlap.
+template <typename PRJ, typename PAR, typename T>
+inline void pj_inv_n(PRJ const& prj, PAR const& par,
+                     T const* x, T const* y, T* lon, T* lat,
+                     int* errors, std::size_t count)
+{
+    typedef typename PAR::type calc_t;
+    static const calc_t EPS = 1.0e-12;
+
+    calc_t xy_x[pj_batch_size];
+    calc_t xy_y[pj_batch_size];
+    calc_t lp_lon[pj_batch_size];
+    calc_t lp_lat[pj_batch_size];
+
+    for (std::size_t first = 0; first < count; first += pj_batch_size)
+    {
+        std::size_t const n = (std::min)(count - first, pj_batch_size);
+
+        /* descale and de-offset */
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            xy_x[i] = (x[first + i] * par.to_meter - par.x0) * par.ra;
+            xy_y[i] = (y[first + i] * par.to_meter - par.y0) * par.ra;
+        }
+
+        prj.inv_n(xy_x, xy_y, lp_lon, lp_lat, errors + first, n); /* inverse project */
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (errors[first + i] != 0)
+            {
+                lon[first + i] = HUGE_VAL;
+                lat[first + i] = HUGE_VAL;
+                continue;
+            }
+
+            calc_t lon_i = lp_lon[i] + par.lam0; /* reduce from del lp.lam */
+            calc_t lat_i = lp_lat[i];
+            if (!par.over)
+                lon_i = adjlon(lon_i); /* adjust longitude to CM */
+            if (par.geoc && geometry::math::abs(geometry::math::abs(lat_i)-geometry::math::half_pi<calc_t>()) > EPS)
+                lat_i = atan(par.one_es * tan(lat_i));
+
+            lon[first + i] = lon_i;
+            lat[first + i] = lat_i;
+        }
+    }
+}
+
 } // namespace detail
 }}} // namespace boost::geometry::projections
 
@@ -1,6 +1,8 @@
 // Boost.Geometry
 // This file is manually converted from PROJ4
 
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
 // This file was modified by Oracle on 2017, 2018.
 // Modifications copyright (c) 2017-2018, Oracle and/or its affiliates.
 // Contributed and/or modified by Adam Wulkiewicz, on behalf of Oracle
@@ -43,13 +45,17 @@
 #include <boost/geometry/core/access.hpp>
 #include <boost/geometry/core/radian_access.hpp>
 
+#include <boost/geometry/srs/projections/exception.hpp>
 #include <boost/geometry/srs/projections/impl/geocent.hpp>
 #include <boost/geometry/srs/projections/impl/pj_apply_gridshift.hpp>
+#include <boost/geometry/srs/projections/impl/pj_fwd.hpp>
+#include <boost/geometry/srs/projections/impl/pj_inv.hpp>
 #include <boost/geometry/srs/projections/impl/projects.hpp>
 #include <boost/geometry/srs/projections/invalid_point.hpp>
 
 #include <boost/geometry/util/range.hpp>
 
+#include <cstddef>
 #include <cstring>
 #include <cmath>
 
@@ -202,6 +208,131 @@ static const int transient_error[60] = {
     /* 40 to 49 */ 0, 0, 0, 0, 0, 0, 0, 0, 1, 0,
     /* 50 to 59 */ 1, 0, 1, 0, 1, 1, 1, 1, 0, 0 };
 
+inline bool pj_is_transient_error(int code)
+{
+    return code == 33 /*EDOM*/
+        || code == 34 /*ERANGE*/
+        || ( code <= 0 && code >= -44 && transient_error[-code] != 0 );
+}
+
+// -----------------------------------------------------------
+// Boost.Geometry helpers begin
+// -----------------------------------------------------------
+
+// Inverse projection of the valid points of a range in batches, the points
+// are invalidated in case of transient errors, other errors are thrown
+template <typename Prj, typename Par, typename Range>
+inline bool pj_inv_range(Prj const& prj, Par const& par, Range & range)
+{
+    typedef typename boost::range_value<Range>::type point_type;
+    typedef typename Par::type calc_t;
+
+    calc_t x[pj_batch_size];
+    calc_t y[pj_batch_size];
+    int errors[pj_batch_size];
+    std::size_t indexes[pj_batch_size];
+
+    std::size_t const point_count = boost::size(range);
+    bool result = true;
+    std::size_t i = 0;
+    while (i < point_count)
+    {
+        std::size_t n = 0;
+        for ( ; i < point_count && n < pj_batch_size ; ++i )
+        {
+            point_type const& point = range::at(range, i);
+            if( ! is_invalid_point(point) )
+            {
+                x[n] = get<0>(point);
+                y[n] = get<1>(point);
+                indexes[n] = i;
+                ++n;
+            }
+        }
+
+        pj_inv_n(prj, par, x, y, x, y, errors, n);
+
+        for ( std::size_t k = 0 ; k < n ; ++k )
+        {
+            point_type & point = range::at(range, indexes[k]);
+            if( errors[k] == 0 )
+            {
+                set_from_radian<0>(point, x[k]);
+                set_from_radian<1>(point, y[k]);
+            }
+            else if( pj_is_transient_error(errors[k]) )
+            {
+                set_invalid_point(point);
+                result = false;
+            }
+            else
+            {
+                BOOST_THROW_EXCEPTION( projection_exception(errors[k]) );
+            }
+        }
+    }
+    return result;
+}
+
+// Forward projection of the valid points of a range in batches, the points
+// are invalidated in case of transient errors, other errors are thrown
+template <typename Prj, typename Par, typename Range>
+inline bool pj_fwd_range(Prj const& prj, Par const& par, Range & range)
+{
+    typedef typename boost::range_value<Range>::type point_type;
+    typedef typename Par::type calc_t;
+
+    calc_t lon[pj_batch_size];
+    calc_t lat[pj_batch_size];
+    int errors[pj_batch_size];
+    std::size_t indexes[pj_batch_size];
+
+    std::size_t const point_count = boost::size(range);
+    bool result = true;
+    std::size_t i = 0;
+    while (i < point_count)
+    {
+        std::size_t n = 0;
+        for ( ; i < point_count && n < pj_batch_size ; ++i )
+        {
+            point_type const& point = range::at(range, i);
+            if( ! is_invalid_point(point) )
+            {
+                lon[n] = get_as_radian<0>(point);
+                lat[n] = get_as_radian<1>(point);
+                indexes[n] = i;
+                ++n;
+            }
+        }
+
+        pj_fwd_n(prj, par, lon, lat, lon, lat, errors, n);
+
+        for ( std::size_t k = 0 ; k < n ; ++k )
+        {
+            point_type & point = range::at(range, indexes[k]);
+            if( errors[k] == 0 )
+            {
+                set<0>(point, lon[k]);
+                set<1>(point, lat[k]);
+            }
+            else if( pj_is_transient_error(errors[k]) )
+            {
+                set_invalid_point(point);
+                result = false;
+            }
+            else
+            {
+                BOOST_THROW_EXCEPTION( projection_exception(errors[k]) );
+            }
+        }
+    }
+    return result;
+}
+
+// -----------------------------------------------------------
+// Boost.Geometry helpers end
+// -----------------------------------------------------------
+
 
 template <typename T, typename Range>
 inline int pj_geocentric_to_geodetic( T const& a, T const& es,
@@ -356,32 +487,12 @@ inline bool pj_transform(SrcPrj const& srcprj, Par const& srcdefn,
         //else
         {
             /* Fallback to the original PROJ.4 API 2d inversion - inv */
-            for( std::size_t i = 0; i < point_count; i++ )
+            // The points are projected in batches
+            if( ! pj_inv_range(srcprj, srcdefn, range) )
             {
-                point_type & point = range::at(range, i);
-
-                if( is_invalid_point(point) )
-                    continue;
-
-                try
-                {
-                    pj_inv(srcprj, srcdefn, point, point);
-                }
-                catch(projection_exception const& e)
-                {
-                    if( (e.code() != 33 /*EDOM*/
-                        && e.code() != 34 /*ERANGE*/ )
-                        && (e.code() > 0
-                            || e.code() < -44 /*|| point_count == 1*/
-                            || transient_error[-e.code()] == 0) ) {
-                        BOOST_RETHROW
-                    } else {
-                        set_invalid_point(point);
-                        result = false;
-                        if (point_count == 1)
-                            return result;
-                    }
-                }
+                result = false;
+                if (point_count == 1)
+                    return result;
             }
         }
     }
@@ -530,30 +641,12 @@ inline bool pj_transform(SrcPrj const& srcprj, Par const& srcdefn,
         //}
         //else
         {
-            for(std::size_t i = 0; i < point_count; i++ )
+            // The points are projected in batches
+            if( ! pj_fwd_range(dstprj, dstdefn, range) )
             {
-                point_type & point = range::at(range, i);
-
-                if( is_invalid_point(point) )
-                    continue;
-
-                try {
-                    pj_fwd(dstprj, dstdefn, point, point);
-                } catch (projection_exception const& e) {
-
-                    if( (e.code() != 33 /*EDOM*/
-                         && e.code() != 34 /*ERANGE*/ )
-                        && (e.code() > 0
-                            || e.code() < -44 /*|| point_count == 1*/
-                            || transient_error[-e.code()] == 0) ) {
-                        BOOST_RETHROW
-                    } else {
-                        set_invalid_point(point);
-                        result = false;
-                        if (point_count == 1)
-                            return result;
-                    }
-                }
+                result = false;
+                if (point_count == 1)
+                    return result;
             }
         }
     }
@@ -40,6 +40,7 @@
 #define BOOST_GEOMETRY_PROJECTIONS_IMPL_PROJECTS_HPP
 
 
+#include <cstddef>
 #include <cstring>
 #include <string>
 #include <vector>
@@ -69,6 +70,9 @@ enum datum_type
     datum_wgs84     = 4  /* WGS84 (or anything considered equivelent) */
 };
 
+// The number of points projected at once by pj_fwd_n() and pj_inv_n()
+static const std::size_t pj_batch_size = 64;
+
 // Originally defined in proj_internal.h
 //enum pj_io_units {
 //    pj_io_units_whatever  = 0,  /* Doesn't matter (or depends on pipeline neighbours) */
@@ -0,0 +1,224 @@
+// Boost.Geometry
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_SRS_PROJECTIONS_LOCKFREE_SHARED_GRIDS_HPP
+#define BOOST_GEOMETRY_SRS_PROJECTIONS_LOCKFREE_SHARED_GRIDS_HPP
+
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <boost/geometry/srs/projections/impl/pj_gridinfo.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+
+// Forward declarations
+namespace srs
+{
+
+// Forward declaration for functions declarations below
+class lockfree_shared_grids;
+
+} // namespace srs
+namespace projections { namespace detail
+{
+
+// Forward declaratios of lockfree_shared_grids friends
+template <typename StreamPolicy>
+inline bool pj_gridlist_merge_gridfile(std::string const& gridname,
+                                       StreamPolicy const& stream_policy,
+                                       srs::lockfree_shared_grids & grids,
+                                       std::vector<std::size_t> & gridindexes);
+template <bool Inverse, typename CalcT, typename StreamPolicy, typename Range>
+inline bool pj_apply_gridshift_3(StreamPolicy const& stream_policy,
+                                 Range & range,
+                                 srs::lockfree_shared_grids & grids,
+                                 std::vector<std::size_t> const& gridindexes);
+
+
+// The grid of lockfree_shared_grids. The header is immutable and the cells
+// are published with atomic pointer after loading.
+class pj_lockfree_gi
+{
+    pj_lockfree_gi(pj_lockfree_gi const&);
+    pj_lockfree_gi & operator=(pj_lockfree_gi const&);
+
+public:
+    explicit pj_lockfree_gi(pj_gi const& gi)
+        : header(gi)
+        , loaded(NULL)
+    {
+        children.reserve(gi.children.size());
+        for (std::size_t i = 0 ; i < gi.children.size() ; ++i)
+        {
+            children.push_back(new pj_lockfree_gi(gi.children[i]));
+        }
+    }
+
+    ~pj_lockfree_gi()
+    {
+        delete loaded.load(boost::memory_order_acquire);
+        for (std::size_t i = 0 ; i < children.size() ; ++i)
+        {
+            delete children[i];
+        }
+    }
+
+    // Returns the grid containing the cells or NULL if it's not loaded yet
+    pj_gi_load const* cells() const
+    {
+        // e.g. the cells stored in mapped file
+        if (header.ct.is_loaded())
+        {
+            return &header;
+        }
+
+        return loaded.load(boost::memory_order_acquire);
+    }
+
+    // Publishes the loaded grid, returns the grid published by this or
+    // other thread
+    pj_gi_load const* publish(pj_gi_load const* gi) const
+    {
+        pj_gi_load const* expected = NULL;
+        if (loaded.compare_exchange_strong(expected, gi,
+                                           boost::memory_order_acq_rel,
+                                           boost::memory_order_acquire))
+        {
+            return gi;
+        }
+
+        // other thread loaded the grid first
+        delete gi;
+        return expected;
+    }
+
+    pj_gi_load header;
+    std::vector<pj_lockfree_gi const*> children;
+
+private:
+    mutable boost::atomic<pj_gi_load const*> loaded;
+};
+
+// The grids of one file. The files form the list starting from the last
+// merged file.
+class pj_lockfree_gridfile
+{
+    pj_lockfree_gridfile(pj_lockfree_gridfile const&);
+    pj_lockfree_gridfile & operator=(pj_lockfree_gridfile const&);
+
+public:
+    pj_lockfree_gridfile(std::string const& gname,
+                         pj_gridinfo const& gridinfo,
+                         pj_lockfree_gridfile const* prev)
+        : gridname(gname)
+        , first(prev != NULL ? prev->first + prev->grids.size() : 0)
+        , next(prev)
+    {
+        grids.reserve(gridinfo.size());
+        for (std::size_t i = 0 ; i < gridinfo.size() ; ++i)
+        {
+            grids.push_back(new pj_lockfree_gi(gridinfo[i]));
+        }
+    }
+
+    ~pj_lockfree_gridfile()
+    {
+        for (std::size_t i = 0 ; i < grids.size() ; ++i)
+        {
+            delete grids[i];
+        }
+    }
+
+    std::string gridname;
+    std::vector<pj_lockfree_gi const*> grids;
+    std::size_t first; // index of the first grid
+    pj_lockfree_gridfile const* next;
+};
+
+}} // namespace projections::detail
+
+
+namespace srs
+{
+
+
+/*!
+\brief Grids shared between threads accessed without locking
+\details The grids are not modified after they are added to the list and
+    the cells are published with atomic pointers when they are loaded, so
+    the transformations take no locks. If two threads load the same grid
+    at the same time the cells loaded by one of them are discarded. The
+    mutex is locked only while new grid files are added.
+*/
+class lockfree_shared_grids
+{
+    typedef projections::detail::pj_lockfree_gridfile gridfile_type;
+
+    lockfree_shared_grids(lockfree_shared_grids const&);
+    lockfree_shared_grids & operator=(lockfree_shared_grids const&);
+
+public:
+    lockfree_shared_grids()
+        : last(NULL)
+    {}
+
+    ~lockfree_shared_grids()
+    {
+        gridfile_type const* file = last.load(boost::memory_order_acquire);
+        while (file != NULL)
+        {
+            gridfile_type const* next = file->next;
+            delete file;
+            file = next;
+        }
+    }
+
+    std::size_t size() const
+    {
+        gridfile_type const* file = last.load(boost::memory_order_acquire);
+        return file != NULL ? file->first + file->grids.size() : 0;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+private:
+    template <typename StreamPolicy>
+    friend inline bool projections::detail::pj_gridlist_merge_gridfile(
+                            std::string const& gridname,
+                            StreamPolicy const& stream_policy,
+                            srs::lockfree_shared_grids & grids,
+                            std::vector<std::size_t> & gridindexes);
+    template <bool Inverse, typename CalcT, typename StreamPolicy, typename Range>
+    friend inline bool projections::detail::pj_apply_gridshift_3(
+                            StreamPolicy const& stream_policy,
+                            Range & range,
+                            srs::lockfree_shared_grids & grids,
+                            std::vector<std::size_t> const& gridindexes);
+
+    boost::atomic<gridfile_type const*> last;
+    boost::mutex mutex;
+};
+
+
+} // namespace srs
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_SRS_PROJECTIONS_LOCKFREE_SHARED_GRIDS_HPP
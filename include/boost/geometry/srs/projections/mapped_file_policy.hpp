@@ -0,0 +1,279 @@
+// Boost.Geometry
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_SRS_PROJECTIONS_MAPPED_FILE_POLICY_HPP
+#define BOOST_GEOMETRY_SRS_PROJECTIONS_MAPPED_FILE_POLICY_HPP
+
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <ios>
+#include <string>
+
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <boost/geometry/srs/projections/impl/pj_gridinfo.hpp>
+
+
+namespace boost { namespace geometry
+{
+
+namespace srs
+{
+
+
+/*!
+\brief Input stream reading the grid file mapped into memory
+\details The file is mapped in read-only mode so the pages are shared with
+    other processes mapping the same file. The grids initialized from this
+    stream refer to the cells in the mapped memory instead of copying them
+    and the pages of the file are loaded by the operating system when the
+    cells are accessed.
+*/
+class mapped_file_stream
+{
+    struct mapping
+    {
+        explicit mapping(const char * filename)
+            : file(filename, boost::interprocess::read_only)
+            , region(file, boost::interprocess::read_only)
+        {}
+
+        boost::interprocess::file_mapping file;
+        boost::interprocess::mapped_region region;
+    };
+
+public:
+    typedef boost::long_long_type offset_type;
+
+    mapped_file_stream()
+        : m_data(NULL), m_size(0), m_pos(0), m_gcount(0), m_fail(false)
+    {}
+
+    void open(std::string const& filename)
+    {
+        try
+        {
+            boost::shared_ptr<mapping> m(new mapping(filename.c_str()));
+            m_data = static_cast<const char *>(m->region.get_address());
+            m_size = m->region.get_size();
+            m_mapping = m;
+        }
+        catch (boost::interprocess::interprocess_exception const&)
+        {
+            // the file doesn't exist or is empty
+            m_data = NULL;
+            m_size = 0;
+        }
+
+        m_pos = 0;
+        m_gcount = 0;
+        m_fail = m_data == NULL;
+    }
+
+    bool is_open() const
+    {
+        return m_data != NULL;
+    }
+
+    bool fail() const
+    {
+        return m_fail;
+    }
+
+    std::streamsize gcount() const
+    {
+        return m_gcount;
+    }
+
+    offset_type tellg() const
+    {
+        return m_fail ? offset_type(-1) : offset_type(m_pos);
+    }
+
+    mapped_file_stream & read(char * s, std::streamsize count)
+    {
+        m_gcount = 0;
+        if (m_fail)
+        {
+            return *this;
+        }
+
+        std::size_t const n = (std::min)(static_cast<std::size_t>(count), m_size - m_pos);
+        std::memcpy(s, m_data + m_pos, n);
+        m_pos += n;
+        m_gcount = static_cast<std::streamsize>(n);
+        m_fail = n < static_cast<std::size_t>(count);
+        return *this;
+    }
+
+    mapped_file_stream & seekg(offset_type pos)
+    {
+        return seek(pos);
+    }
+
+    mapped_file_stream & seekg(offset_type off, std::ios_base::seekdir dir)
+    {
+        return dir == std::ios_base::beg ? seek(off)
+             : dir == std::ios_base::cur ? seek(offset_type(m_pos) + off)
+             : seek(offset_type(m_size) + off);
+    }
+
+    /*!
+    \brief Returns the pointer to the bytes of the mapped file
+    */
+    const char * data() const
+    {
+        return m_data;
+    }
+
+    /*!
+    \brief Returns the size of the mapped file
+    */
+    std::size_t size() const
+    {
+        return m_size;
+    }
+
+    /*!
+    \brief Returns the shared ownership of the mapping
+    */
+    boost::shared_ptr<void> const& mapping_ptr() const
+    {
+        return m_mapping;
+    }
+
+private:
+    mapped_file_stream & seek(offset_type pos)
+    {
+        if (! m_fail)
+        {
+            if (pos < 0 || pos > offset_type(m_size))
+            {
+                m_fail = true;
+            }
+            else
+            {
+                m_pos = static_cast<std::size_t>(pos);
+            }
+        }
+        return *this;
+    }
+
+    boost::shared_ptr<void> m_mapping;
+    const char * m_data;
+    std::size_t m_size;
+    std::size_t m_pos;
+    std::streamsize m_gcount;
+    bool m_fail;
+};
+
+
+/*!
+\brief Stream policy mapping the grid files into memory
+\details May be used with srs::grids or srs::shared_grids, e.g.
+    srs::grids_storage<srs::mapped_file_policy, srs::shared_grids>.
+    The horizontal grids in ctable, ctable2, NTv1 and NTv2 formats are
+    not loaded into memory, the cells are read from the mapped file during
+    the transformation. Vertical grids are loaded on first use.
+*/
+struct mapped_file_policy
+{
+    typedef mapped_file_stream stream_type;
+
+    static inline void open(stream_type & is, std::string const& gridname)
+    {
+        is.open(gridname);
+    }
+};
+
+
+} // namespace srs
+
+
+namespace projections { namespace detail
+{
+
+// Sets the cells of the grids read from the mapped file
+template <>
+struct pj_gridinfo_map<srs::mapped_file_stream>
+{
+    static inline void apply(srs::mapped_file_stream const& is,
+                             pj_gridinfo & gridinfo,
+                             std::size_t first)
+    {
+        for (std::size_t i = first ; i < gridinfo.size() ; ++i)
+        {
+            apply(is, gridinfo[i]);
+        }
+    }
+
+private:
+    static inline void apply(srs::mapped_file_stream const& is, pj_gi & gi)
+    {
+        pj_gi_load::offset_t offset = 0;
+        pj_ctable::cells_t::layout_t layout = pj_ctable::cells_t::native;
+        bool swap = false;
+
+        if (gi.format == pj_gi::ctable)
+        {
+            offset = pj_gridinfo_ctable_header_size();
+        }
+        else if (gi.format == pj_gi::ctable2)
+        {
+            offset = 160;
+            swap = ! is_lsb();
+        }
+        else if (gi.format == pj_gi::ntv1)
+        {
+            offset = gi.grid_offset;
+            layout = pj_ctable::cells_t::ntv1;
+            swap = is_lsb();
+        }
+        else if (gi.format == pj_gi::ntv2)
+        {
+            offset = gi.grid_offset;
+            layout = pj_ctable::cells_t::ntv2;
+            swap = gi.must_swap;
+        }
+        else
+        {
+            // vertical grids are loaded
+            offset = -1;
+        }
+
+        std::size_t const cells_count = std::size_t(gi.ct.lim.lam) * std::size_t(gi.ct.lim.phi);
+        std::size_t const cells_size = cells_count * pj_ctable::cells_t::cell_size(layout);
+        if (offset >= 0
+         && std::size_t(offset) <= is.size()
+         && cells_size <= is.size() - std::size_t(offset))
+        {
+            gi.ct.cells.data = is.data() + offset;
+            gi.ct.cells.layout = layout;
+            gi.ct.cells.swap = swap;
+            gi.ct.cells.mapping = is.mapping_ptr();
+        }
+
+        for (std::size_t i = 0 ; i < gi.children.size() ; ++i)
+        {
+            apply(is, gi.children[i]);
+        }
+    }
+};
+
+}} // namespace projections::detail
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_SRS_PROJECTIONS_MAPPED_FILE_POLICY_HPP
@@ -1,6 +1,7 @@
 // Boost.Geometry - gis-projections (based on PROJ4)
 
 // Copyright (c) 2008-2015 Barend Gehrels, Amsterdam, the Netherlands.
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
 
 // This file was modified by Oracle on 2017, 2018.
 // Modifications copyright (c) 2017-2018, Oracle and/or its affiliates.
@@ -40,6 +41,8 @@
 #ifndef BOOST_GEOMETRY_PROJECTIONS_LCC_HPP
 #define BOOST_GEOMETRY_PROJECTIONS_LCC_HPP
 
+#include <cstddef>
+
 #include <boost/geometry/util/math.hpp>
 #include <boost/math/special_functions/hypot.hpp>
 
@@ -86,17 +89,44 @@ namespace projections
 
                 // FORWARD(e_forward)  ellipsoid & spheroid
                 // Project coordinates from geographic (lon, lat) to cartesian (x, y)
-                inline void fwd(T lp_lon, T const& lp_lat, T& xy_x, T& xy_y) const
+                inline void fwd(T const& lp_lon, T const& lp_lat, T& xy_x, T& xy_y) const
                 {
-                    static const T fourth_pi = detail::fourth_pi<T>();
                     static const T half_pi = detail::half_pi<T>();
 
-                    T rho;
-
                     if (fabs(fabs(lp_lat) - half_pi) < epsilon10) {
                         if ((lp_lat * this->m_proj_parm.n) <= 0.) {
                             BOOST_THROW_EXCEPTION( projection_exception(error_tolerance_condition) );
                         }
+                    }
+                    fwd_checked(lp_lon, lp_lat, xy_x, xy_y);
+                }
+
+                // Project arrays of coordinates, the errors are checked in
+                // a separate loop so the coordinates can be vectorized
+                inline void fwd_n(T const* lp_lon, T const* lp_lat, T* xy_x, T* xy_y,
+                                  int* errors, std::size_t count) const
+                {
+                    static const T half_pi = detail::half_pi<T>();
+
+                    for (std::size_t i = 0; i < count; ++i) {
+                        errors[i] = fabs(fabs(lp_lat[i]) - half_pi) < epsilon10
+                                 && (lp_lat[i] * this->m_proj_parm.n) <= 0.
+                                  ? error_tolerance_condition : 0;
+                    }
+                    for (std::size_t i = 0; i < count; ++i) {
+                        fwd_checked(lp_lon[i], lp_lat[i], xy_x[i], xy_y[i]);
+                    }
+                }
+
+                // The forward projection of the coordinates already checked
+                inline void fwd_checked(T lp_lon, T const& lp_lat, T& xy_x, T& xy_y) const
+                {
+                    static const T fourth_pi = detail::fourth_pi<T>();
+                    static const T half_pi = detail::half_pi<T>();
+
+                    T rho;
+
+                    if (fabs(fabs(lp_lat) - half_pi) < epsilon10) {
                         rho = 0.;
                     } else {
                         rho = this->m_proj_parm.c * (this->m_proj_parm.ellips
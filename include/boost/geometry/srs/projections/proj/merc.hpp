@@ -1,6 +1,7 @@
 // Boost.Geometry - gis-projections (based on PROJ4)
 
 // Copyright (c) 2008-2015 Barend Gehrels, Amsterdam, the Netherlands.
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
 
 // This file was modified by Oracle on 2017, 2018.
 // Modifications copyright (c) 2017-2018, Oracle and/or its affiliates.
@@ -40,6 +41,8 @@
 #ifndef BOOST_GEOMETRY_PROJECTIONS_MERC_HPP
 #define BOOST_GEOMETRY_PROJECTIONS_MERC_HPP
 
+#include <cstddef>
+
 #include <boost/geometry/util/math.hpp>
 
 #include <boost/geometry/srs/projections/impl/base_static.hpp>
@@ -83,6 +86,25 @@ namespace projections
                     xy_y = - this->m_par.k0 * log(pj_tsfn(lp_lat, sin(lp_lat), this->m_par.e));
                 }
 
+                // Project arrays of coordinates, the errors are checked in
+                // a separate loop so the coordinates can be vectorized
+                inline void fwd_n(T const* lp_lon, T const* lp_lat, T* xy_x, T* xy_y,
+                                  int* errors, std::size_t count) const
+                {
+                    static const T half_pi = detail::half_pi<T>();
+
+                    T const k0 = this->m_par.k0;
+                    T const e = this->m_par.e;
+                    for (std::size_t i = 0; i < count; ++i) {
+                        errors[i] = fabs(fabs(lp_lat[i]) - half_pi) <= epsilon10
+                                  ? error_tolerance_condition : 0;
+                    }
+                    for (std::size_t i = 0; i < count; ++i) {
+                        xy_x[i] = k0 * lp_lon[i];
+                        xy_y[i] = - k0 * log(pj_tsfn(lp_lat[i], sin(lp_lat[i]), e));
+                    }
+                }
+
                 // INVERSE(e_inverse)  ellipsoid
                 // Project coordinates from cartesian (x, y) to geographic (lon, lat)
                 inline void inv(T const& xy_x, T const& xy_y, T& lp_lon, T& lp_lat) const
@@ -123,6 +145,25 @@ namespace projections
                     xy_y = this->m_par.k0 * log(tan(fourth_pi + .5 * lp_lat));
                 }
 
+                // Project arrays of coordinates, the errors are checked in
+                // a separate loop so the coordinates can be vectorized
+                inline void fwd_n(T const* lp_lon, T const* lp_lat, T* xy_x, T* xy_y,
+                                  int* errors, std::size_t count) const
+                {
+                    static const T half_pi = detail::half_pi<T>();
+                    static const T fourth_pi = detail::fourth_pi<T>();
+
+                    T const k0 = this->m_par.k0;
+                    for (std::size_t i = 0; i < count; ++i) {
+                        errors[i] = fabs(fabs(lp_lat[i]) - half_pi) <= epsilon10
+                                  ? error_tolerance_condition : 0;
+                    }
+                    for (std::size_t i = 0; i < count; ++i) {
+                        xy_x[i] = k0 * lp_lon[i];
+                        xy_y[i] = k0 * log(tan(fourth_pi + .5 * lp_lat[i]));
+                    }
+                }
+
                 // INVERSE(s_inverse)  spheroid
                 // Project coordinates from cartesian (x, y) to geographic (lon, lat)
                 inline void inv(T const& xy_x, T const& xy_y, T& lp_lon, T& lp_lat) const
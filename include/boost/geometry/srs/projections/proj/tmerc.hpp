@@ -1,6 +1,7 @@
 // Boost.Geometry - gis-projections (based on PROJ4)
 
 // Copyright (c) 2008-2015 Barend Gehrels, Amsterdam, the Netherlands.
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
 
 // This file was modified by Oracle on 2017, 2018.
 // Modifications copyright (c) 2017-2018, Oracle and/or its affiliates.
@@ -40,6 +41,8 @@
 #ifndef BOOST_GEOMETRY_PROJECTIONS_TMERC_HPP
 #define BOOST_GEOMETRY_PROJECTIONS_TMERC_HPP
 
+#include <cstddef>
+
 #include <boost/geometry/util/math.hpp>
 
 #include <boost/geometry/srs/projections/impl/base_static.hpp>
@@ -102,16 +105,6 @@ namespace projections
                 inline void fwd(T const& lp_lon, T const& lp_lat, T& xy_x, T& xy_y) const
                 {
                     static const T half_pi = detail::half_pi<T>();
-                    static const T FC1 = tmerc::FC1<T>();
-                    static const T FC2 = tmerc::FC2<T>();
-                    static const T FC3 = tmerc::FC3<T>();
-                    static const T FC4 = tmerc::FC4<T>();
-                    static const T FC5 = tmerc::FC5<T>();
-                    static const T FC6 = tmerc::FC6<T>();
-                    static const T FC7 = tmerc::FC7<T>();
-                    static const T FC8 = tmerc::FC8<T>();
-
-                    T al, als, n, cosphi, sinphi, t;
 
                     /*
                      * Fail if our longitude is more than 90 degrees from the
@@ -128,6 +121,39 @@ namespace projections
                         return;
                     }
 
+                    fwd_checked(lp_lon, lp_lat, xy_x, xy_y);
+                }
+
+                // Project arrays of coordinates, the errors are checked in
+                // a separate loop so the coordinates can be vectorized
+                inline void fwd_n(T const* lp_lon, T const* lp_lat, T* xy_x, T* xy_y,
+                                  int* errors, std::size_t count) const
+                {
+                    static const T half_pi = detail::half_pi<T>();
+
+                    for (std::size_t i = 0; i < count; ++i) {
+                        errors[i] = lp_lon[i] < -half_pi || lp_lon[i] > half_pi
+                                  ? error_lat_or_lon_exceed_limit : 0;
+                    }
+                    for (std::size_t i = 0; i < count; ++i) {
+                        fwd_checked(lp_lon[i], lp_lat[i], xy_x[i], xy_y[i]);
+                    }
+                }
+
+                // The forward projection of the coordinates already checked
+                inline void fwd_checked(T const& lp_lon, T const& lp_lat, T& xy_x, T& xy_y) const
+                {
+                    T const FC1 = tmerc::FC1<T>();
+                    T const FC2 = tmerc::FC2<T>();
+                    T const FC3 = tmerc::FC3<T>();
+                    T const FC4 = tmerc::FC4<T>();
+                    T const FC5 = tmerc::FC5<T>();
+                    T const FC6 = tmerc::FC6<T>();
+                    T const FC7 = tmerc::FC7<T>();
+                    T const FC8 = tmerc::FC8<T>();
+
+                    T al, als, n, cosphi, sinphi, t;
+
                     sinphi = sin(lp_lat);
                     cosphi = cos(lp_lat);
                     t = fabs(cosphi) > 1e-10 ? sinphi/cosphi : 0.;
@@ -11,7 +11,11 @@
 #define BOOST_GEOMETRY_SRS_TRANSFORMATION_HPP
 
 
+#include <algorithm>
+#include <cstddef>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <boost/geometry/algorithms/convert.hpp>
 
@@ -27,10 +31,13 @@
 #include <boost/geometry/srs/projections/grids.hpp>
 #include <boost/geometry/srs/projections/impl/pj_transform.hpp>
 
+#include <boost/geometry/util/parallel.hpp>
+
 #include <boost/geometry/views/detail/indexed_point_view.hpp>
 
 #include <boost/mpl/assert.hpp>
 #include <boost/mpl/if.hpp>
+#include <boost/range/iterator_range.hpp>
 #include <boost/smart_ptr/shared_ptr.hpp>
 #include <boost/throw_exception.hpp>
 #include <boost/type_traits/is_integral.hpp>
@@ -558,6 +565,480 @@ struct transform<MultiPolygon, CT, multi_polygon_tag>
 {};
 
 
+// Transforms arrays of coordinates in batches of points, the angles are
+// in degrees
+template <typename CT>
+struct transform_arrays
+{
+    template
+    <
+        typename Proj1, typename Par1,
+        typename Proj2, typename Par2,
+        typename T,
+        typename Grids
+    >
+    static inline bool apply(Proj1 const& proj1, Par1 const& par1,
+                             Proj2 const& proj2, Par2 const& par2,
+                             T const* x_in, T const* y_in,
+                             T* x_out, T* y_out, std::size_t count,
+                             Grids const& grids1, Grids const& grids2)
+    {
+        typedef geometry::model::point<CT, 2, cs::cartesian> point_type;
+
+        // NOTE: this has to be consistent with pj_transform()
+        bool const input_angles = !par1.is_geocent && par1.is_latlong;
+        bool const output_angles = !par2.is_geocent && par2.is_latlong;
+        CT const d2r = geometry::math::d2r<CT>();
+        CT const r2d = geometry::math::r2d<CT>();
+
+        point_type points[pj_batch_size];
+
+        bool res = true;
+        for (std::size_t first = 0; first < count; first += pj_batch_size)
+        {
+            std::size_t const n = (std::min)(count - first, pj_batch_size);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                CT const x = x_in[first + i];
+                CT const y = y_in[first + i];
+                geometry::set<0>(points[i], input_angles ? x * d2r : x);
+                geometry::set<1>(points[i], input_angles ? y * d2r : y);
+            }
+
+            std::pair<point_type *, point_type *> range(points, points + n);
+
+            try
+            {
+                if (! pj_transform(proj1, par1, proj2, par2, range, grids1, grids2))
+                {
+                    res = false;
+                }
+            }
+            catch (projection_exception const&)
+            {
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    set_invalid_point(points[i]);
+                }
+                res = false;
+            }
+            catch(...)
+            {
+                BOOST_RETHROW
+            }
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                CT const x = geometry::get<0>(points[i]);
+                CT const y = geometry::get<1>(points[i]);
+                bool const convert = output_angles && ! is_invalid_point(points[i]);
+                x_out[first + i] = static_cast<T>(convert ? x * r2d : x);
+                y_out[first + i] = static_cast<T>(convert ? y * r2d : y);
+            }
+        }
+
+        return res;
+    }
+};
+
+// Ranges having less points are transformed in one thread
+static const std::size_t parallel_min_points = 4 * pj_batch_size;
+
+inline std::size_t parallel_parts_count(std::size_t count, std::size_t threads)
+{
+    // more parts than threads to balance the work
+    std::size_t const max_parts = threads * 4;
+    std::size_t const parts = count / parallel_min_points;
+    return parts < 1 ? 1
+         : parts > max_parts ? max_parts
+         : parts;
+}
+
+inline bool all_succeeded(std::vector<char> const& results)
+{
+    return std::find(results.begin(), results.end(), 0) == results.end();
+}
+
+// Transforms the points of a range, the parts of the range are transformed
+// in separate threads
+template <typename CT>
+struct transform_range_parallel
+{
+    template
+    <
+        typename Proj1, typename Par1,
+        typename Proj2, typename Par2,
+        typename Range,
+        typename Grids
+    >
+    struct part_visitor
+    {
+        part_visitor(Proj1 const& proj1, Par1 const& par1,
+                     Proj2 const& proj2, Par2 const& par2,
+                     Range & range, std::size_t part_size,
+                     Grids const& grids1, Grids const& grids2,
+                     std::vector<char> & results)
+            : m_proj1(proj1), m_par1(par1)
+            , m_proj2(proj2), m_par2(par2)
+            , m_range(range), m_part_size(part_size)
+            , m_grids1(grids1), m_grids2(grids2)
+            , m_results(results)
+        {}
+
+        void operator()(std::size_t i)
+        {
+            typedef typename boost::range_iterator<Range>::type iterator;
+
+            std::size_t const count = boost::size(m_range);
+            std::size_t const first = (std::min)(i * m_part_size, count);
+            std::size_t const last = (std::min)(first + m_part_size, count);
+
+            iterator const it = boost::begin(m_range);
+            boost::iterator_range<iterator> part(it + first, it + last);
+
+            // non-transient errors are thrown and rethrown by for_each_index()
+            bool const res = pj_transform(m_proj1, m_par1, m_proj2, m_par2, part,
+                                          m_grids1, m_grids2);
+
+            m_results[i] = res ? 1 : 0;
+        }
+
+        Proj1 const& m_proj1;
+        Par1 const& m_par1;
+        Proj2 const& m_proj2;
+        Par2 const& m_par2;
+        Range & m_range;
+        std::size_t m_part_size;
+        Grids const& m_grids1;
+        Grids const& m_grids2;
+        std::vector<char> & m_results;
+    };
+
+    template
+    <
+        typename Proj1, typename Par1,
+        typename Proj2, typename Par2,
+        typename RangeIn, typename RangeOut,
+        typename Grids
+    >
+    static inline bool apply(std::size_t threads,
+                             Proj1 const& proj1, Par1 const& par1,
+                             Proj2 const& proj2, Par2 const& par2,
+                             RangeIn const& in, RangeOut & out,
+                             Grids const& grids1, Grids const& grids2)
+    {
+        typedef transform_geometry_wrapper<RangeOut, CT> wrapper_type;
+        typedef typename wrapper_type::type range_type;
+
+        // NOTE: this has to be consistent with pj_transform()
+        bool const input_angles = !par1.is_geocent && par1.is_latlong;
+
+        wrapper_type wrapper(in, out, input_angles);
+        range_type & range = wrapper.get();
+
+        std::size_t const count = boost::size(range);
+        std::size_t const parts = parallel_parts_count(count, threads);
+        std::size_t const part_size = (count + parts - 1) / parts;
+
+        std::vector<char> results(parts, 1);
+        part_visitor
+            <
+                Proj1, Par1, Proj2, Par2, range_type, Grids
+            > visitor(proj1, par1, proj2, par2, range, part_size,
+                      grids1, grids2, results);
+
+        geometry::detail::parallel::for_each_index(parts, visitor, threads);
+
+        wrapper.finish();
+
+        return all_succeeded(results);
+    }
+};
+
+// Transforms the members of a multi-geometry or interior rings in separate
+// threads, if there are less members than threads the points of each member
+// are transformed in parallel
+template <typename ParallelPolicy>
+struct transform_multi_parallel
+{
+    template
+    <
+        typename Proj1, typename Par1,
+        typename Proj2, typename Par2,
+        typename MultiIn, typename MultiOut,
+        typename Grids
+    >
+    struct member_visitor
+    {
+        member_visitor(Proj1 const& proj1, Par1 const& par1,
+                       Proj2 const& proj2, Par2 const& par2,
+                       MultiIn const& in, MultiOut & out,
+                       Grids const& grids1, Grids const& grids2,
+                       std::vector<char> & results)
+            : m_proj1(proj1), m_par1(par1)
+            , m_proj2(proj2), m_par2(par2)
+            , m_in(in), m_out(out)
+            , m_grids1(grids1), m_grids2(grids2)
+            , m_results(results)
+        {}
+
+        void operator()(std::size_t i)
+        {
+            // transformed in this thread, the errors are thrown the same way
+            // as if the member was transformed in parallel
+            bool const res = ParallelPolicy::apply(1, m_proj1, m_par1, m_proj2, m_par2,
+                                                   range::at(m_in, i), range::at(m_out, i),
+                                                   m_grids1, m_grids2);
+            m_results[i] = res ? 1 : 0;
+        }
+
+        Proj1 const& m_proj1;
+        Par1 const& m_par1;
+        Proj2 const& m_proj2;
+        Par2 const& m_par2;
+        MultiIn const& m_in;
+        MultiOut & m_out;
+        Grids const& m_grids1;
+        Grids const& m_grids2;
+        std::vector<char> & m_results;
+    };
+
+    template
+    <
+        typename Proj1, typename Par1,
+        typename Proj2, typename Par2,
+        typename MultiIn, typename MultiOut,
+        typename Grids
+    >
+    static inline bool apply(std::size_t threads,
+                             Proj1 const& proj1, Par1 const& par1,
+                             Proj2 const& proj2, Par2 const& par2,
+                             MultiIn const& in, MultiOut & out,
+                             Grids const& grids1, Grids const& grids2)
+    {
+        if (! same_object(in, out))
+            range::resize(out, boost::size(in));
+
+        std::size_t const count = boost::size(in);
+
+        if (count < threads)
+        {
+            bool res = true;
+            for (std::size_t i = 0 ; i < count ; ++i)
+            {
+                if (! ParallelPolicy::apply(threads, proj1, par1, proj2, par2,
+                                            range::at(in, i), range::at(out, i),
+                                            grids1, grids2))
+                {
+                    res = false;
+                }
+            }
+            return res;
+        }
+
+        std::vector<char> results(count, 1);
+        member_visitor
+            <
+                Proj1, Par1, Proj2, Par2, MultiIn, MultiOut, Grids
+            > visitor(proj1, par1, proj2, par2, in, out,
+                      grids1, grids2, results);
+
+        geometry::detail::parallel::for_each_index(count, visitor, threads);
+
+        return all_succeeded(results);
+    }
+};
+
+// Geometries containing few points are transformed in the calling thread
+template
+<
+    typename Geometry,
+    typename CT,
+    typename Tag = typename geometry::tag<Geometry>::type
+>
+struct transform_parallel
+{
+    template
+    <
+        typename Proj1, typename Par1,
+        typename Proj2, typename Par2,
+        typename GeometryIn, typename GeometryOut,
+        typename Grids
+    >
+    static inline bool apply(std::size_t ,
+                             Proj1 const& proj1, Par1 const& par1,
+                             Proj2 const& proj2, Par2 const& par2,
+                             GeometryIn const& in, GeometryOut & out,
+                             Grids const& grids1, Grids const& grids2)
+    {
+        return transform<Geometry, CT>::apply(proj1, par1, proj2, par2,
+                                              in, out, grids1, grids2);
+    }
+};
+
+template <typename MultiPoint, typename CT>
+struct transform_parallel<MultiPoint, CT, multi_point_tag>
+    : transform_range_parallel<CT>
+{};
+
+template <typename Linestring, typename CT>
+struct transform_parallel<Linestring, CT, linestring_tag>
+    : transform_range_parallel<CT>
+{};
+
+template <typename Ring, typename CT>
+struct transform_parallel<Ring, CT, ring_tag>
+    : transform_range_parallel<CT>
+{};
+
+template <typename MultiLinestring, typename CT>
+struct transform_parallel<MultiLinestring, CT, multi_linestring_tag>
+    : transform_multi_parallel
+        <
+            transform_range_parallel<CT>
+        >
+{};
+
+template <typename Polygon, typename CT>
+struct transform_parallel<Polygon, CT, polygon_tag>
+{
+    template
+    <
+        typename Proj1, typename Par1,
+        typename Proj2, typename Par2,
+        typename PolygonIn, typename PolygonOut,
+        typename Grids
+    >
+    static inline bool apply(std::size_t threads,
+                             Proj1 const& proj1, Par1 const& par1,
+                             Proj2 const& proj2, Par2 const& par2,
+                             PolygonIn const& in, PolygonOut & out,
+                             Grids const& grids1, Grids const& grids2)
+    {
+        bool r1 = transform_range_parallel
+                    <
+                        CT
+                    >::apply(threads, proj1, par1, proj2, par2,
+                             geometry::exterior_ring(in),
+                             geometry::exterior_ring(out),
+                             grids1, grids2);
+        bool r2 = transform_multi_parallel
+                    <
+                        transform_range_parallel<CT>
+                    >::apply(threads, proj1, par1, proj2, par2,
+                             geometry::interior_rings(in),
+                             geometry::interior_rings(out),
+                             grids1, grids2);
+        return r1 && r2;
+    }
+};
+
+template <typename MultiPolygon, typename CT>
+struct transform_parallel<MultiPolygon, CT, multi_polygon_tag>
+    : transform_multi_parallel
+        <
+            transform_parallel
+                <
+                    typename boost::range_value<MultiPolygon>::type,
+                    CT,
+                    polygon_tag
+                >
+        >
+{};
+
+// Transforms the arrays of coordinates, parts of the arrays consisting of
+// whole batches are transformed in separate threads
+template <typename CT>
+struct transform_arrays_parallel
+{
+    template
+    <
+        typename Proj1, typename Par1,
+        typename Proj2, typename Par2,
+        typename T,
+        typename Grids
+    >
+    struct part_visitor
+    {
+        part_visitor(Proj1 const& proj1, Par1 const& par1,
+                     Proj2 const& proj2, Par2 const& par2,
+                     T const* x_in, T const* y_in,
+                     T* x_out, T* y_out,
+                     std::size_t count, std::size_t part_size,
+                     Grids const& grids1, Grids const& grids2,
+                     std::vector<char> & results)
+            : m_proj1(proj1), m_par1(par1)
+            , m_proj2(proj2), m_par2(par2)
+            , m_x_in(x_in), m_y_in(y_in)
+            , m_x_out(x_out), m_y_out(y_out)
+            , m_count(count), m_part_size(part_size)
+            , m_grids1(grids1), m_grids2(grids2)
+            , m_results(results)
+        {}
+
+        void operator()(std::size_t i)
+        {
+            std::size_t const first = (std::min)(i * m_part_size, m_count);
+            std::size_t const n = (std::min)(m_part_size, m_count - first);
+
+            bool const res = transform_arrays
+                <
+                    CT
+                >::apply(m_proj1, m_par1, m_proj2, m_par2,
+                         m_x_in + first, m_y_in + first,
+                         m_x_out + first, m_y_out + first, n,
+                         m_grids1, m_grids2);
+
+            m_results[i] = res ? 1 : 0;
+        }
+
+        Proj1 const& m_proj1;
+        Par1 const& m_par1;
+        Proj2 const& m_proj2;
+        Par2 const& m_par2;
+        T const* m_x_in;
+        T const* m_y_in;
+        T* m_x_out;
+        T* m_y_out;
+        std::size_t m_count;
+        std::size_t m_part_size;
+        Grids const& m_grids1;
+        Grids const& m_grids2;
+        std::vector<char> & m_results;
+    };
+
+    template
+    <
+        typename Proj1, typename Par1,
+        typename Proj2, typename Par2,
+        typename T,
+        typename Grids
+    >
+    static inline bool apply(std::size_t threads,
+                             Proj1 const& proj1, Par1 const& par1,
+                             Proj2 const& proj2, Par2 const& par2,
+                             T const* x_in, T const* y_in,
+                             T* x_out, T* y_out, std::size_t count,
+                             Grids const& grids1, Grids const& grids2)
+    {
+        std::size_t const parts = parallel_parts_count(count, threads);
+        std::size_t const batches = (count + pj_batch_size - 1) / pj_batch_size;
+        std::size_t const part_size = (batches + parts - 1) / parts * pj_batch_size;
+
+        std::vector<char> results(parts, 1);
+        part_visitor
+            <
+                Proj1, Par1, Proj2, Par2, T, Grids
+            > visitor(proj1, par1, proj2, par2,
+                      x_in, y_in, x_out, y_out, count, part_size,
+                      grids1, grids2, results);
+
+        geometry::detail::parallel::for_each_index(parts, visitor, threads);
+
+        return all_succeeded(results);
+    }
+};
+
 }} // namespace projections::detail
     
 namespace srs
@@ -701,6 +1182,201 @@ public:
                          grids.src_grids);
     }
 
+    /*!
+    \brief Transforms arrays of coordinates
+    \details The points are transformed in batches, with the kernels of the
+        projections called once per batch. Geographic coordinates are in
+        degrees. The points which could not be transformed are set to
+        HUGE_VAL. The output arrays may be the same as the input arrays.
+    \return true if all of the points were transformed
+    */
+    template <typename T>
+    bool forward(T const* x_in, T const* y_in, T* x_out, T* y_out,
+                 std::size_t count) const
+    {
+        return forward(x_in, y_in, x_out, y_out, count,
+                       transformation_grids<detail::empty_grids_storage>());
+    }
+
+    template <typename T>
+    bool inverse(T const* x_in, T const* y_in, T* x_out, T* y_out,
+                 std::size_t count) const
+    {
+        return inverse(x_in, y_in, x_out, y_out, count,
+                       transformation_grids<detail::empty_grids_storage>());
+    }
+
+    template <typename T, typename GridsStorage>
+    bool forward(T const* x_in, T const* y_in, T* x_out, T* y_out,
+                 std::size_t count,
+                 transformation_grids<GridsStorage> const& grids) const
+    {
+        return projections::detail::transform_arrays
+                <
+                    calc_t
+                >::apply(m_proj1.proj(), m_proj1.proj().params(),
+                         m_proj2.proj(), m_proj2.proj().params(),
+                         x_in, y_in, x_out, y_out, count,
+                         grids.src_grids,
+                         grids.dst_grids);
+    }
+
+    template <typename T, typename GridsStorage>
+    bool inverse(T const* x_in, T const* y_in, T* x_out, T* y_out,
+                 std::size_t count,
+                 transformation_grids<GridsStorage> const& grids) const
+    {
+        return projections::detail::transform_arrays
+                <
+                    calc_t
+                >::apply(m_proj2.proj(), m_proj2.proj().params(),
+                         m_proj1.proj(), m_proj1.proj().params(),
+                         x_in, y_in, x_out, y_out, count,
+                         grids.dst_grids,
+                         grids.src_grids);
+    }
+
+    /*!
+    \brief Transforms a geometry in parallel
+    \details The members of multi-geometries and interior rings are
+        transformed in separate threads. If there are less of them than
+        threads the points of the ranges are split into parts transformed
+        in separate threads. The projections are shared by the threads.
+        If the grids are used they have to be stored in srs::shared_grids.
+        The points which can't be transformed are invalidated and false is
+        returned. Other errors of the ranges of points are not ignored,
+        the first exception thrown by any thread is rethrown.
+    */
+    template <typename GeometryIn, typename GeometryOut>
+    bool forward(geometry::execution::parallel_policy const& policy,
+                 GeometryIn const& in, GeometryOut & out) const
+    {
+        return forward(policy, in, out,
+                       transformation_grids<detail::empty_grids_storage>());
+    }
+
+    template <typename GeometryIn, typename GeometryOut>
+    bool inverse(geometry::execution::parallel_policy const& policy,
+                 GeometryIn const& in, GeometryOut & out) const
+    {
+        return inverse(policy, in, out,
+                       transformation_grids<detail::empty_grids_storage>());
+    }
+
+    template <typename GeometryIn, typename GeometryOut, typename GridsStorage>
+    bool forward(geometry::execution::parallel_policy const& policy,
+                 GeometryIn const& in, GeometryOut & out,
+                 transformation_grids<GridsStorage> const& grids) const
+    {
+        BOOST_MPL_ASSERT_MSG((projections::detail::same_tags<GeometryIn, GeometryOut>::value),
+                             NOT_SUPPORTED_COMBINATION_OF_GEOMETRIES,
+                             (GeometryIn, GeometryOut));
+        BOOST_MPL_ASSERT_MSG((detail::is_thread_safe_grids_storage<GridsStorage>::value),
+                             SHARED_GRIDS_REQUIRED_IN_PARALLEL_TRANSFORMATION,
+                             (GridsStorage));
+
+        return projections::detail::transform_parallel
+                <
+                    GeometryOut,
+                    calc_t
+                >::apply(policy.threads(),
+                         m_proj1.proj(), m_proj1.proj().params(),
+                         m_proj2.proj(), m_proj2.proj().params(),
+                         in, out,
+                         grids.src_grids,
+                         grids.dst_grids);
+    }
+
+    template <typename GeometryIn, typename GeometryOut, typename GridsStorage>
+    bool inverse(geometry::execution::parallel_policy const& policy,
+                 GeometryIn const& in, GeometryOut & out,
+                 transformation_grids<GridsStorage> const& grids) const
+    {
+        BOOST_MPL_ASSERT_MSG((projections::detail::same_tags<GeometryIn, GeometryOut>::value),
+                             NOT_SUPPORTED_COMBINATION_OF_GEOMETRIES,
+                             (GeometryIn, GeometryOut));
+        BOOST_MPL_ASSERT_MSG((detail::is_thread_safe_grids_storage<GridsStorage>::value),
+                             SHARED_GRIDS_REQUIRED_IN_PARALLEL_TRANSFORMATION,
+                             (GridsStorage));
+
+        return projections::detail::transform_parallel
+                <
+                    GeometryOut,
+                    calc_t
+                >::apply(policy.threads(),
+                         m_proj2.proj(), m_proj2.proj().params(),
+                         m_proj1.proj(), m_proj1.proj().params(),
+                         in, out,
+                         grids.dst_grids,
+                         grids.src_grids);
+    }
+
+    /*!
+    \brief Transforms arrays of coordinates in parallel
+    \details The arrays are split into parts consisting of whole batches
+        transformed in separate threads. If the grids are used they have
+        to be stored in srs::shared_grids.
+    */
+    template <typename T>
+    bool forward(geometry::execution::parallel_policy const& policy,
+                 T const* x_in, T const* y_in, T* x_out, T* y_out,
+                 std::size_t count) const
+    {
+        return forward(policy, x_in, y_in, x_out, y_out, count,
+                       transformation_grids<detail::empty_grids_storage>());
+    }
+
+    template <typename T>
+    bool inverse(geometry::execution::parallel_policy const& policy,
+                 T const* x_in, T const* y_in, T* x_out, T* y_out,
+                 std::size_t count) const
+    {
+        return inverse(policy, x_in, y_in, x_out, y_out, count,
+                       transformation_grids<detail::empty_grids_storage>());
+    }
+
+    template <typename T, typename GridsStorage>
+    bool forward(geometry::execution::parallel_policy const& policy,
+                 T const* x_in, T const* y_in, T* x_out, T* y_out,
+                 std::size_t count,
+                 transformation_grids<GridsStorage> const& grids) const
+    {
+        BOOST_MPL_ASSERT_MSG((detail::is_thread_safe_grids_storage<GridsStorage>::value),
+                             SHARED_GRIDS_REQUIRED_IN_PARALLEL_TRANSFORMATION,
+                             (GridsStorage));
+
+        return projections::detail::transform_arrays_parallel
+                <
+                    calc_t
+                >::apply(policy.threads(),
+                         m_proj1.proj(), m_proj1.proj().params(),
+                         m_proj2.proj(), m_proj2.proj().params(),
+                         x_in, y_in, x_out, y_out, count,
+                         grids.src_grids,
+                         grids.dst_grids);
+    }
+
+    template <typename T, typename GridsStorage>
+    bool inverse(geometry::execution::parallel_policy const& policy,
+                 T const* x_in, T const* y_in, T* x_out, T* y_out,
+                 std::size_t count,
+                 transformation_grids<GridsStorage> const& grids) const
+    {
+        BOOST_MPL_ASSERT_MSG((detail::is_thread_safe_grids_storage<GridsStorage>::value),
+                             SHARED_GRIDS_REQUIRED_IN_PARALLEL_TRANSFORMATION,
+                             (GridsStorage));
+
+        return projections::detail::transform_arrays_parallel
+                <
+                    calc_t
+                >::apply(policy.threads(),
+                         m_proj2.proj(), m_proj2.proj().params(),
+                         m_proj1.proj(), m_proj1.proj().params(),
+                         x_in, y_in, x_out, y_out, count,
+                         grids.dst_grids,
+                         grids.src_grids);
+    }
+
     template <typename GridsStorage>
     inline transformation_grids<GridsStorage> initialize_grids(GridsStorage & grids_storage) const
     {
@@ -0,0 +1,296 @@
+// Boost.Geometry
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_UTIL_PARALLEL_HPP
+#define BOOST_GEOMETRY_UTIL_PARALLEL_HPP
+
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/config.hpp>
+#include <boost/core/ignore_unused.hpp>
+
+
+// Parallel execution requires C++11 threading support. If it's not available
+// or if BOOST_GEOMETRY_NO_PARALLEL is defined by the user the algorithms
+// taking parallel_policy are executed sequentially in the calling thread.
+#if ! defined(BOOST_GEOMETRY_NO_PARALLEL) \
+ && ( defined(BOOST_NO_CXX11_HDR_THREAD) \
+   || defined(BOOST_NO_CXX11_HDR_MUTEX) \
+   || defined(BOOST_NO_CXX11_HDR_ATOMIC) \
+   || defined(BOOST_NO_CXX11_HDR_FUNCTIONAL) )
+#define BOOST_GEOMETRY_NO_PARALLEL
+#endif
+
+#ifndef BOOST_GEOMETRY_NO_PARALLEL
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#endif
+
+
+namespace boost { namespace geometry
+{
+
+
+#ifndef DOXYGEN_NO_DETAIL
+namespace detail { namespace parallel
+{
+
+
+inline std::size_t threads_count(std::size_t requested)
+{
+#ifndef BOOST_GEOMETRY_NO_PARALLEL
+    if (requested == 0)
+    {
+        requested = std::thread::hardware_concurrency();
+    }
+    return requested > 0 ? requested : 1;
+#else
+    boost::ignore_unused(requested);
+    return 1;
+#endif
+}
+
+
+#ifndef BOOST_GEOMETRY_NO_PARALLEL
+
+// Stores the first exception thrown in any of the threads
+class exception_holder
+{
+public:
+    exception_holder()
+        : m_failed(false)
+    {}
+
+    void capture()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (! m_exception)
+        {
+            m_exception = std::current_exception();
+        }
+        m_failed = true;
+    }
+
+    bool failed() const
+    {
+        return m_failed;
+    }
+
+    void rethrow() const
+    {
+        if (m_exception)
+        {
+            std::rethrow_exception(m_exception);
+        }
+    }
+
+private:
+    std::mutex m_mutex;
+    std::exception_ptr m_exception;
+    std::atomic<bool> m_failed;
+};
+
+template <typename Function>
+struct invoke_worker
+{
+    invoke_worker(Function & f, exception_holder & eh)
+        : function(f), exceptions(eh)
+    {}
+
+    void operator()()
+    {
+        try
+        {
+            function();
+        }
+        catch(...)
+        {
+            exceptions.capture();
+        }
+    }
+
+    Function & function;
+    exception_holder & exceptions;
+};
+
+template <typename Function>
+struct for_each_index_worker
+{
+    for_each_index_worker(Function & f, std::size_t c, exception_holder & eh)
+        : function(f), count(c), next(0), exceptions(eh)
+    {}
+
+    void operator()()
+    {
+        try
+        {
+            while (! exceptions.failed())
+            {
+                std::size_t const i = next++;
+                if (i >= count)
+                {
+                    return;
+                }
+                function(i);
+            }
+        }
+        catch(...)
+        {
+            exceptions.capture();
+        }
+    }
+
+    Function & function;
+    std::size_t const count;
+    std::atomic<std::size_t> next;
+    exception_holder & exceptions;
+};
+
+#endif // BOOST_GEOMETRY_NO_PARALLEL
+
+
+// Calls f1() and f2(). If parallel is true f1() is called in a separate
+// thread concurrently to f2(). The function returns when both calls are
+// finished. The first exception thrown by any of them is rethrown.
+template <typename Function1, typename Function2>
+inline void invoke(Function1 & f1, Function2 & f2, bool parallel)
+{
+#ifndef BOOST_GEOMETRY_NO_PARALLEL
+    if (parallel)
+    {
+        exception_holder exceptions;
+        invoke_worker<Function1> worker(f1, exceptions);
+
+        std::thread thread;
+        try
+        {
+            thread = std::thread(std::ref(worker));
+        }
+        catch(std::system_error const&)
+        {
+            // thread could not be created, fall back to sequential execution
+            f1();
+            f2();
+            return;
+        }
+
+        invoke_worker<Function2> current(f2, exceptions);
+        current();
+
+        thread.join();
+        exceptions.rethrow();
+        return;
+    }
+#else
+    boost::ignore_unused(parallel);
+#endif
+
+    f1();
+    f2();
+}
+
+// Calls f(i) for each i in [0, count) using up to threads threads.
+// Indexes are distributed dynamically so the calls may have various
+// execution times. After the first exception is thrown the remaining
+// indexes are not processed and the exception is rethrown.
+template <typename Function>
+inline void for_each_index(std::size_t count, Function & f, std::size_t threads)
+{
+#ifndef BOOST_GEOMETRY_NO_PARALLEL
+    if (threads > count)
+    {
+        threads = count;
+    }
+
+    if (threads > 1)
+    {
+        exception_holder exceptions;
+        for_each_index_worker<Function> worker(f, count, exceptions);
+
+        std::vector<std::thread> workers;
+        workers.reserve(threads - 1);
+        for (std::size_t i = 1 ; i < threads ; ++i)
+        {
+            try
+            {
+                workers.push_back(std::thread(std::ref(worker)));
+            }
+            catch(std::system_error const&)
+            {
+                // use the threads created so far
+                break;
+            }
+        }
+
+        worker();
+
+        for (std::size_t i = 0 ; i < workers.size() ; ++i)
+        {
+            workers[i].join();
+        }
+
+        exceptions.rethrow();
+        return;
+    }
+#else
+    boost::ignore_unused(threads);
+#endif
+
+    for (std::size_t i = 0 ; i < count ; ++i)
+    {
+        f(i);
+    }
+}
+
+
+}} // namespace detail::parallel
+#endif // DOXYGEN_NO_DETAIL
+
+
+namespace execution
+{
+
+/*!
+\brief Policy requesting parallel execution of an algorithm.
+\details The number of threads is a hint. If it's equal to 0 the number of
+    hardware threads is used. If parallel execution is not supported
+    (C++11 threads are not available or BOOST_GEOMETRY_NO_PARALLEL is defined)
+    the algorithm is executed sequentially.
+*/
+class parallel_policy
+{
+public:
+    explicit parallel_policy(std::size_t threads = 0)
+        : m_threads(threads)
+    {}
+
+    /*!
+    \brief Returns the number of threads which should be used.
+    */
+    std::size_t threads() const
+    {
+        return geometry::detail::parallel::threads_count(m_threads);
+    }
+
+private:
+    std::size_t m_threads;
+};
+
+} // namespace execution
+
+
+}} // namespace boost::geometry
+
+
+#endif // BOOST_GEOMETRY_UTIL_PARALLEL_HPP
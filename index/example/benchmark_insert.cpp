@@ -1,7 +1,7 @@
 // Boost.Geometry Index
 // Additional tests
 
-// Copyright (c) 2011-2015 Adam Wulkiewicz, Lodz, Poland.
+// Copyright (c) 2011-2018 Adam Wulkiewicz, Lodz, Poland.
 
 // Use, modification and distribution is subject to the Boost Software License,
 // Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
@@ -77,38 +77,131 @@ void test_queries(RT const& t, std::vector< std::pair<float, float> > const& coo
     std::cout << time.count() << " " << temp << '\n';
 }
 
-//#define BOOST_GEOMETRY_INDEX_BENCHMARK_DEBUG
-
-int main()
+template <typename Params>
+void test_inserts(const char* name,
+                  std::vector<V> const& values,
+                  std::vector< std::pair<float, float> > const& coords,
+                  size_t queries_count,
+                  size_t max_range_inserts)
 {
-    //typedef bgi::rtree<V, bgi::linear<4, 2> > RT;
-    //typedef bgi::rtree<V, bgi::linear<16, 4> > RT;
-    //typedef bgi::rtree<V, bgi::quadratic<4, 2> > RT;
-    typedef bgi::rtree<V, bgi::rstar<8, 2> > RT;
+    typedef bgi::rtree<V, Params> RT;
 
     typedef boost::chrono::thread_clock clock_t;
     typedef boost::chrono::duration<float> dur_t;
 
+    size_t values_count = values.size();
+
+    std::cout << name << '\n';
+
+    // packing test
+    {
+        clock_t::time_point start = clock_t::now();
+
+        RT t(values.begin(), values.end());
+
+        BOOST_ASSERT(bgi::detail::rtree::utilities::are_boxes_ok(t));
+        BOOST_ASSERT(bgi::detail::rtree::utilities::are_counts_ok(t));
+        BOOST_ASSERT(bgi::detail::rtree::utilities::are_levels_ok(t));
+
+        dur_t time = clock_t::now() - start;
+        std::cout << "pack(" << values_count << ") - " << time.count() << ", ";
+
+        test_queries(t, coords, queries_count);
+    }
+
+    // Hilbert packing test
+    {
+        clock_t::time_point start = clock_t::now();
+
+        RT t(bgi::hilbert_packing(), values.begin(), values.end());
+
+        BOOST_ASSERT(bgi::detail::rtree::utilities::are_boxes_ok(t));
+        BOOST_ASSERT(bgi::detail::rtree::utilities::are_counts_ok(t));
+        BOOST_ASSERT(bgi::detail::rtree::utilities::are_levels_ok(t));
+
+        dur_t time = clock_t::now() - start;
+        std::cout << "pack_hilbert(" << values_count << ") - " << time.count() << ", ";
+
+        test_queries(t, coords, queries_count);
+    }
+
+    {
+        size_t n_per_max = values_count / max_range_inserts;
+
+        for ( size_t j = 0 ; j < max_range_inserts ; ++j )
+        {
+            clock_t::time_point start = clock_t::now();
+
+            RT t;
+
+            // perform j range-inserts
+            for ( size_t i = 0 ; i < j ; ++i )
+            {
+                t.insert(values.begin() + n_per_max * i,
+                         values.begin() + (std::min)(n_per_max * (i + 1), values_count));
+            }
+
+            if ( !t.empty() )
+            {
+                BOOST_ASSERT(bgi::detail::rtree::utilities::are_boxes_ok(t));
+                BOOST_ASSERT(bgi::detail::rtree::utilities::are_counts_ok(t));
+                BOOST_ASSERT(bgi::detail::rtree::utilities::are_levels_ok(t));
+            }
+
+            // perform n-n/max_inserts*j inserts
+            size_t inserted_count = (std::min)(n_per_max*j, values_count);
+            for ( size_t i = inserted_count ; i < values_count ; ++i )
+            {
+                t.insert(values[i]);
+            }
+
+            if ( !t.empty() )
+            {
+                BOOST_ASSERT(bgi::detail::rtree::utilities::are_boxes_ok(t));
+                BOOST_ASSERT(bgi::detail::rtree::utilities::are_counts_ok(t));
+                BOOST_ASSERT(bgi::detail::rtree::utilities::are_levels_ok(t));
+            }
+
+            dur_t time = clock_t::now() - start;
+            std::cout << j << "*insert(N/" << max_range_inserts << ")+insert(" << (values_count - inserted_count) << ") - " << time.count() << ", ";
+
+            test_queries(t, coords, queries_count);
+        }
+    }
+}
+
+void test_all(std::vector<V> const& values,
+              std::vector< std::pair<float, float> > const& coords,
+              size_t queries_count,
+              size_t max_range_inserts)
+{
+    test_inserts< bgi::linear<16, 4> >(" linear<16, 4>", values, coords, queries_count, max_range_inserts);
+    test_inserts< bgi::quadratic<16, 4> >(" quadratic<16, 4>", values, coords, queries_count, max_range_inserts);
+    test_inserts< bgi::rstar<16, 4> >(" rstar<16, 4>", values, coords, queries_count, max_range_inserts);
+    test_inserts< bgi::kmeans<16, 4> >(" kmeans<16, 4>", values, coords, queries_count, max_range_inserts);
+}
+
+//#define BOOST_GEOMETRY_INDEX_BENCHMARK_DEBUG
+
+int main()
+{
 #ifndef BOOST_GEOMETRY_INDEX_BENCHMARK_DEBUG
     size_t values_count = 1000000;
     size_t queries_count = 100000;
-    size_t nearest_queries_count = 20000;
-    unsigned neighbours_count = 10;
     size_t max_range_inserts = 10;
 #else
     size_t values_count = 10000;
     size_t queries_count = 1000;
-    size_t nearest_queries_count = 100;
-    unsigned neighbours_count = 10;
     size_t max_range_inserts = 10;
 #endif
 
     float max_val = static_cast<float>(values_count / 2);
-    std::vector< std::pair<float, float> > coords;
-    std::vector<V> values;
 
-    //randomize values
+    //randomize uniformly distributed values
     {
+        std::vector< std::pair<float, float> > coords;
+        std::vector<V> values;
+
         boost::mt19937 rng;
         //rng.seed(static_cast<unsigned int>(std::time(0)));
         boost::uniform_real<float> range(-max_val, max_val);
@@ -116,7 +209,7 @@ int main()
 
         coords.reserve(values_count);
 
-        std::cout << "randomizing data\n";
+        std::cout << "randomizing uniform data\n";
         for ( size_t i = 0 ; i < values_count ; ++i )
         {
             float x = rnd();
@@ -125,71 +218,50 @@ int main()
             values.push_back(generate_value<V>::apply(x, y));
         }
         std::cout << "randomized\n";
+
+        test_all(values, coords, queries_count, max_range_inserts);
     }
 
-    for (;;)
+    //randomize clustered values, e.g. like GPS positions gathered in cities
     {
-        // packing test
-        {
-            clock_t::time_point start = clock_t::now();
+        std::vector< std::pair<float, float> > coords;
+        std::vector<V> values;
 
-            RT t(values.begin(), values.end());
+        size_t clusters_count = 100;
+        size_t per_cluster = values_count / clusters_count;
 
-            BOOST_ASSERT(bgi::detail::rtree::utilities::are_boxes_ok(t));
-            BOOST_ASSERT(bgi::detail::rtree::utilities::are_counts_ok(t));
-            BOOST_ASSERT(bgi::detail::rtree::utilities::are_levels_ok(t));
-
-            dur_t time = clock_t::now() - start;
-            std::cout << "pack(" << values_count << ") - " << time.count() << ", ";
+        boost::mt19937 rng;
+        boost::uniform_real<float> range(-max_val, max_val);
+        boost::variate_generator<boost::mt19937&, boost::uniform_real<float> > rnd(rng, range);
+        boost::normal_distribution<float> spread(0, max_val / 100);
+        boost::variate_generator<boost::mt19937&, boost::normal_distribution<float> > rnd_spread(rng, spread);
 
-            test_queries(t, coords, queries_count);
-        }
+        coords.reserve(values_count);
 
+        std::cout << "randomizing clustered data\n";
+        for ( size_t c = 0 ; c < clusters_count ; ++c )
         {
-            size_t n_per_max = values_count / max_range_inserts;
-
-            for ( size_t j = 0 ; j < max_range_inserts ; ++j )
+            float cx = rnd();
+            float cy = rnd();
+            for ( size_t i = 0 ; i < per_cluster ; ++i )
             {
-                clock_t::time_point start = clock_t::now();
-
-                RT t;
-
-                // perform j range-inserts
-                for ( size_t i = 0 ; i < j ; ++i )
-                {
-                    t.insert(values.begin() + n_per_max * i,
-                             values.begin() + (std::min)(n_per_max * (i + 1), values_count));
-                }
-
-                if ( !t.empty() )
-                {
-                    BOOST_ASSERT(bgi::detail::rtree::utilities::are_boxes_ok(t));
-                    BOOST_ASSERT(bgi::detail::rtree::utilities::are_counts_ok(t));
-                    BOOST_ASSERT(bgi::detail::rtree::utilities::are_levels_ok(t));
-                }
-
-                // perform n-n/max_inserts*j inserts
-                size_t inserted_count = (std::min)(n_per_max*j, values_count);
-                for ( size_t i = inserted_count ; i < values_count ; ++i )
-                {
-                    t.insert(values[i]);
-                }
-
-                if ( !t.empty() )
-                {
-                    BOOST_ASSERT(bgi::detail::rtree::utilities::are_boxes_ok(t));
-                    BOOST_ASSERT(bgi::detail::rtree::utilities::are_counts_ok(t));
-                    BOOST_ASSERT(bgi::detail::rtree::utilities::are_levels_ok(t));
-                }
-
-                dur_t time = clock_t::now() - start;
-                std::cout << j << "*insert(N/" << max_range_inserts << ")+insert(" << (values_count - inserted_count) << ") - " << time.count() << ", ";
-
-                test_queries(t, coords, queries_count);
+                float x = cx + rnd_spread();
+                float y = cy + rnd_spread();
+                coords.push_back(std::make_pair(x, y));
             }
         }
+        // the values are inserted in random order, shuffled with the same
+        // generator, std::random_shuffle() is not available since C++17
+        for ( size_t i = coords.size() ; i > 1 ; --i )
+        {
+            boost::uniform_int<size_t> index(0, i - 1);
+            std::swap(coords[i - 1], coords[index(rng)]);
+        }
+        for ( size_t i = 0 ; i < coords.size() ; ++i )
+            values.push_back(generate_value<V>::apply(coords[i].first, coords[i].second));
+        std::cout << "randomized\n";
 
-        std::cout << "------------------------------------------------\n";
+        test_all(values, coords, queries_count, max_range_inserts);
     }
 
     return 0;
@@ -0,0 +1,125 @@
+// Boost.Geometry Index
+// Additional tests
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// Compares spatial queries performed on the rtree using the default nodes
+// and the nodes storing the bounds in the SoA layout. Compile with the
+// instruction sets enabled (e.g. -mavx2 or -mavx512f) to use the vectorized
+// kernels or with BOOST_GEOMETRY_INDEX_NO_SIMD to use the scalar ones.
+
+#include <iostream>
+#include <vector>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
+#include <boost/chrono.hpp>
+#include <boost/random.hpp>
+
+namespace bg = boost::geometry;
+namespace bgi = bg::index;
+
+typedef boost::chrono::thread_clock clock_type;
+typedef boost::chrono::duration<float> dur_t;
+
+template <typename Rtree, typename Box>
+void test_queries(Rtree const& t, std::vector<Box> const& queries, const char * name)
+{
+    typedef typename Rtree::value_type value_t;
+
+    std::vector<value_t> result;
+    result.reserve(100);
+
+    clock_type::time_point start = clock_type::now();
+    size_t temp = 0;
+    for (size_t i = 0 ; i < queries.size() ; ++i )
+    {
+        result.clear();
+        t.query(bgi::intersects(queries[i]), std::back_inserter(result));
+        temp += result.size();
+    }
+    dur_t time = clock_type::now() - start;
+    std::cout << time << " - " << name << " query(B) " << queries.size() << " found " << temp << '\n';
+}
+
+template <typename T, size_t Max>
+void test(std::vector< std::pair<float, float> > const& coords, size_t queries_count)
+{
+    typedef bg::model::point<T, 2, bg::cs::cartesian> P;
+    typedef bg::model::box<P> B;
+
+    std::vector<P> points;
+    std::vector<B> boxes;
+    std::vector<B> queries;
+    std::vector<B> queries_large;
+    for ( size_t i = 0 ; i < coords.size() ; ++i )
+    {
+        T x = coords[i].first;
+        T y = coords[i].second;
+        points.push_back(P(x, y));
+        boxes.push_back(B(P(x - 0.5f, y - 0.5f), P(x + 0.5f, y + 0.5f)));
+        if ( i < queries_count )
+            queries.push_back(B(P(x - 10, y - 10), P(x + 10, y + 10)));
+        if ( i < queries_count / 10 )
+            queries_large.push_back(B(P(x - 1000, y - 1000), P(x + 1000, y + 1000)));
+    }
+
+    std::cout << "coordinate size: " << sizeof(T) << ", max elements: " << Max << '\n';
+
+    {
+        bgi::rtree<P, bgi::rstar<Max> > t(points);
+        bgi::rtree<P, bgi::soa_layout< bgi::rstar<Max> > > t_soa(points);
+        test_queries(t, queries, "points     ");
+        test_queries(t_soa, queries, "points SoA ");
+        test_queries(t, queries_large, "points     ");
+        test_queries(t_soa, queries_large, "points SoA ");
+    }
+
+    {
+        bgi::rtree<B, bgi::rstar<Max> > t(boxes);
+        bgi::rtree<B, bgi::soa_layout< bgi::rstar<Max> > > t_soa(boxes);
+        test_queries(t, queries, "boxes      ");
+        test_queries(t_soa, queries, "boxes SoA  ");
+        test_queries(t, queries_large, "boxes      ");
+        test_queries(t_soa, queries_large, "boxes SoA  ");
+    }
+
+    std::cout << "------------------------------------------------\n";
+}
+
+int main()
+{
+    size_t values_count = 1000000;
+    size_t queries_count = 200000;
+
+    std::vector< std::pair<float, float> > coords;
+
+    //randomize values
+    {
+        boost::mt19937 rng;
+        float max_val = static_cast<float>(values_count / 2);
+        boost::uniform_real<float> range(-max_val, max_val);
+        boost::variate_generator<boost::mt19937&, boost::uniform_real<float> > rnd(rng, range);
+
+        coords.reserve(values_count);
+
+        std::cout << "randomizing data\n";
+        for ( size_t i = 0 ; i < values_count ; ++i )
+        {
+            coords.push_back(std::make_pair(rnd(), rnd()));
+        }
+        std::cout << "randomized\n";
+    }
+
+    test<double, 16>(coords, queries_count);
+    test<float, 16>(coords, queries_count);
+    test<double, 32>(coords, queries_count);
+    test<float, 32>(coords, queries_count);
+
+    return 0;
+}
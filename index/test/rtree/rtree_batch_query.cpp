@@ -0,0 +1,95 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+template <typename Value>
+struct pair_less
+{
+    bool operator()(std::pair<std::size_t, Value> const& l, std::pair<std::size_t, Value> const& r) const
+    {
+        return l.first < r.first
+            || (l.first == r.first && bg::less<Value>()(l.second, r.second));
+    }
+};
+
+template <typename Rtree, typename PredicatesRange>
+void check_batch_query(Rtree const& rt, PredicatesRange const& preds)
+{
+    typedef typename Rtree::value_type value_t;
+    typedef std::pair<std::size_t, value_t> pair_t;
+
+    std::vector<pair_t> expected;
+    for ( std::size_t i = 0 ; i < preds.size() ; ++i )
+    {
+        std::vector<value_t> result;
+        rt.query(preds[i], std::back_inserter(result));
+        for ( std::size_t j = 0 ; j < result.size() ; ++j )
+            expected.push_back(std::make_pair(i, result[j]));
+    }
+
+    std::vector<pair_t> result;
+    std::size_t found = rt.batch_query(preds, std::back_inserter(result));
+
+    BOOST_CHECK(found == result.size());
+    BOOST_CHECK(result.size() == expected.size());
+
+    std::sort(expected.begin(), expected.end(), pair_less<value_t>());
+    std::sort(result.begin(), result.end(), pair_less<value_t>());
+
+    BOOST_CHECK(std::equal(expected.begin(), expected.end(), result.begin(),
+                           bgi::equal_to<pair_t>()));
+}
+
+template <typename Params>
+void test_rtree(std::size_t count)
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+
+    std::vector<point_t> values;
+    for ( std::size_t i = 0 ; i < count ; ++i )
+        values.push_back(point_t(double((i * 7919) % 101), double((i * 104729) % 97)));
+
+    bgi::rtree<point_t, Params> rt(values);
+    bgi::rtree<point_t, Params> rt_empty;
+
+    typedef bgi::detail::predicates::spatial_predicate
+        <
+            box_t, bgi::detail::predicates::intersects_tag, false
+        > intersects_t;
+    std::vector<intersects_t> intersects_preds;
+    for ( int y = 0 ; y < 100 ; y += 9 )
+        for ( int x = 0 ; x < 100 ; x += 7 )
+            intersects_preds.push_back(bgi::intersects(box_t(point_t(x, y), point_t(x + 10, y + 5))));
+
+    check_batch_query(rt, intersects_preds);
+    check_batch_query(rt_empty, intersects_preds);
+    check_batch_query(rt, std::vector<intersects_t>());
+
+    typedef bgi::detail::predicates::spatial_predicate
+        <
+            box_t, bgi::detail::predicates::disjoint_tag, false
+        > disjoint_t;
+    std::vector<disjoint_t> disjoint_preds;
+    disjoint_preds.push_back(bgi::disjoint(box_t(point_t(0, 0), point_t(50, 50))));
+    disjoint_preds.push_back(bgi::disjoint(box_t(point_t(20, 20), point_t(70, 70))));
+
+    check_batch_query(rt, disjoint_preds);
+}
+
+int test_main(int, char* [])
+{
+    test_rtree< bgi::linear<4, 2> >(1000);
+    test_rtree< bgi::quadratic<5, 2> >(1000);
+    test_rtree< bgi::rstar<16, 4> >(1000);
+    test_rtree< bgi::rstar<16, 4> >(10);
+
+    return 0;
+}
@@ -0,0 +1,209 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <boost/geometry/index/concurrent_rtree.hpp>
+
+#include <functional>
+#include <thread>
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+typedef bg::model::box<point_t> box_t;
+
+// The iterator traversing the values only once, all copies share the position
+class single_pass_iterator
+{
+public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef point_t value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef point_t const* pointer;
+    typedef point_t const& reference;
+
+    single_pass_iterator() : m_values(0), m_pos(0) {}
+    single_pass_iterator(std::vector<point_t> const& values, std::size_t & pos)
+        : m_values(&values), m_pos(&pos)
+    {}
+
+    reference operator*() const { return (*m_values)[*m_pos]; }
+    pointer operator->() const { return &**this; }
+    single_pass_iterator & operator++() { ++*m_pos; return *this; }
+    single_pass_iterator operator++(int) { single_pass_iterator it = *this; ++*m_pos; return it; }
+
+    bool operator==(single_pass_iterator const& other) const { return is_end() == other.is_end(); }
+    bool operator!=(single_pass_iterator const& other) const { return !(*this == other); }
+
+private:
+    bool is_end() const { return m_values == 0 || *m_pos == m_values->size(); }
+
+    std::vector<point_t> const* m_values;
+    std::size_t * m_pos;
+};
+
+template <typename CTree>
+void test_single_pass(CTree & ct, std::vector<point_t> const& values)
+{
+    std::size_t const size = ct.size();
+
+    std::size_t pos = 0;
+    ct.insert(single_pass_iterator(values, pos), single_pass_iterator());
+    BOOST_CHECK(ct.size() == size + values.size());
+
+    // publish the other instance
+    ct.insert(point_t(100, 100));
+    BOOST_CHECK(ct.size() == size + values.size() + 1);
+    ct.remove(point_t(100, 100));
+    BOOST_CHECK(ct.size() == size + values.size());
+
+    pos = 0;
+    BOOST_CHECK(ct.remove(single_pass_iterator(values, pos), single_pass_iterator()) == values.size());
+    BOOST_CHECK(ct.size() == size);
+
+    ct.insert(point_t(100, 100));
+    BOOST_CHECK(ct.size() == size + 1);
+    ct.remove(point_t(100, 100));
+    BOOST_CHECK(ct.size() == size);
+}
+
+template <typename Params>
+void test_sequential()
+{
+    typedef bgi::concurrent_rtree<point_t, Params> ctree_t;
+    typedef typename ctree_t::rtree_type rtree_t;
+
+    std::vector<point_t> values;
+    for ( int i = 0 ; i < 100 ; ++i )
+        values.push_back(point_t(i % 10, i / 10));
+
+    ctree_t ct;
+    BOOST_CHECK(ct.empty());
+
+    ct.insert(values.begin(), values.begin() + 50);
+    ct.insert(values[50]);
+    ct.insert(std::vector<point_t>(values.begin() + 51, values.end()));
+    BOOST_CHECK(ct.size() == values.size());
+    BOOST_CHECK(ct.count(values[0]) == 1);
+
+    std::vector<point_t> result;
+    ct.query(bgi::intersects(box_t(point_t(0, 0), point_t(4, 4))), std::back_inserter(result));
+    BOOST_CHECK(result.size() == 25);
+
+    {
+        typename ctree_t::const_snapshot s = ct.snapshot();
+        BOOST_CHECK(s->size() == values.size());
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_boxes_ok(*s));
+        typename ctree_t::const_snapshot s2 = s;
+        BOOST_CHECK(std::distance(s2->qbegin(bgi::nearest(point_t(0, 0), 3)), s2->qend()) == 3);
+    }
+
+    BOOST_CHECK(ct.remove(values[0]) == 1);
+    BOOST_CHECK(ct.remove(values[0]) == 0);
+    BOOST_CHECK(ct.remove(values.begin() + 1, values.begin() + 10) == 9);
+    BOOST_CHECK(ct.size() == values.size() - 10);
+
+
+    // both instances should be equal
+    {
+        rtree_t const* t1 = &*ct.snapshot();
+        std::vector<point_t> v1(ct.snapshot()->begin(), ct.snapshot()->end());
+        ct.insert(point_t(100, 100));
+        rtree_t const* t2 = &*ct.snapshot();
+        BOOST_CHECK(t1 != t2);
+        BOOST_CHECK(ct.snapshot()->size() == v1.size() + 1);
+        ct.remove(point_t(100, 100));
+        rtree_t const* t3 = &*ct.snapshot();
+        std::vector<point_t> v3(ct.snapshot()->begin(), ct.snapshot()->end());
+        BOOST_CHECK(t1 == t3);
+        BOOST_CHECK(v1.size() == v3.size() && std::equal(v1.begin(), v1.end(), v3.begin(), bgi::equal_to<point_t>()));
+    }
+
+    // single-pass ranges
+    test_single_pass(ct, std::vector<point_t>(values.begin(), values.begin() + 10));
+
+    ct.clear();
+    BOOST_CHECK(ct.empty());
+
+    ctree_t ct2(values.begin(), values.end());
+    BOOST_CHECK(ct2.size() == values.size());
+}
+
+template <typename CTree>
+struct reader
+{
+    reader(CTree const& t, int i) : tree(&t), id(i), failed(false) {}
+
+    void operator()()
+    {
+        for ( int i = 0 ; i < 2000 ; ++i )
+        {
+            // the values in the first column are never removed
+            std::vector<point_t> result;
+            tree->query(bgi::intersects(box_t(point_t(0, 0), point_t(0, 9))), std::back_inserter(result));
+            if ( result.size() != 10 )
+                failed = true;
+
+            typename CTree::const_snapshot s = tree->snapshot();
+            std::size_t count = s->size();
+            if ( std::size_t(std::distance(s->begin(), s->end())) != count )
+                failed = true;
+        }
+    }
+
+    CTree const* tree;
+    int id;
+    bool failed;
+};
+
+template <typename Params>
+void test_concurrent()
+{
+    typedef bgi::concurrent_rtree<point_t, Params> ctree_t;
+
+    std::vector<point_t> values;
+    for ( int i = 0 ; i < 100 ; ++i )
+        values.push_back(point_t(i % 10, i / 10));
+
+    ctree_t ct(values.begin(), values.end());
+
+    std::vector< reader<ctree_t> > readers;
+    for ( int i = 0 ; i < 4 ; ++i )
+        readers.push_back(reader<ctree_t>(ct, i));
+
+    std::vector<std::thread> threads;
+    for ( std::size_t i = 0 ; i < readers.size() ; ++i )
+        threads.push_back(std::thread(std::ref(readers[i])));
+
+    for ( int i = 0 ; i < 200 ; ++i )
+    {
+        point_t p(1 + i % 9, 20 + i % 10);
+        ct.insert(p);
+        ct.remove(p);
+    }
+
+    for ( std::size_t i = 0 ; i < threads.size() ; ++i )
+        threads[i].join();
+
+    for ( std::size_t i = 0 ; i < readers.size() ; ++i )
+        BOOST_CHECK(!readers[i].failed);
+
+    BOOST_CHECK(ct.size() == values.size());
+}
+
+int test_main(int, char* [])
+{
+    test_sequential< bgi::linear<4, 2> >();
+    test_sequential< bgi::quadratic<4, 2> >();
+    test_sequential< bgi::rstar<4, 2> >();
+
+    test_concurrent< bgi::linear<4, 2> >();
+    test_concurrent< bgi::rstar<4, 2> >();
+
+    return 0;
+}
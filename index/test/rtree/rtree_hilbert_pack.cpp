@@ -0,0 +1,105 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <boost/geometry/index/detail/rtree/utilities/are_counts_ok.hpp>
+
+template <typename Params, typename Value, typename Box>
+void test_rtree(std::vector<Value> const& values, Box const& qbox, Params const& params)
+{
+    typedef bgi::rtree<Value, Params> rtree_t;
+
+    rtree_t rt_str(values, params);
+    rtree_t rt(bgi::hilbert_packing(), values, params);
+    rtree_t rt_it(bgi::hilbert_packing(), values.begin(), values.end(), params);
+
+    BOOST_CHECK(rt.size() == values.size());
+    BOOST_CHECK(rt_it.size() == values.size());
+    if ( ! values.empty() )
+    {
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_boxes_ok(rt));
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_levels_ok(rt));
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_counts_ok(rt));
+    }
+
+    // the iterator and range versions create the same tree
+    BOOST_CHECK(std::equal(rt.begin(), rt.end(), rt_it.begin(), bgi::equal_to<Value>()));
+
+    // all values are stored in the tree
+    bool all_found = true;
+    for ( std::size_t i = 0 ; i < values.size() ; ++i )
+        all_found = all_found && 0 < rt.count(values[i]);
+    BOOST_CHECK(all_found);
+
+    std::vector<Value> expected, result;
+    rt_str.query(bgi::intersects(qbox), std::back_inserter(expected));
+    rt.query(bgi::intersects(qbox), std::back_inserter(result));
+    basictest::compare_outputs(rt, result, expected);
+
+    // the tree may be modified after packing
+    if ( ! values.empty() )
+    {
+        rt.remove(values.front());
+        rt.insert(values.front());
+        BOOST_CHECK(rt.size() == values.size());
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_boxes_ok(rt));
+    }
+}
+
+template <typename Point, typename Params>
+void test_rtree_counts(Params const& params)
+{
+    typedef bg::model::box<Point> box_t;
+
+    std::size_t const counts[] = { 0, 1, 5, 17, 177, 1000, 5000 };
+
+    box_t qbox;
+    bg::assign_values(qbox, 100, 100, 300, 250);
+
+    for ( std::size_t c = 0 ; c < sizeof(counts) / sizeof(counts[0]) ; ++c )
+    {
+        std::vector<Point> points;
+        std::vector<box_t> boxes;
+        for ( std::size_t i = 0 ; i < counts[c] ; ++i )
+        {
+            int x = int((i * 7919) % 1009);
+            int y = int((i * 104729) % 997);
+            Point p;
+            bg::assign_values(p, x, y);
+            box_t b;
+            bg::assign_values(b, x, y, x + 1 + int(i % 5), y + 1 + int(i % 3));
+            points.push_back(p);
+            boxes.push_back(b);
+        }
+
+        test_rtree(points, qbox, params);
+        test_rtree(boxes, qbox, params);
+    }
+
+    // all values in the same position
+    std::vector<Point> points(100);
+    for ( std::size_t i = 0 ; i < points.size() ; ++i )
+        bg::assign_values(points[i], 1, 2);
+    test_rtree(points, qbox, params);
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> P2d;
+    typedef bg::model::point<int, 2, bg::cs::cartesian> P2i;
+
+    test_rtree_counts<P2d>(bgi::linear<4, 2>());
+    test_rtree_counts<P2d>(bgi::quadratic<5, 2>());
+    test_rtree_counts<P2d>(bgi::rstar<16, 4>());
+    test_rtree_counts<P2d>(bgi::dynamic_rstar(16, 8));
+    test_rtree_counts<P2i>(bgi::quadratic<8, 3>());
+
+    return 0;
+}
@@ -0,0 +1,43 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// The rtree header must be self-contained, it's included before any other
+#include <boost/geometry/index/rtree.hpp>
+
+#include <geometry_index_test_common.hpp>
+
+#include <iterator>
+#include <utility>
+#include <vector>
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+
+    std::vector<point_t> points;
+    std::vector<box_t> boxes;
+    for ( int i = 0 ; i < 100 ; ++i )
+    {
+        points.push_back(point_t(i, i));
+        boxes.push_back(box_t(point_t(i, i), point_t(i + 0.5, i + 0.5)));
+    }
+
+    bgi::rtree<point_t, bgi::quadratic<8, 3> > rt1(points);
+    bgi::rtree<box_t, bgi::linear<8, 3> > rt2(boxes);
+
+    std::vector<point_t> result;
+    rt1.query(bgi::intersects(box_t(point_t(10, 10), point_t(19.5, 19.5))), std::back_inserter(result));
+    BOOST_CHECK_EQUAL(result.size(), 10u);
+
+    std::vector< std::pair<point_t, box_t> > pairs;
+    BOOST_CHECK_EQUAL(rt1.spatial_join(rt2, std::back_inserter(pairs)), 100u);
+
+    return 0;
+}
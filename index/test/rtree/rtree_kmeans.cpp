@@ -0,0 +1,25 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+int test_main(int, char* [])
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> P2d;
+    typedef bg::model::box<P2d> B2d;
+    typedef bg::model::point<double, 3, bg::cs::cartesian> P3d;
+
+    testset::queries<P2d>(bgi::kmeans<5, 2>(), std::allocator<int>());
+    testset::modifiers<P2d>(bgi::kmeans<5, 2>(), std::allocator<int>());
+    testset::queries<B2d>(bgi::dynamic_kmeans(5, 2), std::allocator<int>());
+    testset::modifiers<B2d>(bgi::dynamic_kmeans(5, 2), std::allocator<int>());
+    testset::queries<P3d>(bgi::kmeans<8, 3>(), std::allocator<int>());
+
+    return 0;
+}
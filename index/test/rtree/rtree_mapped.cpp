@@ -0,0 +1,250 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <boost/geometry/index/mapped_rtree.hpp>
+
+template <typename Rtree, typename View, typename Box>
+void check_queries(Rtree const& rt, View const& view, Box const& qbox)
+{
+    Box qbox2 = qbox;
+    bg::set<bg::max_corner, 0>(qbox2, bg::get<bg::min_corner, 0>(qbox) + 100);
+
+    typedef typename Rtree::value_type value_t;
+
+    BOOST_CHECK(view.size() == rt.size());
+    BOOST_CHECK(view.empty() == rt.empty());
+    BOOST_CHECK(view.depth() == bgi::detail::rtree::utilities::view<Rtree>(rt).depth());
+    BOOST_CHECK(bg::equals(view.bounds(), rt.bounds()) || rt.empty());
+
+    {
+        std::vector<value_t> expected, result;
+        rt.query(bgi::intersects(qbox), std::back_inserter(expected));
+        std::size_t found = view.query(bgi::intersects(qbox), std::back_inserter(result));
+        BOOST_CHECK(found == result.size());
+        basictest::compare_outputs(rt, result, expected);
+    }
+    {
+        std::vector<value_t> expected, result;
+        rt.query(bgi::disjoint(qbox), std::back_inserter(expected));
+        view.query(bgi::disjoint(qbox), std::back_inserter(result));
+        basictest::compare_outputs(rt, result, expected);
+    }
+    {
+        std::vector<value_t> expected, result;
+        rt.query(bgi::within(qbox) && !bgi::covered_by(qbox2), std::back_inserter(expected));
+        view.query(bgi::within(qbox) && !bgi::covered_by(qbox2), std::back_inserter(result));
+        basictest::compare_outputs(rt, result, expected);
+    }
+}
+
+// Modifies a copy of the header of the image and checks that it's rejected
+template <typename Value, typename Modify>
+void check_corrupted_header(std::vector<double> image, std::size_t size, Modify modify)
+{
+    char * data = reinterpret_cast<char*>(&image[0]);
+    modify(*reinterpret_cast<bgi::detail::rtree::flat::image_header*>(data), data);
+    BOOST_CHECK_THROW((bgi::flat_rtree_view<Value>(&image[0], size)), std::runtime_error);
+}
+
+// Modifies a copy of the image and checks that it's opened but rejected
+// by validate() and optionally by the query visiting all nodes
+template <typename Value, typename Modify>
+void check_corrupted(std::vector<double> image, std::size_t size, Modify modify, bool query_throws)
+{
+    typedef bgi::flat_rtree_view<Value> view_t;
+    typedef typename bg::point_type<typename view_t::bounds_type>::type point_t;
+
+    char * data = reinterpret_cast<char*>(&image[0]);
+    modify(*reinterpret_cast<bgi::detail::rtree::flat::image_header*>(data), data);
+
+    view_t view(&image[0], size);
+    BOOST_CHECK_THROW(view.validate(), std::runtime_error);
+
+    if ( query_throws )
+    {
+        point_t far_pt;
+        bg::assign_values(far_pt, -1e10, -1e10);
+        typename view_t::bounds_type const far_box(far_pt, far_pt);
+
+        std::vector<Value> result;
+        BOOST_CHECK_THROW(view.query(bgi::disjoint(far_box), std::back_inserter(result)), std::runtime_error);
+    }
+}
+
+struct truncated_image_size
+{
+    void operator()(bgi::detail::rtree::flat::image_header & h, char *) const
+    {
+        h.image_size = h.root_offset + 4;
+    }
+};
+
+struct invalid_values_count
+{
+    void operator()(bgi::detail::rtree::flat::image_header & h, char *) const
+    {
+        h.values_count += 1;
+    }
+};
+
+struct invalid_depth
+{
+    void operator()(bgi::detail::rtree::flat::image_header & h, char *) const
+    {
+        h.leafs_level = h.nodes_count;
+    }
+};
+
+struct invalid_root_offset
+{
+    void operator()(bgi::detail::rtree::flat::image_header & h, char *) const
+    {
+        h.root_offset = h.image_size;
+    }
+};
+
+struct invalid_root_count
+{
+    void operator()(bgi::detail::rtree::flat::image_header & h, char * data) const
+    {
+        reinterpret_cast<bgi::detail::rtree::flat::node_header*>(data + h.root_offset)->count = 0xFFFFFFFF;
+    }
+};
+
+struct invalid_root_kind
+{
+    void operator()(bgi::detail::rtree::flat::image_header & h, char * data) const
+    {
+        bgi::detail::rtree::flat::node_header & n = *reinterpret_cast<bgi::detail::rtree::flat::node_header*>(data + h.root_offset);
+        n.is_leaf = n.is_leaf ? 0 : 1;
+    }
+};
+
+template <typename Value, typename Box>
+struct invalid_child_offset
+{
+    void operator()(bgi::detail::rtree::flat::image_header & h, char * data) const
+    {
+        typedef bgi::detail::rtree::flat::image_traits<Value, Box> traits;
+        typedef bgi::detail::rtree::flat::internal_element<Box> element_t;
+        element_t * elements = reinterpret_cast<element_t*>(data + h.root_offset + traits::elements_offset());
+        elements[0].offset = h.image_size - traits::alignment;
+    }
+};
+
+template <typename Value, typename Box>
+struct cyclic_child_offset
+{
+    void operator()(bgi::detail::rtree::flat::image_header & h, char * data) const
+    {
+        typedef bgi::detail::rtree::flat::image_traits<Value, Box> traits;
+        typedef bgi::detail::rtree::flat::internal_element<Box> element_t;
+        element_t * elements = reinterpret_cast<element_t*>(data + h.root_offset + traits::elements_offset());
+        elements[0].offset = h.root_offset;
+    }
+};
+
+template <typename Params, typename Value, typename Box>
+void test_rtree(std::vector<Value> const& values, Box const& qbox)
+{
+    typedef bgi::rtree<Value, Params> rtree_t;
+    rtree_t rt(values);
+
+    std::stringstream ss(std::ios::in | std::ios::out | std::ios::binary);
+    bgi::write_flat_image(rt, ss);
+    std::string const image_str = ss.str();
+
+    // the image has to be aligned
+    std::vector<double> image((image_str.size() + sizeof(double) - 1) / sizeof(double));
+    if ( ! image_str.empty() )
+        std::memcpy(&image[0], image_str.data(), image_str.size());
+
+    bgi::flat_rtree_view<Value> view(&image[0], image_str.size());
+    view.validate();
+    check_queries(rt, view, qbox);
+
+    // invalid and truncated images
+    BOOST_CHECK_THROW((bgi::flat_rtree_view<Value>(&image[0], 4)), std::runtime_error);
+    BOOST_CHECK_THROW((bgi::flat_rtree_view<Value>(&image[0], image_str.size() - 1)), std::runtime_error);
+
+    // corrupted images
+    if ( ! rt.empty() )
+    {
+        check_corrupted_header<Value>(image, image_str.size(), invalid_depth());
+        check_corrupted<Value>(image, image_str.size(), truncated_image_size(), true);
+        check_corrupted<Value>(image, image_str.size(), invalid_values_count(), false);
+        check_corrupted<Value>(image, image_str.size(), invalid_root_offset(), true);
+        check_corrupted<Value>(image, image_str.size(), invalid_root_count(), true);
+        check_corrupted<Value>(image, image_str.size(), invalid_root_kind(), true);
+        if ( view.depth() > 0 )
+        {
+            check_corrupted<Value>(image, image_str.size(), invalid_child_offset<Value, typename rtree_t::bounds_type>(), true);
+            check_corrupted<Value>(image, image_str.size(), cyclic_child_offset<Value, typename rtree_t::bounds_type>(), true);
+        }
+    }
+
+    // incompatible Value
+    typedef bg::model::box<bg::model::point<float, 2, bg::cs::cartesian> > float_box_t;
+    BOOST_CHECK_THROW((bgi::flat_rtree_view<float_box_t>(&image[0], image_str.size())), std::runtime_error);
+
+    // memory-mapped file
+    const char * filename = "rtree_mapped_test.bin";
+    {
+        std::ofstream ofs(filename, std::ios::binary | std::ios::trunc);
+        bgi::write_flat_image(rt, ofs);
+    }
+    {
+        bgi::mapped_rtree<Value> mapped(filename);
+        mapped.validate();
+        check_queries(rt, mapped, qbox);
+    }
+    std::remove(filename);
+}
+
+template <typename Params>
+void test_rtree_counts()
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+
+    box_t const qbox(point_t(100, 200), point_t(500, 400));
+
+    std::size_t const counts[] = { 0, 1, 5, 17, 177, 1000 };
+
+    for ( std::size_t c = 0 ; c < sizeof(counts) / sizeof(counts[0]) ; ++c )
+    {
+        std::vector<point_t> points;
+        std::vector<box_t> boxes;
+        for ( std::size_t i = 0 ; i < counts[c] ; ++i )
+        {
+            double x = double((i * 7919) % 1009);
+            double y = double((i * 104729) % 997);
+            points.push_back(point_t(x, y));
+            boxes.push_back(box_t(point_t(x, y), point_t(x + 1 + i % 5, y + 1 + i % 3)));
+        }
+
+        test_rtree<Params>(points, qbox);
+        test_rtree<Params>(boxes, qbox);
+    }
+}
+
+int test_main(int, char* [])
+{
+    test_rtree_counts< bgi::linear<4, 2> >();
+    test_rtree_counts< bgi::quadratic<5, 2> >();
+    test_rtree_counts< bgi::rstar<16, 4> >();
+
+    return 0;
+}
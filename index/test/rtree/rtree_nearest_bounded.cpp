@@ -0,0 +1,202 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+template <typename Value>
+struct less_by_distance
+{
+    typedef typename bgi::indexable<Value>::result_type indexable_type;
+    typedef typename bg::point_type<indexable_type>::type point_type;
+
+    explicit less_by_distance(point_type const& p) : pt(p) {}
+
+    bool operator()(Value const& l, Value const& r) const
+    {
+        return bg::comparable_distance(pt, l) < bg::comparable_distance(pt, r);
+    }
+
+    point_type pt;
+};
+
+template <typename Value>
+struct store_until
+{
+    store_until(std::vector<Value> & r, std::size_t m) : result(&r), max_count(m) {}
+
+    bool operator()(Value const& v)
+    {
+        result->push_back(v);
+        return result->size() < max_count;
+    }
+
+    std::vector<Value> * result;
+    std::size_t max_count;
+};
+
+template <typename Value>
+struct store_first_in_box
+{
+    typedef typename bgi::indexable<Value>::result_type indexable_type;
+    typedef typename bg::point_type<indexable_type>::type point_type;
+    typedef bg::model::box<point_type> box_type;
+
+    store_first_in_box(std::vector<Value> & r, box_type const& b) : result(&r), box(b) {}
+
+    bool operator()(Value const& v)
+    {
+        result->push_back(v);
+        return ! bg::intersects(v, box);
+    }
+
+    std::vector<Value> * result;
+    box_type box;
+};
+
+template <typename Value, typename Point>
+std::vector<Value> brute_force(std::vector<Value> values, Point const& pt,
+                               std::size_t k, double max_distance)
+{
+    std::vector<Value> result;
+    for ( std::size_t i = 0 ; i < values.size() ; ++i )
+        if ( bg::distance(pt, values[i]) <= max_distance )
+            result.push_back(values[i]);
+    std::sort(result.begin(), result.end(), less_by_distance<Value>(pt));
+    if ( k < result.size() )
+        result.resize(k);
+    return result;
+}
+
+template <typename Value, typename Point>
+void check_result(std::vector<Value> const& result, std::vector<Value> const& expected,
+                  Point const& pt, double max_distance)
+{
+    BOOST_CHECK_EQUAL(result.size(), expected.size());
+    for ( std::size_t i = 0 ; i < result.size() && i < expected.size() ; ++i )
+    {
+        BOOST_CHECK(bg::distance(pt, result[i]) <= max_distance);
+        BOOST_CHECK_CLOSE(bg::distance(pt, result[i]), bg::distance(pt, expected[i]), 0.0001);
+    }
+}
+
+template <typename Value, typename Params, typename Point>
+void test_bounded(std::vector<Value> const& values, Point const& pt,
+                  std::size_t k, double max_distance)
+{
+    typedef bgi::rtree<Value, Params> rtree_t;
+    rtree_t rt(values);
+
+    std::vector<Value> expected = brute_force(values, pt, k, max_distance);
+
+    // knn query
+    std::vector<Value> result;
+    rt.query(bgi::nearest(pt, k, max_distance), std::back_inserter(result));
+    std::sort(result.begin(), result.end(), less_by_distance<Value>(pt));
+    check_result(result, expected, pt, max_distance);
+
+    // incremental knn query
+    std::vector<Value> result_incremental(rt.qbegin(bgi::nearest(pt, k, max_distance)), rt.qend());
+    check_result(result_incremental, expected, pt, max_distance);
+
+    // callback stopped after some of the values
+    std::vector<Value> result_stopped;
+    std::size_t const half = (std::max)(expected.size() / 2, std::size_t(1));
+    std::size_t found = rt.query_nearest(bgi::nearest(pt, k, max_distance),
+                                         store_until<Value>(result_stopped, half));
+    BOOST_CHECK_EQUAL(found, result_stopped.size());
+    BOOST_CHECK_EQUAL(found, (std::min)(half, expected.size()));
+    check_result(result_stopped, std::vector<Value>(expected.begin(), expected.begin() + found),
+                 pt, max_distance);
+}
+
+template <typename Value, typename Params, typename Point>
+void test_stop(std::vector<Value> const& values, Point const& pt)
+{
+    typedef typename store_first_in_box<Value>::box_type box_type;
+
+    bgi::rtree<Value, Params> rt(values);
+
+    // pass all of the values to the function object
+    std::vector<Value> result_all;
+    std::size_t found_all = bgi::query_nearest(rt, bgi::nearest(pt, unsigned(values.size())),
+                                               store_until<Value>(result_all, values.size()));
+    BOOST_CHECK_EQUAL(found_all, values.size());
+    for ( std::size_t i = 0 ; i + 1 < result_all.size() ; ++i )
+        BOOST_CHECK(! less_by_distance<Value>(pt)(result_all[i + 1], result_all[i]));
+
+    // stop at the first value intersecting the box
+    box_type box(Point(80, 80), Point(90, 90));
+    std::vector<Value> result;
+    std::size_t found = bgi::query_nearest(rt, bgi::nearest(pt, unsigned(values.size())),
+                                           store_first_in_box<Value>(result, box));
+    BOOST_CHECK_EQUAL(found, result.size());
+    BOOST_CHECK(0 < found && found < values.size());
+    BOOST_CHECK(bg::intersects(result.back(), box));
+    for ( std::size_t i = 0 ; i + 1 < result.size() ; ++i )
+        BOOST_CHECK(! bg::intersects(result[i], box));
+
+    // empty rtree
+    bgi::rtree<Value, Params> empty;
+    BOOST_CHECK_EQUAL(bgi::query_nearest(empty, bgi::nearest(pt, 5), store_until<Value>(result, 10)), 0u);
+}
+
+template <typename Params>
+void test_cartesian()
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+
+    std::vector<point_t> points;
+    std::vector<box_t> boxes;
+    for ( int i = 0 ; i < 1000 ; ++i )
+    {
+        double x = (i * 7919) % 101, y = (i * 104729) % 97;
+        points.push_back(point_t(x, y));
+        boxes.push_back(box_t(point_t(x, y), point_t(x + 0.5, y + 0.25)));
+    }
+
+    point_t pt(40.3, 60.7);
+    test_bounded<point_t, Params>(points, pt, 10, 5.0);
+    test_bounded<point_t, Params>(points, pt, 100, 5.0);
+    test_bounded<point_t, Params>(points, pt, 100, 0.1);
+    test_bounded<box_t, Params>(boxes, pt, 10, 5.0);
+    test_bounded<box_t, Params>(boxes, pt, 100, 5.0);
+
+    test_stop<point_t, Params>(points, pt);
+}
+
+template <typename Params>
+void test_spherical()
+{
+    typedef bg::model::point<double, 2, bg::cs::spherical_equatorial<bg::degree> > point_t;
+
+    std::vector<point_t> points;
+    for ( int i = 0 ; i < 1000 ; ++i )
+        points.push_back(point_t((i * 7919) % 101 - 50.0, (i * 104729) % 97 - 48.0));
+
+    // the distance on the unit sphere
+    point_t pt(10.3, 20.7);
+    test_bounded<point_t, Params>(points, pt, 10, 0.1);
+    test_bounded<point_t, Params>(points, pt, 100, 0.05);
+}
+
+int test_main(int, char* [])
+{
+    test_cartesian< bgi::quadratic<8, 3> >();
+    test_cartesian< bgi::rstar<8, 3> >();
+    test_spherical< bgi::linear<8, 3> >();
+
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    BOOST_CHECK_THROW(bgi::nearest(point_t(0, 0), 1, -1.0), std::invalid_argument);
+    BOOST_CHECK_THROW(bgi::nearest(point_t(0, 0), 1, std::numeric_limits<double>::quiet_NaN()),
+                      std::invalid_argument);
+    BOOST_CHECK_NO_THROW(bgi::nearest(point_t(0, 0), 1, 0.0));
+
+    return 0;
+}
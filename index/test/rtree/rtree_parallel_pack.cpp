@@ -0,0 +1,81 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <boost/geometry/util/parallel.hpp>
+
+template <typename Params, typename Value>
+void test_rtree(std::vector<Value> const& values, std::size_t threads)
+{
+    typedef bgi::rtree<Value, Params> rtree_t;
+
+    rtree_t rt_seq(values);
+    rtree_t rt_par(bg::execution::parallel_policy(threads), values);
+    rtree_t rt_par_it(bg::execution::parallel_policy(threads), values.begin(), values.end());
+
+    BOOST_CHECK(rt_par.size() == values.size());
+    BOOST_CHECK(rt_par_it.size() == values.size());
+    if ( ! values.empty() )
+    {
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_boxes_ok(rt_par));
+        BOOST_CHECK(bgi::detail::rtree::utilities::are_levels_ok(rt_par));
+    }
+
+    // the structure of the trees should be the same
+    // so the values should be traversed in the same order
+    BOOST_CHECK(std::equal(rt_seq.begin(), rt_seq.end(), rt_par.begin(), bgi::equal_to<Value>()));
+    BOOST_CHECK(std::equal(rt_seq.begin(), rt_seq.end(), rt_par_it.begin(), bgi::equal_to<Value>()));
+}
+
+template <typename Params>
+void test_rtree_counts(std::size_t threads)
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+
+    std::size_t const counts[] = { 0, 1, 5, 17, 177, 1000, 5000 };
+
+    for ( std::size_t c = 0 ; c < sizeof(counts) / sizeof(counts[0]) ; ++c )
+    {
+        std::vector<point_t> points;
+        std::vector<box_t> boxes;
+        for ( std::size_t i = 0 ; i < counts[c] ; ++i )
+        {
+            double x = double((i * 7919) % 1009);
+            double y = double((i * 104729) % 997);
+            points.push_back(point_t(x, y));
+            boxes.push_back(box_t(point_t(x, y), point_t(x + 1 + i % 5, y + 1 + i % 3)));
+        }
+
+        test_rtree<Params>(points, threads);
+        test_rtree<Params>(boxes, threads);
+    }
+}
+
+template <int Max, int Min>
+void test_rtree_all()
+{
+    std::size_t const threads[] = { 1, 2, 3, 8 };
+    for ( std::size_t t = 0 ; t < sizeof(threads) / sizeof(threads[0]) ; ++t )
+    {
+        test_rtree_counts< bgi::linear<Max, Min> >(threads[t]);
+        test_rtree_counts< bgi::quadratic<Max, Min> >(threads[t]);
+        test_rtree_counts< bgi::rstar<Max, Min> >(threads[t]);
+    }
+}
+
+int test_main(int, char* [])
+{
+    test_rtree_all<4, 2>();
+    test_rtree_all<5, 2>();
+    test_rtree_all<16, 4>();
+
+    return 0;
+}
@@ -0,0 +1,129 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+
+#include <cstdlib>
+#include <new>
+
+// Count the allocations to check that the queries don't allocate memory.
+// The replacements are not inlined, otherwise the compiler could see
+// the memory allocated with malloc() and released with operator delete.
+std::size_t allocations_count = 0;
+
+#ifdef BOOST_NO_CXX11_NOEXCEPT
+BOOST_NOINLINE void * operator new(std::size_t size) throw(std::bad_alloc)
+#else
+BOOST_NOINLINE void * operator new(std::size_t size)
+#endif
+{
+    ++allocations_count;
+    void * p = std::malloc(size > 0 ? size : 1);
+    if ( p == NULL )
+        throw std::bad_alloc();
+    return p;
+}
+
+BOOST_NOINLINE void operator delete(void * p) BOOST_NOEXCEPT_OR_NOTHROW
+{
+    std::free(p);
+}
+
+#ifdef __cpp_sized_deallocation
+BOOST_NOINLINE void operator delete(void * p, std::size_t) BOOST_NOEXCEPT_OR_NOTHROW
+{
+    ::operator delete(p);
+}
+#endif
+
+template <typename Value>
+void check_equal(std::vector<Value> result, std::vector<Value> expected)
+{
+    std::sort(expected.begin(), expected.end(), bg::less<Value>());
+    std::sort(result.begin(), result.end(), bg::less<Value>());
+
+    BOOST_CHECK(result.size() == expected.size());
+    BOOST_CHECK(std::equal(expected.begin(), expected.end(), result.begin(),
+                           bgi::equal_to<Value>()));
+}
+
+template <typename Params>
+void test_rtree(std::size_t count)
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+    typedef bg::model::box<point_t> box_t;
+    typedef bgi::rtree<point_t, Params> rtree_t;
+    typedef typename rtree_t::const_query_iterator query_iterator;
+
+    std::vector<point_t> values;
+    for ( std::size_t i = 0 ; i < count ; ++i )
+        values.push_back(point_t(double((i * 7919) % 1009), double((i * 104729) % 997)));
+
+    rtree_t rt(values);
+
+    box_t box(point_t(100, 100), point_t(300, 250));
+    std::vector<point_t> expected;
+    rt.query(bgi::intersects(box), std::back_inserter(expected));
+
+    std::vector<point_t> result1, result2;
+    result1.reserve(expected.size());
+    result2.reserve(expected.size());
+
+    std::size_t const allocations = allocations_count;
+
+    // type-erased iterators
+    for ( query_iterator it = rt.qbegin(bgi::intersects(box)) ; it != rt.qend() ; ++it )
+        result1.push_back(*it);
+
+    // non-erased iterators
+    basictest::copy_alt(rt.qbegin_(bgi::intersects(box)), rt.qend_(), std::back_inserter(result2));
+
+    // copies of type-erased iterators
+    query_iterator it1 = rt.qbegin(bgi::intersects(box));
+    query_iterator it2 = it1;
+    ++it2;
+    it1 = it2;
+    bool const copies_equal = it1 == it2;
+
+    std::size_t const query_allocations = allocations_count - allocations;
+
+    BOOST_CHECK_EQUAL(query_allocations, 0u);
+    BOOST_CHECK(copies_equal);
+    check_equal(result1, expected);
+    check_equal(result2, expected);
+
+    // the iterators of knn query stored in the iterator and the end iterator
+    std::vector<point_t> nearest_expected, nearest_result;
+    rt.query(bgi::nearest(point_t(500, 500), 20), std::back_inserter(nearest_expected));
+    query_iterator nit = rt.qbegin(bgi::nearest(point_t(500, 500), 20));
+    query_iterator nit_copy = nit;
+    nit = rt.qend();
+    for ( ; nit_copy != nit ; ++nit_copy )
+        nearest_result.push_back(*nit_copy);
+    check_equal(nearest_result, nearest_expected);
+
+    // the iterators of queries with many predicates
+    std::vector<query_iterator> iterators;
+    for ( std::size_t i = 0 ; i < 10 ; ++i )
+        iterators.push_back(rt.qbegin(bgi::intersects(box) && bgi::disjoint(box_t(point_t(double(i), -2), point_t(double(i) + 1, -1)))));
+    for ( std::size_t i = 0 ; i < iterators.size() ; ++i )
+    {
+        std::vector<point_t> res(iterators[i], query_iterator());
+        check_equal(res, expected);
+    }
+}
+
+int test_main(int, char* [])
+{
+    test_rtree< bgi::linear<16, 4> >(20000);
+    test_rtree< bgi::quadratic<8, 3> >(20000);
+    test_rtree< bgi::rstar<16, 4> >(20000);
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+#include <rtree/test_soa_layout.hpp>
+
+template <typename Indexable, typename Parameters>
+void test_soa_bounds_update(Parameters const& parameters)
+{
+    typedef bgi::rtree<Indexable, Parameters> rtree_t;
+    typedef typename rtree_t::bounds_type box_t;
+
+    std::vector<Indexable> input;
+    box_t qbox;
+    generate::input<bg::dimension<Indexable>::value>::apply(input, qbox);
+
+    rtree_t rt(input, parameters);
+    BOOST_CHECK(soa_bounds_ok(rt));
+
+    rtree_t rt2(parameters);
+    rt2.insert(input);
+    BOOST_CHECK(soa_bounds_ok(rt2));
+
+    rtree_t rt3 = rt2;
+    BOOST_CHECK(soa_bounds_ok(rt3));
+
+    rt2.remove(input.begin(), input.begin() + input.size() / 2);
+    BOOST_CHECK(soa_bounds_ok(rt2));
+
+    std::vector<Indexable> expected;
+    for ( std::size_t i = input.size() / 2 ; i < input.size() ; ++i )
+        if ( bg::intersects(input[i], qbox) )
+            expected.push_back(input[i]);
+
+    std::vector<Indexable> result;
+    rt2.query(bgi::intersects(qbox), std::back_inserter(result));
+    basictest::compare_outputs(rt2, result, expected);
+
+    // the box containing all representable coordinates
+    box_t inv_box;
+    bg::assign_inverse(inv_box);
+    box_t all_box(inv_box.max_corner(), inv_box.min_corner());
+    result.clear();
+    rt.query(bgi::intersects(all_box), std::back_inserter(result));
+    BOOST_CHECK(result.size() == input.size());
+}
+
+template <typename Parameters>
+void test_soa_layout(Parameters const& parameters)
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> P2d;
+    typedef bg::model::point<float, 3, bg::cs::cartesian> P3f;
+    typedef bg::model::box<P3f> B3f;
+
+    test_soa_bounds_update<P2d>(parameters);
+    test_soa_bounds_update<B3f>(parameters);
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::box< bg::model::point<double, 2, bg::cs::cartesian> > B2d;
+
+    testset::queries<B2d>(bgi::soa_layout< bgi::rstar<8, 3> >(), std::allocator<int>());
+
+    test_soa_layout(bgi::soa_layout< bgi::linear<5, 2> >());
+    test_soa_layout(bgi::soa_layout< bgi::quadratic<5, 2> >());
+    test_soa_layout(bgi::soa_layout< bgi::rstar<8, 3> >());
+
+    return 0;
+}
@@ -0,0 +1,139 @@
+// Boost.Geometry Index
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <rtree/test_rtree.hpp>
+#include <rtree/test_soa_layout.hpp>
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> point_t;
+typedef bg::model::box<point_t> box_t;
+typedef std::pair<box_t, int> box_value;
+typedef std::pair<point_t, int> point_value;
+
+template <typename Pairs>
+std::vector< std::pair<int, int> > ids(Pairs const& pairs)
+{
+    std::vector< std::pair<int, int> > result;
+    for ( std::size_t i = 0 ; i < pairs.size() ; ++i )
+        result.push_back(std::make_pair(pairs[i].first.second, pairs[i].second.second));
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+template <typename Rtree1, typename Rtree2>
+void test_join(Rtree1 const& rt1, Rtree2 const& rt2)
+{
+    typedef typename Rtree1::value_type value1_t;
+    typedef typename Rtree2::value_type value2_t;
+    typedef std::pair<value1_t, value2_t> result_t;
+
+    // the result of the queries performed for each value of the first rtree
+    std::vector<result_t> expected;
+    for ( typename Rtree1::const_iterator it = rt1.begin() ; it != rt1.end() ; ++it )
+    {
+        std::vector<value2_t> found;
+        rt2.query(bgi::intersects(it->first), std::back_inserter(found));
+        for ( std::size_t i = 0 ; i < found.size() ; ++i )
+            expected.push_back(result_t(*it, found[i]));
+    }
+
+    std::vector<result_t> result;
+    std::size_t found_count = rt1.spatial_join(rt2, std::back_inserter(result));
+    BOOST_CHECK_EQUAL(found_count, result.size());
+    BOOST_CHECK(ids(result) == ids(expected));
+
+    // the parallel join returns the same pairs in the same order
+    std::vector<result_t> result_parallel;
+    std::size_t found_count_parallel = bgi::spatial_join(bg::execution::parallel_policy(4),
+                                                         rt1, rt2, std::back_inserter(result_parallel));
+    BOOST_CHECK_EQUAL(found_count_parallel, found_count);
+    BOOST_CHECK_EQUAL(result_parallel.size(), result.size());
+    for ( std::size_t i = 0 ; i < result.size() && i < result_parallel.size() ; ++i )
+    {
+        BOOST_CHECK(result_parallel[i].first.second == result[i].first.second);
+        BOOST_CHECK(result_parallel[i].second.second == result[i].second.second);
+    }
+}
+
+template <typename Params1, typename Params2>
+void test_rtrees(int count1, int count2)
+{
+    std::vector<box_value> boxes;
+    for ( int i = 0 ; i < count1 ; ++i )
+    {
+        double x = (i * 7919) % 1009, y = (i * 104729) % 997;
+        boxes.push_back(box_value(box_t(point_t(x, y), point_t(x + (i % 7), y + (i % 5))), i));
+    }
+
+    std::vector<box_value> boxes2;
+    std::vector<point_value> points;
+    for ( int i = 0 ; i < count2 ; ++i )
+    {
+        double x = (i * 104729) % 1013, y = (i * 7919) % 991;
+        boxes2.push_back(box_value(box_t(point_t(x, y), point_t(x + (i % 3), y + (i % 11))), i));
+        points.push_back(point_value(point_t(x, y), i));
+    }
+
+    bgi::rtree<box_value, Params1> rt1(boxes);
+    bgi::rtree<box_value, Params2> rt2(boxes2);
+    bgi::rtree<point_value, Params2> rt_pts(points);
+
+    test_join(rt1, rt2);
+    test_join(rt2, rt1);
+    test_join(rt1, rt_pts);
+
+    // empty rtree
+    bgi::rtree<box_value, Params2> empty;
+    std::vector< std::pair<box_value, box_value> > result;
+    BOOST_CHECK_EQUAL(rt1.spatial_join(empty, std::back_inserter(result)), 0u);
+    BOOST_CHECK_EQUAL(bgi::spatial_join(bg::execution::parallel_policy(4), empty, rt1, std::back_inserter(result)), 0u);
+    BOOST_CHECK(result.empty());
+}
+
+// The join only reads the nodes so it can't outdate the SoA bounds
+template <typename Params1, typename Params2>
+void test_soa_layout(int count1, int count2)
+{
+    std::vector<box_value> boxes;
+    for ( int i = 0 ; i < count1 ; ++i )
+    {
+        double x = (i * 7919) % 1009, y = (i * 104729) % 997;
+        boxes.push_back(box_value(box_t(point_t(x, y), point_t(x + (i % 7), y + (i % 5))), i));
+    }
+
+    std::vector<box_value> boxes2;
+    for ( int i = 0 ; i < count2 ; ++i )
+    {
+        double x = (i * 104729) % 1013, y = (i * 7919) % 991;
+        boxes2.push_back(box_value(box_t(point_t(x, y), point_t(x + (i % 3), y + (i % 11))), i));
+    }
+
+    bgi::rtree<box_value, bgi::soa_layout<Params1> > rt1(boxes);
+    bgi::rtree<box_value, Params2> rt2(boxes2);
+    bgi::rtree<box_value, bgi::soa_layout<Params2> > rt3;
+    rt3.insert(boxes2);
+
+    test_join(rt1, rt2);
+    test_join(rt2, rt1);
+    test_join(rt1, rt3);
+
+    BOOST_CHECK(soa_bounds_ok(rt1));
+    BOOST_CHECK(soa_bounds_ok(rt3));
+}
+
+int test_main(int, char* [])
+{
+    // trees of various heights
+    test_rtrees< bgi::quadratic<8, 3>, bgi::rstar<8, 3> >(5000, 3000);
+    test_rtrees< bgi::linear<16, 4>, bgi::quadratic<4, 2> >(500, 10000);
+    test_rtrees< bgi::rstar<16, 4>, bgi::linear<4, 2> >(10, 2000);
+
+    test_soa_layout< bgi::rstar<16, 4>, bgi::quadratic<8, 3> >(3000, 2000);
+
+    return 0;
+}
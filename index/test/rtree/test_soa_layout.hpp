@@ -0,0 +1,75 @@
+// Boost.Geometry Index
+//
+// SoA layout test utilities
+//
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+//
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef BOOST_GEOMETRY_INDEX_TEST_RTREE_SOA_LAYOUT_HPP
+#define BOOST_GEOMETRY_INDEX_TEST_RTREE_SOA_LAYOUT_HPP
+
+#include <rtree/test_rtree.hpp>
+
+// Checks if the SoA bounds of all nodes are up to date
+template <typename Rtree>
+class are_soa_bounds_ok
+    : public bgi::detail::rtree::visitor
+        <
+            typename Rtree::value_type,
+            typename bgi::detail::rtree::utilities::view<Rtree>::options_type::parameters_type,
+            typename bgi::detail::rtree::utilities::view<Rtree>::box_type,
+            typename bgi::detail::rtree::utilities::view<Rtree>::allocators_type,
+            typename bgi::detail::rtree::utilities::view<Rtree>::options_type::node_tag,
+            true
+        >::type
+{
+    typedef bgi::detail::rtree::utilities::view<Rtree> view;
+    typedef typename view::options_type::parameters_type parameters_type;
+    typedef typename bgi::detail::rtree::internal_node
+        <
+            typename Rtree::value_type, parameters_type, typename view::box_type,
+            typename view::allocators_type, typename view::options_type::node_tag
+        >::type internal_node;
+    typedef typename bgi::detail::rtree::leaf
+        <
+            typename Rtree::value_type, parameters_type, typename view::box_type,
+            typename view::allocators_type, typename view::options_type::node_tag
+        >::type leaf;
+
+public:
+    are_soa_bounds_ok() : result(true) {}
+
+    void operator()(internal_node const& n)
+    {
+        check(n);
+        for ( std::size_t i = 0 ; i < n.elements.size() ; ++i )
+            bgi::detail::rtree::apply_visitor(*this, *n.elements[i].second);
+    }
+
+    void operator()(leaf const& n)
+    {
+        check(n);
+    }
+
+    bool result;
+
+private:
+    template <typename Node>
+    void check(Node const& n)
+    {
+        result = result && ! n.soa_outdated && n.soa.count == n.elements.size();
+    }
+};
+
+template <typename Rtree>
+bool soa_bounds_ok(Rtree const& rt)
+{
+    are_soa_bounds_ok<Rtree> v;
+    bgi::detail::rtree::utilities::view<Rtree>(rt).apply_visitor(v);
+    return v.result;
+}
+
+#endif // BOOST_GEOMETRY_INDEX_TEST_RTREE_SOA_LAYOUT_HPP
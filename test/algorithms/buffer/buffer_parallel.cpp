@@ -0,0 +1,195 @@
+// Boost.Geometry
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <cstddef>
+#include <sstream>
+#include <string>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/algorithms/area.hpp>
+#include <boost/geometry/algorithms/buffer.hpp>
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/num_points.hpp>
+
+#include <boost/geometry/geometries/linestring.hpp>
+#include <boost/geometry/geometries/multi_linestring.hpp>
+#include <boost/geometry/geometries/multi_point.hpp>
+#include <boost/geometry/geometries/multi_polygon.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/geometries/polygon.hpp>
+
+#include <boost/geometry/iterators/point_iterator.hpp>
+
+#include <boost/geometry/strategies/strategies.hpp>
+
+#include <boost/geometry/io/wkt/read.hpp>
+
+#include <boost/geometry/util/parallel.hpp>
+
+
+// Star-shaped polygon with concave corners
+template <typename Polygon>
+inline void make_star(Polygon& poly, double cx, double cy)
+{
+    typedef typename bg::point_type<Polygon>::type point_type;
+
+    int const n = 24;
+    for (int k = 0 ; k < n ; ++k)
+    {
+        double const a = 2 * 3.1415926535897932 * k / n;
+        double const r = k % 2 == 0 ? 8 : 4;
+        bg::exterior_ring(poly).push_back(
+            point_type(cx + r * std::cos(a), cy + r * std::sin(a)));
+    }
+    bg::correct(poly);
+}
+
+template <typename MultiPolygon>
+inline void check_equal(MultiPolygon const& result, MultiPolygon const& expected,
+                        std::string const& caseid)
+{
+    BOOST_CHECK_MESSAGE(result.size() == expected.size(),
+                        caseid << " polygons: " << result.size()
+                               << " expected: " << expected.size());
+    BOOST_CHECK_MESSAGE(bg::num_points(result) == bg::num_points(expected),
+                        caseid << " points: " << bg::num_points(result)
+                               << " expected: " << bg::num_points(expected));
+    if (bg::num_points(result) != bg::num_points(expected))
+    {
+        return;
+    }
+
+    bool equal = true;
+    bg::point_iterator<MultiPolygon const> it1 = bg::points_begin(result);
+    bg::point_iterator<MultiPolygon const> it2 = bg::points_begin(expected);
+    for ( ; it1 != bg::points_end(result) ; ++it1, ++it2)
+    {
+        equal = equal && bg::get<0>(*it1) == bg::get<0>(*it2)
+                      && bg::get<1>(*it1) == bg::get<1>(*it2);
+    }
+    BOOST_CHECK_MESSAGE(equal, caseid << " different points");
+}
+
+template <typename MultiPolygon>
+inline void check_area(MultiPolygon const& result, MultiPolygon const& expected,
+                       std::string const& caseid)
+{
+    double const area = bg::area(result);
+    double const expected_area = bg::area(expected);
+
+    BOOST_CHECK_MESSAGE(expected_area > 0, caseid << " empty");
+    BOOST_CHECK_MESSAGE(std::fabs(area - expected_area) <= 1e-6 * expected_area,
+                        caseid << " area: " << area << " expected: " << expected_area);
+}
+
+// Compares the results of the sequential and the parallel buffer. The
+// results have to be the same for single geometries and the same areas
+// have to be covered for multi-geometries.
+template <bool Multi, typename Geometry, typename MultiPolygon, typename Distance, typename Join, typename End, typename PointStrategy>
+inline void test_one(std::string const& caseid, Geometry const& geometry,
+                     MultiPolygon&,
+                     Distance const& distance, Join const& join, End const& end,
+                     PointStrategy const& point_strategy)
+{
+    bg::strategy::buffer::side_straight side;
+
+    MultiPolygon expected;
+    bg::buffer(geometry, expected, distance, side, join, end, point_strategy);
+
+    for (std::size_t threads = 1 ; threads <= 4 ; threads *= 2)
+    {
+        MultiPolygon result;
+        bg::buffer(bg::execution::parallel_policy(threads), geometry, result,
+                   distance, side, join, end, point_strategy);
+
+        std::ostringstream out;
+        out << caseid << " threads: " << threads;
+
+        if (Multi && threads > 1)
+        {
+            check_area(result, expected, out.str());
+        }
+        else
+        {
+            check_equal(result, expected, out.str());
+        }
+    }
+}
+
+template <typename P>
+void test_all()
+{
+    typedef bg::model::polygon<P> polygon_type;
+    typedef bg::model::multi_polygon<polygon_type> multi_polygon_type;
+    typedef bg::model::linestring<P> linestring_type;
+    typedef bg::model::multi_linestring<linestring_type> multi_linestring_type;
+    typedef bg::model::multi_point<P> multi_point_type;
+
+    bg::strategy::buffer::join_round join_round(12);
+    bg::strategy::buffer::join_miter join_miter;
+    bg::strategy::buffer::end_round end_round(12);
+    bg::strategy::buffer::end_flat end_flat;
+    bg::strategy::buffer::point_circle circle(12);
+    bg::strategy::buffer::distance_symmetric<double> inflate(1.5);
+    bg::strategy::buffer::distance_symmetric<double> deflate(-0.5);
+
+    multi_polygon_type mp;
+
+    polygon_type star;
+    make_star(star, 0, 0);
+    test_one<false>("star_round", star, mp, inflate, join_round, end_flat, circle);
+    test_one<false>("star_miter", star, mp, inflate, join_miter, end_flat, circle);
+    test_one<false>("star_deflate", star, mp, deflate, join_round, end_flat, circle);
+
+    multi_polygon_type stars;
+    for (int i = 0 ; i < 5 ; ++i)
+    {
+        for (int j = 0 ; j < 5 ; ++j)
+        {
+            polygon_type poly;
+            make_star(poly, i * 18, j * 18 + (i % 2) * 5);
+            stars.push_back(poly);
+        }
+    }
+    test_one<true>("stars_round", stars, mp, inflate, join_round, end_flat, circle);
+    test_one<true>("stars_miter", stars, mp, inflate, join_miter, end_flat, circle);
+    test_one<true>("stars_deflate", stars, mp, deflate, join_round, end_flat, circle);
+
+    multi_polygon_type one_star;
+    one_star.push_back(star);
+    test_one<false>("one_star", one_star, mp, inflate, join_round, end_flat, circle);
+
+    linestring_type ls;
+    bg::read_wkt("LINESTRING(0 0,4 5,8 0,12 5,16 0,20 5)", ls);
+    test_one<false>("ls", ls, mp, inflate, join_round, end_round, circle);
+
+    multi_linestring_type mls;
+    bg::read_wkt("MULTILINESTRING((0 0,4 5,8 0,12 5),(0 3,12 3),(6 -2,6 8),(20 0,20 5))", mls);
+    test_one<true>("mls_round", mls, mp, inflate, join_round, end_round, circle);
+    test_one<true>("mls_flat", mls, mp, inflate, join_miter, end_flat, circle);
+
+    multi_point_type mpt;
+    for (int i = 0 ; i < 10 ; ++i)
+    {
+        for (int j = 0 ; j < 10 ; ++j)
+        {
+            mpt.push_back(P(i * 2.0, j * 2.0 + (i % 3)));
+        }
+    }
+    test_one<true>("mpt", mpt, mp, inflate, join_round, end_round, circle);
+}
+
+int test_main(int, char* [])
+{
+    test_all<bg::model::d2::point_xy<double> >();
+
+    return 0;
+}
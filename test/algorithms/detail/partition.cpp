@@ -1,7 +1,7 @@
 // Boost.Geometry (aka GGL, Generic Geometry Library)
 //
 // Copyright (c) 2007-2015 Barend Gehrels, Amsterdam, the Netherlands.
-// Copyright (c) 2017 Adam Wulkiewicz, Lodz, Poland.
+// Copyright (c) 2017-2018 Adam Wulkiewicz, Lodz, Poland.
 //
 // This file was modified by Oracle on 2017.
 // Modifications copyright (c) 2017 Oracle and/or its affiliates.
@@ -11,6 +11,11 @@
 // Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
 // http://www.boost.org/LICENSE_1_0.txt)
 
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+
 #include <geometry_test_common.hpp>
 
 #include <algorithms/test_overlay.hpp>
@@ -134,6 +139,38 @@ struct reversed_point_in_box_visitor
 };
 
 
+// Stores the ids of visited pairs, may be used by the parallel partition
+struct pairs_visitor
+{
+    std::vector<std::pair<int, int> > pairs;
+    std::size_t max_count;
+
+    explicit pairs_visitor(std::size_t max = (std::numeric_limits<std::size_t>::max)())
+        : max_count(max)
+    {}
+
+    template <typename Item1, typename Item2>
+    inline bool apply(Item1 const& item1, Item2 const& item2)
+    {
+        if (pairs.size() >= max_count)
+        {
+            return false; // interrupt
+        }
+        pairs.push_back(std::make_pair(item1.id, item2.id));
+        return true;
+    }
+
+    pairs_visitor split() const
+    {
+        return pairs_visitor(max_count);
+    }
+
+    void join(pairs_visitor const& other)
+    {
+        pairs.insert(pairs.end(), other.pairs.begin(), other.pairs.end());
+    }
+};
+
 
 template <typename Box>
 void test_boxes(std::string const& wkt_box_list, double expected_area, int expected_count)
@@ -642,6 +679,52 @@ void test_heterogenuous_collections(int seed1, int seed2, int size, int count)
     BOOST_CHECK_EQUAL(visitor2.count, expected_count);
 }
 
+void test_parallel(int seed1, int seed2, int size, int count, std::size_t threads)
+{
+    typedef bg::model::box<point_item> box_type;
+    typedef bg::partition<box_type> partition_type;
+    std::vector<box_item<box_type> > boxes1, boxes2;
+
+    fill_boxes(boxes1, seed1, size, count);
+    fill_boxes(boxes2, seed2, size, count);
+
+    bg::execution::parallel_policy const policy(threads);
+
+    // The same pairs have to be visited in the same order
+    {
+        pairs_visitor expected, visitor;
+        partition_type::apply(boxes1, expected, get_box(), ovelaps_box(), 2);
+        partition_type::apply(policy, boxes1, visitor, get_box(), ovelaps_box(), 2);
+        BOOST_CHECK(visitor.pairs == expected.pairs);
+    }
+
+    {
+        pairs_visitor expected, visitor;
+        partition_type::apply(boxes1, boxes2, expected, get_box(), ovelaps_box(),
+                              get_box(), ovelaps_box(), 2);
+        partition_type::apply(policy, boxes1, boxes2, visitor, get_box(), ovelaps_box(),
+                              get_box(), ovelaps_box(), 2);
+        BOOST_CHECK(visitor.pairs == expected.pairs);
+
+        pairs_visitor default_expected, default_visitor;
+        partition_type::apply(boxes1, boxes2, default_expected, get_box(), ovelaps_box());
+        partition_type::apply(policy, boxes1, boxes2, default_visitor, get_box(), ovelaps_box());
+        BOOST_CHECK(default_visitor.pairs == default_expected.pairs);
+    }
+
+    // Interrupted, the pairs visited before the interruption are stored
+    {
+        std::size_t const max_count = 5;
+        pairs_visitor expected(max_count), visitor(max_count);
+        bool const expected_result = partition_type::apply(boxes1, expected, get_box(), ovelaps_box(), 2);
+        bool const result = partition_type::apply(policy, boxes1, visitor, get_box(), ovelaps_box(), 2);
+        BOOST_CHECK_EQUAL(result, expected_result);
+        BOOST_CHECK(visitor.pairs.size() <= expected.pairs.size());
+        BOOST_CHECK(std::equal(visitor.pairs.begin(), visitor.pairs.end(),
+                               expected.pairs.begin()));
+    }
+}
+
 int test_main( int , char* [] )
 {
     test_all<bg::model::d2::point_xy<double> >();
@@ -666,5 +749,9 @@ int test_main( int , char* [] )
 
     test_heterogenuous_collections(67890, 98765, 20, 60);
 
+    test_parallel(12345, 54321, 20, 100, 1);
+    test_parallel(12345, 54321, 20, 100, 4);
+    test_parallel(67890, 98765, 30, 200, 3);
+
     return 0;
 }
@@ -0,0 +1,176 @@
+// Boost.Geometry
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/detail/overlay/get_turns.hpp>
+#include <boost/geometry/algorithms/detail/overlay/self_turn_points.hpp>
+#include <boost/geometry/policies/robustness/get_rescale_policy.hpp>
+
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/multi_polygon.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/geometries/polygon.hpp>
+
+#include <boost/geometry/strategies/strategies.hpp>
+
+#include <boost/geometry/io/wkt/read.hpp>
+
+#include <boost/geometry/util/parallel.hpp>
+
+
+// Star-shaped polygons placed in a grid, each one overlapping its neighbours
+template <typename MultiPolygon>
+inline void fill_stars(MultiPolygon& mpoly, int count, double offset)
+{
+    typedef typename boost::range_value<MultiPolygon>::type polygon_type;
+    typedef typename bg::point_type<MultiPolygon>::type point_type;
+
+    for (int i = 0 ; i < count ; ++i)
+    {
+        for (int j = 0 ; j < count ; ++j)
+        {
+            polygon_type poly;
+            double const cx = i * 10 + offset;
+            double const cy = j * 10 + offset;
+            int const n = 24;
+            for (int k = 0 ; k < n ; ++k)
+            {
+                double const a = 2 * 3.1415926535897932 * k / n;
+                double const r = k % 2 == 0 ? 8 : 4;
+                bg::exterior_ring(poly).push_back(
+                    point_type(cx + r * std::cos(a), cy + r * std::sin(a)));
+            }
+            bg::correct(poly);
+            mpoly.push_back(poly);
+        }
+    }
+}
+
+template <typename Turns>
+inline void check_turns(Turns const& turns, Turns const& expected)
+{
+    BOOST_CHECK_EQUAL(turns.size(), expected.size());
+    if (turns.size() != expected.size())
+    {
+        return;
+    }
+
+    for (std::size_t i = 0 ; i < turns.size() ; ++i)
+    {
+        BOOST_CHECK(turns[i].operations[0].seg_id == expected[i].operations[0].seg_id);
+        BOOST_CHECK(turns[i].operations[1].seg_id == expected[i].operations[1].seg_id);
+        BOOST_CHECK(turns[i].method == expected[i].method);
+        BOOST_CHECK(bg::get<0>(turns[i].point) == bg::get<0>(expected[i].point));
+        BOOST_CHECK(bg::get<1>(turns[i].point) == bg::get<1>(expected[i].point));
+    }
+}
+
+template <typename Point>
+void test_all(std::size_t threads)
+{
+    typedef bg::model::polygon<Point> polygon_type;
+    typedef bg::model::multi_polygon<polygon_type> multi_polygon_type;
+    typedef bg::model::box<Point> box_type;
+
+    typedef typename bg::strategy::intersection::services::default_strategy
+        <
+            typename bg::cs_tag<Point>::type
+        >::type strategy_type;
+    typedef typename bg::rescale_policy_type<Point>::type rescale_policy_type;
+    typedef bg::detail::overlay::turn_info
+        <
+            Point,
+            typename bg::segment_ratio_type<Point, rescale_policy_type>::type
+        > turn_info;
+    typedef std::vector<turn_info> turns_type;
+
+    bg::execution::parallel_policy const policy(threads);
+    strategy_type strategy;
+
+    multi_polygon_type mpoly1, mpoly2;
+    fill_stars(mpoly1, 8, 0);
+    fill_stars(mpoly2, 8, 3);
+
+    rescale_policy_type robust_policy
+        = bg::get_rescale_policy<rescale_policy_type>(mpoly1, mpoly2);
+
+    // two geometries
+    {
+        turns_type expected, turns;
+        bg::detail::get_turns::no_interrupt_policy interrupt_policy;
+
+        bg::get_turns
+            <
+                false, false, bg::detail::overlay::assign_null_policy
+            >(mpoly1, mpoly2, strategy, robust_policy, expected, interrupt_policy);
+        bg::get_turns
+            <
+                false, false, bg::detail::overlay::assign_null_policy
+            >(policy, mpoly1, mpoly2, strategy, robust_policy, turns, interrupt_policy);
+
+        BOOST_CHECK(! expected.empty());
+        check_turns(turns, expected);
+    }
+
+    // geometry and box, calculated sequentially
+    {
+        box_type box;
+        bg::read_wkt("BOX(5 5, 35 35)", box);
+
+        turns_type expected, turns;
+        bg::detail::get_turns::no_interrupt_policy interrupt_policy;
+
+        bg::get_turns
+            <
+                false, false, bg::detail::overlay::assign_null_policy
+            >(mpoly1, box, strategy, robust_policy, expected, interrupt_policy);
+        bg::get_turns
+            <
+                false, false, bg::detail::overlay::assign_null_policy
+            >(policy, mpoly1, box, strategy, robust_policy, turns, interrupt_policy);
+
+        BOOST_CHECK(! expected.empty());
+        check_turns(turns, expected);
+    }
+
+    // self turns
+    {
+        turns_type expected, turns;
+        bg::detail::self_get_turn_points::no_interrupt_policy interrupt_policy;
+
+        bg::self_turns
+            <
+                bg::detail::overlay::assign_null_policy
+            >(mpoly1, strategy, robust_policy, expected, interrupt_policy);
+        bg::self_turns
+            <
+                bg::detail::overlay::assign_null_policy
+            >(policy, mpoly1, strategy, robust_policy, turns, interrupt_policy);
+
+        BOOST_CHECK(! expected.empty());
+        check_turns(turns, expected);
+    }
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::d2::point_xy<double> point_type;
+
+    test_all<point_type>(1);
+    test_all<point_type>(2);
+    test_all<point_type>(4);
+
+    return 0;
+}
@@ -0,0 +1,213 @@
+// Boost.Geometry
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/algorithms/area.hpp>
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/difference.hpp>
+#include <boost/geometry/algorithms/equals.hpp>
+#include <boost/geometry/algorithms/intersection.hpp>
+#include <boost/geometry/algorithms/num_points.hpp>
+#include <boost/geometry/algorithms/union.hpp>
+
+#include <boost/geometry/geometries/multi_polygon.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/geometries/polygon.hpp>
+
+#include <boost/geometry/strategies/strategies.hpp>
+
+#include <boost/geometry/io/wkt/read.hpp>
+
+#include <boost/geometry/util/parallel.hpp>
+
+
+// Star-shaped polygons placed in a grid, each one overlapping its neighbours
+template <typename MultiPolygon>
+inline void fill_stars(MultiPolygon& mpoly, int count, double offset)
+{
+    typedef typename boost::range_value<MultiPolygon>::type polygon_type;
+    typedef typename bg::point_type<MultiPolygon>::type point_type;
+
+    for (int i = 0 ; i < count ; ++i)
+    {
+        for (int j = 0 ; j < count ; ++j)
+        {
+            polygon_type poly;
+            double const cx = i * 10 + offset;
+            double const cy = j * 10 + offset;
+            int const n = 24;
+            for (int k = 0 ; k < n ; ++k)
+            {
+                double const a = 2 * 3.1415926535897932 * k / n;
+                double const r = k % 2 == 0 ? 8 : 4;
+                bg::exterior_ring(poly).push_back(
+                    point_type(cx + r * std::cos(a), cy + r * std::sin(a)));
+            }
+            bg::correct(poly);
+            mpoly.push_back(poly);
+        }
+    }
+}
+
+// The parallel version should generate exactly the same output
+template <typename MultiPolygon>
+inline void check_equal(MultiPolygon const& result, MultiPolygon const& expected)
+{
+    BOOST_CHECK(! expected.empty());
+    BOOST_CHECK_EQUAL(result.size(), expected.size());
+    BOOST_CHECK_EQUAL(bg::num_points(result), bg::num_points(expected));
+    BOOST_CHECK_EQUAL(bg::area(result), bg::area(expected));
+    BOOST_CHECK(bg::equals(result, expected));
+}
+
+template <bg::overlay_type OverlayType, bool ReverseSecond, typename MultiPolygon>
+inline void test_timings(MultiPolygon const& mpoly1, MultiPolygon const& mpoly2,
+                         std::size_t threads)
+{
+    typedef typename boost::range_value<MultiPolygon>::type polygon_type;
+    typedef typename bg::point_type<MultiPolygon>::type point_type;
+    typedef typename bg::rescale_overlay_policy_type
+        <
+            MultiPolygon, MultiPolygon
+        >::type rescale_policy_type;
+    typedef typename bg::strategy::intersection::services::default_strategy
+        <
+            typename bg::cs_tag<point_type>::type
+        >::type strategy_type;
+    typedef bg::detail::overlay::overlay
+        <
+            MultiPolygon, MultiPolygon, false, ReverseSecond, false,
+            polygon_type, OverlayType
+        > overlay_type;
+
+    rescale_policy_type robust_policy
+        = bg::get_rescale_policy<rescale_policy_type>(mpoly1, mpoly2);
+    strategy_type strategy;
+    bg::detail::overlay::overlay_null_visitor visitor;
+
+    MultiPolygon expected, result;
+    bg::overlay_timings timings, parallel_timings;
+
+    overlay_type::apply(mpoly1, mpoly2, robust_policy,
+                        bg::range::back_inserter(expected),
+                        strategy, visitor, timings);
+    overlay_type::apply(bg::execution::parallel_policy(threads),
+                        mpoly1, mpoly2, robust_policy,
+                        bg::range::back_inserter(result),
+                        strategy, visitor, parallel_timings);
+
+    check_equal(result, expected);
+
+    BOOST_CHECK(timings.get_turns >= 0 && parallel_timings.get_turns >= 0);
+    BOOST_CHECK(timings.self_turns >= 0 && parallel_timings.self_turns >= 0);
+    BOOST_CHECK(timings.enrich >= 0 && parallel_timings.enrich >= 0);
+    BOOST_CHECK(timings.traverse >= 0 && parallel_timings.traverse >= 0);
+    BOOST_CHECK(timings.select_rings >= 0 && parallel_timings.select_rings >= 0);
+    BOOST_CHECK(timings.assign_parents >= 0 && parallel_timings.assign_parents >= 0);
+    BOOST_CHECK(timings.add_rings >= 0 && parallel_timings.add_rings >= 0);
+}
+
+template <typename Point>
+void test_all(std::size_t threads)
+{
+    typedef bg::model::polygon<Point> polygon_type;
+    typedef bg::model::multi_polygon<polygon_type> multi_polygon_type;
+
+    bg::execution::parallel_policy const policy(threads);
+
+    multi_polygon_type mpoly1, mpoly2;
+    fill_stars(mpoly1, 8, 0);
+    fill_stars(mpoly2, 8, 3);
+
+    {
+        multi_polygon_type expected, result;
+        bg::union_(mpoly1, mpoly2, expected);
+        bg::union_(mpoly1, mpoly2, result, policy);
+        check_equal(result, expected);
+    }
+
+    {
+        multi_polygon_type expected, result;
+        bg::intersection(mpoly1, mpoly2, expected);
+        bg::intersection(mpoly1, mpoly2, result, policy);
+        check_equal(result, expected);
+    }
+
+    {
+        multi_polygon_type expected, result;
+        bg::difference(mpoly1, mpoly2, expected);
+        bg::difference(mpoly1, mpoly2, result, policy);
+        check_equal(result, expected);
+    }
+
+    // polygon with holes
+    {
+        polygon_type poly;
+        bg::read_wkt("POLYGON((-5 -5,-5 80,80 80,80 -5,-5 -5),"
+                     "(10 10,30 10,30 30,10 30,10 10),"
+                     "(40 40,60 40,60 60,40 60,40 40))", poly);
+
+        multi_polygon_type expected, result;
+        bg::difference(poly, mpoly2, expected);
+        bg::difference(poly, mpoly2, result, policy);
+        check_equal(result, expected);
+    }
+
+    // timings reported by the algorithms
+    {
+        multi_polygon_type expected, result;
+        bg::overlay_timings timings;
+        bg::union_(mpoly1, mpoly2, expected);
+        bg::union_(mpoly1, mpoly2, result, policy, timings);
+        check_equal(result, expected);
+        BOOST_CHECK(timings.get_turns >= 0 && timings.traverse >= 0);
+
+        double const traverse = timings.traverse;
+        expected.clear();
+        result.clear();
+        bg::intersection(mpoly1, mpoly2, expected);
+        bg::intersection(mpoly1, mpoly2, result, policy, timings);
+        check_equal(result, expected);
+        BOOST_CHECK(timings.traverse >= traverse);
+
+        expected.clear();
+        result.clear();
+        bg::difference(mpoly1, mpoly2, expected);
+        bg::difference(mpoly1, mpoly2, result, policy, timings);
+        check_equal(result, expected);
+    }
+
+    // std::vector of polygons
+    {
+        std::vector<polygon_type> expected, result;
+        bg::union_(mpoly1, mpoly2, expected);
+        bg::union_(mpoly1, mpoly2, result, policy);
+        BOOST_CHECK_EQUAL(result.size(), expected.size());
+        BOOST_CHECK_EQUAL(bg::num_points(result.front()), bg::num_points(expected.front()));
+    }
+
+    test_timings<bg::overlay_union, false>(mpoly1, mpoly2, threads);
+    test_timings<bg::overlay_difference, true>(mpoly1, mpoly2, threads);
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::d2::point_xy<double> point_type;
+
+    test_all<point_type>(1);
+    test_all<point_type>(2);
+    test_all<point_type>(4);
+
+    return 0;
+}
@@ -0,0 +1,239 @@
+// Boost.Geometry
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/algorithms/area.hpp>
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/equals.hpp>
+#include <boost/geometry/algorithms/is_valid.hpp>
+#include <boost/geometry/algorithms/make.hpp>
+#include <boost/geometry/algorithms/num_interior_rings.hpp>
+#include <boost/geometry/algorithms/transform.hpp>
+#include <boost/geometry/algorithms/unary_union.hpp>
+#include <boost/geometry/algorithms/union.hpp>
+
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/multi_polygon.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/geometries/polygon.hpp>
+
+#include <boost/geometry/strategies/strategies.hpp>
+
+#include <boost/geometry/io/wkt/read.hpp>
+
+#include <boost/geometry/util/parallel.hpp>
+
+
+// Squares of size 2 with the lower left corners at (i, j) for
+// i, j in [0, count) so each one overlaps its neighbours
+template <typename Polygon>
+inline void fill_squares(std::vector<Polygon>& polygons, int count)
+{
+    typedef typename bg::point_type<Polygon>::type point_type;
+
+    for (int i = 0 ; i < count ; ++i)
+    {
+        for (int j = 0 ; j < count ; ++j)
+        {
+            Polygon poly;
+            bg::exterior_ring(poly).push_back(bg::make<point_type>(i, j));
+            bg::exterior_ring(poly).push_back(bg::make<point_type>(i, j + 2));
+            bg::exterior_ring(poly).push_back(bg::make<point_type>(i + 2, j + 2));
+            bg::exterior_ring(poly).push_back(bg::make<point_type>(i + 2, j));
+            bg::exterior_ring(poly).push_back(bg::make<point_type>(i, j));
+            polygons.push_back(poly);
+        }
+    }
+}
+
+// Star-shaped polygons placed in a grid, each one overlapping its neighbours
+template <typename Polygon>
+inline void fill_stars(std::vector<Polygon>& polygons, int count, double offset)
+{
+    typedef typename bg::point_type<Polygon>::type point_type;
+
+    for (int i = 0 ; i < count ; ++i)
+    {
+        for (int j = 0 ; j < count ; ++j)
+        {
+            Polygon poly;
+            double const cx = i * 10 + offset;
+            double const cy = j * 10 + offset;
+            int const n = 24;
+            for (int k = 0 ; k < n ; ++k)
+            {
+                double const a = 2 * 3.1415926535897932 * k / n;
+                double const r = k % 2 == 0 ? 8 : 4;
+                bg::exterior_ring(poly).push_back(
+                    point_type(cx + r * std::cos(a), cy + r * std::sin(a)));
+            }
+            bg::correct(poly);
+            polygons.push_back(poly);
+        }
+    }
+}
+
+template <typename Polygons, typename MultiPolygon>
+inline void fold_union(Polygons const& polygons, MultiPolygon& result)
+{
+    for (std::size_t i = 0 ; i < polygons.size() ; ++i)
+    {
+        MultiPolygon temp;
+        bg::union_(result, polygons[i], temp);
+        result.swap(temp);
+    }
+}
+
+template <typename Polygons, typename MultiPolygon>
+inline void test_unary_union(std::string const& caseid,
+                             Polygons const& polygons,
+                             MultiPolygon const& expected,
+                             std::size_t expected_count,
+                             std::size_t expected_holes,
+                             bool check_equals = true)
+{
+    MultiPolygon result;
+    bg::unary_union(polygons, result);
+
+    BOOST_CHECK_MESSAGE(result.size() == expected_count,
+                        caseid << " #polygons expected: " << expected_count
+                        << " detected: " << result.size());
+    BOOST_CHECK_MESSAGE(bg::num_interior_rings(result) == expected_holes,
+                        caseid << " #holes expected: " << expected_holes
+                        << " detected: " << bg::num_interior_rings(result));
+    BOOST_CHECK_MESSAGE(bg::is_valid(result), caseid << " not valid");
+    BOOST_CHECK_CLOSE(bg::area(result), bg::area(expected), 0.0001);
+    if (check_equals)
+    {
+        BOOST_CHECK_MESSAGE(bg::equals(result, expected), caseid << " not equal");
+    }
+
+    // The parallel version should generate exactly the same output
+    for (std::size_t threads = 1 ; threads <= 4 ; threads *= 2)
+    {
+        MultiPolygon parallel_result;
+        bg::unary_union(bg::execution::parallel_policy(threads),
+                        polygons, parallel_result);
+
+        BOOST_CHECK_EQUAL(parallel_result.size(), result.size());
+        BOOST_CHECK_EQUAL(bg::area(parallel_result), bg::area(result));
+        BOOST_CHECK(bg::equals(parallel_result, result));
+    }
+}
+
+template <typename Point>
+void test_all()
+{
+    typedef bg::model::polygon<Point> polygon_type;
+    typedef bg::model::multi_polygon<polygon_type> multi_polygon_type;
+    typedef bg::model::box<Point> box_type;
+
+    {
+        std::vector<polygon_type> polygons;
+        fill_squares(polygons, 20);
+
+        multi_polygon_type expected;
+        bg::read_wkt("MULTIPOLYGON(((0 0,0 21,21 21,21 0,0 0)))", expected);
+
+        test_unary_union("squares", polygons, expected, 1, 0);
+    }
+
+    {
+        std::vector<polygon_type> polygons;
+        fill_stars(polygons, 12, 0);
+
+        // the union calculated in different order may have slightly
+        // different coordinates of the intersection points
+        multi_polygon_type expected;
+        fold_union(polygons, expected);
+
+        test_unary_union("stars", polygons, expected,
+                         expected.size(), bg::num_interior_rings(expected),
+                         false);
+    }
+
+    // separate clusters, the one in the middle forming a ring
+    {
+        std::vector<polygon_type> polygons;
+        fill_squares(polygons, 3);
+        std::vector<polygon_type> frame;
+        fill_squares(frame, 4);
+        for (std::size_t i = 0 ; i < frame.size() ; ++i)
+        {
+            if (i != 5 && i != 6 && i != 9 && i != 10)
+            {
+                polygon_type poly;
+                bg::transform(frame[i], poly,
+                    bg::strategy::transform::translate_transformer<double, 2, 2>(10, 0));
+                polygons.push_back(poly);
+            }
+        }
+
+        multi_polygon_type expected;
+        bg::read_wkt("MULTIPOLYGON(((0 0,0 4,4 4,4 0,0 0)),"
+                     "((10 0,10 5,15 5,15 0,10 0),(12 2,13 2,13 3,12 3,12 2)))",
+                     expected);
+
+        test_unary_union("clusters", polygons, expected, 2, 1);
+    }
+
+    // boxes converted to polygons
+    {
+        std::vector<box_type> boxes;
+        boxes.push_back(bg::make<box_type>(0, 0, 2, 2));
+        boxes.push_back(bg::make<box_type>(1, 1, 3, 3));
+        boxes.push_back(bg::make<box_type>(5, 5, 6, 6));
+
+        multi_polygon_type expected;
+        bg::read_wkt("MULTIPOLYGON(((0 0,0 2,1 2,1 3,3 3,3 1,2 1,2 0,0 0)),"
+                     "((5 5,5 6,6 6,6 5,5 5)))", expected);
+
+        test_unary_union("boxes", boxes, expected, 2, 0);
+    }
+
+    // rings converted to polygons
+    {
+        std::vector<polygon_type> polygons;
+        fill_squares(polygons, 2);
+        std::vector<typename bg::ring_type<polygon_type>::type> rings;
+        for (std::size_t i = 0 ; i < polygons.size() ; ++i)
+        {
+            rings.push_back(bg::exterior_ring(polygons[i]));
+        }
+
+        multi_polygon_type expected;
+        bg::read_wkt("MULTIPOLYGON(((0 0,0 3,3 3,3 0,0 0)))", expected);
+
+        test_unary_union("rings", rings, expected, 1, 0);
+    }
+
+    // empty input
+    {
+        std::vector<polygon_type> polygons;
+        multi_polygon_type result;
+        bg::unary_union(polygons, result);
+        BOOST_CHECK(result.empty());
+
+        polygons.resize(2);
+        bg::unary_union(polygons, result);
+        BOOST_CHECK(result.empty());
+    }
+}
+
+int test_main(int, char* [])
+{
+    test_all<bg::model::d2::point_xy<double> >();
+
+    return 0;
+}
@@ -11,6 +11,7 @@
 
 #include <geometry_test_common.hpp>
 
+#include <boost/algorithm/string/trim.hpp>
 #include <boost/config.hpp>
 #include <boost/geometry/algorithms/for_each.hpp>
 
@@ -0,0 +1,124 @@
+// Boost.Geometry
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <string>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/algorithms/correct.hpp>
+#include <boost/geometry/algorithms/covered_by.hpp>
+#include <boost/geometry/algorithms/polygon_grid.hpp>
+#include <boost/geometry/algorithms/within.hpp>
+
+#include <boost/geometry/geometries/multi_polygon.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/geometries/polygon.hpp>
+#include <boost/geometry/geometries/ring.hpp>
+
+#include <boost/geometry/strategies/strategies.hpp>
+
+#include <boost/geometry/io/wkt/read.hpp>
+
+
+template <typename Point, typename Geometry>
+void check_point(Point const& point, bg::polygon_grid<Geometry> const& grid,
+                 Geometry const& geometry)
+{
+    BOOST_CHECK_MESSAGE(bg::within(point, grid) == bg::within(point, geometry),
+                        "within " << bg::wkt(point) << " " << bg::wkt(geometry));
+    BOOST_CHECK_MESSAGE(bg::covered_by(point, grid) == bg::covered_by(point, geometry),
+                        "covered_by " << bg::wkt(point) << " " << bg::wkt(geometry));
+}
+
+// Compares the results for the points of a grid covering the geometry,
+// including the vertices and the points on the segments
+template <typename Point, typename Geometry>
+void test_points(std::string const& wkt, double min_c, double max_c, double step)
+{
+    Geometry geometry;
+    bg::read_wkt(wkt, geometry);
+
+    bg::polygon_grid<Geometry> const grid(geometry);
+
+    BOOST_CHECK(grid.cells_count() > 1);
+
+    for (double x = min_c ; x <= max_c ; x += step)
+    {
+        for (double y = min_c ; y <= max_c ; y += step)
+        {
+            check_point(Point(x, y), grid, geometry);
+        }
+    }
+}
+
+// Polygon with many segments having vertices at the boundaries of cells
+template <typename Point, typename Polygon>
+void test_star(int n)
+{
+    Polygon poly;
+    for (int k = 0 ; k < n ; ++k)
+    {
+        double const a = 2 * 3.1415926535897932 * k / n;
+        double const r = k % 2 == 0 ? 100 : 60;
+        bg::exterior_ring(poly).push_back(
+            Point(std::floor(r * std::cos(a)), std::floor(r * std::sin(a))));
+    }
+    bg::correct(poly);
+
+    bg::polygon_grid<Polygon> const grid(poly);
+
+    BOOST_CHECK(grid.cells_count() > 1);
+
+    for (int x = -101 ; x <= 101 ; ++x)
+    {
+        for (int y = -101 ; y <= 101 ; y += 3)
+        {
+            check_point(Point(x, y), grid, poly);
+        }
+    }
+}
+
+template <typename P, bool ClockWise, bool Closed>
+void test_all()
+{
+    typedef bg::model::ring<P, ClockWise, Closed> ring_type;
+    typedef bg::model::polygon<P, ClockWise, Closed> polygon_type;
+    typedef bg::model::multi_polygon<polygon_type> multi_polygon_type;
+
+    std::string const ring = ClockWise
+        ? (Closed ? "POLYGON((0 0,0 4,2 6,4 4,4 0,0 0))" : "POLYGON((0 0,0 4,2 6,4 4,4 0))")
+        : (Closed ? "POLYGON((0 0,4 0,4 4,2 6,0 4,0 0))" : "POLYGON((0 0,4 0,4 4,2 6,0 4))");
+    std::string const poly = ClockWise
+        ? "POLYGON((0 0,0 10,10 10,10 0,0 0),(2 2,6 2,6 6,2 6,2 2),(7 7,9 7,8 9,7 7))"
+        : "POLYGON((0 0,10 0,10 10,0 10,0 0),(2 2,2 6,6 6,6 2,2 2),(7 7,8 9,9 7,7 7))";
+    std::string const mpoly = ClockWise
+        ? "MULTIPOLYGON(((0 0,0 10,10 10,10 0,0 0),(2 2,6 2,6 6,2 6,2 2)),"
+          "((3 3,3 5,5 5,5 3,3 3)),((11 0,11 2,13 2,13 0,11 0)))"
+        : "MULTIPOLYGON(((0 0,10 0,10 10,0 10,0 0),(2 2,2 6,6 6,6 2,2 2)),"
+          "((3 3,5 3,5 5,3 5,3 3)),((11 0,13 0,13 2,11 2,11 0)))";
+
+    test_points<P, ring_type>(ring, -1, 7, 0.25);
+    test_points<P, polygon_type>(poly, -1, 11, 0.25);
+    test_points<P, multi_polygon_type>(mpoly, -1, 14, 0.25);
+
+    test_star<P, polygon_type>(400);
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::d2::point_xy<double> point_type;
+
+    test_all<point_type, true, true>();
+    test_all<point_type, false, true>();
+    test_all<point_type, true, false>();
+    test_all<point_type, false, false>();
+
+    return 0;
+}
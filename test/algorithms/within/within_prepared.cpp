@@ -0,0 +1,136 @@
+// Boost.Geometry
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <string>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/algorithms/covered_by.hpp>
+#include <boost/geometry/algorithms/intersects.hpp>
+#include <boost/geometry/algorithms/prepared.hpp>
+#include <boost/geometry/algorithms/within.hpp>
+
+#include <boost/geometry/geometries/box.hpp>
+#include <boost/geometry/geometries/linestring.hpp>
+#include <boost/geometry/geometries/multi_linestring.hpp>
+#include <boost/geometry/geometries/multi_point.hpp>
+#include <boost/geometry/geometries/multi_polygon.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/geometries/polygon.hpp>
+#include <boost/geometry/geometries/ring.hpp>
+
+#include <boost/geometry/strategies/strategies.hpp>
+
+#include <boost/geometry/io/wkt/read.hpp>
+
+
+// Compares the results for the points of a grid covering the geometry,
+// including the vertices and the points on the segments
+template <typename Point, typename Geometry>
+void test_points(std::string const& wkt, double min_c, double max_c, double step)
+{
+    Geometry geometry;
+    bg::read_wkt(wkt, geometry);
+
+    bg::prepared<Geometry> const prepared(geometry);
+
+    for (double x = min_c ; x <= max_c ; x += step)
+    {
+        for (double y = min_c ; y <= max_c ; y += step)
+        {
+            Point const point(x, y);
+            BOOST_CHECK_MESSAGE(bg::within(point, prepared) == bg::within(point, geometry),
+                                "within " << bg::wkt(point) << " " << wkt);
+            BOOST_CHECK_MESSAGE(bg::covered_by(point, prepared) == bg::covered_by(point, geometry),
+                                "covered_by " << bg::wkt(point) << " " << wkt);
+            BOOST_CHECK_MESSAGE(bg::intersects(point, prepared) == bg::intersects(point, geometry),
+                                "intersects " << bg::wkt(point) << " " << wkt);
+        }
+    }
+}
+
+template <typename Geometry, typename Prepared>
+void test_intersects(std::string const& wkt, Prepared const& prepared, bool expected)
+{
+    Geometry geometry;
+    bg::read_wkt(wkt, geometry);
+
+    BOOST_CHECK_MESSAGE(bg::intersects(geometry, prepared) == expected,
+                        "intersects " << wkt << " expected: " << expected);
+    BOOST_CHECK_MESSAGE(bg::intersects(geometry, prepared.geometry()) == expected,
+                        "intersects " << wkt << " not prepared, expected: " << expected);
+}
+
+template <typename P, bool ClockWise, bool Closed>
+void test_all()
+{
+    typedef bg::model::ring<P, ClockWise, Closed> ring_type;
+    typedef bg::model::polygon<P, ClockWise, Closed> polygon_type;
+    typedef bg::model::multi_polygon<polygon_type> multi_polygon_type;
+
+    std::string const ring = ClockWise
+        ? (Closed ? "POLYGON((0 0,0 4,2 6,4 4,4 0,0 0))" : "POLYGON((0 0,0 4,2 6,4 4,4 0))")
+        : (Closed ? "POLYGON((0 0,4 0,4 4,2 6,0 4,0 0))" : "POLYGON((0 0,4 0,4 4,2 6,0 4))");
+    std::string const poly = ClockWise
+        ? "POLYGON((0 0,0 10,10 10,10 0,0 0),(2 2,6 2,6 6,2 6,2 2),(7 7,9 7,8 9,7 7))"
+        : "POLYGON((0 0,10 0,10 10,0 10,0 0),(2 2,2 6,6 6,6 2,2 2),(7 7,8 9,9 7,7 7))";
+    std::string const mpoly = ClockWise
+        ? "MULTIPOLYGON(((0 0,0 10,10 10,10 0,0 0),(2 2,6 2,6 6,2 6,2 2)),"
+          "((3 3,3 5,5 5,5 3,3 3)),((11 0,11 2,13 2,13 0,11 0)))"
+        : "MULTIPOLYGON(((0 0,10 0,10 10,0 10,0 0),(2 2,2 6,6 6,6 2,2 2)),"
+          "((3 3,5 3,5 5,3 5,3 3)),((11 0,13 0,13 2,11 2,11 0)))";
+
+    test_points<P, ring_type>(ring, -1, 7, 0.5);
+    test_points<P, polygon_type>(poly, -1, 11, 0.5);
+    test_points<P, multi_polygon_type>(mpoly, -1, 14, 0.5);
+
+    multi_polygon_type geometry;
+    bg::read_wkt(mpoly, geometry);
+    bg::prepared<multi_polygon_type> const prepared(geometry);
+
+    BOOST_CHECK_EQUAL(prepared.segments_count(), 16u);
+
+    typedef bg::model::linestring<P> linestring_type;
+    typedef bg::model::multi_linestring<linestring_type> multi_linestring_type;
+    typedef bg::model::multi_point<P> multi_point_type;
+    typedef bg::model::box<P> box_type;
+    typedef bg::model::polygon<P> cw_polygon_type;
+
+    test_intersects<linestring_type>("LINESTRING(-1 -1,-1 11)", prepared, false);
+    test_intersects<linestring_type>("LINESTRING(-1 5,11 5)", prepared, true);
+    test_intersects<linestring_type>("LINESTRING(2.5 2.5,2.5 5.5)", prepared, false);
+    test_intersects<linestring_type>("LINESTRING(4 4,4.5 4.5)", prepared, true);
+    test_intersects<linestring_type>("LINESTRING(1 1,1 9)", prepared, true);
+    test_intersects<linestring_type>("LINESTRING(10 1,10 9)", prepared, true);
+    test_intersects<multi_linestring_type>("MULTILINESTRING((-1 -1,-1 11),(2.5 2.5,2.5 3))", prepared, false);
+    test_intersects<multi_linestring_type>("MULTILINESTRING((-1 -1,-1 11),(12 1,12 1.5))", prepared, true);
+    test_intersects<multi_point_type>("MULTIPOINT(-1 -1,2.5 2.5,10.5 0)", prepared, false);
+    test_intersects<multi_point_type>("MULTIPOINT(-1 -1,2.5 2.5,4 4)", prepared, true);
+    test_intersects<box_type>("BOX(2.5 2.5,2.8 2.8)", prepared, false);
+    test_intersects<box_type>("BOX(2.5 2.5,3.5 3.5)", prepared, true);
+    test_intersects<box_type>("BOX(-5 -5,20 20)", prepared, true);
+    test_intersects<box_type>("BOX(14 0,15 1)", prepared, false);
+    test_intersects<cw_polygon_type>("POLYGON((2.5 2.5,2.5 2.8,2.8 2.8,2.8 2.5,2.5 2.5))", prepared, false);
+    test_intersects<cw_polygon_type>("POLYGON((2.5 2.5,2.5 3.5,3.5 3.5,3.5 2.5,2.5 2.5))", prepared, true);
+    test_intersects<cw_polygon_type>("POLYGON((-5 -5,-5 20,20 20,20 -5,-5 -5))", prepared, true);
+    test_intersects<cw_polygon_type>("POLYGON((2.5 2.5,2.5 5.5,5.5 5.5,5.5 2.5,2.5 2.5))", prepared, true);
+    test_intersects<cw_polygon_type>("POLYGON((-5 -5,-5 20,20 20,20 -5,-5 -5),(-1 -1,14 -1,14 14,-1 14,-1 -1))", prepared, false);
+}
+
+int test_main(int, char* [])
+{
+    typedef bg::model::d2::point_xy<double> point_type;
+
+    test_all<point_type, true, true>();
+    test_all<point_type, false, true>();
+    test_all<point_type, true, false>();
+    test_all<point_type, false, false>();
+
+    return 0;
+}
@@ -0,0 +1,360 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cctype>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/core/ignore_unused.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/predef/other/endian.h>
+
+#include <boost/geometry/algorithms/area.hpp>
+#include <boost/geometry/algorithms/length.hpp>
+#include <boost/geometry/algorithms/num_interior_rings.hpp>
+#include <boost/geometry/algorithms/num_points.hpp>
+#include <boost/geometry/algorithms/within.hpp>
+#include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/io/wkb/wkb.hpp>
+#include <boost/geometry/io/wkt/read.hpp>
+#include <boost/geometry/io/wkt/write.hpp>
+#include <boost/geometry/strategies/strategies.hpp>
+
+typedef std::vector<unsigned char> bytes_type;
+
+typedef bg::model::point<double, 2, bg::cs::cartesian> point_type;
+typedef bg::model::point<double, 3, bg::cs::cartesian> point3d_type;
+typedef bg::model::point<double, 4, bg::cs::cartesian> point4d_type;
+typedef bg::model::linestring<point_type> linestring_type;
+typedef bg::model::polygon<point_type> polygon_type;
+
+bytes_type from_hex(std::string const& hex)
+{
+    bytes_type result;
+    for (std::size_t i = 0 ; i + 1 < hex.size() ; i += 2)
+    {
+        unsigned int value = 0;
+        std::istringstream in(hex.substr(i, 2));
+        in >> std::hex >> value;
+        result.push_back(static_cast<unsigned char>(value));
+    }
+    return result;
+}
+
+std::string to_hex(bytes_type const& bytes)
+{
+    char const* const digits = "0123456789ABCDEF";
+    std::string result;
+    for (std::size_t i = 0 ; i < bytes.size() ; ++i)
+    {
+        result += digits[bytes[i] >> 4];
+        result += digits[bytes[i] & 0xF];
+    }
+    return result;
+}
+
+template <typename Geometry>
+std::string to_wkt(Geometry const& geometry)
+{
+    std::ostringstream out;
+    out << bg::wkt(geometry);
+    return out.str();
+}
+
+template <typename Geometry>
+void test_round_trip(std::string const& wkt)
+{
+    Geometry expected;
+    bg::read_wkt(wkt, expected);
+
+    bytes_type wkb;
+    BOOST_CHECK(bg::write_wkb(expected, std::back_inserter(wkb)));
+
+    Geometry geometry;
+    BOOST_CHECK_MESSAGE(bg::read_wkb(wkb.begin(), wkb.end(), geometry),
+                        "read_wkb failed: " << wkt);
+    BOOST_CHECK_EQUAL(to_wkt(geometry), to_wkt(expected));
+
+    // EWKB with SRID
+    bytes_type ewkb;
+    BOOST_CHECK(bg::write_ewkb(expected, 4326, std::back_inserter(ewkb)));
+
+    boost::uint32_t srid = 0;
+    BOOST_CHECK(bg::read_wkb(ewkb.begin(), ewkb.end(), geometry, srid));
+    BOOST_CHECK_EQUAL(srid, 4326u);
+    BOOST_CHECK_EQUAL(to_wkt(geometry), to_wkt(expected));
+
+    // All bytes are required
+    if (! wkb.empty())
+    {
+        BOOST_CHECK(! bg::read_wkb(&wkb[0], wkb.size() - 1, geometry));
+    }
+}
+
+template <typename Geometry>
+void test_read(std::string const& hex, std::string const& wkt,
+               boost::uint32_t expected_srid = 0)
+{
+    bytes_type const wkb = from_hex(hex);
+
+    Geometry geometry;
+    boost::uint32_t srid = 0;
+    BOOST_CHECK_MESSAGE(bg::read_wkb(wkb.begin(), wkb.end(), geometry, srid),
+                        "read_wkb failed: " << hex);
+    BOOST_CHECK_EQUAL(to_wkt(geometry), wkt);
+    BOOST_CHECK_EQUAL(srid, expected_srid);
+
+    // The same from a pointer
+    Geometry from_pointer;
+    BOOST_CHECK(bg::read_wkb(&wkb[0], wkb.size(), from_pointer));
+    BOOST_CHECK_EQUAL(to_wkt(from_pointer), wkt);
+}
+
+template <typename Geometry>
+void test_wrong(std::string const& hex)
+{
+    bytes_type const wkb = from_hex(hex);
+
+    Geometry geometry;
+    BOOST_CHECK_MESSAGE(! bg::read_wkb(wkb.begin(), wkb.end(), geometry),
+                        "read_wkb did not fail: " << hex);
+}
+
+template <typename Geometry>
+void test_write(std::string const& wkt, std::string const& hex)
+{
+#if BOOST_ENDIAN_LITTLE_BYTE
+    Geometry geometry;
+    bg::read_wkt(wkt, geometry);
+
+    bytes_type wkb;
+    bg::write_wkb(geometry, std::back_inserter(wkb));
+    BOOST_CHECK_EQUAL(to_hex(wkb), hex);
+#else
+    boost::ignore_unused(wkt, hex);
+#endif
+}
+
+template <typename Geometry>
+void test_write_ewkb(std::string const& wkt, boost::uint32_t srid,
+                     std::string const& hex)
+{
+#if BOOST_ENDIAN_LITTLE_BYTE
+    Geometry geometry;
+    bg::read_wkt(wkt, geometry);
+
+    bytes_type wkb;
+    bg::write_ewkb(geometry, srid, std::back_inserter(wkb));
+    BOOST_CHECK_EQUAL(to_hex(wkb), hex);
+#else
+    boost::ignore_unused(wkt, srid, hex);
+#endif
+}
+
+void test_geometries()
+{
+    test_round_trip<point_type>("POINT(1.234 5.678)");
+    test_round_trip<point3d_type>("POINT(1 2 3)");
+    test_round_trip<point4d_type>("POINT(1 2 3 4)");
+    test_round_trip<linestring_type>("LINESTRING(1 2,3 4,5 6)");
+    test_round_trip<linestring_type>("LINESTRING()");
+    test_round_trip<bg::model::linestring<point3d_type> >("LINESTRING(1 2 3,4 5 6)");
+    test_round_trip<bg::model::ring<point_type> >("POLYGON((0 0,0 4,4 4,4 0,0 0))");
+    test_round_trip<bg::model::ring<point_type, true, false> >("POLYGON((0 0,0 4,4 4,4 0))");
+    test_round_trip<polygon_type>("POLYGON((0 0,0 4,4 4,4 0,0 0),(1 1,2 1,2 2,1 2,1 1))");
+    test_round_trip<polygon_type>("POLYGON(())");
+    test_round_trip<bg::model::polygon<point_type, false, false> >(
+        "POLYGON((0 0,4 0,4 4,0 4),(1 1,1 2,2 2,2 1))");
+    test_round_trip<bg::model::multi_point<point_type> >("MULTIPOINT((1 2),(3 4))");
+    test_round_trip<bg::model::multi_linestring<linestring_type> >(
+        "MULTILINESTRING((1 1,2 2),(3 3,4 4,5 5))");
+    test_round_trip<bg::model::multi_polygon<polygon_type> >(
+        "MULTIPOLYGON(((0 0,0 4,4 4,4 0,0 0),(1 1,2 1,2 2,1 2,1 1)),((5 5,5 6,6 6,6 5,5 5)))");
+    test_round_trip<bg::model::multi_polygon<polygon_type> >("MULTIPOLYGON EMPTY");
+    test_round_trip<bg::model::point<int, 2, bg::cs::cartesian> >("POINT(-1 2)");
+    test_round_trip<bg::model::point<float, 2, bg::cs::cartesian> >("POINT(0.5 -0.25)");
+}
+
+void test_formats()
+{
+    // Little and big endian
+    test_read<point_type>("0101000000000000000000F03F0000000000000040", "POINT(1 2)");
+    test_read<point_type>("00000000013FF00000000000004000000000000000", "POINT(1 2)");
+    test_read<linestring_type>(
+        "000000000200000002"
+        "3FF00000000000004000000000000000"
+        "40080000000000004010000000000000",
+        "LINESTRING(1 2,3 4)");
+
+    // Multi-geometry containing geometries with different byte order
+    test_read<bg::model::multi_point<point_type> >(
+        "010400000002000000"
+        "0101000000000000000000F03F0000000000000040"
+        "00000000014008000000000000" "4010000000000000",
+        "MULTIPOINT((1 2),(3 4))");
+
+    // ISO Z, M and ZM
+    test_read<point3d_type>("01E9030000000000000000F03F00000000000000400000000000000840",
+                            "POINT(1 2 3)");
+    test_read<point_type>("01D1070000000000000000F03F00000000000000400000000000000840",
+                          "POINT(1 2)");
+    test_read<point3d_type>("01D1070000000000000000F03F00000000000000400000000000000840",
+                            "POINT(1 2 0)");
+    test_read<point4d_type>(
+        "01B90B0000000000000000F03F000000000000004000000000000008400000000000001040",
+        "POINT(1 2 3 4)");
+    test_read<point3d_type>(
+        "01B90B0000000000000000F03F000000000000004000000000000008400000000000001040",
+        "POINT(1 2 3)");
+
+    // EWKB of PostGIS with Z, M and SRID
+    test_read<point_type>("0101000020E6100000000000000000F03F0000000000000040",
+                          "POINT(1 2)", 4326);
+    test_read<point3d_type>(
+        "01010000A0E6100000000000000000F03F00000000000000400000000000000840",
+        "POINT(1 2 3)", 4326);
+    test_read<point_type>("0101000040000000000000F03F00000000000000400000000000000840",
+                          "POINT(1 2)");
+    test_read<linestring_type>(
+        "0102000020E610000002000000"
+        "000000000000F03F0000000000000040"
+        "00000000000008400000000000001040",
+        "LINESTRING(1 2,3 4)", 4326);
+
+    // The closing point of open rings is not stored
+    {
+        bytes_type const wkb = from_hex("01030000000100000005000000"
+                                        "00000000000000000000000000000000"
+                                        "00000000000000000000000000001040"
+                                        "00000000000010400000000000001040"
+                                        "00000000000010400000000000000000"
+                                        "00000000000000000000000000000000");
+        bg::model::polygon<point_type, true, false> polygon;
+        BOOST_CHECK(bg::read_wkb(wkb.begin(), wkb.end(), polygon));
+        BOOST_CHECK_EQUAL(boost::size(bg::exterior_ring(polygon)), 4u);
+    }
+
+    test_write<point_type>("POINT(1 2)", "0101000000000000000000F03F0000000000000040");
+    test_write<point3d_type>("POINT(1 2 3)",
+        "01E9030000000000000000F03F00000000000000400000000000000840");
+    test_write<point4d_type>("POINT(1 2 3 4)",
+        "01B90B0000000000000000F03F000000000000004000000000000008400000000000001040");
+    test_write<polygon_type>("POLYGON EMPTY", "010300000000000000");
+    test_write<bg::model::ring<point_type, true, false> >("POLYGON((0 0,0 4,4 4,4 0))",
+        "01030000000100000005000000"
+        "00000000000000000000000000000000"
+        "00000000000000000000000000001040"
+        "00000000000010400000000000001040"
+        "00000000000010400000000000000000"
+        "00000000000000000000000000000000");
+
+    test_write_ewkb<point_type>("POINT(1 2)", 4326,
+        "0101000020E6100000000000000000F03F0000000000000040");
+    test_write_ewkb<point3d_type>("POINT(1 2 3)", 4326,
+        "01010000A0E6100000000000000000F03F00000000000000400000000000000840");
+    // The SRID is stored only in the outermost geometry
+    test_write_ewkb<bg::model::multi_point<point_type> >("MULTIPOINT((1 2))", 4326,
+        "0104000020E610000001000000"
+        "0101000000000000000000F03F0000000000000040");
+}
+
+void test_wrong_data()
+{
+    // Z can't be stored in 2 dimensions
+    test_wrong<point_type>("01E9030000000000000000F03F00000000000000400000000000000840");
+    test_wrong<point_type>("0101000080000000000000F03F00000000000000400000000000000840");
+    // Different geometry type
+    test_wrong<linestring_type>("0101000000000000000000F03F0000000000000040");
+    test_wrong<point_type>("010400000000000000");
+    // Wrong byte order and type
+    test_wrong<point_type>("0201000000000000000000F03F0000000000000040");
+    test_wrong<point_type>("0109000000000000000000F03F0000000000000040");
+    test_wrong<point_type>("01A10F0000000000000000F03F0000000000000040");
+    // Too few bytes
+    test_wrong<point_type>("");
+    test_wrong<point_type>("01010000");
+    test_wrong<point_type>("0101000000000000000000F03F00000000000000");
+    test_wrong<linestring_type>("010200000002000000000000000000F03F0000000000000040");
+    // The number of points can't be stored, nothing is allocated
+    test_wrong<linestring_type>("0102000000FFFFFFFF000000000000F03F0000000000000040");
+    test_wrong<polygon_type>("0103000000FFFFFFFF");
+    test_wrong<bg::model::multi_polygon<polygon_type> >("0106000000FFFFFFFF");
+    // A ring has to be a polygon without interior rings
+    test_wrong<bg::model::ring<point_type> >("010300000002000000"
+                                             "0000000000000000");
+}
+
+void test_views()
+{
+    polygon_type polygon;
+    bg::read_wkt("POLYGON((0 0,0 4,4 4,4 0,0 0),(1 1,2 1,2 2,1 2,1 1))", polygon);
+    linestring_type linestring;
+    bg::read_wkt("LINESTRING(0 0,3 4,3 5)", linestring);
+
+    bytes_type polygon_wkb, linestring_wkb;
+    bg::write_wkb(polygon, std::back_inserter(polygon_wkb));
+    bg::write_wkb(linestring, std::back_inserter(linestring_wkb));
+
+    bg::wkb_linestring_view<point_type> const ls_view(
+        &linestring_wkb[0], &linestring_wkb[0] + linestring_wkb.size());
+    BOOST_CHECK_EQUAL(boost::size(ls_view), 3u);
+    BOOST_CHECK_EQUAL(bg::num_points(ls_view), 3u);
+    BOOST_CHECK_CLOSE(bg::length(ls_view), 6.0, 0.0001);
+    BOOST_CHECK_EQUAL(to_wkt(ls_view), "LINESTRING(0 0,3 4,3 5)");
+    BOOST_CHECK_EQUAL(bg::get<1>(*(boost::begin(ls_view) + 2)), 5.0);
+
+    bg::wkb_polygon_view<point_type> const poly_view(
+        &polygon_wkb[0], &polygon_wkb[0] + polygon_wkb.size());
+    BOOST_CHECK_EQUAL(bg::num_interior_rings(poly_view), 1u);
+    BOOST_CHECK_EQUAL(bg::num_points(poly_view), 10u);
+    BOOST_CHECK_CLOSE(bg::area(poly_view), bg::area(polygon), 0.0001);
+    BOOST_CHECK(bg::within(point_type(0.5, 0.5), poly_view));
+    BOOST_CHECK(! bg::within(point_type(1.5, 1.5), poly_view));
+    BOOST_CHECK_EQUAL(to_wkt(poly_view), to_wkt(polygon));
+
+    // Big endian
+    bytes_type const big = from_hex("000000000200000002"
+                                    "00000000000000000000000000000000"
+                                    "40080000000000004010000000000000");
+    bg::wkb_linestring_view<point_type> const big_view(&big[0], &big[0] + big.size());
+    BOOST_CHECK_CLOSE(bg::length(big_view), 5.0, 0.0001);
+
+    // Wrong data
+    try
+    {
+        bg::wkb_linestring_view<point_type> view(&polygon_wkb[0],
+                                                 &polygon_wkb[0] + polygon_wkb.size());
+        BOOST_CHECK_MESSAGE(false, "view of wrong geometry type created");
+    }
+    catch (bg::read_wkb_exception const&)
+    {}
+
+    try
+    {
+        bg::wkb_polygon_view<point_type> view(&polygon_wkb[0],
+                                              &polygon_wkb[0] + polygon_wkb.size() - 1);
+        BOOST_CHECK_MESSAGE(false, "view of truncated polygon created");
+    }
+    catch (bg::read_wkb_exception const&)
+    {}
+}
+
+int test_main(int, char* [])
+{
+    test_geometries();
+    test_formats();
+    test_wrong_data();
+    test_views();
+
+    return 0;
+}
@@ -0,0 +1,406 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <clocale>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <locale>
+#include <new>
+#include <sstream>
+#include <string>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/geometries/geometries.hpp>
+
+#include <boost/geometry/io/wkt/read.hpp>
+#include <boost/geometry/io/wkt/reader.hpp>
+#include <boost/geometry/io/wkt/write.hpp>
+
+// Count the allocations to check that the numbers are parsed without
+// allocating memory. The replacements are not inlined, otherwise the
+// compiler could see the memory allocated with malloc() and released
+// with operator delete.
+std::size_t allocations_count = 0;
+
+#ifdef BOOST_NO_CXX11_NOEXCEPT
+BOOST_NOINLINE void * operator new(std::size_t size) throw(std::bad_alloc)
+#else
+BOOST_NOINLINE void * operator new(std::size_t size)
+#endif
+{
+    ++allocations_count;
+    void * p = std::malloc(size > 0 ? size : 1);
+    if ( p == NULL )
+        throw std::bad_alloc();
+    return p;
+}
+
+BOOST_NOINLINE void operator delete(void * p) BOOST_NOEXCEPT_OR_NOTHROW
+{
+    std::free(p);
+}
+
+#ifdef __cpp_sized_deallocation
+BOOST_NOINLINE void operator delete(void * p, std::size_t) BOOST_NOEXCEPT_OR_NOTHROW
+{
+    ::operator delete(p);
+}
+#endif
+
+template <typename Geometry>
+std::string to_wkt(Geometry const& geometry)
+{
+    std::ostringstream out;
+    out << std::setprecision(20) << bg::wkt(geometry);
+    return out.str();
+}
+
+// The result of the reader has to be the same as the result of read_wkt()
+template <typename Geometry>
+void test_read(std::string const& wkt, std::string const& reference_wkt)
+{
+    Geometry expected;
+    bg::read_wkt(reference_wkt, expected);
+
+    Geometry geometry;
+    char const* first = wkt.c_str();
+    char const* last = first + wkt.size();
+    char const* position = bg::read_wkt(first, last, geometry);
+
+    BOOST_CHECK_MESSAGE(position == last, "not all characters parsed: " << wkt);
+    BOOST_CHECK_EQUAL(to_wkt(geometry), to_wkt(expected));
+}
+
+template <typename Geometry>
+void test_read(std::string const& wkt)
+{
+    test_read<Geometry>(wkt, wkt);
+}
+
+template <typename Geometry>
+void test_wrong(std::string const& wkt, std::string const& start)
+{
+    Geometry geometry;
+    char const* first = wkt.c_str();
+    try
+    {
+        bg::read_wkt(first, first + wkt.size(), geometry);
+        BOOST_CHECK_MESSAGE(false, "read_wkt did not throw: " << wkt);
+    }
+    catch(bg::read_wkt_exception const& e)
+    {
+        BOOST_CHECK_MESSAGE(std::string(e.what()).compare(0, start.size(), start) == 0,
+                            "unexpected message: " << e.what());
+    }
+}
+
+template <typename T>
+void test_numbers()
+{
+    typedef bg::model::point<T, 2, bg::cs::cartesian> point;
+
+    test_read<point>("POINT(1 2)");
+    test_read<point>("POINT(-1.5 +2.25)");
+    test_read<point>("POINT(0.1 0.7)");
+    test_read<point>("POINT(1e3 -2.5E-3)");
+    test_read<point>("POINT(.5 5.)");
+    test_read<point>("POINT(123456789.123456789 -0.000000000123456789)");
+    test_read<point>("POINT(12345678901234567890123 0.30000000000000000000001)");
+
+    if (boost::is_same<T, double>::value)
+    {
+        test_read<point>("POINT(1.7976931348623157e308 4.9406564584124654e-324)");
+    }
+    test_read<point>("POINT(-0 0.0)");
+
+    std::string const bad_cast
+        = "Bad lexical cast: source type value could not be interpreted as target";
+    test_wrong<point>("POINT(1x 2)", bad_cast + " at '1x'");
+    test_wrong<point>("POINT(1e 2)", bad_cast + " at '1e'");
+    test_wrong<point>("POINT(. 2)", bad_cast + " at '.'");
+    // only decimal numbers are accepted
+    test_wrong<point>("POINT(0x10 2)", bad_cast + " at '0x10'");
+    test_wrong<point>("POINT(0x1p-2 2)", bad_cast + " at '0x1p-2'");
+    test_wrong<point>("POINT(infinite 2)", bad_cast + " at 'infinite'");
+    test_wrong<point>("POINT(nanx 2)", bad_cast + " at 'nanx'");
+
+    // infinity and NaN are accepted the same way as by lexical_cast
+    test_read<point>("POINT(inf 2)");
+    test_read<point>("POINT(1 -Infinity)", "POINT(1 -inf)");
+    test_read<point>("POINT(NaN -nan)", "POINT(nan -nan)");
+}
+
+// The number above the midpoint between two floats by less than half of
+// the distance between doubles is rounded down if it's converted to double
+// first, it has to be rounded up.
+void test_float_rounding()
+{
+    typedef bg::model::point<float, 2, bg::cs::cartesian> point;
+
+    std::string const wkt = "POINT(1.000000059604644776257986737988403547205962240695953369140625 0)";
+    point p;
+    bg::read_wkt(wkt.c_str(), wkt.c_str() + wkt.size(), p);
+    BOOST_CHECK_EQUAL(bg::get<0>(p), 1.0f + std::numeric_limits<float>::epsilon());
+}
+
+template <typename T>
+void test_number(std::string const& str, T expected)
+{
+    T value = 0;
+    std::size_t const count = allocations_count;
+    bool const parsed = bg::detail::wkt::parse_number<T>::apply(
+        str.c_str(), str.c_str() + str.size(), value);
+    BOOST_CHECK_MESSAGE(allocations_count == count, "memory allocated: " << str);
+    BOOST_CHECK_MESSAGE(parsed, "not parsed: " << str);
+    BOOST_CHECK_MESSAGE(value == expected && bg::math::sign(value) == bg::math::sign(expected),
+                        "wrong value: " << str);
+}
+
+template <typename T>
+void test_number_wrong(std::string const& str)
+{
+    T value = 0;
+    std::size_t const count = allocations_count;
+    bool const parsed = bg::detail::wkt::parse_number<T>::apply(
+        str.c_str(), str.c_str() + str.size(), value);
+    BOOST_CHECK_MESSAGE(allocations_count == count, "memory allocated: " << str);
+    BOOST_CHECK_MESSAGE(! parsed, "parsed: " << str);
+}
+
+// The numbers with full precision, many digits or big exponents are
+// correctly rounded without allocating memory
+void test_full_precision()
+{
+    test_number<double>("0.30000000000000004", 0.30000000000000004);
+    test_number<double>("51.123456789012345", 51.123456789012345);
+    test_number<double>("-17.987654321098765", -17.987654321098765);
+    test_number<double>("1e300", 1e300);
+    test_number<double>("1.7976931348623157e308", 1.7976931348623157e308);
+    test_number<double>("2.2250738585072011e-308", 2.2250738585072011e-308);
+    test_number<double>("4.9406564584124654e-324", 4.9406564584124654e-324);
+    test_number<double>("2.4703282292062328e-324", 4.9406564584124654e-324);
+    test_number<double>("1e-400", 0.0);
+    test_number<double>("-1e-400", -0.0);
+    // in the middle between two doubles, rounded to even
+    test_number<double>("9007199254740993", 9007199254740992.0);
+    test_number<double>("9007199254740995", 9007199254740996.0);
+    // slightly above the middle
+    test_number<double>("9007199254740993.00000000000000000000000000001", 9007199254740994.0);
+    test_number<double>("123456789012345678901234567890", 123456789012345678901234567890.0);
+    test_number<double>("0.000000000000000000000000000000000000000001234567890123456789", 1.234567890123456789e-42);
+
+    test_number<float>("0.1", 0.1f);
+    test_number<float>("3.14159274", 3.14159274f);
+    test_number<float>("3.4028235e38", 3.4028235e38f);
+    test_number<float>("1e-40", 1e-40f);
+    test_number<float>("1.4e-45", 1.4e-45f);
+    test_number<float>("16777217", 16777216.0f);
+    test_number<float>("16777217.000000000000000000001", 16777218.0f);
+
+    // out of range
+    test_number_wrong<double>("1e400");
+    test_number_wrong<double>("-1.8e308");
+    test_number_wrong<float>("3.5e38");
+    test_number_wrong<float>("1e39");
+}
+
+struct comma_numpunct : std::numpunct<char>
+{
+protected:
+    char do_decimal_point() const { return ','; }
+    char do_thousands_sep() const { return '.'; }
+    std::string do_grouping() const { return "\3"; }
+};
+
+// The numbers are parsed the same way regardless of the global C++ locale
+// and the C locale, if a locale using comma as decimal point is available
+void test_locale()
+{
+    typedef bg::model::point<double, 2, bg::cs::cartesian> point;
+
+    std::locale const previous = std::locale::global(
+        std::locale(std::locale::classic(), new comma_numpunct));
+
+    std::string const previous_c = std::setlocale(LC_NUMERIC, NULL);
+    char const* const c_locales[] =
+    {
+        "de_DE.UTF-8", "de_DE.utf8", "de_DE", "fr_FR.UTF-8", "pl_PL.UTF-8", "German"
+    };
+    for (std::size_t i = 0 ; i < sizeof(c_locales) / sizeof(c_locales[0]) ; ++i)
+    {
+        if (std::setlocale(LC_NUMERIC, c_locales[i]) != NULL)
+        {
+            break;
+        }
+    }
+
+    // fast path and the numbers with many digits and big exponents
+    std::string const wkt = "POINT(1.5 0.30000000000000000000001) "
+                            "POINT(123456789012345678901.5 2.5e-300)";
+    char const* const last = wkt.c_str() + wkt.size();
+    point p1, p2;
+    char const* it = bg::read_wkt(wkt.c_str(), last, p1);
+    bg::read_wkt(it, last, p2);
+
+    test_wrong<point>("POINT(1,5 2)", "Expected ')' at ','");
+
+    std::setlocale(LC_NUMERIC, previous_c.c_str());
+    std::locale::global(previous);
+
+    BOOST_CHECK_EQUAL(bg::get<0>(p1), 1.5);
+    BOOST_CHECK_EQUAL(bg::get<1>(p1), 0.3);
+    BOOST_CHECK_EQUAL(bg::get<0>(p2), 123456789012345678901.5);
+    BOOST_CHECK_EQUAL(bg::get<1>(p2), 2.5e-300);
+}
+
+template <typename T>
+void test_all()
+{
+    typedef bg::model::point<T, 2, bg::cs::cartesian> point;
+    typedef bg::model::point<T, 3, bg::cs::cartesian> point3d;
+
+    test_read<point>("POINT(1 2)");
+    test_read<point>("point ( 1 2 )");
+    test_read<point>("POINT(1)");
+    test_read<point3d>("POINT Z (1 2 3)");
+    test_read<point>("POINT M (1 2)");
+
+    test_read<bg::model::linestring<point> >("LINESTRING(1 1,2 2,3 3)");
+    // All whitespace characters are separators
+    test_read<bg::model::linestring<point> >("LINESTRING\n(\t1 1 , 2 2,3 3)",
+                                             "LINESTRING(1 1,2 2,3 3)");
+    test_read<bg::model::linestring<point> >("LINESTRING()");
+    test_read<bg::model::linestring<point> >("LINESTRING EMPTY");
+
+    test_read<bg::model::ring<point> >("POLYGON((0 0,0 4,4 4,4 0,0 0))");
+    test_read<bg::model::ring<point, true, false> >("POLYGON((0 0,0 4,4 4,4 0,0 0))");
+    test_read<bg::model::polygon<point> >("POLYGON((0 0,0 4,4 4,4 0,0 0),(1 1,2 1,2 2,1 2,1 1))");
+    test_read<bg::model::polygon<point, false, false> >("POLYGON((0 0,4 0,4 4,0 4,0 0),(1 1,1 2,2 2,2 1,1 1))");
+    test_read<bg::model::polygon<point> >("POLYGON EMPTY");
+
+    test_read<bg::model::multi_point<point> >("MULTIPOINT((1 2),(3 4))");
+    test_read<bg::model::multi_point<point> >("MULTIPOINT(1 2,3 4)");
+    test_read<bg::model::multi_point<point> >("MULTIPOINT()");
+    test_read<bg::model::multi_linestring<bg::model::linestring<point> > >(
+        "MULTILINESTRING((1 1,2 2),(3 3,4 4,5 5))");
+    test_read<bg::model::multi_polygon<bg::model::polygon<point> > >(
+        "MULTIPOLYGON(((0 0,0 4,4 4,4 0,0 0),(1 1,2 1,2 2,1 2,1 1)),((5 5,5 6,6 6,6 5,5 5)))");
+    test_read<bg::model::multi_polygon<bg::model::polygon<point> > >("MULTIPOLYGON EMPTY");
+
+    test_read<bg::model::box<point> >("BOX(1 2,3 4)");
+    test_read<bg::model::box<point> >("POLYGON((1 2,1 4,3 4,3 2,1 2))");
+    test_read<bg::model::box<point> >("POLYGON((1 2,1 4,3 4,3 2))");
+    test_read<bg::model::segment<point> >("SEGMENT(1 2,3 4)");
+    test_read<bg::model::segment<point> >("LINESTRING(1 2,3 4)");
+
+    test_wrong<point>("LINESTRING(1 2)", "Should start with 'POINT'");
+    test_wrong<point>("POINTS(1 2)", "Should start with 'POINT'");
+    test_wrong<point>("POINT(1 2", "Expected ')'");
+    test_wrong<point>("POINT 1 2)", "Expected '(' at '1'");
+    test_wrong<point>("POINT(1 2 3)", "Expected ')' at '3'");
+    test_wrong<point>("POINT Z (1 2)", "Z only allowed for 3 or more dimensions");
+    test_wrong<bg::model::linestring<point> >("LINESTRING(1 1,2 2", "Expected ')'");
+    test_wrong<bg::model::polygon<point> >("POLYGON((0 0,0 4)", "Expected ')'");
+    test_wrong<bg::model::box<point> >("BOX(1 2,3 4,5 6)", "Box should have 2,4 or 5 points");
+    test_wrong<bg::model::segment<point> >("SEGMENT(1 2)", "Segment should have 2 points");
+
+    // The characters following the geometry are not analysed
+    {
+        std::string const wkt = "POINT(1 2) POINT(3 4)";
+        point p;
+        char const* position = bg::read_wkt(wkt.c_str(), wkt.c_str() + wkt.size(), p);
+        BOOST_CHECK_EQUAL(position - wkt.c_str(), 10);
+        BOOST_CHECK_EQUAL(to_wkt(p), "POINT(1 2)");
+    }
+}
+
+template <typename T>
+void test_reader()
+{
+    typedef bg::model::point<T, 2, bg::cs::cartesian> point;
+    typedef bg::model::polygon<point> polygon;
+
+    std::string const data
+        = "POLYGON((0 0,0 4,4 4,4 0,0 0))\n"
+          "POLYGON((1 1,1 2,2 2,2 1,1 1));\n"
+          "\n"
+          "POLYGON EMPTY;POLYGON((5 5,5 6,6 6,6 5,5 5))\n\n";
+
+    char const* const expected[] =
+    {
+        "POLYGON((0 0,0 4,4 4,4 0,0 0))",
+        "POLYGON((1 1,1 2,2 2,2 1,1 1))",
+        "POLYGON(())",
+        "POLYGON((5 5,5 6,6 6,6 5,5 5))"
+    };
+
+    bg::wkt_reader reader(data.c_str(), data.c_str() + data.size());
+    polygon poly;
+    std::size_t count = 0;
+    while (reader.read(poly))
+    {
+        BOOST_CHECK(count < 4);
+        if (count < 4)
+        {
+            BOOST_CHECK_EQUAL(to_wkt(poly), expected[count]);
+        }
+        ++count;
+    }
+    BOOST_CHECK_EQUAL(count, 4u);
+    BOOST_CHECK(! reader.read(poly));
+
+    // Empty input
+    std::string const empty = " \n;\n";
+    bg::wkt_reader empty_reader(empty.c_str(), empty.c_str() + empty.size());
+    BOOST_CHECK(! empty_reader.read(poly));
+
+    // The geometries of different types
+    std::string const mixed = "POINT(1 2) LINESTRING(1 2,3 4)";
+    bg::wkt_reader mixed_reader(mixed.c_str(), mixed.c_str() + mixed.size());
+    point p;
+    bg::model::linestring<point> ls;
+    BOOST_CHECK(mixed_reader.read(p));
+    BOOST_CHECK(mixed_reader.read(ls));
+    BOOST_CHECK_EQUAL(to_wkt(p), "POINT(1 2)");
+    BOOST_CHECK_EQUAL(to_wkt(ls), "LINESTRING(1 2,3 4)");
+    BOOST_CHECK(! mixed_reader.read(p));
+
+    // The error message contains the context of the wrong geometry
+    std::string const wrong = "POINT(1 2)\nPOINT(1 x)";
+    bg::wkt_reader wrong_reader(wrong.c_str(), wrong.c_str() + wrong.size());
+    BOOST_CHECK(wrong_reader.read(p));
+    try
+    {
+        wrong_reader.read(p);
+        BOOST_CHECK_MESSAGE(false, "read did not throw");
+    }
+    catch(bg::read_wkt_exception const& e)
+    {
+        BOOST_CHECK_EQUAL(std::string(e.what()),
+                          "Bad lexical cast: source type value could not be interpreted as target at 'x' in 'POINT(1 x)'");
+    }
+}
+
+int test_main(int, char* [])
+{
+    test_numbers<double>();
+    test_numbers<float>();
+    test_float_rounding();
+    test_full_precision();
+    test_locale();
+
+    test_all<double>();
+    test_all<int>();
+
+    test_reader<double>();
+
+    return 0;
+}
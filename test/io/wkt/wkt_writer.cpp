@@ -0,0 +1,299 @@
+// Boost.Geometry (aka GGL, Generic Geometry Library)
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <clocale>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <locale>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <geometry_test_common.hpp>
+
+#include <boost/geometry/geometries/geometries.hpp>
+
+#include <boost/geometry/io/wkt/read.hpp>
+#include <boost/geometry/io/wkt/write.hpp>
+#include <boost/geometry/io/wkt/writer.hpp>
+
+#include <boost/variant/variant.hpp>
+
+// Count the allocations to check that the numbers are formatted without
+// allocating memory. The replacements are not inlined, otherwise the
+// compiler could see the memory allocated with malloc() and released
+// with operator delete.
+std::size_t allocations_count = 0;
+
+#ifdef BOOST_NO_CXX11_NOEXCEPT
+BOOST_NOINLINE void * operator new(std::size_t size) throw(std::bad_alloc)
+#else
+BOOST_NOINLINE void * operator new(std::size_t size)
+#endif
+{
+    ++allocations_count;
+    void * p = std::malloc(size > 0 ? size : 1);
+    if ( p == NULL )
+        throw std::bad_alloc();
+    return p;
+}
+
+BOOST_NOINLINE void operator delete(void * p) BOOST_NOEXCEPT_OR_NOTHROW
+{
+    std::free(p);
+}
+
+#ifdef __cpp_sized_deallocation
+BOOST_NOINLINE void operator delete(void * p, std::size_t) BOOST_NOEXCEPT_OR_NOTHROW
+{
+    ::operator delete(p);
+}
+#endif
+
+// The result has to be the same as the result of the wkt() manipulator
+template <typename Geometry>
+void test_write(std::string const& wkt)
+{
+    Geometry geometry;
+    bg::read_wkt(wkt, geometry);
+
+    std::ostringstream out;
+    out << bg::wkt(geometry);
+
+    std::string buffer;
+    bg::write_wkt(geometry, buffer);
+    BOOST_CHECK_EQUAL(buffer, out.str());
+
+    std::vector<char> chars;
+    bg::write_wkt(geometry, chars);
+    BOOST_CHECK_EQUAL(std::string(chars.begin(), chars.end()), out.str());
+}
+
+template <typename Geometry>
+void test_fixed(std::string const& wkt, int precision)
+{
+    Geometry geometry;
+    bg::read_wkt(wkt, geometry);
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(precision) << bg::wkt(geometry);
+
+    std::string buffer;
+    bg::write_wkt(geometry, buffer, precision);
+    BOOST_CHECK_EQUAL(buffer, out.str());
+}
+
+template <typename T>
+void test_number(T const& value, std::string const& expected)
+{
+    bg::model::point<T, 2, bg::cs::cartesian> p(value, 0);
+    std::string buffer;
+    bg::write_wkt(p, buffer);
+    BOOST_CHECK_EQUAL(buffer, "POINT(" + expected + " 0)");
+}
+
+// The shortest representation has to be read back as the same value
+template <typename T>
+void test_round_trip()
+{
+    typedef bg::model::point<T, 2, bg::cs::cartesian> point;
+
+    // Park-Miller generator, the same sequence on all platforms
+    unsigned long seed = 12345;
+    for (int i = 0 ; i < 10000 ; ++i)
+    {
+        seed = (seed * 16807ul) % 2147483647ul;
+        double const r1 = static_cast<double>(seed) / 2147483647.0;
+        seed = (seed * 16807ul) % 2147483647ul;
+        double const r2 = static_cast<double>(seed) / 2147483647.0;
+
+        double const scale = std::pow(10.0, static_cast<int>(seed % 40) - 20);
+        point const p(static_cast<T>((r1 - 0.5) * scale),
+                      static_cast<T>(r2 * 360.0 - 180.0));
+
+        std::string buffer;
+        bg::write_wkt(p, buffer);
+
+        point q;
+        bg::read_wkt(buffer, q);
+        BOOST_CHECK_MESSAGE(bg::get<0>(p) == bg::get<0>(q)
+                         && bg::get<1>(p) == bg::get<1>(q),
+                            "round trip failed: " << buffer);
+    }
+}
+
+// The characters are appended to the buffer with reserved memory
+template <typename T>
+void test_no_allocations(T const& value, int precision)
+{
+    bg::model::point<T, 2, bg::cs::cartesian> const p(value, -value);
+    std::string buffer;
+    buffer.reserve(2048);
+
+    std::size_t const count = allocations_count;
+    if (precision < 0)
+    {
+        bg::write_wkt(p, buffer);
+    }
+    else
+    {
+        bg::write_wkt(p, buffer, precision);
+    }
+    BOOST_CHECK_MESSAGE(allocations_count == count, "memory allocated: " << buffer);
+}
+
+void test_allocations()
+{
+    test_no_allocations(0.30000000000000004, -1);
+    test_no_allocations(1.7976931348623157e308, -1);
+    test_no_allocations(3.4e38f, -1);
+    test_no_allocations(1e-40f, -1);
+    test_no_allocations(123456792.0f, -1);
+    test_no_allocations(1e22, 3);
+    test_no_allocations(1.7976931348623157e308, 30);
+    test_no_allocations(5e-324, 400);
+    test_no_allocations(0.125, 2);
+    test_no_allocations(3.4e38f, 2);
+}
+
+struct comma_numpunct : std::numpunct<char>
+{
+protected:
+    char do_decimal_point() const { return ','; }
+    char do_thousands_sep() const { return '.'; }
+    std::string do_grouping() const { return "\3"; }
+};
+
+// The output doesn't depend on the global C++ locale and the C locale,
+// if a locale using comma as decimal point is available
+void test_locale()
+{
+    std::locale const previous = std::locale::global(
+        std::locale(std::locale::classic(), new comma_numpunct));
+
+    std::string const previous_c = std::setlocale(LC_NUMERIC, NULL);
+    char const* const c_locales[] =
+    {
+        "de_DE.UTF-8", "de_DE.utf8", "de_DE", "fr_FR.UTF-8", "pl_PL.UTF-8", "German"
+    };
+    for (std::size_t i = 0 ; i < sizeof(c_locales) / sizeof(c_locales[0]) ; ++i)
+    {
+        if (std::setlocale(LC_NUMERIC, c_locales[i]) != NULL)
+        {
+            break;
+        }
+    }
+
+    // small floats and large numbers in fixed notation
+    std::string tiny, smallest, fixed, shortest;
+    bg::write_wkt(bg::model::point<float, 2, bg::cs::cartesian>(1e-30f, 3.4567e-25f), tiny);
+    bg::write_wkt(bg::model::point<float, 2, bg::cs::cartesian>(1.17549435e-38f, 0.5f), smallest);
+    bg::write_wkt(bg::model::point<double, 2, bg::cs::cartesian>(1.5, 1e30), fixed, 2);
+    bg::write_wkt(bg::model::point<double, 2, bg::cs::cartesian>(1.5, 1e-300), shortest);
+
+    std::setlocale(LC_NUMERIC, previous_c.c_str());
+    std::locale::global(previous);
+
+    BOOST_CHECK_EQUAL(tiny, "POINT(1e-30 3.4567e-25)");
+    BOOST_CHECK_EQUAL(smallest, "POINT(1.1754944e-38 0.5)");
+    BOOST_CHECK_EQUAL(fixed, "POINT(1.50 1000000000000000019884624838656.00)");
+    BOOST_CHECK_EQUAL(shortest, "POINT(1.5 1e-300)");
+}
+
+template <typename T>
+void test_all()
+{
+    typedef bg::model::point<T, 2, bg::cs::cartesian> point;
+    typedef bg::model::point<T, 3, bg::cs::cartesian> point3d;
+
+    test_write<point>("POINT(1 2)");
+    test_write<point>("POINT(-1 -2)");
+    test_write<point3d>("POINT(1 2 3)");
+    test_write<bg::model::linestring<point> >("LINESTRING(1 1,2 2,3 3)");
+    test_write<bg::model::linestring<point> >("LINESTRING()");
+    test_write<bg::model::ring<point> >("POLYGON((0 0,0 4,4 4,4 0))");
+    test_write<bg::model::polygon<point> >("POLYGON((0 0,0 4,4 4,4 0,0 0),(1 1,2 1,2 2,1 2,1 1))");
+    test_write<bg::model::polygon<point> >("POLYGON((0 0,0 4,4 4,4 0),(1 1,2 1,2 2,1 2))");
+    test_write<bg::model::multi_point<point> >("MULTIPOINT((1 2),(3 4))");
+    test_write<bg::model::multi_linestring<bg::model::linestring<point> > >(
+        "MULTILINESTRING((1 1,2 2),(3 3,4 4,5 5))");
+    test_write<bg::model::multi_polygon<bg::model::polygon<point> > >(
+        "MULTIPOLYGON(((0 0,0 4,4 4,4 0,0 0),(1 1,2 1,2 2,1 2,1 1)),((5 5,5 6,6 6,6 5,5 5)))");
+    test_write<bg::model::box<point> >("BOX(1 2,3 4)");
+    test_write<bg::model::segment<point> >("SEGMENT(1 2,3 4)");
+
+    {
+        boost::variant<point, bg::model::linestring<point> > v = point(1, 2);
+        std::string buffer;
+        bg::write_wkt(v, buffer);
+        BOOST_CHECK_EQUAL(buffer, "POINT(1 2)");
+    }
+}
+
+int test_main(int, char* [])
+{
+    test_all<double>();
+    test_all<float>();
+    test_all<int>();
+
+    test_locale();
+
+    test_number(0.1, "0.1");
+    test_number(-0.25, "-0.25");
+    test_number(0.000001, "0.000001");
+    test_number(0.0000001, "1e-07");
+    test_number(1e21, "1e+21");
+    test_number(1e20, "100000000000000000000");
+    test_number(123456.789, "123456.789");
+    test_number(1.0 / 3.0, "0.3333333333333333");
+    test_number(2.0 / 3.0, "0.6666666666666666");
+    test_number(0.1f, "0.1");
+    test_number(3.4028235e38f, "3.4028235e+38");
+    test_number(1e-7f, "1e-07");
+    test_number(1e22, "1e+22");
+    test_number(1.7976931348623157e308, "1.7976931348623157e+308");
+    test_number(-0.0, "-0");
+    test_number(5e-324, "5e-324");
+    test_number(-2147483647 - 1, "-2147483648");
+    // the shortest digits of large and small floats
+    test_number(123456792.0f, "123456790");
+    test_number(16777216.0f, "16777216");
+    test_number(1e-40f, "1e-40");
+    test_number(1.4e-45f, "1e-45");
+    test_number(1.17549435e-38f, "1.1754944e-38");
+    test_number(1e30f, "1e+30");
+
+    test_round_trip<double>();
+    test_round_trip<float>();
+
+    test_fixed<bg::model::point<double, 2, bg::cs::cartesian> >("POINT(1 2.345678)", 2);
+    test_fixed<bg::model::point<double, 2, bg::cs::cartesian> >("POINT(-0.001 1e20)", 2);
+    test_fixed<bg::model::linestring<bg::model::point<double, 2, bg::cs::cartesian> > >(
+        "LINESTRING(0.123456789 -5.5,1e-9 3)", 6);
+    test_fixed<bg::model::point<double, 2, bg::cs::cartesian> >("POINT(1.5 2.5)", 0);
+    // large numbers, big precisions and ties rounded exactly
+    test_fixed<bg::model::point<double, 2, bg::cs::cartesian> >("POINT(1e22 -1e300)", 3);
+    test_fixed<bg::model::point<double, 2, bg::cs::cartesian> >("POINT(0.125 0.375)", 2);
+    test_fixed<bg::model::point<double, 2, bg::cs::cartesian> >("POINT(5e-324 0.1)", 30);
+    test_fixed<bg::model::point<double, 2, bg::cs::cartesian> >("POINT(63.669811428128313 -786.99570764433031)", 14);
+    test_fixed<bg::model::point<float, 2, bg::cs::cartesian> >("POINT(3.4e38 1e-40)", 2);
+
+    test_allocations();
+
+    // The characters are appended
+    {
+        std::string buffer = "1;";
+        bg::write_wkt(bg::model::point<double, 2, bg::cs::cartesian>(1.5, 2), buffer);
+        BOOST_CHECK_EQUAL(buffer, "1;POINT(1.5 2)");
+    }
+
+    return 0;
+}
@@ -0,0 +1,456 @@
+// Boost.Geometry
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include <geometry_test_common.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/srs/lockfree_shared_grids.hpp>
+#include <boost/geometry/srs/projections/mapped_file_policy.hpp>
+#include <boost/geometry/srs/shared_grids.hpp>
+#include <boost/geometry/srs/transformation.hpp>
+#include <boost/geometry/util/parallel.hpp>
+
+
+namespace bg = boost::geometry;
+
+typedef bg::model::point<double, 2, bg::cs::geographic<bg::degree> > point_ll;
+typedef bg::model::linestring<point_ll> linestring_ll;
+
+
+// Writes the files of the grids covering the area from 10 to 20 degrees of
+// longitude and from 45 to 55 degrees of latitude with cells of 0.5 degree
+
+bool is_little_endian()
+{
+    boost::uint16_t const one = 1;
+    return *reinterpret_cast<unsigned char const*>(&one) == 1;
+}
+
+class grid_writer
+{
+public:
+    grid_writer(std::string const& filename, bool big_endian)
+        : m_os(filename.c_str(), std::ios::binary)
+        , m_swap(big_endian == is_little_endian())
+    {}
+
+    template <typename T>
+    void value(T v)
+    {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &v, sizeof(T));
+        if (m_swap)
+        {
+            std::reverse(bytes, bytes + sizeof(T));
+        }
+        m_os.write(bytes, sizeof(T));
+    }
+
+    // Writes the string padded with spaces to the size
+    void text(std::string const& s, std::size_t size)
+    {
+        std::string str(s);
+        str.resize(size, ' ');
+        m_os.write(str.c_str(), size);
+    }
+
+    void zeros(std::size_t size)
+    {
+        std::vector<char> buf(size, 0);
+        m_os.write(&buf[0], size);
+    }
+
+    void record(std::string const& name, double v)
+    {
+        text(name, 8);
+        value(v);
+    }
+
+    void record(std::string const& name, boost::int32_t v)
+    {
+        text(name, 8);
+        value(v);
+        zeros(4);
+    }
+
+    void record(std::string const& name, std::string const& v)
+    {
+        text(name, 8);
+        text(v, 8);
+    }
+
+private:
+    std::ofstream m_os;
+    bool m_swap;
+};
+
+// Shift in seconds of arc, different in each cell
+double shift_lon(int row, int col) { return 1.0 + 0.25 * row + 0.5 * col; }
+double shift_lat(int row, int col) { return -2.0 + 0.125 * row - 0.25 * col; }
+
+int const rows = 21;
+int const cols = 21;
+
+void write_ctable2(std::string const& filename)
+{
+    double const s2r = bg::math::d2r<double>() / 3600.0;
+    double const d2r = bg::math::d2r<double>();
+
+    grid_writer w(filename, false);
+    w.text("CTABLE V2", 16);
+    w.zeros(80);
+    w.value(10.0 * d2r);
+    w.value(45.0 * d2r);
+    w.value(0.5 * d2r);
+    w.value(0.5 * d2r);
+    w.value(boost::int32_t(cols));
+    w.value(boost::int32_t(rows));
+    w.zeros(24);
+
+    for (int row = 0 ; row < rows ; ++row)
+    {
+        for (int col = 0 ; col < cols ; ++col)
+        {
+            w.value(float(shift_lon(row, col) * s2r));
+            w.value(float(shift_lat(row, col) * s2r));
+        }
+    }
+}
+
+void write_ntv1(std::string const& filename)
+{
+    grid_writer w(filename, true);
+    w.record("HEADER", boost::int32_t(12));
+    w.record("S_LAT", 45.0);
+    w.record("N_LAT", 55.0);
+    w.record("E_LONG", -20.0);
+    w.record("W_LONG", -10.0);
+    w.record("N_GRID", 0.5);
+    w.record("W GRID", 0.5);
+    w.record("TYPE", std::string("SECONDS"));
+    w.record("VERSION", std::string("NTv1"));
+    w.text("TO      NAD83", 16);
+    w.zeros(16);
+
+    // the rows from east to west
+    for (int row = 0 ; row < rows ; ++row)
+    {
+        for (int col = cols - 1 ; col >= 0 ; --col)
+        {
+            w.value(shift_lat(row, col));
+            w.value(shift_lon(row, col));
+        }
+    }
+}
+
+void write_ntv2_subfile(grid_writer & w, std::string const& name,
+                        std::string const& parent,
+                        double s, double n, double e, double west,
+                        double inc, double factor)
+{
+    int const r = int((n - s) / inc + 0.5) + 1;
+    int const c = int((west - e) / inc + 0.5) + 1;
+
+    w.record("SUB_NAME", name);
+    w.record("PARENT", parent);
+    w.record("CREATED", std::string("20180101"));
+    w.record("UPDATED", std::string("20180101"));
+    w.record("S_LAT", s);
+    w.record("N_LAT", n);
+    w.record("E_LONG", e);
+    w.record("W_LONG", west);
+    w.record("LAT_INC", inc);
+    w.record("LONG_INC", inc);
+    w.record("GS_COUNT", boost::int32_t(r * c));
+
+    // the rows from east to west
+    for (int row = 0 ; row < r ; ++row)
+    {
+        for (int col = c - 1 ; col >= 0 ; --col)
+        {
+            w.value(float(factor * shift_lat(row, col)));
+            w.value(float(factor * shift_lon(row, col)));
+            w.value(0.0f);
+            w.value(0.0f);
+        }
+    }
+}
+
+void write_ntv2(std::string const& filename, bool big_endian)
+{
+    grid_writer w(filename, big_endian);
+    w.record("NUM_OREC", boost::int32_t(11));
+    w.record("NUM_SREC", boost::int32_t(11));
+    w.record("NUM_FILE", boost::int32_t(2));
+    w.record("GS_TYPE", std::string("SECONDS"));
+    w.record("VERSION", std::string("NTv2.0"));
+    w.record("SYSTEM_F", std::string("TEST"));
+    w.record("SYSTEM_T", std::string("WGS84"));
+    w.record("MAJOR_F", 6378137.0);
+    w.record("MINOR_F", 6356752.314);
+    w.record("MAJOR_T", 6378137.0);
+    w.record("MINOR_T", 6356752.314);
+
+    // the seconds of arc, longitudes positive west
+    write_ntv2_subfile(w, "PARENT", "NONE",
+                       45 * 3600.0, 55 * 3600.0, -20 * 3600.0, -10 * 3600.0,
+                       1800.0, 1.0);
+    write_ntv2_subfile(w, "CHILD", "PARENT",
+                       48 * 3600.0, 50 * 3600.0, -16 * 3600.0, -14 * 3600.0,
+                       900.0, 2.0);
+
+    w.record("END", 0.0);
+}
+
+template <typename Storage>
+void transform(std::string const& gridname, linestring_ll const& ls,
+               linestring_ll & out)
+{
+    bg::srs::transformation<> tr((bg::srs::proj4("+proj=longlat +ellps=WGS84 +nadgrids=" + gridname)),
+                                 (bg::srs::proj4("+proj=longlat +ellps=WGS84 +datum=WGS84")));
+
+    Storage storage;
+    bg::srs::transformation_grids<Storage> grids = tr.initialize_grids(storage);
+    BOOST_CHECK_EQUAL(grids.src_grids.size(), 1u);
+
+    tr.forward(ls, out, grids);
+}
+
+// The grids shared by the threads
+template <typename Storage>
+void transform_parallel(std::string const& gridname, linestring_ll const& ls,
+                        linestring_ll & out)
+{
+    bg::srs::transformation<> tr((bg::srs::proj4("+proj=longlat +ellps=WGS84 +nadgrids=" + gridname)),
+                                 (bg::srs::proj4("+proj=longlat +ellps=WGS84 +datum=WGS84")));
+
+    Storage storage;
+    bg::srs::transformation_grids<Storage> grids = tr.initialize_grids(storage);
+
+    tr.forward(bg::execution::parallel_policy(4), ls, out, grids);
+}
+
+void check_equal(linestring_ll const& out, linestring_ll const& expected,
+                 std::string const& caseid)
+{
+    BOOST_CHECK_EQUAL(out.size(), expected.size());
+    for (std::size_t i = 0 ; i < out.size() && i < expected.size() ; ++i)
+    {
+        // the same conversions of cells
+        BOOST_CHECK_MESSAGE(bg::get<0>(out[i]) == bg::get<0>(expected[i])
+                         && bg::get<1>(out[i]) == bg::get<1>(expected[i]),
+                            caseid << " point " << i);
+    }
+}
+
+void test_grid(std::string const& gridname)
+{
+    typedef bg::srs::grids_storage<bg::srs::ifstream_policy> ifstream_storage;
+    typedef bg::srs::grids_storage<bg::srs::mapped_file_policy> mapped_storage;
+    typedef bg::srs::grids_storage
+        <
+            bg::srs::mapped_file_policy, bg::srs::shared_grids
+        > mapped_shared_storage;
+    typedef bg::srs::grids_storage
+        <
+            bg::srs::ifstream_policy, bg::srs::lockfree_shared_grids
+        > lockfree_storage;
+    typedef bg::srs::grids_storage
+        <
+            bg::srs::mapped_file_policy, bg::srs::lockfree_shared_grids
+        > mapped_lockfree_storage;
+
+    linestring_ll ls;
+    for (int i = 0 ; i < 1000 ; ++i)
+    {
+        ls.push_back(point_ll(10.1 + 0.0097 * i, 45.2 + 0.0093 * (i % 997)));
+    }
+
+    linestring_ll expected, out, out_shared, out_lockfree, out_mapped_lockfree;
+    transform<ifstream_storage>(gridname, ls, expected);
+    transform<mapped_storage>(gridname, ls, out);
+    transform_parallel<mapped_shared_storage>(gridname, ls, out_shared);
+    // the grids loaded lazily by many threads at the same time
+    transform_parallel<lockfree_storage>(gridname, ls, out_lockfree);
+    transform_parallel<mapped_lockfree_storage>(gridname, ls, out_mapped_lockfree);
+
+    check_equal(out, expected, gridname + " mapped");
+    check_equal(out_shared, expected, gridname + " mapped shared");
+    check_equal(out_lockfree, expected, gridname + " lockfree");
+    check_equal(out_mapped_lockfree, expected, gridname + " mapped lockfree");
+
+    bool shifted = false;
+    for (std::size_t i = 0 ; i < ls.size() && i < expected.size() ; ++i)
+    {
+        if (bg::get<0>(ls[i]) != bg::get<0>(expected[i]))
+        {
+            shifted = true;
+        }
+    }
+
+    BOOST_CHECK_MESSAGE(shifted, gridname << " not applied");
+}
+
+// Many transformations adding the same and different files to the grids
+// and loading them at the same time
+struct lockfree_transform
+{
+    typedef bg::srs::grids_storage
+        <
+            bg::srs::ifstream_policy, bg::srs::lockfree_shared_grids
+        > storage_type;
+
+    lockfree_transform(storage_type & s, linestring_ll const& l,
+                       std::vector<linestring_ll> & o)
+        : storage(s), ls(l), outs(o)
+    {}
+
+    void operator()(std::size_t i) const
+    {
+        static const char* gridnames[] = { "bg_test_grid.ct2", "bg_test_grid.dat",
+                                           "bg_test_grid.gsb", "bg_test_grid_be.gsb" };
+
+        bg::srs::transformation<> tr((bg::srs::proj4(std::string("+proj=longlat +ellps=WGS84 +nadgrids=") + gridnames[i % 4])),
+                                     (bg::srs::proj4("+proj=longlat +ellps=WGS84 +datum=WGS84")));
+        bg::srs::transformation_grids<storage_type> grids = tr.initialize_grids(storage);
+        tr.forward(ls, outs[i], grids);
+    }
+
+    storage_type & storage;
+    linestring_ll const& ls;
+    std::vector<linestring_ll> & outs;
+};
+
+void test_lockfree_concurrent()
+{
+    typedef bg::srs::grids_storage<bg::srs::ifstream_policy> ifstream_storage;
+
+    linestring_ll ls;
+    for (int i = 0 ; i < 200 ; ++i)
+    {
+        ls.push_back(point_ll(10.1 + 0.048 * i, 45.2 + 0.047 * i));
+    }
+
+    std::vector<linestring_ll> expected(4);
+    transform<ifstream_storage>("bg_test_grid.ct2", ls, expected[0]);
+    transform<ifstream_storage>("bg_test_grid.dat", ls, expected[1]);
+    transform<ifstream_storage>("bg_test_grid.gsb", ls, expected[2]);
+    transform<ifstream_storage>("bg_test_grid_be.gsb", ls, expected[3]);
+
+    std::size_t const count = 64;
+    lockfree_transform::storage_type storage;
+    std::vector<linestring_ll> outs(count);
+    lockfree_transform f(storage, ls, outs);
+    bg::detail::parallel::for_each_index(count, f, 16);
+
+    for (std::size_t i = 0 ; i < count ; ++i)
+    {
+        check_equal(outs[i], expected[i % 4], "concurrent");
+    }
+
+    // each file is added once
+    BOOST_CHECK_EQUAL(storage.hgrids.size(), 4u);
+}
+
+// The cells read from the mapped file are the same as the loaded ones
+void check_cells(bg::projections::detail::pj_gi const& mapped,
+                 bg::projections::detail::pj_gi & loaded)
+{
+    namespace bgpd = bg::projections::detail;
+
+    BOOST_CHECK(mapped.ct.cells.data != NULL);
+    BOOST_CHECK(mapped.ct.cvs.empty());
+
+    std::ifstream is(loaded.gridname.c_str(), std::ios::binary);
+    BOOST_CHECK(bgpd::pj_gridinfo_load(is, loaded));
+
+    boost::int32_t const count = mapped.ct.lim.lam * mapped.ct.lim.phi;
+    BOOST_CHECK_EQUAL(std::size_t(count), loaded.ct.cvs.size());
+    for (boost::int32_t i = 0 ; i < count ; ++i)
+    {
+        BOOST_CHECK_EQUAL(mapped.ct.cell(i).lam, loaded.ct.cvs[i].lam);
+        BOOST_CHECK_EQUAL(mapped.ct.cell(i).phi, loaded.ct.cvs[i].phi);
+    }
+
+    BOOST_CHECK_EQUAL(mapped.children.size(), loaded.children.size());
+    for (std::size_t i = 0 ; i < mapped.children.size() && i < loaded.children.size() ; ++i)
+    {
+        check_cells(mapped.children[i], loaded.children[i]);
+    }
+}
+
+void test_cells(std::string const& gridname)
+{
+    namespace bgpd = bg::projections::detail;
+
+    bg::srs::mapped_file_stream mis;
+    mis.open(gridname);
+    bgpd::pj_gridinfo mapped;
+    BOOST_CHECK(bgpd::pj_gridinfo_init(gridname, mis, mapped));
+
+    std::ifstream is(gridname.c_str(), std::ios::binary);
+    bgpd::pj_gridinfo loaded;
+    BOOST_CHECK(bgpd::pj_gridinfo_init(gridname, is, loaded));
+
+    BOOST_CHECK_EQUAL(mapped.size(), loaded.size());
+    for (std::size_t i = 0 ; i < mapped.size() && i < loaded.size() ; ++i)
+    {
+        check_cells(mapped[i], loaded[i]);
+    }
+}
+
+void test_missing()
+{
+    typedef bg::srs::grids_storage<bg::srs::mapped_file_policy> mapped_storage;
+
+    bg::srs::transformation<> tr((bg::srs::proj4("+proj=longlat +ellps=WGS84 +nadgrids=@bg_missing_grid.gsb")),
+                                 (bg::srs::proj4("+proj=longlat +ellps=WGS84 +datum=WGS84")));
+
+    mapped_storage storage;
+    bg::srs::transformation_grids<mapped_storage> grids = tr.initialize_grids(storage);
+    BOOST_CHECK(grids.src_grids.empty());
+}
+
+int test_main(int, char*[])
+{
+    write_ctable2("bg_test_grid.ct2");
+    write_ntv1("bg_test_grid.dat");
+    write_ntv2("bg_test_grid.gsb", false);
+    write_ntv2("bg_test_grid_be.gsb", true);
+
+    test_grid("bg_test_grid.ct2");
+    test_grid("bg_test_grid.dat");
+    test_grid("bg_test_grid.gsb");
+    test_grid("bg_test_grid_be.gsb");
+
+    test_cells("bg_test_grid.ct2");
+    test_cells("bg_test_grid.dat");
+    test_cells("bg_test_grid.gsb");
+    test_cells("bg_test_grid_be.gsb");
+    test_missing();
+    test_lockfree_concurrent();
+
+    std::remove("bg_test_grid.ct2");
+    std::remove("bg_test_grid.dat");
+    std::remove("bg_test_grid.gsb");
+    std::remove("bg_test_grid_be.gsb");
+
+    return 0;
+}
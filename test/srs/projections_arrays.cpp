@@ -0,0 +1,184 @@
+// Boost.Geometry
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include <geometry_test_common.hpp>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/srs/projection.hpp>
+#include <boost/geometry/srs/transformation.hpp>
+
+
+namespace bg = boost::geometry;
+
+typedef bg::model::point<double, 2, bg::cs::geographic<bg::degree> > point_ll;
+typedef bg::model::point<double, 2, bg::cs::cartesian> point_xy;
+
+
+void check_equal(double a, double b)
+{
+    if (a == HUGE_VAL || b == HUGE_VAL)
+    {
+        BOOST_CHECK_EQUAL(a, b);
+    }
+    else if (a != a || b != b)
+    {
+        // NaN
+        BOOST_CHECK(a != a && b != b);
+    }
+    else
+    {
+        BOOST_CHECK_SMALL(a - b, 1e-6);
+    }
+}
+
+// The grid of points covering the globe, some of them not valid in some
+// projections, more points than the size of a batch
+void test_points(std::vector<double> & lon, std::vector<double> & lat)
+{
+    for (int y = -90 ; y <= 90 ; y += 10)
+    {
+        for (int x = -180 ; x <= 180 ; x += 15)
+        {
+            lon.push_back(x + 0.5);
+            lat.push_back(y);
+        }
+    }
+}
+
+template <typename Projection>
+void test_projection(Projection const& prj, std::string const& name)
+{
+    std::vector<double> lon, lat;
+    test_points(lon, lat);
+    std::size_t const count = lon.size();
+
+    std::vector<double> x(count), y(count);
+    bool const result = prj.forward(&lon[0], &lat[0], &x[0], &y[0], count);
+
+    bool expected_result = true;
+    for (std::size_t i = 0 ; i < count ; ++i)
+    {
+        point_xy pt;
+        if (! prj.forward(point_ll(lon[i], lat[i]), pt))
+        {
+            expected_result = false;
+        }
+        check_equal(x[i], bg::get<0>(pt));
+        check_equal(y[i], bg::get<1>(pt));
+    }
+    BOOST_CHECK_MESSAGE(result == expected_result, name);
+
+    // the points projected in place
+    std::vector<double> lon2(lon), lat2(lat);
+    prj.forward(&lon2[0], &lat2[0], &lon2[0], &lat2[0], count);
+    BOOST_CHECK(lon2 == x && lat2 == y);
+
+    std::vector<double> lon3(count), lat3(count);
+    prj.inverse(&x[0], &y[0], &lon3[0], &lat3[0], count);
+    for (std::size_t i = 0 ; i < count ; ++i)
+    {
+        // the invalid points are not projected
+        if (x[i] == HUGE_VAL)
+        {
+            BOOST_CHECK_EQUAL(lon3[i], HUGE_VAL);
+            continue;
+        }
+
+        point_ll pt;
+        prj.inverse(point_xy(x[i], y[i]), pt);
+        check_equal(lon3[i], bg::get<0>(pt));
+        check_equal(lat3[i], bg::get<1>(pt));
+    }
+}
+
+void test_projections()
+{
+    using namespace bg::srs;
+
+    char const* const definitions[] = {
+        "+proj=merc +ellps=WGS84",
+        "+proj=merc +a=6378137 +b=6378137",
+        "+proj=tmerc +ellps=WGS84 +lon_0=15",
+        "+proj=tmerc +a=6378137 +b=6378137",
+        "+proj=etmerc +ellps=WGS84",
+        "+proj=utm +ellps=WGS84 +zone=33",
+        "+proj=lcc +ellps=WGS84 +lat_1=33 +lat_2=45",
+        "+proj=lcc +a=6378137 +b=6378137 +lat_1=33 +lat_2=45",
+        "+proj=robin +ellps=WGS84"
+    };
+
+    for (std::size_t i = 0 ; i < sizeof(definitions) / sizeof(char const*) ; ++i)
+    {
+        projection<> prj = proj4(definitions[i]);
+        test_projection(prj, definitions[i]);
+    }
+
+    {
+        projection<spar::parameters<spar::proj_tmerc, spar::ellps_wgs84> > prj;
+        test_projection(prj, "static tmerc");
+    }
+}
+
+void test_transformation()
+{
+    using namespace bg::srs;
+
+    std::vector<double> lon, lat;
+    test_points(lon, lat);
+    std::size_t const count = lon.size();
+
+    transformation<> tr((proj4("+proj=longlat +ellps=WGS84 +datum=WGS84 +no_defs")),
+                        (proj4("+proj=utm +ellps=intl +zone=33 +towgs84=-87,-98,-121")));
+
+    std::vector<double> x(count), y(count);
+    bool const result = tr.forward(&lon[0], &lat[0], &x[0], &y[0], count);
+
+    bool expected_result = true;
+    for (std::size_t i = 0 ; i < count ; ++i)
+    {
+        point_xy pt;
+        if (! tr.forward(point_ll(lon[i], lat[i]), pt))
+        {
+            expected_result = false;
+        }
+        check_equal(x[i], bg::get<0>(pt));
+        check_equal(y[i], bg::get<1>(pt));
+    }
+    BOOST_CHECK_EQUAL(result, expected_result);
+
+    std::vector<double> lon2(count), lat2(count);
+    tr.inverse(&x[0], &y[0], &lon2[0], &lat2[0], count);
+    for (std::size_t i = 0 ; i < count ; ++i)
+    {
+        if (x[i] == HUGE_VAL)
+        {
+            BOOST_CHECK_EQUAL(lon2[i], HUGE_VAL);
+            continue;
+        }
+
+        point_ll pt;
+        tr.inverse(point_xy(x[i], y[i]), pt);
+        check_equal(lon2[i], bg::get<0>(pt));
+        check_equal(lat2[i], bg::get<1>(pt));
+    }
+}
+
+int test_main(int, char*[])
+{
+    test_projections();
+    test_transformation();
+
+    return 0;
+}
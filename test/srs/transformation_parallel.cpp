@@ -0,0 +1,281 @@
+// Boost.Geometry
+// Unit Test
+
+// Copyright (c) 2018 Adam Wulkiewicz, Lodz, Poland.
+
+// Use, modification and distribution is subject to the Boost Software License,
+// Version 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+
+#include <geometry_test_common.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <boost/geometry.hpp>
+#include <boost/geometry/geometries/geometries.hpp>
+#include <boost/geometry/srs/shared_grids.hpp>
+#include <boost/geometry/srs/transformation.hpp>
+#include <boost/geometry/util/parallel.hpp>
+
+
+namespace bg = boost::geometry;
+
+typedef bg::model::point<double, 2, bg::cs::geographic<bg::degree> > point_ll;
+typedef bg::model::point<double, 2, bg::cs::cartesian> point_xy;
+typedef bg::model::point<float, 2, bg::cs::cartesian> point_xy_f;
+
+
+void check_equal(double a, double b)
+{
+    if (a == HUGE_VAL || b == HUGE_VAL)
+    {
+        BOOST_CHECK_EQUAL(a, b);
+    }
+    else
+    {
+        BOOST_CHECK_SMALL(a - b, 1e-6);
+    }
+}
+
+template <typename Geometry1, typename Geometry2>
+void check_geometry(Geometry1 const& g1, Geometry2 const& g2, std::string const& caseid)
+{
+    typedef bg::point_iterator<Geometry1 const> iterator1;
+    typedef bg::point_iterator<Geometry2 const> iterator2;
+
+    BOOST_CHECK_MESSAGE(bg::num_points(g1) == bg::num_points(g2),
+                        caseid << " points: " << bg::num_points(g1)
+                        << " expected: " << bg::num_points(g2));
+
+    iterator1 it1 = bg::points_begin(g1);
+    iterator2 it2 = bg::points_begin(g2);
+    for ( ; it1 != bg::points_end(g1) && it2 != bg::points_end(g2) ; ++it1, ++it2)
+    {
+        check_equal(bg::get<0>(*it1), bg::get<0>(*it2));
+        check_equal(bg::get<1>(*it1), bg::get<1>(*it2));
+    }
+}
+
+// A ring of n points around the center
+template <typename Ring>
+void make_ring(Ring & ring, double cx, double cy, double r, std::size_t n)
+{
+    typedef typename bg::point_type<Ring>::type point_type;
+
+    for (std::size_t i = 0 ; i < n ; ++i)
+    {
+        double const a = -2 * 3.1415926535897932 * double(i) / double(n);
+        bg::range::push_back(ring, point_type(cx + r * std::cos(a), cy + r * std::sin(a)));
+    }
+    bg::range::push_back(ring, bg::range::front(ring));
+}
+
+template <typename Transformation, typename GeometryIn, typename GeometryOut>
+void test_geometry(Transformation const& tr, GeometryIn const& in,
+                   GeometryOut const& , std::string const& caseid)
+{
+    GeometryOut expected, out1, out4;
+    bool const res = tr.forward(in, expected);
+    bool const res1 = tr.forward(bg::execution::parallel_policy(1), in, out1);
+    bool const res4 = tr.forward(bg::execution::parallel_policy(4), in, out4);
+
+    BOOST_CHECK_MESSAGE(res1 == res && res4 == res, caseid);
+    check_geometry(out1, expected, caseid + " 1");
+    check_geometry(out4, expected, caseid + " 4");
+
+    GeometryIn inv_expected, inv4;
+    tr.inverse(expected, inv_expected);
+    tr.inverse(bg::execution::parallel_policy(4), expected, inv4);
+    check_geometry(inv4, inv_expected, caseid + " inverse");
+}
+
+template <typename PointOut>
+void test_geometries(std::string const& caseid)
+{
+    typedef bg::model::linestring<point_ll> ls_ll;
+    typedef bg::model::polygon<point_ll> poly_ll;
+    typedef bg::model::multi_point<point_ll> mpt_ll;
+    typedef bg::model::multi_linestring<ls_ll> mls_ll;
+    typedef bg::model::multi_polygon<poly_ll> mpoly_ll;
+
+    typedef bg::model::linestring<PointOut> ls_xy;
+    typedef bg::model::polygon<PointOut> poly_xy;
+    typedef bg::model::multi_point<PointOut> mpt_xy;
+    typedef bg::model::multi_linestring<ls_xy> mls_xy;
+    typedef bg::model::multi_polygon<poly_xy> mpoly_xy;
+
+    bg::srs::transformation<> tr((bg::srs::proj4("+proj=longlat +ellps=WGS84 +datum=WGS84 +no_defs")),
+                                 (bg::srs::proj4("+proj=utm +ellps=intl +zone=33 +towgs84=-87,-98,-121")));
+
+    // a big ring, the points are transformed in parts
+    ls_ll ls;
+    make_ring(ls, 15, 50, 5, 10000);
+    test_geometry(tr, ls, ls_xy(), caseid + " linestring");
+
+    mpt_ll mpt;
+    make_ring(mpt, 15, 50, 5, 5000);
+    test_geometry(tr, mpt, mpt_xy(), caseid + " multi_point");
+
+    // big exterior and many interior rings
+    poly_ll poly;
+    make_ring(bg::exterior_ring(poly), 15, 50, 10, 5000);
+    bg::correct(poly);
+    for (int i = 0 ; i < 20 ; ++i)
+    {
+        bg::traits::push_back<typename bg::traits::interior_mutable_type<poly_ll>::type>
+            ::apply(bg::interior_rings(poly), typename bg::ring_type<poly_ll>::type());
+        make_ring(bg::interior_rings(poly).back(), 10 + i * 0.5, 50, 0.2, 50);
+    }
+    bg::correct(poly);
+    test_geometry(tr, poly, poly_xy(), caseid + " polygon");
+
+    // many members
+    mpoly_ll mpoly;
+    mls_ll mls;
+    for (int i = 0 ; i < 100 ; ++i)
+    {
+        poly_ll p;
+        make_ring(bg::exterior_ring(p), -20 + i, i % 2 ? 45 : -45, 0.4, 100);
+        bg::correct(p);
+        mpoly.push_back(p);
+
+        ls_ll l;
+        make_ring(l, -20 + i, 45, 0.4, 100);
+        mls.push_back(l);
+    }
+    test_geometry(tr, mpoly, mpoly_xy(), caseid + " multi_polygon");
+    test_geometry(tr, mls, mls_xy(), caseid + " multi_linestring");
+
+    // less members than threads
+    mpoly_ll mpoly2;
+    mpoly2.push_back(poly);
+    test_geometry(tr, mpoly2, mpoly_xy(), caseid + " multi_polygon one");
+}
+
+void test_invalid()
+{
+    typedef bg::model::linestring<point_ll> ls_ll;
+    typedef bg::model::linestring<point_xy> ls_xy;
+
+    // points which can't be transformed
+    bg::srs::transformation<> tr((bg::srs::proj4("+proj=longlat +ellps=WGS84 +datum=WGS84 +no_defs")),
+                                 (bg::srs::proj4("+proj=tmerc +ellps=WGS84 +lon_0=15")));
+    ls_ll ls;
+    make_ring(ls, 15, 0, 179, 10000);
+    test_geometry(tr, ls, ls_xy(), "invalid");
+}
+
+// Non-transient errors are not ignored, the same way for ranges
+// transformed in parts and members of multi-geometries
+void test_errors()
+{
+    typedef bg::model::linestring<point_xy> ls_xy;
+    typedef bg::model::multi_linestring<ls_xy> mls_xy;
+    typedef bg::model::linestring<point_ll> ls_ll;
+    typedef bg::model::multi_linestring<ls_ll> mls_ll;
+
+    // geocentric coordinates have to be 3D
+    bg::srs::transformation<> tr((bg::srs::proj4("+proj=geocent +ellps=WGS84")),
+                                 (bg::srs::proj4("+proj=longlat +ellps=WGS84")));
+
+    ls_xy ls;
+    make_ring(ls, 0, 0, 1000, 10000);
+    ls_ll ls_out;
+    BOOST_CHECK_THROW(tr.forward(bg::execution::parallel_policy(4), ls, ls_out),
+                      bg::projection_exception);
+
+    mls_xy mls;
+    for (int i = 0 ; i < 10 ; ++i)
+    {
+        mls.push_back(ls_xy());
+        make_ring(mls.back(), i, 0, 1000, 100);
+    }
+    mls_ll mls_out;
+    BOOST_CHECK_THROW(tr.forward(bg::execution::parallel_policy(4), mls, mls_out),
+                      bg::projection_exception);
+
+    // less members than threads
+    mls.resize(2);
+    BOOST_CHECK_THROW(tr.forward(bg::execution::parallel_policy(4), mls, mls_out),
+                      bg::projection_exception);
+}
+
+void test_arrays()
+{
+    bg::srs::transformation<> tr((bg::srs::proj4("+proj=longlat +ellps=WGS84 +datum=WGS84 +no_defs")),
+                                 (bg::srs::proj4("+proj=utm +ellps=intl +zone=33 +towgs84=-87,-98,-121")));
+
+    std::vector<double> lon, lat;
+    for (int y = -90 ; y <= 90 ; ++y)
+    {
+        for (int x = -180 ; x <= 180 ; x += 3)
+        {
+            lon.push_back(x + 0.5);
+            lat.push_back(y);
+        }
+    }
+    std::size_t const count = lon.size();
+
+    std::vector<double> x(count), y(count), x4(count), y4(count);
+    bool const res = tr.forward(&lon[0], &lat[0], &x[0], &y[0], count);
+    bool const res4 = tr.forward(bg::execution::parallel_policy(4),
+                                 &lon[0], &lat[0], &x4[0], &y4[0], count);
+    BOOST_CHECK_EQUAL(res, res4);
+    for (std::size_t i = 0 ; i < count ; ++i)
+    {
+        check_equal(x4[i], x[i]);
+        check_equal(y4[i], y[i]);
+    }
+
+    std::vector<double> lon2(count), lat2(count), lon4(count), lat4(count);
+    tr.inverse(&x[0], &y[0], &lon2[0], &lat2[0], count);
+    tr.inverse(bg::execution::parallel_policy(4), &x[0], &y[0], &lon4[0], &lat4[0], count);
+    for (std::size_t i = 0 ; i < count ; ++i)
+    {
+        check_equal(lon4[i], lon2[i]);
+        check_equal(lat4[i], lat2[i]);
+    }
+
+    // the number of points not divisible by the size of a batch
+    std::vector<double> x5(count), y5(count);
+    tr.forward(bg::execution::parallel_policy(3), &lon[0], &lat[0], &x5[0], &y5[0], 1001);
+    for (std::size_t i = 0 ; i < 1001 ; ++i)
+    {
+        check_equal(x5[i], x[i]);
+        check_equal(y5[i], y[i]);
+    }
+}
+
+void test_shared_grids()
+{
+    bg::srs::transformation<> tr((bg::srs::proj4("+proj=longlat +ellps=WGS84 +datum=WGS84 +no_defs")),
+                                 (bg::srs::proj4("+proj=merc +ellps=WGS84")));
+
+    typedef bg::srs::grids_storage<bg::srs::ifstream_policy, bg::srs::shared_grids> storage_type;
+    storage_type storage;
+    bg::srs::transformation_grids<storage_type> grids = tr.initialize_grids(storage);
+
+    bg::model::linestring<point_ll> ls;
+    make_ring(ls, 15, 50, 5, 1000);
+
+    bg::model::linestring<point_xy> expected, out;
+    tr.forward(ls, expected, grids);
+    tr.forward(bg::execution::parallel_policy(4), ls, out, grids);
+    check_geometry(out, expected, "shared grids");
+}
+
+int test_main(int, char*[])
+{
+    test_geometries<point_xy>("double");
+    test_geometries<point_xy_f>("float");
+    test_invalid();
+    test_errors();
+    test_arrays();
+    test_shared_grids();
+
+    return 0;
+}